@@ -0,0 +1,142 @@
+#if defined(_WIN32)
+// Windows
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+// Posix
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // defined(_WIN32)
+
+// Standard
+#include <utility>
+
+// Tilia
+#include "Mapped_File.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+
+tilia::utils::Mapped_File::~Mapped_File()
+{
+	Close();
+}
+
+tilia::utils::Mapped_File::Mapped_File(Mapped_File&& other) noexcept
+	: m_data{ std::exchange(other.m_data, nullptr) }, m_size{ std::exchange(other.m_size, 0) },
+	m_mapping{ std::exchange(other.m_mapping, nullptr) }
+{
+}
+
+tilia::utils::Mapped_File& tilia::utils::Mapped_File::operator=(Mapped_File&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+	Close();
+	m_data = std::exchange(other.m_data, nullptr);
+	m_size = std::exchange(other.m_size, 0);
+	m_mapping = std::exchange(other.m_mapping, nullptr);
+	return *this;
+}
+
+/**
+ * The file itself is closed once mapped, the mapping keeps it open for as long as it is needed.
+ */
+void tilia::utils::Mapped_File::Open(const std::string& path)
+{
+
+	Close();
+
+#if defined(_WIN32)
+
+	const HANDLE file{ CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr) };
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Failed to open file for mapping { Path: ", path, ", Error: ", GetLastError(),
+			" }" } };
+	}
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Can not map an empty file { Path: ", path, " }" } };
+	}
+
+	const HANDLE mapping{ CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+	CloseHandle(file);
+	if (!mapping)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Failed to map file { Path: ", path, ", Error: ", GetLastError(), " }" } };
+	}
+
+	const void* view{ MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) };
+	if (!view)
+	{
+		const auto error{ GetLastError() };
+		CloseHandle(mapping);
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Failed to map view of file { Path: ", path, ", Error: ", error, " }" } };
+	}
+
+	m_data = static_cast<const std::uint8_t*>(view);
+	m_size = static_cast<std::size_t>(size.QuadPart);
+	m_mapping = mapping;
+
+#else
+
+	const int file{ open(path.c_str(), O_RDONLY) };
+	if (file < 0)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Failed to open file for mapping { Path: ", path, " }" } };
+	}
+
+	struct stat status {};
+	if (fstat(file, &status) != 0 || status.st_size == 0)
+	{
+		close(file);
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Can not map an empty file { Path: ", path, " }" } };
+	}
+
+	const auto size{ static_cast<std::size_t>(status.st_size) };
+	void* view{ mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0) };
+	close(file);
+	if (view == MAP_FAILED)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Failed to map file { Path: ", path, " }" } };
+	}
+
+	m_data = static_cast<const std::uint8_t*>(view);
+	m_size = size;
+
+#endif // defined(_WIN32)
+
+}
+
+void tilia::utils::Mapped_File::Close()
+{
+
+	if (!m_data)
+		return;
+
+#if defined(_WIN32)
+	UnmapViewOfFile(m_data);
+	CloseHandle(static_cast<HANDLE>(m_mapping));
+#else
+	munmap(const_cast<std::uint8_t*>(m_data), m_size);
+#endif // defined(_WIN32)
+
+	m_data = nullptr;
+	m_size = 0;
+	m_mapping = nullptr;
+
+}
@@ -0,0 +1,85 @@
+/**************************************************************************************************
+ * @file   Mapped_File.hpp
+ *
+ * @brief  Maps a file into memory for reading. The pages of the file are read in by the system
+ *		   as they are touched, so data can be handed straight to where it is needed without
+ *		   first being copied into a buffer of its own.
+ *
+ * @author Gustav Fagerlind
+ * @date   19/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_WINDOWS_MAPPED_FILE_HPP
+#define TILIA_WINDOWS_MAPPED_FILE_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace tilia
+{
+	namespace utils
+	{
+
+		/**
+		 * @brief A read only mapping of a file. Can be moved but not copied, the mapping is
+		 * closed along with it.
+		 */
+		class Mapped_File
+		{
+		public:
+
+			Mapped_File() = default;
+			~Mapped_File();
+
+			Mapped_File(Mapped_File&& other) noexcept;
+			Mapped_File& operator=(Mapped_File&& other) noexcept;
+
+			// Mapped_File shan't be copyable
+			Mapped_File(const Mapped_File&) = delete;
+			Mapped_File& operator=(const Mapped_File&) = delete;
+
+			/**
+			 * @brief Maps the whole of the given file, closing any earlier mapping.
+			 *
+			 * @param path - The path of the file to map.
+			 *
+			 * @exception The file could not be opened, is empty or could not be mapped.
+			 */
+			void Open(const std::string& path);
+
+			/**
+			 * @brief Unmaps the file. Pointers into the mapping are left dangling.
+			 */
+			void Close();
+
+			/**
+			 * @brief Whether or not a file is mapped.
+			 */
+			bool Is_Open() const { return m_data != nullptr; }
+
+			/**
+			 * @brief Gets the first byte of the mapping, nullptr if nothing is mapped.
+			 */
+			const std::uint8_t* Get_Data() const { return m_data; }
+
+			/**
+			 * @brief Gets the size of the mapping in bytes.
+			 */
+			std::size_t Get_Size() const { return m_size; }
+
+		private:
+
+			const std::uint8_t* m_data{ nullptr };
+			std::size_t m_size{};
+
+			// The handle of the mapping on systems which keep one apart from the view
+			void* m_mapping{ nullptr };
+
+		}; // Mapped_File
+
+	} // utils
+} // tilia
+
+#endif // TILIA_WINDOWS_MAPPED_FILE_HPP
@@ -0,0 +1,845 @@
+// Standard
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+// Tilia
+#include "Block_Encoder.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+#include TILIA_JOB_SYSTEM_INCLUDE
+#include TILIA_OPENGL_3_3_PROGRAM_BINARY_CACHE_INCLUDE
+
+#if TILIA_SSE2 == 1
+// Standard
+#include <emmintrin.h>
+#endif // TILIA_SSE2 == 1
+
+static constexpr char FILE_MAGIC[4]{ 'T', 'B', 'L', 'K' };
+static constexpr std::uint32_t FILE_VERSION{ 1 };
+
+// The amount of rows of blocks every job encodes
+static constexpr std::size_t ROWS_PER_JOB{ 4 };
+
+// The index of each color of a color block, ordered from the second endpoint to the first
+static constexpr std::uint32_t COLOR_INDICES[4]{ 1, 3, 2, 0 };
+
+/**
+ * Copies a block of texels into RGBA, repeating the last row and column for blocks hanging over
+ * the edge of the image.
+ */
+static void Fetch_Block(const std::uint8_t* data, std::int32_t width, std::int32_t height,
+	std::int32_t channels, std::int32_t block_x, std::int32_t block_y, std::uint8_t* texels)
+{
+	constexpr auto block_size{ tilia::Block_Encoder::s_block_size };
+	for (std::int32_t y{ 0 }; y < block_size; ++y)
+	{
+		const std::int32_t source_y{ std::min(block_y * block_size + y, height - 1) };
+		for (std::int32_t x{ 0 }; x < block_size; ++x)
+		{
+			const std::int32_t source_x{ std::min(block_x * block_size + x, width - 1) };
+			const std::uint8_t* texel{ data +
+				(static_cast<std::size_t>(source_y) * width + source_x) * channels };
+			std::uint8_t* rgba{ texels + (y * block_size + x) * 4 };
+			switch (channels)
+			{
+			case 1:
+				rgba[0] = rgba[1] = rgba[2] = texel[0];
+				rgba[3] = 0xFF;
+				break;
+			case 2:
+				rgba[0] = rgba[1] = rgba[2] = texel[0];
+				rgba[3] = texel[1];
+				break;
+			case 3:
+				rgba[0] = texel[0];
+				rgba[1] = texel[1];
+				rgba[2] = texel[2];
+				rgba[3] = 0xFF;
+				break;
+			default:
+				std::memcpy(rgba, texel, 4);
+				break;
+			}
+		}
+	}
+}
+
+static std::uint16_t To_565(const std::uint8_t* color)
+{
+	return static_cast<std::uint16_t>(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) |
+		(color[2] >> 3));
+}
+
+/**
+ * The low bits are filled with the high bits so that 0x1F becomes 0xFF rather than 0xF8.
+ */
+static void From_565(std::uint16_t packed, std::int32_t* color)
+{
+	const std::int32_t r{ (packed >> 11) & 0x1F }, g{ (packed >> 5) & 0x3F }, b{ packed & 0x1F };
+	color[0] = (r << 3) | (r >> 2);
+	color[1] = (g << 2) | (g >> 4);
+	color[2] = (b << 3) | (b >> 2);
+}
+
+/**
+ * Projects every texel of a block onto the line between the endpoints and finds the nearest of
+ * the four colors on it, 0 to 3 starting at the second endpoint. With SSE2 four texels are
+ * projected at a time.
+ */
+static void Find_Color_Steps(const std::uint8_t* texels, std::uint16_t first_endpoint,
+	std::uint16_t second_endpoint, std::int32_t* steps)
+{
+
+	std::int32_t first[3]{}, second[3]{};
+	From_565(first_endpoint, first);
+	From_565(second_endpoint, second);
+
+	const std::int32_t direction[3]{ first[0] - second[0], first[1] - second[1],
+		first[2] - second[2] };
+	const std::int32_t length{ direction[0] * direction[0] + direction[1] * direction[1] +
+		direction[2] * direction[2] };
+	const std::int32_t base{ second[0] * direction[0] + second[1] * direction[1] +
+		second[2] * direction[2] };
+
+#if TILIA_SSE2 == 1
+
+	const __m128i zero{ _mm_setzero_si128() };
+	const __m128i directions{ _mm_setr_epi16(
+		static_cast<std::int16_t>(direction[0]), static_cast<std::int16_t>(direction[1]),
+		static_cast<std::int16_t>(direction[2]), 0,
+		static_cast<std::int16_t>(direction[0]), static_cast<std::int16_t>(direction[1]),
+		static_cast<std::int16_t>(direction[2]), 0) };
+	const __m128i bases{ _mm_set1_epi32(base) };
+	const __m128i thresholds[3]{ _mm_set1_epi32(length - 1),
+		_mm_set1_epi32(length * 3 - 1), _mm_set1_epi32(length * 5 - 1) };
+
+	for (std::size_t i{ 0 }; i < 4; ++i)
+	{
+		const __m128i four_texels{
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(texels + i * 16)) };
+
+		// Every texel gives two sums, red and green as well as blue and alpha
+		const __m128 low{ _mm_castsi128_ps(_mm_madd_epi16(
+			_mm_unpacklo_epi8(four_texels, zero), directions)) };
+		const __m128 high{ _mm_castsi128_ps(_mm_madd_epi16(
+			_mm_unpackhi_epi8(four_texels, zero), directions)) };
+		const __m128i dots{ _mm_sub_epi32(_mm_add_epi32(
+			_mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0))),
+			_mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)))),
+			bases) };
+
+		// Compared against the halfway points between the colors, scaled by 6 * length
+		const __m128i scaled{ _mm_add_epi32(_mm_slli_epi32(dots, 2),
+			_mm_slli_epi32(dots, 1)) };
+		const __m128i step{ _mm_sub_epi32(zero, _mm_add_epi32(
+			_mm_add_epi32(_mm_cmpgt_epi32(scaled, thresholds[0]),
+				_mm_cmpgt_epi32(scaled, thresholds[1])),
+			_mm_cmpgt_epi32(scaled, thresholds[2]))) };
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(steps + i * 4), step);
+	}
+
+#else
+
+	for (std::size_t i{ 0 }; i < 16; ++i)
+	{
+		const std::uint8_t* texel{ texels + i * 4 };
+		const std::int32_t scaled{ 6 * (texel[0] * direction[0] + texel[1] * direction[1] +
+			texel[2] * direction[2] - base) };
+		steps[i] = (scaled >= length) + (scaled >= length * 3) + (scaled >= length * 5);
+	}
+
+#endif // TILIA_SSE2 == 1
+
+}
+
+std::size_t tilia::Block_Image::Get_Blocks_X() const
+{
+	return static_cast<std::size_t>((width + Block_Encoder::s_block_size - 1) /
+		Block_Encoder::s_block_size);
+}
+
+std::size_t tilia::Block_Image::Get_Blocks_Y() const
+{
+	return static_cast<std::size_t>((height + Block_Encoder::s_block_size - 1) /
+		Block_Encoder::s_block_size);
+}
+
+std::size_t tilia::Block_Image::Get_Row_Size() const
+{
+	return Get_Blocks_X() * Block_Encoder::Get_Block_Bytes(format);
+}
+
+void tilia::Block_Encoder::Init(const std::string& directory)
+{
+
+	try
+	{
+		std::filesystem::create_directories(directory);
+	}
+	catch (std::exception& e)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Failed to create block encoder directory { Directory: ", directory, " }",
+			"\n>>> Message: ", e.what() } };
+	}
+
+	m_directory = directory;
+
+}
+
+/**
+ * The key is made from the path along with the size and last write time of the file, which
+ * changes the key whenever the file does without having to read it.
+ */
+tilia::Block_Image tilia::Block_Encoder::Load(const std::string& path,
+	enums::Block_Format format, bool flip_vertical)
+{
+
+	using gfx::Program_Binary_Cache;
+
+	std::error_code error{};
+	const auto file_size{ static_cast<std::uint64_t>(std::filesystem::file_size(path, error)) };
+	const auto write_time{ static_cast<std::int64_t>(
+		std::filesystem::last_write_time(path, error).time_since_epoch().count()) };
+	const auto stored_format{ static_cast<std::uint32_t>(format) };
+	const std::uint8_t flip{ flip_vertical };
+
+	std::uint64_t key{ Program_Binary_Cache::Hash(path.data(), path.size()) };
+	key = Program_Binary_Cache::Hash(&file_size, sizeof(file_size), key);
+	key = Program_Binary_Cache::Hash(&write_time, sizeof(write_time), key);
+	key = Program_Binary_Cache::Hash(&stored_format, sizeof(stored_format), key);
+	key = Program_Binary_Cache::Hash(&flip, sizeof(flip), key);
+
+	std::string stored_path{};
+	if (!m_directory.empty())
+	{
+		char name[32]{};
+		std::snprintf(name, sizeof(name), "%016llx.tbc", static_cast<unsigned long long>(key));
+		stored_path = (std::filesystem::path{ m_directory } / name).string();
+	}
+
+	Block_Image block_image{};
+
+	if (!stored_path.empty() && Read(stored_path, key, block_image))
+	{
+		++m_hits;
+		return block_image;
+	}
+
+	++m_misses;
+
+	try
+	{
+		const Image image{ path, Get_Image_Channels(format), enums::Image_Data_Type::Unsigned_Byte,
+			flip_vertical };
+		block_image = Encode(image, format);
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION, "Failed to encode image { Path: ", path, " }" });
+	}
+
+	if (!stored_path.empty())
+		Write(stored_path, key, block_image);
+
+	return block_image;
+
+}
+
+tilia::Block_Image tilia::Block_Encoder::Encode(const Image& image, enums::Block_Format format)
+{
+
+	if (image.Data_Type() != enums::Image_Data_Type::Unsigned_Byte)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Only images of unsigned bytes can be block encoded { Data type: ",
+			*image.Data_Type(), " }" } };
+	}
+
+	return Encode(image.Get_Data(), image.Width(), image.Height(), *image.Channels(), format);
+
+}
+
+/**
+ * Rows of blocks are split over the workers of the job system, each block being independent of
+ * every other.
+ */
+tilia::Block_Image tilia::Block_Encoder::Encode(const std::uint8_t* data, std::int32_t width,
+	std::int32_t height, std::int32_t channels, enums::Block_Format format)
+{
+
+	if (!data || width <= 0 || height <= 0 || channels < 1 || channels > 4)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Image can not be block encoded { Width: ", width, ", Height: ", height,
+			", Channels: ", channels, " }" } };
+	}
+
+	Block_Image block_image{};
+	block_image.format = format;
+	block_image.width = width;
+	block_image.height = height;
+	block_image.data.resize(Get_Encoded_Size(format, width, height));
+
+	const std::size_t blocks_x{ block_image.Get_Blocks_X() };
+	const std::size_t block_bytes{ Get_Block_Bytes(format) };
+	std::uint8_t* const blocks{ block_image.data.data() };
+
+	auto encode_rows{ [=](std::size_t begin, std::size_t end)
+	{
+		std::uint8_t texels[s_block_size * s_block_size * 4]{};
+		for (std::size_t y{ begin }; y < end; ++y)
+		{
+			for (std::size_t x{ 0 }; x < blocks_x; ++x)
+			{
+				Fetch_Block(data, width, height, channels, static_cast<std::int32_t>(x),
+					static_cast<std::int32_t>(y), texels);
+
+				std::uint8_t* const block{ blocks + (y * blocks_x + x) * block_bytes };
+				switch (format)
+				{
+				case enums::Block_Format::BC1:
+					Encode_Color_Block(texels, block);
+					break;
+				case enums::Block_Format::BC3:
+					Encode_Channel_Block(texels, 3, block);
+					Encode_Color_Block(texels, block + 8);
+					break;
+				case enums::Block_Format::BC4:
+					Encode_Channel_Block(texels, 0, block);
+					break;
+				case enums::Block_Format::BC5:
+					Encode_Channel_Block(texels, 0, block);
+					Encode_Channel_Block(texels, 1, block + 8);
+					break;
+				}
+			}
+		}
+	} };
+
+	const std::size_t blocks_y{ block_image.Get_Blocks_Y() };
+
+	jobs::Job_System& job_system{ jobs::Job_System::Instance() };
+	if (job_system.Can_Run_Jobs() && blocks_y > ROWS_PER_JOB)
+		job_system.Parallel_For(0, blocks_y, ROWS_PER_JOB, encode_rows);
+	else
+		encode_rows(0, blocks_y);
+
+	return block_image;
+
+}
+
+/**
+ * The endpoints are the corners of the bounding box of the block, moved a sixteenth of the box
+ * inwards since the texels at the corners are usually few. Texels are projected onto the line
+ * between the endpoints and given the nearest of the four colors on it, after which the
+ * endpoints are fitted to those colors once. With SSE2 the bounding box is found for all texels
+ * at once.
+ */
+void tilia::Block_Encoder::Encode_Color_Block(const std::uint8_t* texels, std::uint8_t* block)
+{
+
+	std::uint8_t min_color[4]{}, max_color[4]{};
+
+#if TILIA_SSE2 == 1
+
+	__m128i min_texels{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels)) };
+	__m128i max_texels{ min_texels };
+	for (std::size_t i{ 1 }; i < 4; ++i)
+	{
+		const __m128i four_texels{
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(texels + i * 16)) };
+		min_texels = _mm_min_epu8(min_texels, four_texels);
+		max_texels = _mm_max_epu8(max_texels, four_texels);
+	}
+	min_texels = _mm_min_epu8(min_texels, _mm_srli_si128(min_texels, 8));
+	min_texels = _mm_min_epu8(min_texels, _mm_srli_si128(min_texels, 4));
+	max_texels = _mm_max_epu8(max_texels, _mm_srli_si128(max_texels, 8));
+	max_texels = _mm_max_epu8(max_texels, _mm_srli_si128(max_texels, 4));
+
+	const std::int32_t packed_min{ _mm_cvtsi128_si32(min_texels) };
+	const std::int32_t packed_max{ _mm_cvtsi128_si32(max_texels) };
+	std::memcpy(min_color, &packed_min, sizeof(min_color));
+	std::memcpy(max_color, &packed_max, sizeof(max_color));
+
+#else
+
+	std::memcpy(min_color, texels, sizeof(min_color));
+	std::memcpy(max_color, texels, sizeof(max_color));
+	for (std::size_t i{ 1 }; i < 16; ++i)
+	{
+		for (std::size_t c{ 0 }; c < 4; ++c)
+		{
+			min_color[c] = std::min(min_color[c], texels[i * 4 + c]);
+			max_color[c] = std::max(max_color[c], texels[i * 4 + c]);
+		}
+	}
+
+#endif // TILIA_SSE2 == 1
+
+	// The box is flipped along every channel falling as the widest channel rises, so that the
+	// endpoints lie on the diagonal the colors follow
+	std::size_t widest{ 0 };
+	for (std::size_t c{ 1 }; c < 3; ++c)
+	{
+		if (max_color[c] - min_color[c] > max_color[widest] - min_color[widest])
+			widest = c;
+	}
+	std::int32_t covariance[3]{};
+	for (std::size_t i{ 0 }; i < 16; ++i)
+	{
+		const std::uint8_t* texel{ texels + i * 4 };
+		const std::int32_t offset{ texel[widest] * 2 - min_color[widest] - max_color[widest] };
+		for (std::size_t c{ 0 }; c < 3; ++c)
+			covariance[c] += offset * (texel[c] * 2 - min_color[c] - max_color[c]);
+	}
+	for (std::size_t c{ 0 }; c < 3; ++c)
+	{
+		if (covariance[c] < 0)
+			std::swap(min_color[c], max_color[c]);
+	}
+
+	for (std::size_t c{ 0 }; c < 3; ++c)
+	{
+		const std::int32_t inset{ (max_color[c] - min_color[c]) / 16 };
+		min_color[c] = static_cast<std::uint8_t>(min_color[c] + inset);
+		max_color[c] = static_cast<std::uint8_t>(max_color[c] - inset);
+	}
+
+	// The first endpoint has to be the larger for the block to use four colors
+	std::uint16_t endpoints[2]{ To_565(max_color), To_565(min_color) };
+	if (endpoints[0] < endpoints[1])
+		std::swap(endpoints[0], endpoints[1]);
+
+	std::uint32_t indices{};
+
+	if (endpoints[0] != endpoints[1])
+	{
+
+		std::int32_t steps[16]{};
+		Find_Color_Steps(texels, endpoints[0], endpoints[1], steps);
+
+		// The endpoints are then moved to those fitting the steps best by least squares, which
+		// mends blocks whose colors do not lie along the diagonal of their box
+		float aa{}, bb{}, ab{}, ax[3]{}, bx[3]{};
+		for (std::size_t i{ 0 }; i < 16; ++i)
+		{
+			const float a{ static_cast<float>(steps[i]) / 3.0f }, b{ 1.0f - a };
+			aa += a * a;
+			bb += b * b;
+			ab += a * b;
+			for (std::size_t c{ 0 }; c < 3; ++c)
+			{
+				ax[c] += a * texels[i * 4 + c];
+				bx[c] += b * texels[i * 4 + c];
+			}
+		}
+
+		const float determinant{ aa * bb - ab * ab };
+		if (determinant > 0.0f)
+		{
+			std::uint8_t first[4]{}, second[4]{};
+			for (std::size_t c{ 0 }; c < 3; ++c)
+			{
+				first[c] = static_cast<std::uint8_t>(std::clamp(
+					(ax[c] * bb - bx[c] * ab) / determinant + 0.5f, 0.0f, 255.0f));
+				second[c] = static_cast<std::uint8_t>(std::clamp(
+					(bx[c] * aa - ax[c] * ab) / determinant + 0.5f, 0.0f, 255.0f));
+			}
+
+			std::uint16_t refined[2]{ To_565(first), To_565(second) };
+			if (refined[0] < refined[1])
+				std::swap(refined[0], refined[1]);
+			if (refined[0] != refined[1])
+			{
+				endpoints[0] = refined[0];
+				endpoints[1] = refined[1];
+				Find_Color_Steps(texels, endpoints[0], endpoints[1], steps);
+			}
+		}
+
+		for (std::size_t i{ 0 }; i < 16; ++i)
+			indices |= COLOR_INDICES[steps[i]] << (i * 2);
+
+	}
+
+	block[0] = static_cast<std::uint8_t>(endpoints[0] & 0xFF);
+	block[1] = static_cast<std::uint8_t>(endpoints[0] >> 8);
+	block[2] = static_cast<std::uint8_t>(endpoints[1] & 0xFF);
+	block[3] = static_cast<std::uint8_t>(endpoints[1] >> 8);
+	block[4] = static_cast<std::uint8_t>(indices & 0xFF);
+	block[5] = static_cast<std::uint8_t>((indices >> 8) & 0xFF);
+	block[6] = static_cast<std::uint8_t>((indices >> 16) & 0xFF);
+	block[7] = static_cast<std::uint8_t>(indices >> 24);
+
+}
+
+/**
+ * The endpoints are the smallest and largest value of the block, the larger first so that the
+ * six values between them are used. Each value is rounded to the nearest step between them.
+ */
+void tilia::Block_Encoder::Encode_Channel_Block(const std::uint8_t* texels, std::size_t channel,
+	std::uint8_t* block)
+{
+
+	std::uint8_t values[16]{};
+	for (std::size_t i{ 0 }; i < 16; ++i)
+		values[i] = texels[i * 4 + channel];
+
+#if TILIA_SSE2 == 1
+
+	__m128i min_values{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(values)) };
+	__m128i max_values{ min_values };
+	min_values = _mm_min_epu8(min_values, _mm_srli_si128(min_values, 8));
+	min_values = _mm_min_epu8(min_values, _mm_srli_si128(min_values, 4));
+	min_values = _mm_min_epu8(min_values, _mm_srli_si128(min_values, 2));
+	min_values = _mm_min_epu8(min_values, _mm_srli_si128(min_values, 1));
+	max_values = _mm_max_epu8(max_values, _mm_srli_si128(max_values, 8));
+	max_values = _mm_max_epu8(max_values, _mm_srli_si128(max_values, 4));
+	max_values = _mm_max_epu8(max_values, _mm_srli_si128(max_values, 2));
+	max_values = _mm_max_epu8(max_values, _mm_srli_si128(max_values, 1));
+	const auto min_value{ static_cast<std::uint8_t>(_mm_cvtsi128_si32(min_values) & 0xFF) };
+	const auto max_value{ static_cast<std::uint8_t>(_mm_cvtsi128_si32(max_values) & 0xFF) };
+
+#else
+
+	const auto min_value{ *std::min_element(values, values + 16) };
+	const auto max_value{ *std::max_element(values, values + 16) };
+
+#endif // TILIA_SSE2 == 1
+
+	block[0] = max_value;
+	block[1] = min_value;
+
+	std::uint64_t indices{};
+
+	const std::int32_t range{ max_value - min_value };
+	if (range > 0)
+	{
+		for (std::size_t i{ 0 }; i < 16; ++i)
+		{
+			const std::int32_t step{ ((values[i] - min_value) * 14 + range) / (range * 2) };
+			// The endpoints are indices 0 and 1, the steps between them go down from the first
+			const std::uint64_t index{ static_cast<std::uint64_t>(
+				(step == 7) ? 0 : (step == 0) ? 1 : 8 - step) };
+			indices |= index << (i * 3);
+		}
+	}
+
+	for (std::size_t i{ 0 }; i < 6; ++i)
+		block[2 + i] = static_cast<std::uint8_t>((indices >> (i * 8)) & 0xFF);
+
+}
+
+tilia::Image tilia::Block_Encoder::Decode(const Block_Image& block_image)
+{
+
+	const auto width{ static_cast<std::size_t>(block_image.width) };
+	const auto height{ static_cast<std::size_t>(block_image.height) };
+	const std::size_t blocks_x{ block_image.Get_Blocks_X() };
+	const std::size_t block_bytes{ Get_Block_Bytes(block_image.format) };
+
+	std::vector<std::uint8_t> texels(width * height * 4);
+
+	auto decode_channel{ [](const std::uint8_t* block, std::size_t texel)
+	{
+		const std::int32_t first{ block[0] }, second{ block[1] };
+		std::uint64_t indices{};
+		for (std::size_t i{ 0 }; i < 6; ++i)
+			indices |= static_cast<std::uint64_t>(block[2 + i]) << (i * 8);
+		const auto index{ static_cast<std::int32_t>((indices >> (texel * 3)) & 0x7) };
+
+		if (index < 2)
+			return static_cast<std::uint8_t>((index == 0) ? first : second);
+		if (first > second)
+			return static_cast<std::uint8_t>(((8 - index) * first + (index - 1) * second) / 7);
+		if (index < 6)
+			return static_cast<std::uint8_t>(((6 - index) * first + (index - 1) * second) / 5);
+		return static_cast<std::uint8_t>((index == 6) ? 0 : 0xFF);
+	} };
+
+	auto decode_color{ [](const std::uint8_t* block, std::size_t texel, std::uint8_t* rgb)
+	{
+		const auto first_packed{ static_cast<std::uint16_t>(block[0] | (block[1] << 8)) };
+		const auto second_packed{ static_cast<std::uint16_t>(block[2] | (block[3] << 8)) };
+		std::int32_t first[3]{}, second[3]{};
+		From_565(first_packed, first);
+		From_565(second_packed, second);
+
+		const std::uint32_t indices{ static_cast<std::uint32_t>(block[4]) |
+			(static_cast<std::uint32_t>(block[5]) << 8) |
+			(static_cast<std::uint32_t>(block[6]) << 16) |
+			(static_cast<std::uint32_t>(block[7]) << 24) };
+		const std::uint32_t index{ (indices >> (texel * 2)) & 0x3 };
+
+		for (std::size_t c{ 0 }; c < 3; ++c)
+		{
+			std::int32_t value{};
+			if (index == 0)
+				value = first[c];
+			else if (index == 1)
+				value = second[c];
+			else if (first_packed > second_packed)
+				value = (index == 2) ? (first[c] * 2 + second[c]) / 3 :
+					(first[c] + second[c] * 2) / 3;
+			else
+				value = (index == 2) ? (first[c] + second[c]) / 2 : 0;
+			rgb[c] = static_cast<std::uint8_t>(value);
+		}
+	} };
+
+	for (std::size_t y{ 0 }; y < height; ++y)
+	{
+		for (std::size_t x{ 0 }; x < width; ++x)
+		{
+			const std::uint8_t* block{ block_image.data.data() +
+				((y / s_block_size) * blocks_x + x / s_block_size) * block_bytes };
+			const std::size_t texel{ (y % s_block_size) * s_block_size + x % s_block_size };
+			std::uint8_t* rgba{ texels.data() + (y * width + x) * 4 };
+
+			rgba[0] = rgba[1] = rgba[2] = 0;
+			rgba[3] = 0xFF;
+
+			switch (block_image.format)
+			{
+			case enums::Block_Format::BC1:
+				decode_color(block, texel, rgba);
+				break;
+			case enums::Block_Format::BC3:
+				rgba[3] = decode_channel(block, texel);
+				decode_color(block + 8, texel, rgba);
+				break;
+			case enums::Block_Format::BC4:
+				rgba[0] = decode_channel(block, texel);
+				break;
+			case enums::Block_Format::BC5:
+				rgba[0] = decode_channel(block, texel);
+				rgba[1] = decode_channel(block + 8, texel);
+				break;
+			}
+		}
+	}
+
+	return Image{ texels.data(), block_image.width, block_image.height,
+		enums::Image_Channels::RGBA, enums::Image_Data_Type::Unsigned_Byte };
+
+}
+
+std::size_t tilia::Block_Encoder::Get_Block_Bytes(enums::Block_Format format)
+{
+	switch (format)
+	{
+	case enums::Block_Format::BC1:
+	case enums::Block_Format::BC4:
+		return 8;
+	default:
+		return 16;
+	}
+}
+
+std::size_t tilia::Block_Encoder::Get_Encoded_Size(enums::Block_Format format,
+	std::int32_t width, std::int32_t height)
+{
+	Block_Image block_image{};
+	block_image.format = format;
+	block_image.width = width;
+	block_image.height = height;
+	return block_image.Get_Row_Size() * block_image.Get_Blocks_Y();
+}
+
+tilia::enums::Image_Channels tilia::Block_Encoder::Get_Image_Channels(
+	enums::Block_Format format)
+{
+	switch (format)
+	{
+	case enums::Block_Format::BC3:
+		return enums::Image_Channels::RGBA;
+	case enums::Block_Format::BC4:
+		return enums::Image_Channels::Grey;
+	default:
+		return enums::Image_Channels::RGB;
+	}
+}
+
+bool tilia::Block_Encoder::Read(const std::string& path, std::uint64_t key,
+	Block_Image& block_image) const
+{
+
+	std::ifstream file{ path, std::ios::binary };
+	if (!file)
+		return false;
+
+	char magic[sizeof(FILE_MAGIC)]{};
+	std::uint32_t version{}, format{};
+	std::int32_t width{}, height{};
+	std::uint64_t stored_key{};
+
+	file.read(magic, sizeof(magic));
+	file.read(reinterpret_cast<char*>(&version), sizeof(version));
+	file.read(reinterpret_cast<char*>(&format), sizeof(format));
+	file.read(reinterpret_cast<char*>(&width), sizeof(width));
+	file.read(reinterpret_cast<char*>(&height), sizeof(height));
+	file.read(reinterpret_cast<char*>(&stored_key), sizeof(stored_key));
+
+	if (!file || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0 ||
+		version != FILE_VERSION || stored_key != key || width <= 0 || height <= 0 ||
+		format > static_cast<std::uint32_t>(enums::Block_Format::BC5))
+	{
+		return false;
+	}
+
+	block_image.format = static_cast<enums::Block_Format>(format);
+	block_image.width = width;
+	block_image.height = height;
+	block_image.data.resize(Get_Encoded_Size(block_image.format, width, height));
+	file.read(reinterpret_cast<char*>(block_image.data.data()),
+		static_cast<std::streamsize>(block_image.data.size()));
+
+	return static_cast<bool>(file);
+
+}
+
+void tilia::Block_Encoder::Write(const std::string& path, std::uint64_t key,
+	const Block_Image& block_image) const
+{
+
+	// Written next to the real file first so that a crash never leaves half an image behind,
+	// named by thread since workers may encode the same file at once
+	const std::string temporary_path{ path + ".tmp" +
+		std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) };
+
+	{
+		std::ofstream file{ temporary_path, std::ios::binary | std::ios::trunc };
+
+		const std::uint32_t version{ FILE_VERSION };
+		const auto format{ static_cast<std::uint32_t>(block_image.format) };
+
+		file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+		file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+		file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+		file.write(reinterpret_cast<const char*>(&block_image.width), sizeof(block_image.width));
+		file.write(reinterpret_cast<const char*>(&block_image.height),
+			sizeof(block_image.height));
+		file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+		file.write(reinterpret_cast<const char*>(block_image.data.data()),
+			static_cast<std::streamsize>(block_image.data.size()));
+
+		// Not being able to write only costs an encode on the next launch
+		if (!file)
+			return;
+	}
+
+	std::error_code error{};
+	std::filesystem::rename(temporary_path, path, error);
+	if (error)
+		std::filesystem::remove(temporary_path, error);
+
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+void tilia::Block_Encoder::Test()
+{
+
+	// Red and green falling against each other with a sharp edge in blue, which is the hardest
+	// for the encoder
+	constexpr std::int32_t width{ 10 }, height{ 7 };
+	std::vector<std::uint8_t> texels(width * height * 4);
+	for (std::int32_t y{ 0 }; y < height; ++y)
+	{
+		for (std::int32_t x{ 0 }; x < width; ++x)
+		{
+			std::uint8_t* texel{ texels.data() + (y * width + x) * 4 };
+			texel[0] = static_cast<std::uint8_t>(x * 25);
+			texel[1] = static_cast<std::uint8_t>(250 - x * 25);
+			texel[2] = static_cast<std::uint8_t>((x < 5) ? 40 : 200);
+			texel[3] = static_cast<std::uint8_t>(255 - x * 20 - y * 4);
+		}
+	}
+
+	// Gets the largest difference of a channel between the texels and the decoded image
+	auto max_error{ [&texels](const Image& decoded, std::size_t channel)
+	{
+		std::int32_t error{};
+		for (std::size_t i{ 0 }; i < texels.size() / 4; ++i)
+		{
+			error = std::max(error, std::abs(static_cast<std::int32_t>(texels[i * 4 + channel]) -
+				static_cast<std::int32_t>(decoded.Get_Data()[i * 4 + channel])));
+		}
+		return error;
+	} };
+
+	SECTION("Sizes")
+	{
+		REQUIRE(Get_Encoded_Size(enums::Block_Format::BC1, width, height) == 3 * 2 * 8);
+		REQUIRE(Get_Encoded_Size(enums::Block_Format::BC3, width, height) == 3 * 2 * 16);
+		REQUIRE(Get_Encoded_Size(enums::Block_Format::BC4, 4, 4) == 8);
+		REQUIRE(Get_Encoded_Size(enums::Block_Format::BC5, 1, 1) == 16);
+	}
+
+	SECTION("BC1")
+	{
+		const Block_Image block_image{ Encode(texels.data(), width, height, 4,
+			enums::Block_Format::BC1) };
+		REQUIRE(block_image.data.size() == Get_Encoded_Size(enums::Block_Format::BC1, width,
+			height));
+
+		const Image decoded{ Decode(block_image) };
+		REQUIRE(decoded.Width() == width);
+		REQUIRE(max_error(decoded, 0) <= 32);
+		REQUIRE(max_error(decoded, 1) <= 32);
+		// The block across the edge can not have all of its colors on one line
+		REQUIRE(max_error(decoded, 2) <= 48);
+	}
+
+	SECTION("BC3")
+	{
+		const Image decoded{ Decode(Encode(texels.data(), width, height, 4,
+			enums::Block_Format::BC3)) };
+		REQUIRE(max_error(decoded, 3) <= 8);
+		REQUIRE(max_error(decoded, 0) <= 32);
+	}
+
+	SECTION("BC4 and BC5")
+	{
+		const Image red{ Decode(Encode(texels.data(), width, height, 4,
+			enums::Block_Format::BC4)) };
+		REQUIRE(max_error(red, 0) <= 8);
+
+		const Image red_green{ Decode(Encode(texels.data(), width, height, 4,
+			enums::Block_Format::BC5)) };
+		REQUIRE(max_error(red_green, 0) <= 8);
+		REQUIRE(max_error(red_green, 1) <= 8);
+	}
+
+	SECTION("Flat blocks")
+	{
+		// Equal endpoints have to decode to the same color rather than to black
+		const std::uint8_t grey[4 * 4]{ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+			0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 };
+		const Image decoded{ Decode(Encode(grey, 4, 4, 1, enums::Block_Format::BC1)) };
+		REQUIRE(std::abs(decoded.Get_Data()[0] - 0x80) <= 4);
+		REQUIRE(decoded.Get_Data()[3] == 0xFF);
+	}
+
+	SECTION("Invalid images")
+	{
+		REQUIRE_THROWS_AS(Encode(texels.data(), 0, height, 4, enums::Block_Format::BC1),
+			utils::Tilia_Exception);
+		REQUIRE_THROWS_AS(Encode(texels.data(), width, height, 5, enums::Block_Format::BC1),
+			utils::Tilia_Exception);
+	}
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
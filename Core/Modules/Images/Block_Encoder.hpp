@@ -0,0 +1,231 @@
+/**************************************************************************************************
+ * @file   Block_Encoder.hpp
+ *
+ * @brief  Encodes images into the block compressed formats BC1, BC3, BC4 and BC5, also known as
+ *		   S3TC and RGTC. Every 4x4 block of texels is stored in 8 or 16 bytes, a quarter to an
+ *		   eighth of the memory of the uncompressed texels. Blocks are encoded on the workers of
+ *		   the job system, and images loaded from files are kept encoded on disk so that they
+ *		   are only encoded the first time they are loaded.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_BLOCK_ENCODER_HPP
+#define TILIA_BLOCK_ENCODER_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_IMAGE_INCLUDE
+
+namespace tilia
+{
+	namespace enums
+	{
+		// The block compressed formats an image can be encoded to.
+		enum class Block_Format
+		{
+			// Red, green and blue in 8 bytes per block.
+			BC1,
+			// Red, green, blue and alpha in 16 bytes per block, alpha stored as in BC4.
+			BC3,
+			// Red in 8 bytes per block.
+			BC4,
+			// Red and green in 16 bytes per block, both stored as in BC4.
+			BC5
+		}; // Block_Format
+	} // enums
+
+	/**
+	 * @brief An image encoded into blocks. Rows of blocks are stored bottom to top, in the same
+	 * order as the rows of the image.
+	 */
+	struct Block_Image
+	{
+		enums::Block_Format format{ enums::Block_Format::BC1 };
+		// The size of the image in texels, which does not have to be a multiple of the block size
+		std::int32_t width{};
+		std::int32_t height{};
+		std::vector<std::uint8_t> data{};
+
+		/**
+		 * @brief Gets the amount of blocks in a row.
+		 */
+		std::size_t Get_Blocks_X() const;
+		/**
+		 * @brief Gets the amount of rows of blocks.
+		 */
+		std::size_t Get_Blocks_Y() const;
+		/**
+		 * @brief Gets the size of a row of blocks in bytes.
+		 */
+		std::size_t Get_Row_Size() const;
+	}; // Block_Image
+
+	/**
+	 * @brief Singleton encoding images into blocks. Endpoints are the corners of the bounding
+	 * box of the colors of a block, inset slightly to lower the error, and every texel is given
+	 * the nearest color between them. This is far quicker than searching for the best endpoints
+	 * while looking close to the same for most textures. Encoding may be done from any thread.
+	 */
+	class Block_Encoder
+	{
+	public:
+
+		// The width and height of a block in texels
+		static constexpr std::int32_t s_block_size{ 4 };
+
+		/**
+		 * @brief First time it is called it will construct an instance of Block_Encoder. A
+		 * reference to this instance is returned to anywhere in the program.
+		 *
+		 * @return A reference to an instance of Block_Encoder.
+		 */
+		static Block_Encoder& Instance()
+		{
+			static Block_Encoder block_encoder{};
+			return block_encoder;
+		}
+
+		/**
+		 * @brief Sets the directory that encoded images are kept in, creating it if needed.
+		 * Without a directory Load encodes every time.
+		 *
+		 * @param directory - The directory to keep encoded images in.
+		 */
+		void Init(const std::string& directory);
+
+		/**
+		 * @brief Stops keeping encoded images on disk.
+		 */
+		void Terminate() { m_directory.clear(); }
+
+		/**
+		 * @brief Loads and encodes the image in the given file, or reads it from the directory if
+		 * it has been encoded before. An encoded image is used for as long as the file it was
+		 * encoded from keeps its size and last write time.
+		 *
+		 * @param path - The path of the image file.
+		 * @param format - The format to encode to.
+		 * @param flip_vertical - Whether or not to flip the image when loading it.
+		 */
+		Block_Image Load(const std::string& path, enums::Block_Format format,
+			bool flip_vertical = false);
+
+		/**
+		 * @brief Encodes an image. Images of one or two channels are encoded as grey, with the
+		 * second channel as alpha.
+		 *
+		 * @param image - The image to encode, which has to be of unsigned bytes.
+		 * @param format - The format to encode to.
+		 */
+		static Block_Image Encode(const Image& image, enums::Block_Format format);
+
+		/**
+		 * @brief Encodes tightly packed texels of unsigned bytes.
+		 *
+		 * @param data - The texels.
+		 * @param width - The width of the image in texels.
+		 * @param height - The height of the image in texels.
+		 * @param channels - The amount of channels of every texel, 1 to 4.
+		 * @param format - The format to encode to.
+		 */
+		static Block_Image Encode(const std::uint8_t* data, std::int32_t width,
+			std::int32_t height, std::int32_t channels, enums::Block_Format format);
+
+		/**
+		 * @brief Decodes an encoded image into RGBA texels, for checking the quality of the
+		 * encoder. Formats without alpha decode to opaque texels and formats without green or
+		 * blue to 0 in those channels.
+		 */
+		static Image Decode(const Block_Image& block_image);
+
+		/**
+		 * @brief Gets the size of a block of the given format in bytes.
+		 */
+		static std::size_t Get_Block_Bytes(enums::Block_Format format);
+
+		/**
+		 * @brief Gets the size in bytes of an image of the given size once encoded.
+		 */
+		static std::size_t Get_Encoded_Size(enums::Block_Format format, std::int32_t width,
+			std::int32_t height);
+
+		/**
+		 * @brief Gets the channels to load an image with before encoding it to the given
+		 * format.
+		 */
+		static enums::Image_Channels Get_Image_Channels(enums::Block_Format format);
+
+		/**
+		 * @brief Gets the amount of images read from the directory.
+		 */
+		std::size_t Get_Hit_Count() const { return m_hits.load(); }
+		/**
+		 * @brief Gets the amount of images which had to be encoded by Load.
+		 */
+		std::size_t Get_Miss_Count() const { return m_misses.load(); }
+
+#if TILIA_UNIT_TESTS == 1
+
+		/**
+		 * @brief Unit test for Block_Encoder. Encodes images made in memory.
+		 */
+		static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+	private:
+
+		Block_Encoder() = default;
+
+		// Block_Encoder shan't be copyable or moveable
+		Block_Encoder(const Block_Encoder&) = delete;
+		Block_Encoder(Block_Encoder&&) = delete;
+		Block_Encoder& operator=(const Block_Encoder&) = delete;
+		Block_Encoder& operator=(Block_Encoder&&) = delete;
+
+		/**
+		 * @brief Encodes the color of a block of 16 RGBA texels into 8 bytes.
+		 */
+		static void Encode_Color_Block(const std::uint8_t* texels, std::uint8_t* block);
+
+		/**
+		 * @brief Encodes one channel of a block of 16 RGBA texels into 8 bytes.
+		 */
+		static void Encode_Channel_Block(const std::uint8_t* texels, std::size_t channel,
+			std::uint8_t* block);
+
+		/**
+		 * @brief Reads an encoded image from the directory.
+		 *
+		 * @return Whether or not it was found.
+		 */
+		bool Read(const std::string& path, std::uint64_t key, Block_Image& block_image) const;
+
+		/**
+		 * @brief Writes an encoded image to the directory.
+		 */
+		void Write(const std::string& path, std::uint64_t key,
+			const Block_Image& block_image) const;
+
+		// The directory encoded images are kept in, empty if they are not kept
+		std::string m_directory{};
+
+		// Images read from the directory
+		std::atomic<std::size_t> m_hits{};
+		// Images encoded by Load
+		std::atomic<std::size_t> m_misses{};
+
+	}; // Block_Encoder
+
+} // tilia
+
+#endif // TILIA_BLOCK_ENCODER_HPP
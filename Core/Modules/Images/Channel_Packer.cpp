@@ -0,0 +1,382 @@
+// Standard
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+// Tilia
+#include "Channel_Packer.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+
+// The maps by the value of their enum along with their names
+static constexpr const char* MAP_NAMES[]{ "none", "base", "specular", "roughness", "metallic",
+	"occlusion", "mask" };
+
+static constexpr std::size_t MAX_CHANNELS{ 4 };
+
+std::int32_t tilia::Channel_Packing::Get_Channel(enums::Material_Map map) const
+{
+	const auto found{ std::find(channels.begin(), channels.end(), map) };
+	if (found == channels.end())
+		return -1;
+	return static_cast<std::int32_t>(found - channels.begin());
+}
+
+std::array<float, 4> tilia::Channel_Packing::Get_Mask(enums::Material_Map map) const
+{
+	std::array<float, 4> mask{};
+	const std::int32_t channel{ Get_Channel(map) };
+	if (channel >= 0)
+		mask[static_cast<std::size_t>(channel)] = 1.0f;
+	return mask;
+}
+
+std::string tilia::Channel_Packing::To_String() const
+{
+	std::string text{};
+	for (std::size_t i{ 0 }; i < channels.size(); ++i)
+	{
+		if (i > 0)
+			text += ' ';
+		text += Get_Name(channels[i]);
+	}
+	return text;
+}
+
+tilia::Channel_Packing tilia::Channel_Packing::Parse(const std::string& text)
+{
+	std::istringstream stream{ text };
+	Channel_Packing packing{};
+
+	for (auto& channel : packing.channels)
+	{
+		std::string name{};
+		if (!(stream >> name))
+		{
+			throw utils::Tilia_Exception{ { TILIA_LOCATION,
+				"Channel packing has to name the maps of four channels",
+				"\n>>> Packing: ", text } };
+		}
+		const auto found{ std::find_if(std::begin(MAP_NAMES), std::end(MAP_NAMES),
+			[&name](const char* map_name) { return name == map_name; }) };
+		if (found == std::end(MAP_NAMES))
+		{
+			throw utils::Tilia_Exception{ { TILIA_LOCATION,
+				"Channel packing names an unknown map",
+				"\n>>> Map: ", name,
+				"\n>>> Packing: ", text } };
+		}
+		channel = static_cast<enums::Material_Map>(found - std::begin(MAP_NAMES));
+	}
+
+	std::string rest{};
+	if (stream >> rest)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Channel packing names more than four maps",
+			"\n>>> Packing: ", text } };
+	}
+
+	return packing;
+}
+
+void tilia::Channel_Packing::Write(const std::string& texture_path) const
+{
+	const std::string path{ Get_Path(texture_path) };
+	std::ofstream file{ path, std::ios::trunc };
+	file << To_String() << '\n';
+	if (!file)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Failed to write channel packing",
+			"\n>>> Path: ", path } };
+	}
+}
+
+tilia::Channel_Packing tilia::Channel_Packing::Read(const std::string& texture_path,
+	std::size_t base_channels)
+{
+	const std::string path{ Get_Path(texture_path) };
+	std::ifstream file{ path };
+	if (!file)
+	{
+		Channel_Packing packing{};
+		std::fill_n(packing.channels.begin(), std::min(base_channels, MAX_CHANNELS),
+			enums::Material_Map::Base);
+		return packing;
+	}
+
+	std::string text{};
+	std::getline(file, text);
+	try
+	{
+		return Parse(text);
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to read channel packing",
+			"\n>>> Path: ", path });
+	}
+}
+
+std::string tilia::Channel_Packing::Get_Path(const std::string& texture_path)
+{
+	return texture_path + ".packing";
+}
+
+const char* tilia::Channel_Packing::Get_Name(enums::Material_Map map)
+{
+	return MAP_NAMES[static_cast<std::size_t>(map)];
+}
+
+std::string tilia::Channel_Packing::Get_Uniform_Name(enums::Material_Map map)
+{
+	if (map == enums::Material_Map::None || map == enums::Material_Map::Base)
+		return {};
+	return std::string{ "tilia_" } + Get_Name(map) + "_channel";
+}
+
+/**
+ * The base and maps are first converted to bytes of the channels they are packed as, and are
+ * then interleaved texel by texel. Images of two channels are grey and alpha, which formats
+ * of two channels such as RG8 do not keep, so a blank third channel is added instead.
+ */
+tilia::Image tilia::Channel_Packer::Pack(const Image& base, std::size_t base_channels,
+	const std::vector<Packed_Map>& maps, Channel_Packing& packing)
+{
+
+	const std::size_t channels{ base_channels + maps.size() };
+	if (channels == 0 || channels > MAX_CHANNELS)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Can only pack from 1 to ", MAX_CHANNELS, " channels",
+			"\n>>> Base channels: ", base_channels,
+			"\n>>> Map count: ", maps.size() } };
+	}
+	if (base_channels > 0 && base.Get_Data() == nullptr)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Can not keep ", base_channels, " channels of an empty base" } };
+	}
+
+	std::vector<Image> sources{};
+	sources.reserve(1 + maps.size());
+	if (base_channels > 0)
+	{
+		sources.push_back(base.Convert(static_cast<enums::Image_Channels>(base_channels),
+			enums::Image_Data_Type::Unsigned_Byte));
+	}
+
+	Channel_Packing new_packing{};
+	std::fill_n(new_packing.channels.begin(), base_channels, enums::Material_Map::Base);
+
+	for (std::size_t i{ 0 }; i < maps.size(); ++i)
+	{
+		const auto map{ maps[i].map };
+		if (map == enums::Material_Map::None || map == enums::Material_Map::Base ||
+			new_packing.Get_Channel(map) >= 0)
+		{
+			throw utils::Tilia_Exception{ { TILIA_LOCATION,
+				"Can not pack a map of none or base, or a map twice",
+				"\n>>> Map: ", Channel_Packing::Get_Name(map) } };
+		}
+		if (maps[i].image.Get_Data() == nullptr)
+		{
+			throw utils::Tilia_Exception{ { TILIA_LOCATION,
+				"Can not pack an empty map",
+				"\n>>> Map: ", Channel_Packing::Get_Name(map) } };
+		}
+		new_packing.channels[base_channels + i] = map;
+		sources.push_back(maps[i].image.Convert(enums::Image_Channels::Grey,
+			enums::Image_Data_Type::Unsigned_Byte));
+	}
+
+	const std::int32_t width{ sources.front().Width() };
+	const std::int32_t height{ sources.front().Height() };
+	for (std::size_t i{ 1 }; i < sources.size(); ++i)
+	{
+		if (sources[i].Width() != width || sources[i].Height() != height)
+		{
+			throw utils::Tilia_Exception{ { TILIA_LOCATION,
+				"Packed images have to be of the same size",
+				"\n>>> Map: ", Channel_Packing::Get_Name(
+					maps[(base_channels > 0) ? i - 1 : i].map),
+				"\n>>> Size: ", sources[i].Width(), "x", sources[i].Height(),
+				"\n>>> Expected size: ", width, "x", height } };
+		}
+	}
+
+	const std::size_t packed_channels{ (channels == 2) ? 3 : channels };
+	const std::size_t count{ static_cast<std::size_t>(width) * height };
+	std::unique_ptr<std::uint8_t[], void (*)(std::uint8_t*)> data{
+		new std::uint8_t[count * packed_channels](),
+		[](std::uint8_t* image_data) { delete[] image_data; } };
+
+	// The first channel of every source
+	std::size_t first_channel{ 0 };
+	for (const auto& source : sources)
+	{
+		const auto source_channels{ static_cast<std::size_t>(*source.Channels()) };
+		const std::uint8_t* texels{ source.Get_Data() };
+		std::uint8_t* packed{ data.get() + first_channel };
+		for (std::size_t i{ 0 }; i < count; ++i)
+		{
+			std::copy_n(texels + i * source_channels, source_channels, packed);
+			packed += packed_channels;
+		}
+		first_channel += source_channels;
+	}
+
+	packing = new_packing;
+
+	return { std::move(data), width, height,
+		static_cast<enums::Image_Channels>(packed_channels),
+		enums::Image_Data_Type::Unsigned_Byte };
+
+}
+
+tilia::Image tilia::Channel_Packer::Pack(const std::string& base_path,
+	std::size_t base_channels,
+	const std::vector<std::pair<enums::Material_Map, std::string>>& map_paths,
+	Channel_Packing& packing)
+{
+	try
+	{
+		Image base{};
+		if (base_channels > 0)
+		{
+			base.Reload(base_path, enums::Image_Channels::Largest,
+				enums::Image_Data_Type::Unsigned_Byte, true);
+		}
+
+		std::vector<Packed_Map> maps{};
+		maps.reserve(map_paths.size());
+		for (const auto& [map, path] : map_paths)
+		{
+			maps.push_back({ map, Image{ path, enums::Image_Channels::Largest,
+				enums::Image_Data_Type::Unsigned_Byte, true } });
+		}
+
+		return Pack(base, base_channels, maps, packing);
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to pack channels",
+			"\n>>> Base: ", base_path });
+	}
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+// Standard
+#include <cstdio>
+#include <filesystem>
+
+void tilia::Channel_Packer::Test()
+{
+
+	using Map = enums::Material_Map;
+
+	// Test packing the specular map of a material into the alpha of its diffuse map
+
+	Channel_Packing packing{};
+	const Image packed{ Pack("res/textures/container2.png", 3,
+		{ { Map::Specular, "res/textures/container2_specular.png" } }, packing) };
+
+	REQUIRE(packed.Channels() == enums::Image_Channels::RGBA);
+	REQUIRE(packing.To_String() == "base base base specular");
+	REQUIRE(packing.Get_Channel(Map::Specular) == 3);
+	REQUIRE(packing.Get_Channel(Map::Roughness) == -1);
+
+	const Image diffuse{ "res/textures/container2.png", enums::Image_Channels::RGB,
+		enums::Image_Data_Type::Unsigned_Byte, true };
+	const Image specular{ Image{ "res/textures/container2_specular.png",
+		enums::Image_Channels::Largest, enums::Image_Data_Type::Unsigned_Byte, true }.Convert(
+			enums::Image_Channels::Grey, enums::Image_Data_Type::Unsigned_Byte) };
+
+	REQUIRE(packed.Width() == diffuse.Width());
+	REQUIRE(packed.Height() == diffuse.Height());
+	const auto count{ static_cast<std::size_t>(packed.Width()) * packed.Height() };
+	bool same{ true };
+	for (std::size_t i{ 0 }; i < count; ++i)
+	{
+		same = same && std::equal(diffuse.Get_Data() + i * 3, diffuse.Get_Data() + i * 3 + 3,
+			packed.Get_Data() + i * 4) && packed.Get_Data()[i * 4 + 3] == specular.Get_Data()[i];
+	}
+	REQUIRE(same);
+
+	// Test packing maps on their own
+
+	const std::uint8_t occlusion_texels[]{ 10, 20, 30, 40 };
+	const std::uint8_t roughness_texels[]{ 50, 60, 70, 80 };
+	const Image occlusion{ occlusion_texels, 2, 2, enums::Image_Channels::Grey,
+		enums::Image_Data_Type::Unsigned_Byte };
+	const Image roughness{ roughness_texels, 2, 2, enums::Image_Channels::Grey,
+		enums::Image_Data_Type::Unsigned_Byte };
+
+	const Image maps{ Pack(Image{}, 0, { { Map::Occlusion, occlusion },
+		{ Map::Roughness, roughness } }, packing) };
+
+	// Never grey and alpha, which would move the second map to alpha once baked
+	REQUIRE(maps.Channels() == enums::Image_Channels::RGB);
+	REQUIRE(packing.To_String() == "occlusion roughness none none");
+	REQUIRE(maps.Get_Data()[0] == 10);
+	REQUIRE(maps.Get_Data()[1] == 50);
+	REQUIRE(maps.Get_Data()[2] == 0);
+	REQUIRE(maps.Get_Data()[9] == 40);
+	REQUIRE(maps.Get_Data()[10] == 80);
+	REQUIRE(maps.Get_Data()[11] == 0);
+
+	// Test the masks and uniforms of the shader helpers
+
+	REQUIRE(packing.Get_Mask(Map::Roughness) == std::array<float, 4>{ 0.0f, 1.0f, 0.0f, 0.0f });
+	REQUIRE(packing.Get_Mask(Map::Specular) == std::array<float, 4>{});
+	REQUIRE(Channel_Packing::Get_Uniform_Name(Map::Occlusion) == "tilia_occlusion_channel");
+	REQUIRE(Channel_Packing::Get_Uniform_Name(Map::Base).empty());
+
+	// Test parsing, writing and reading packings
+
+	REQUIRE(Channel_Packing::Parse("  base base\tbase mask ") == Channel_Packing{ { Map::Base,
+		Map::Base, Map::Base, Map::Mask } });
+	REQUIRE(Channel_Packing::Parse(packing.To_String()) == packing);
+	REQUIRE_THROWS_AS(Channel_Packing::Parse("base base base"), utils::Tilia_Exception);
+	REQUIRE_THROWS_AS(Channel_Packing::Parse("base base base gloss"), utils::Tilia_Exception);
+	REQUIRE_THROWS_AS(Channel_Packing::Parse("base base base none none"),
+		utils::Tilia_Exception);
+
+	const std::string texture_path{ (std::filesystem::temp_directory_path() /
+		"tilia_channel_packer_test.tex").string() };
+	std::remove(Channel_Packing::Get_Path(texture_path).c_str());
+
+	// Textures without a packing only hold their base
+	REQUIRE(Channel_Packing::Read(texture_path, 3).To_String() == "base base base none");
+
+	packing.Write(texture_path);
+	REQUIRE(Channel_Packing::Read(texture_path) == packing);
+	std::remove(Channel_Packing::Get_Path(texture_path).c_str());
+
+	// Test what can not be packed
+
+	REQUIRE_THROWS_AS(Pack(Image{}, 0, {}, packing), utils::Tilia_Exception);
+	REQUIRE_THROWS_AS(Pack(Image{}, 1, { { Map::Occlusion, occlusion } }, packing),
+		utils::Tilia_Exception);
+	REQUIRE_THROWS_AS(Pack(diffuse, 3, { { Map::Occlusion, occlusion },
+		{ Map::Roughness, roughness } }, packing), utils::Tilia_Exception);
+	REQUIRE_THROWS_AS(Pack(diffuse, 3, { { Map::Occlusion, occlusion } }, packing),
+		utils::Tilia_Exception);
+	REQUIRE_THROWS_AS(Pack(Image{}, 0, { { Map::Occlusion, occlusion },
+		{ Map::Occlusion, roughness } }, packing), utils::Tilia_Exception);
+	REQUIRE_THROWS_AS(Pack(Image{}, 0, { { Map::Base, occlusion } }, packing),
+		utils::Tilia_Exception);
+	// The packing is left as it was
+	REQUIRE(packing.To_String() == "occlusion roughness none none");
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
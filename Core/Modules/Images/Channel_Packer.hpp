@@ -0,0 +1,195 @@
+/**************************************************************************************************
+ * @file   Channel_Packer.hpp
+ *
+ * @brief  Packs the single channel maps of materials, such as specular, roughness, occlusion
+ *		   and masks, into the unused channels of another map of the material when its assets
+ *		   are built, so that a material binds fewer textures and fetches fewer texels. The
+ *		   packing is described by a small file kept next to the packed texture, which tells
+ *		   the renderer which channel to unpack each map from through the helpers of
+ *		   res/shaders/include/channel_packing.glsl.
+ *
+ * @author Gustav Fagerlind
+ * @date   19/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_CHANNEL_PACKER_HPP
+#define TILIA_CHANNEL_PACKER_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_CONSTANTS_INCLUDE
+#include TILIA_IMAGE_INCLUDE
+
+namespace tilia
+{
+	namespace enums
+	{
+		// What a channel of a packed image holds.
+		enum class Material_Map
+		{
+			// The channel is unused
+			None,
+			// A channel of the map the others are packed into, such as the color of diffuse
+			Base,
+			Specular,
+			Roughness,
+			Metallic,
+			Occlusion,
+			// Cutout or blend masks
+			Mask
+		}; // Material_Map
+	} // enums
+
+	/**
+	 * @brief Which map every channel of a packed image holds. Written next to the packed
+	 * texture as a single line naming the map of red, green, blue and alpha, such as
+	 * "base base base specular".
+	 */
+	struct Channel_Packing
+	{
+		// The maps of red, green, blue and alpha
+		std::array<enums::Material_Map, 4> channels{ enums::Material_Map::None,
+			enums::Material_Map::None, enums::Material_Map::None, enums::Material_Map::None };
+
+		/**
+		 * @brief Gets the channel holding the given map, -1 if it is not packed.
+		 */
+		std::int32_t Get_Channel(enums::Material_Map map) const;
+
+		/**
+		 * @brief Gets the mask selecting the channel holding the given map, all zero if it is
+		 * not packed, to be set as the uniform of the map from Get_Uniform_Name.
+		 */
+		std::array<float, 4> Get_Mask(enums::Material_Map map) const;
+
+		/**
+		 * @brief Writes the packing as a single line of the names of the maps.
+		 */
+		std::string To_String() const;
+
+		/**
+		 * @brief Reads a packing written by To_String.
+		 *
+		 * @exception The text does not name four maps.
+		 */
+		static Channel_Packing Parse(const std::string& text);
+
+		/**
+		 * @brief Writes the packing of the texture at the given path next to it.
+		 *
+		 * @exception The file could not be written.
+		 */
+		void Write(const std::string& texture_path) const;
+
+		/**
+		 * @brief Reads the packing of the texture at the given path. Textures without one only
+		 * hold their base, in as many channels as the given amount.
+		 *
+		 * @exception The file of the packing is not valid.
+		 */
+		static Channel_Packing Read(const std::string& texture_path,
+			std::size_t base_channels = 4);
+
+		/**
+		 * @brief Gets the path of the packing of the texture at the given path.
+		 */
+		static std::string Get_Path(const std::string& texture_path);
+
+		/**
+		 * @brief Gets the name of a map as written in packings, such as "specular".
+		 */
+		static const char* Get_Name(enums::Material_Map map);
+
+		/**
+		 * @brief Gets the name of the uniform of channel_packing.glsl taking the mask of a
+		 * map, such as "tilia_specular_channel". Empty for None and Base.
+		 */
+		static std::string Get_Uniform_Name(enums::Material_Map map);
+
+		friend bool operator==(const Channel_Packing& lhs, const Channel_Packing& rhs)
+		{
+			return lhs.channels == rhs.channels;
+		}
+		friend bool operator!=(const Channel_Packing& lhs, const Channel_Packing& rhs)
+		{
+			return !(lhs == rhs);
+		}
+	}; // Channel_Packing
+
+	/**
+	 * @brief A single channel map to pack, along with what it is.
+	 */
+	struct Packed_Map
+	{
+		enums::Material_Map map{ enums::Material_Map::None };
+		// Images of several channels are packed by their luma
+		Image image{};
+	}; // Packed_Map
+
+	/**
+	 * @brief Packs maps into the channels of images. Can be used from any thread.
+	 */
+	class Channel_Packer
+	{
+	public:
+
+		/**
+		 * @brief Packs single channel maps into the channels after those kept of a base image,
+		 * such as the specular map of a material into the alpha of its diffuse map.
+		 *
+		 * @param base - The image to pack into, ignored when none of its channels are kept.
+		 * @param base_channels - The amount of channels of the base to keep, from red on, 0
+		 * to pack the maps on their own.
+		 * @param maps - The maps to pack in order, each into the next channel. They have to be
+		 * of the size of the base, or of the first map when there is no base.
+		 * @param packing - Set to which map every channel holds.
+		 *
+		 * @return The packed image of unsigned bytes, with as many channels as the kept
+		 * channels of the base and the maps, two being padded to three with a channel of
+		 * None so that baking keeps the second in green.
+		 *
+		 * @exception There is nothing to pack, more than 4 channels, an empty base, a map of
+		 * None or Base or packed twice, or images of different sizes.
+		 */
+		static Image Pack(const Image& base, std::size_t base_channels,
+			const std::vector<Packed_Map>& maps, Channel_Packing& packing);
+
+		/**
+		 * @brief Loads the base and maps from their files and packs them, as Pack. Images are
+		 * loaded flipped, as textures load them.
+		 *
+		 * @param base_path - The path of the base image, not loaded when none of its channels
+		 * are kept.
+		 * @param map_paths - The maps and the paths of their images.
+		 *
+		 * @exception An image failed to load, or see Pack.
+		 */
+		static Image Pack(const std::string& base_path, std::size_t base_channels,
+			const std::vector<std::pair<enums::Material_Map, std::string>>& map_paths,
+			Channel_Packing& packing);
+
+#if TILIA_UNIT_TESTS == 1
+
+		/**
+		 * @brief Unit test for Channel_Packer.
+		 */
+		static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		// Channel_Packer shan't be constructed
+		Channel_Packer() = delete;
+
+	}; // Channel_Packer
+
+} // tilia
+
+#endif // TILIA_CHANNEL_PACKER_HPP
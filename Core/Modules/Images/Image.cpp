@@ -1,9 +1,151 @@
 // Vendor
 #include "vendor/stb_image/include/stb_image/stb_image.h"
 
+// Standard
+#include <algorithm>
+#include <vector>
+
 // Tilia
 #include "Image.hpp"
 #include TILIA_TILIA_EXCEPTION_INCLUDE
+#include TILIA_PIXEL_CONVERTER_INCLUDE
+
+// The amount of texels converted at a time when both channels and data type change, or when
+// half floats are worked on as floats
+static constexpr std::size_t CONVERT_CHUNK_SIZE{ 1024 };
+
+/**
+ * @brief Works on half floats as floats a chunk of texels at a time, which is exact both ways.
+ * The kernel is given the floats of a chunk of source texels and where to write the floats of
+ * as many destination texels.
+ */
+template<typename Kernel>
+static void Run_As_Floats(const std::uint16_t* source, std::size_t source_channels,
+	std::uint16_t* destination, std::size_t channels, std::size_t count, Kernel kernel)
+{
+	using tilia::Pixel_Converter;
+
+	std::vector<float> source_floats(CONVERT_CHUNK_SIZE * source_channels);
+	std::vector<float> floats(CONVERT_CHUNK_SIZE * channels);
+
+	for (std::size_t i{ 0 }; i < count; i += CONVERT_CHUNK_SIZE)
+	{
+		const std::size_t chunk{ std::min(CONVERT_CHUNK_SIZE, count - i) };
+		Pixel_Converter::F16_To_F32(source + i * source_channels, source_floats.data(),
+			chunk * source_channels);
+		kernel(source_floats.data(), floats.data(), chunk);
+		Pixel_Converter::F32_To_F16(floats.data(), destination + i * channels,
+			chunk * channels);
+	}
+}
+
+/**
+ * @brief Converts values between data types, all of the same channel count.
+ */
+static void Convert_Type(const std::uint8_t* source, tilia::enums::Image_Data_Type source_type,
+	std::uint8_t* destination, tilia::enums::Image_Data_Type data_type, std::size_t count,
+	std::size_t channels, bool srgb)
+{
+	using tilia::Pixel_Converter;
+	using Type = tilia::enums::Image_Data_Type;
+
+	const std::size_t value_count{ count * channels };
+
+	if (source_type == data_type)
+	{
+		std::copy(source, source + value_count * (*data_type), destination);
+	}
+	else if (source_type == Type::Unsigned_Byte && data_type == Type::Float)
+	{
+		float* values{ reinterpret_cast<float*>(destination) };
+		if (srgb)
+			Pixel_Converter::Srgb_To_Linear(source, values, count, channels);
+		else
+			Pixel_Converter::U8_To_F32(source, values, value_count);
+	}
+	else if (source_type == Type::Float && data_type == Type::Unsigned_Byte)
+	{
+		const float* values{ reinterpret_cast<const float*>(source) };
+		if (srgb)
+			Pixel_Converter::Linear_To_Srgb(values, destination, count, channels);
+		else
+			Pixel_Converter::F32_To_U8(values, destination, value_count);
+	}
+	else if (source_type == Type::Float && data_type == Type::Half)
+	{
+		Pixel_Converter::F32_To_F16(reinterpret_cast<const float*>(source),
+			reinterpret_cast<std::uint16_t*>(destination), value_count);
+	}
+	else if (source_type == Type::Half && data_type == Type::Float)
+	{
+		Pixel_Converter::F16_To_F32(reinterpret_cast<const std::uint16_t*>(source),
+			reinterpret_cast<float*>(destination), value_count);
+	}
+	else if (source_type == Type::Unsigned_Byte && data_type == Type::Half)
+	{
+		std::uint16_t* values{ reinterpret_cast<std::uint16_t*>(destination) };
+		if (!srgb)
+		{
+			Pixel_Converter::U8_To_F16(source, values, value_count);
+			return;
+		}
+		std::vector<float> floats(CONVERT_CHUNK_SIZE * channels);
+		for (std::size_t i{ 0 }; i < count; i += CONVERT_CHUNK_SIZE)
+		{
+			const std::size_t chunk{ std::min(CONVERT_CHUNK_SIZE, count - i) };
+			Pixel_Converter::Srgb_To_Linear(source + i * channels, floats.data(), chunk,
+				channels);
+			Pixel_Converter::F32_To_F16(floats.data(), values + i * channels, chunk * channels);
+		}
+	}
+	else if (source_type == Type::Half && data_type == Type::Unsigned_Byte)
+	{
+		const std::uint16_t* values{ reinterpret_cast<const std::uint16_t*>(source) };
+		if (!srgb)
+		{
+			Pixel_Converter::F16_To_U8(values, destination, value_count);
+			return;
+		}
+		std::vector<float> floats(CONVERT_CHUNK_SIZE * channels);
+		for (std::size_t i{ 0 }; i < count; i += CONVERT_CHUNK_SIZE)
+		{
+			const std::size_t chunk{ std::min(CONVERT_CHUNK_SIZE, count - i) };
+			Pixel_Converter::F16_To_F32(values + i * channels, floats.data(), chunk * channels);
+			Pixel_Converter::Linear_To_Srgb(floats.data(), destination + i * channels, chunk,
+				channels);
+		}
+	}
+}
+
+/**
+ * @brief Converts texels between channel counts, all of the same data type.
+ */
+static void Convert_Channels(const std::uint8_t* source, std::size_t source_channels,
+	std::uint8_t* destination, std::size_t channels, tilia::enums::Image_Data_Type data_type,
+	std::size_t count)
+{
+	using tilia::Pixel_Converter;
+
+	if (data_type == tilia::enums::Image_Data_Type::Unsigned_Byte)
+	{
+		Pixel_Converter::Convert_Channels(source, source_channels, destination, channels, count);
+	}
+	else if (data_type == tilia::enums::Image_Data_Type::Half)
+	{
+		Run_As_Floats(reinterpret_cast<const std::uint16_t*>(source), source_channels,
+			reinterpret_cast<std::uint16_t*>(destination), channels, count,
+			[&](const float* texels, float* converted, std::size_t chunk)
+			{
+				Pixel_Converter::Convert_Channels(texels, source_channels, converted, channels,
+					chunk);
+			});
+	}
+	else
+	{
+		Pixel_Converter::Convert_Channels(reinterpret_cast<const float*>(source),
+			source_channels, reinterpret_cast<float*>(destination), channels, count);
+	}
+}
 
 static inline bool Is_Gif(const std::string& filename)
 {
@@ -14,7 +156,6 @@ static inline bool Is_Gif(const std::string& filename)
 
 tilia::Image::Image(const std::string& filename, enums::Image_Channels image_channels, 
 	enums::Image_Data_Type data_type, bool flip_vertical, float gamma)
-	: m_image_data{ nullptr, Free_Image }
 {
 	Reload(filename, image_channels, data_type, flip_vertical, gamma);
 }
@@ -23,18 +164,19 @@ void tilia::Image::Reload(const std::string& filename, enums::Image_Channels ima
 	enums::Image_Data_Type data_type, bool flip_vertical, float gamma)
 {
 	Free();
-	stbi_set_flip_vertically_on_load(flip_vertical);
-	stbi_ldr_to_hdr_gamma(gamma);
+	// Only set for the calling thread so that images may be loaded by several threads at once
+	stbi_set_flip_vertically_on_load_thread(flip_vertical);
 	std::int32_t channel_count{};
 	if (data_type == enums::Image_Data_Type::Unsigned_Byte)
 	{
-		m_image_data = {
+		m_image_data = Data_Ptr{
 			stbi_load(filename.c_str(), &m_width, &m_height,
 			&channel_count, *image_channels), Free_Image };
 	}
-	else if (data_type == enums::Image_Data_Type::Float)
+	else
 	{
-		m_image_data = { static_cast<Byte*>(
+		stbi_ldr_to_hdr_gamma(gamma);
+		m_image_data = Data_Ptr{ static_cast<Byte*>(
 			static_cast<void*>(stbi_loadf(filename.c_str(), &m_width, &m_height,
 			&channel_count, *image_channels))), Free_Image };
 	}
@@ -65,6 +207,17 @@ void tilia::Image::Reload(const std::string& filename, enums::Image_Channels ima
 	{
 		m_image_channels = static_cast<enums::Image_Channels>(channel_count);
 	}
+
+	// stb_image only decodes to floats, which half images are converted from
+	if (data_type == enums::Image_Data_Type::Half)
+	{
+		const std::size_t value_count{ static_cast<std::size_t>(m_width) * m_height *
+			(*m_image_channels) };
+		std::shared_ptr<Byte[]> image_data{ new Byte[value_count * sizeof(std::uint16_t)] };
+		Pixel_Converter::F32_To_F16(reinterpret_cast<const float*>(m_image_data.get()),
+			reinterpret_cast<std::uint16_t*>(image_data.get()), value_count);
+		m_image_data = std::move(image_data);
+	}
 }
 
 void tilia::Image::Free()
@@ -76,6 +229,139 @@ void tilia::Image::Free()
 	m_data_type = enums::Image_Data_Type::Unsigned_Byte;
 }
 
+/**
+ * When both channels and data type change texels are converted in chunks through a buffer,
+ * removing channels before changing type and adding them after, so that as few values as
+ * possible are converted.
+ */
+tilia::Image tilia::Image::Convert(enums::Image_Channels image_channels,
+	enums::Image_Data_Type data_type, bool srgb) const
+{
+
+	if (m_image_data == nullptr)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Can not convert an empty image" } };
+	}
+
+	if (image_channels == enums::Image_Channels::Largest)
+		image_channels = m_image_channels;
+
+	const auto source_channels{ static_cast<std::size_t>(*m_image_channels) };
+	const auto channels{ static_cast<std::size_t>(*image_channels) };
+	const std::size_t count{ static_cast<std::size_t>(m_width) * m_height };
+	const std::size_t source_texel_size{ source_channels * (*m_data_type) };
+	const std::size_t texel_size{ channels * (*data_type) };
+
+	Data_Ptr image_data{ new Byte[count * texel_size],
+		[](Byte* image_data) { delete[] image_data; } };
+
+	const Byte* source{ m_image_data.get() };
+	Byte* destination{ image_data.get() };
+
+	if (data_type == m_data_type)
+	{
+		Convert_Channels(source, source_channels, destination, channels, data_type, count);
+	}
+	else if (channels == source_channels)
+	{
+		Convert_Type(source, m_data_type, destination, data_type, count, channels, srgb);
+	}
+	else
+	{
+		const bool channels_first{ channels < source_channels };
+		std::vector<Byte> buffer(CONVERT_CHUNK_SIZE * std::max(source_channels, channels) *
+			std::max(*m_data_type, *data_type));
+
+		for (std::size_t i{ 0 }; i < count; i += CONVERT_CHUNK_SIZE)
+		{
+			const std::size_t chunk{ std::min(CONVERT_CHUNK_SIZE, count - i) };
+			const Byte* texels{ source + i * source_texel_size };
+			Byte* converted{ destination + i * texel_size };
+			if (channels_first)
+			{
+				Convert_Channels(texels, source_channels, buffer.data(), channels, m_data_type,
+					chunk);
+				Convert_Type(buffer.data(), m_data_type, converted, data_type, chunk, channels,
+					srgb);
+			}
+			else
+			{
+				Convert_Type(texels, m_data_type, buffer.data(), data_type, chunk,
+					source_channels, srgb);
+				Convert_Channels(buffer.data(), source_channels, converted, channels, data_type,
+					chunk);
+			}
+		}
+	}
+
+	return { std::move(image_data), m_width, m_height, image_channels, data_type };
+
+}
+
+void tilia::Image::Premultiply_Alpha()
+{
+	Make_Unique();
+	const std::size_t count{ static_cast<std::size_t>(m_width) * m_height };
+	if (m_data_type == enums::Image_Data_Type::Unsigned_Byte)
+	{
+		Pixel_Converter::Premultiply_Alpha(m_image_data.get(), count, *m_image_channels);
+	}
+	else if (m_data_type == enums::Image_Data_Type::Half)
+	{
+		const std::size_t channels{ static_cast<std::size_t>(*m_image_channels) };
+		auto texels{ reinterpret_cast<std::uint16_t*>(m_image_data.get()) };
+		Run_As_Floats(texels, channels, texels, channels, count,
+			[channels](const float* source, float* destination, std::size_t chunk)
+			{
+				std::copy_n(source, chunk * channels, destination);
+				Pixel_Converter::Premultiply_Alpha(destination, chunk, channels);
+			});
+	}
+	else
+	{
+		Pixel_Converter::Premultiply_Alpha(reinterpret_cast<float*>(m_image_data.get()), count,
+			*m_image_channels);
+	}
+}
+
+void tilia::Image::Swizzle(const std::array<std::uint8_t, 4>& order)
+{
+	Make_Unique();
+	const std::size_t count{ static_cast<std::size_t>(m_width) * m_height };
+	if (m_data_type == enums::Image_Data_Type::Unsigned_Byte)
+	{
+		Pixel_Converter::Swizzle(m_image_data.get(), count, *m_image_channels, order);
+	}
+	else if (m_data_type == enums::Image_Data_Type::Half)
+	{
+		const std::size_t channels{ static_cast<std::size_t>(*m_image_channels) };
+		auto texels{ reinterpret_cast<std::uint16_t*>(m_image_data.get()) };
+		Run_As_Floats(texels, channels, texels, channels, count,
+			[channels, &order](const float* source, float* destination, std::size_t chunk)
+			{
+				std::copy_n(source, chunk * channels, destination);
+				Pixel_Converter::Swizzle(destination, chunk, channels, order);
+			});
+	}
+	else
+	{
+		Pixel_Converter::Swizzle(reinterpret_cast<float*>(m_image_data.get()), count,
+			*m_image_channels, order);
+	}
+}
+
+/**
+ * Other holders keep the data they share, the image getting a copy of its own.
+ */
+void tilia::Image::Make_Unique()
+{
+	if (m_image_data == nullptr || m_image_data.use_count() == 1)
+		return;
+	const std::shared_ptr<Byte[]> shared_data{ std::move(m_image_data) };
+	Copy_Data(shared_data.get());
+}
+
 void tilia::Image::Free_Image(Byte* image_data)
 {
 	stbi_image_free(image_data);
@@ -83,6 +369,9 @@ void tilia::Image::Free_Image(Byte* image_data)
 
 #if TILIA_UNIT_TESTS == 1
 
+// Standard
+#include <cmath>
+
 // Vendor
 #include "vendor/Catch2/Catch2.hpp"
 
@@ -359,8 +648,177 @@ void tilia::Image::Test()
 	image_1 = {};
 
 	REQUIRE(image_0 == image_1);
-	
-	
+
+	// Test converting
+
+	std::uint8_t texels[4 * 3]{ 10, 20, 30, 255, 188, 188, 188, 128, 0, 0, 255, 0 };
+	const Image rgba{ texels, 3, 1, enums::Image_Channels::RGBA,
+		enums::Image_Data_Type::Unsigned_Byte };
+
+		// Channels only
+
+	const Image rgb{ rgba.Convert(enums::Image_Channels::RGB,
+		enums::Image_Data_Type::Unsigned_Byte) };
+
+	REQUIRE(rgb.Channels() == enums::Image_Channels::RGB);
+	REQUIRE(rgb.Size() == 9);
+	REQUIRE(rgb.Get_Data()[3] == 188);
+	REQUIRE(rgb.Get_Data()[8] == 255);
+
+		// Data type only, linearizing sRGB
+
+	const Image linear{ rgba.Convert(enums::Image_Channels::Largest,
+		enums::Image_Data_Type::Float, true) };
+	const float* values{ reinterpret_cast<const float*>(linear.Get_Data()) };
+
+	REQUIRE(linear.Channels() == enums::Image_Channels::RGBA);
+	REQUIRE(linear.Size() == 3 * 4 * 4);
+	REQUIRE(std::abs(values[4] - 0.5f) < 0.003f);
+	REQUIRE(std::abs(values[7] - 128.0f / 255.0f) < 1e-6f);
+
+	REQUIRE(linear.Convert(enums::Image_Channels::Largest,
+		enums::Image_Data_Type::Unsigned_Byte, true) == rgba);
+
+		// Both, removing and adding channels
+
+	const Image grey{ linear.Convert(enums::Image_Channels::Grey,
+		enums::Image_Data_Type::Unsigned_Byte) };
+
+	REQUIRE(grey.Channels() == enums::Image_Channels::Grey);
+	REQUIRE(grey.Data_Type() == enums::Image_Data_Type::Unsigned_Byte);
+	REQUIRE(grey.Size() == 3);
+
+	const Image expanded{ grey.Convert(enums::Image_Channels::RGBA,
+		enums::Image_Data_Type::Float) };
+	values = reinterpret_cast<const float*>(expanded.Get_Data());
+
+	REQUIRE(expanded.Size() == 3 * 4 * 4);
+	REQUIRE(values[8] == values[9]);
+	REQUIRE(values[8] == values[10]);
+	REQUIRE(values[11] == 1.0f);
+
+		// Empty images can not be converted
+
+	REQUIRE_THROWS_AS(Image{}.Convert(enums::Image_Channels::RGBA,
+		enums::Image_Data_Type::Float), utils::Tilia_Exception);
+
+	// Test premultiplying and swizzling
+
+	Image premultiplied{ rgba };
+	premultiplied.Premultiply_Alpha();
+
+	REQUIRE(premultiplied.Get_Data()[0] == 10);
+	REQUIRE(premultiplied.Get_Data()[4] == 94);
+	REQUIRE(premultiplied.Get_Data()[7] == 128);
+	REQUIRE(premultiplied.Get_Data()[10] == 0);
+
+	Image bgra{ rgba };
+	bgra.Swizzle({ 2, 1, 0, 3 });
+
+	REQUIRE(bgra.Get_Data()[0] == 30);
+	REQUIRE(bgra.Get_Data()[2] == 10);
+	REQUIRE(bgra.Get_Data()[8] == 255);
+	REQUIRE(bgra.Get_Data()[10] == 0);
+
+		// The image copied from is left as it is
+
+	REQUIRE(rgba.Get_Data()[0] == 10);
+	REQUIRE(rgba.Get_Data()[4] == 188);
+
+	// Test half floats
+
+	const Image half{ rgba.Convert(enums::Image_Channels::Largest,
+		enums::Image_Data_Type::Half) };
+	const auto halves{ reinterpret_cast<const std::uint16_t*>(half.Get_Data()) };
+	float half_values[3 * 4]{};
+	Pixel_Converter::F16_To_F32(halves, half_values, 3 * 4);
+
+	REQUIRE(half.Data_Type() == enums::Image_Data_Type::Half);
+	REQUIRE(half.Size() == 3 * 4 * 2);
+	REQUIRE(std::abs(half_values[4] - 188.0f / 255.0f) < 1e-3f);
+	REQUIRE(half_values[3] == 1.0f);
+
+	REQUIRE(half.Convert(enums::Image_Channels::Largest,
+		enums::Image_Data_Type::Unsigned_Byte) == rgba);
+	REQUIRE(half.Convert(enums::Image_Channels::Largest, enums::Image_Data_Type::Float,
+		true).Convert(enums::Image_Channels::Largest, enums::Image_Data_Type::Half, true) ==
+		half);
+
+		// Channels of halves
+
+	const Image half_rgb{ half.Convert(enums::Image_Channels::RGB,
+		enums::Image_Data_Type::Half) };
+
+	REQUIRE(half_rgb.Size() == 3 * 3 * 2);
+	REQUIRE(half_rgb.Convert(enums::Image_Channels::Largest,
+		enums::Image_Data_Type::Unsigned_Byte) == rgb);
+
+		// Premultiplying and swizzling halves
+
+	Image half_premultiplied{ half };
+	half_premultiplied.Premultiply_Alpha();
+
+	REQUIRE(half_premultiplied.Convert(enums::Image_Channels::Largest,
+		enums::Image_Data_Type::Unsigned_Byte) == premultiplied);
+
+	Image half_bgra{ half };
+	half_bgra.Swizzle({ 2, 1, 0, 3 });
+
+	REQUIRE(half_bgra.Convert(enums::Image_Channels::Largest,
+		enums::Image_Data_Type::Unsigned_Byte) == bgra);
+
+		// Loading halves holds the values of loading floats
+
+	const Image loaded_half{ filename_0, enums::Image_Channels::RGBA,
+		enums::Image_Data_Type::Half };
+	const Image loaded_float{ filename_0, enums::Image_Channels::RGBA,
+		enums::Image_Data_Type::Float };
+
+	REQUIRE(loaded_half.Data_Type() == enums::Image_Data_Type::Half);
+	REQUIRE(loaded_half.Size() == loaded_half.Width() * loaded_half.Height() * 4 * 2);
+	REQUIRE(loaded_half.Convert(enums::Image_Channels::Largest,
+		enums::Image_Data_Type::Float) == loaded_float.Convert(
+			enums::Image_Channels::Largest, enums::Image_Data_Type::Half).Convert(
+				enums::Image_Channels::Largest, enums::Image_Data_Type::Float));
+
+	// Test sharing data between copies
+
+	Image shared{ rgba };
+	const Image& const_shared{ shared };
+
+	REQUIRE(shared.Is_Shared());
+	REQUIRE(rgba.Is_Shared());
+	REQUIRE(const_shared.Get_Data() == rgba.Get_Data());
+
+		// Changing a copy copies its data first
+
+	shared.Get_Data()[0] = 0;
+
+	REQUIRE_FALSE(shared.Is_Shared());
+	REQUIRE_FALSE(rgba.Is_Shared());
+	REQUIRE(const_shared.Get_Data() != rgba.Get_Data());
+	REQUIRE(rgba.Get_Data()[0] == 10);
+
+		// Shared data outlives the image
+
+	const Image::Shared_Data data{ shared.Share_Data() };
+
+	REQUIRE(shared.Is_Shared());
+
+	shared.Free();
+
+	REQUIRE(data.use_count() == 1);
+	REQUIRE(data[0] == 0);
+	REQUIRE(data[1] == 20);
+
+		// Moving does not copy
+
+	Image moved{ rgba };
+	const Byte* const moved_data{ rgba.Get_Data() };
+	Image moved_to{ std::move(moved) };
+
+	REQUIRE(static_cast<const Image&>(moved_to).Get_Data() == moved_data);
+
 }
 
 #endif // TILIA_UNIT_TESTS == 1
\ No newline at end of file
@@ -11,6 +11,8 @@
 #define TILIA_IMAGE_HPP
 
 // Standard
+#include <cstdint>
+#include <array>
 #include <memory>
 #include <string>
 
@@ -31,17 +33,22 @@ namespace tilia
 			RGB		   = 0x0003,
 			RGBA	   = 0x0004
 		}; // Image_Channels
-		// The data type to use to represent the image data.
+		// The data type to use to represent the image data. Underlying value is the size of a
+		// value in bytes.
 		enum class Image_Data_Type
 		{
 			Unsigned_Byte = sizeof(unsigned char),
+			// 16 bit floats, halving the size of float images of high dynamic range
+			Half		  = sizeof(std::uint16_t),
 			Float		  = sizeof(float)
 		}; // Image_Data_Type
 	} // enums
 	
 	/**
 	 * @brief A class for image loading. Can be copied and moved for both construction and
-	 * assignment.
+	 * assignment. Copies share the image data, which is only copied once a copy is changed, so
+	 * that images can be passed around by value without duplicating their texels. Different
+	 * copies may be used by different threads but a single image may not.
 	 */
 	class Image
 	{
@@ -58,9 +65,11 @@ namespace tilia
 		 * 
 		 * @param image_channels - The image channels that the image data will be loaded with. If
 		 * file is 'GIF' then this is ignored and the data is loaded with RGBA channels.
-		 * @param data_type - The type of data for the image to be loaded as.
+		 * @param data_type - The type of data for the image to be loaded as. Half images are
+		 * loaded as float and converted.
 		 * @param flip_vertical - Whether or not to load the data in a flipped state.
-		 * @param gamma - The gamma to load the image with. Only works on images loaded as float.
+		 * @param gamma - The gamma to load the image with. Only works on images loaded as float
+		 * or half.
 		 */
 		Image(const std::string& filename, enums::Image_Channels image_channels =
 			enums::Image_Channels::Largest, enums::Image_Data_Type data_type = 
@@ -70,9 +79,11 @@ namespace tilia
 		 *
 		 * @param image_channels - The image channels that the image data will be loaded with. If
 		 * file is 'GIF' then this is ignored and the data is loaded with RGBA channels.
-		 * @param data_type - The type of data for the image to be loaded as.
+		 * @param data_type - The type of data for the image to be loaded as. Half images are
+		 * loaded as float and converted.
 		 * @param flip_vertical - Whether or not to load the data in a flipped state.
-		 * @param gamma - The gamma to load the image with. Only works on images loaded as float.
+		 * @param gamma - The gamma to load the image with. Only works on images loaded as float
+		 * or half.
 		 */
 		void Reload(const std::string& filename, enums::Image_Channels image_channels =
 			enums::Image_Channels::Largest, enums::Image_Data_Type data_type =
@@ -84,9 +95,54 @@ namespace tilia
 		void Free();
 
 		/**
-		 * @brief Gets a pointer to the image data.
+		 * @brief Makes a copy of the image with other channels and data type, through the
+		 * kernels of Pixel_Converter. Added color channels copy grey and added alpha is opaque,
+		 * removed color channels become the luma of red, green and blue.
+		 *
+		 * @param image_channels - The channels of the copy, Largest to keep those of the image.
+		 * @param data_type - The data type of the copy.
+		 * @param srgb - Whether or not the color channels of byte data are sRGB encoded. If so
+		 * they are linearized when converted to float or half and encoded when converted to
+		 * bytes.
+		 *
+		 * @exception The image is empty.
+		 */
+		Image Convert(enums::Image_Channels image_channels, enums::Image_Data_Type data_type,
+			bool srgb = false) const;
+
+		/**
+		 * @brief Multiplies the color channels with alpha. Images without alpha are left as
+		 * they are.
+		 */
+		void Premultiply_Alpha();
+
+		/**
+		 * @brief Reorders the channels of the image.
+		 *
+		 * @param order - The source channel of every channel, such as { 2, 1, 0, 3 } to swap
+		 * between RGBA and BGRA. Only as many as the image has channels are used.
+		 *
+		 * @exception A source channel is out of range.
+		 */
+		void Swizzle(const std::array<std::uint8_t, 4>& order);
+
+		// Image data shared with the image, which is left as it is whatever the image does.
+		using Shared_Data = std::shared_ptr<const Byte[]>;
+
+		/**
+		 * @brief Gets a pointer to the image data. Getting data that may be changed first copies
+		 * it if it is shared.
 		 */
-		auto Get_Data() { return m_image_data.get(); }
+		auto Get_Data() { Make_Unique(); return m_image_data.get(); }
+		auto Get_Data() const { return static_cast<const Byte*>(m_image_data.get()); }
+		/**
+		 * @brief Shares the image data, without copying it.
+		 */
+		Shared_Data Share_Data() const { return m_image_data; }
+		/**
+		 * @brief Whether or not the image data is shared with other images or holders of it.
+		 */
+		bool Is_Shared() const { return m_image_data.use_count() > 1; }
 		/**
 		 * @brief The width of the image.
 		 */
@@ -119,8 +175,8 @@ namespace tilia
 
 	private:
 		static void Free_Image(Byte* image_data);
-		// The data of the image
-		Data_Ptr m_image_data{ nullptr, nullptr };
+		// The data of the image, shared between copies
+		std::shared_ptr<Byte[]> m_image_data{};
 		// Dimensions of the image
 		std::int32_t
 			m_width{ 0 },
@@ -134,58 +190,32 @@ namespace tilia
 		 * @brief Copies the given data. Uses the size of member variabels for width, height and
 		 * number of channels.
 		 */
-		void Copy_Data(Byte* image_data)
+		void Copy_Data(const Byte* image_data)
 		{
-			const auto size{ m_width * m_height * (*m_image_channels) * (*m_data_type) };
-			// Copies data as well as sets custom destructor to just do 'delete[]' since the data
-			// is allocated using new[]
-			m_image_data = { new Byte[size], [](Byte* image_data) { delete[] image_data; } };
+			const auto size{ static_cast<std::size_t>(Size()) };
+			// Allocated using new[] and so deleted using 'delete[]'
+			m_image_data.reset(new Byte[size]);
 			std::copy(image_data, image_data + size, m_image_data.get());
 		}
 
+		/**
+		 * @brief Copies the image data if it is shared, so that it may be changed.
+		 */
+		void Make_Unique();
+
 	public:
 
 		Image() = default;
 
-		Image(const Image& other)
-			: m_image_data{ nullptr, [](Byte* image_data) { delete[] image_data; } },
-			m_width{ other.m_width }, m_height{ other.m_height },
-			m_image_channels{ other.m_image_channels }, m_data_type{ other.m_data_type }
-		{ Copy_Data(other.m_image_data.get()); }
-		Image(Image&& other) noexcept
-			: m_image_data{ std::move(other.m_image_data) },
-			m_width{ other.m_width }, m_height{ other.m_height },
-			m_image_channels{ other.m_image_channels }, m_data_type{ other.m_data_type } { }
-
-		Image& operator=(const Image& other)
-		{
-			if (this == &other)
-				return *this;
-			Free();
-			m_width = other.m_width;
-			m_height = other.m_height;
-			m_image_channels = other.m_image_channels;
-			m_data_type = other.m_data_type;
-			Copy_Data(other.m_image_data.get());
-			return *this;
-		}
-		Image& operator=(Image&& other) noexcept
-		{
-			if (this == &other)
-				return *this;
-			Free();
-			m_width = other.m_width;
-			m_height = other.m_height;
-			m_image_channels = other.m_image_channels;
-			m_data_type = other.m_data_type;
-			m_image_data = std::move(other.m_image_data);
-			return *this;
-		}
+		Image(const Image& other) = default;
+		Image(Image&& other) noexcept = default;
+
+		Image& operator=(const Image& other) = default;
+		Image& operator=(Image&& other) noexcept = default;
 
-		Image(Byte* image_data, std::int32_t width, std::int32_t height,
+		Image(const Byte* image_data, std::int32_t width, std::int32_t height,
 			enums::Image_Channels image_channels, enums::Image_Data_Type data_type)
-			: m_image_data{ nullptr, [](Byte* image_data) { delete[] image_data; } },
-			m_width{ width }, m_height{ height }, m_image_channels{ image_channels },
+			: m_width{ width }, m_height{ height }, m_image_channels{ image_channels },
 			m_data_type{ data_type }
 		{
 			Copy_Data(image_data);
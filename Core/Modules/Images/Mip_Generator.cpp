@@ -0,0 +1,789 @@
+// Standard
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+
+// Tilia
+#include "Mip_Generator.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+#include TILIA_JOB_SYSTEM_INCLUDE
+#include TILIA_PIXEL_CONVERTER_INCLUDE
+
+#if TILIA_AVX == 1
+// Standard
+#include <immintrin.h>
+#elif TILIA_SSE2 == 1
+// Standard
+#include <emmintrin.h>
+#endif // TILIA_AVX == 1
+
+// The amount of rows of a level filtered by each job
+static constexpr std::size_t ROWS_PER_JOB{ 16 };
+
+// The radius of the Kaiser filter in texels of the level being generated, and the alpha of its
+// window. Wider filters ring more, lower alphas keep more of the sinc and so more sharpness.
+static constexpr float KAISER_WIDTH{ 3.0f };
+static constexpr float KAISER_ALPHA{ 4.0f };
+
+// The largest alpha scale used to keep coverage, so that levels of almost fully transparent
+// images are not made opaque
+static constexpr float MAX_ALPHA_SCALE{ 64.0f };
+
+static constexpr std::size_t NO_ALPHA{ std::numeric_limits<std::size_t>::max() };
+
+static constexpr float PI{ 3.14159265358979f };
+
+/**
+ * @brief The taps of one axis of a level. Texel i of the level sums count[i] texels of the level
+ * above it, from first[i] on, weighted by the weights from i * stride on.
+ */
+struct Filter_Taps
+{
+	std::vector<std::int32_t> first{};
+	std::vector<std::int32_t> count{};
+	std::vector<float> weights{};
+	std::size_t stride{};
+}; // Filter_Taps
+
+static float Sinc(float x)
+{
+	if (std::abs(x) < 1e-6f)
+		return 1.0f;
+	return std::sin(PI * x) / (PI * x);
+}
+
+/**
+ * @brief The modified Bessel function of the first kind and order 0, which the Kaiser window is
+ * made from.
+ */
+static float Bessel_I0(float x)
+{
+	float sum{ 1.0f };
+	float term{ 1.0f };
+	for (std::int32_t k{ 1 }; k < 32 && term > sum * 1e-8f; ++k)
+	{
+		const float factor{ x / (2.0f * static_cast<float>(k)) };
+		term *= factor * factor;
+		sum += term;
+	}
+	return sum;
+}
+
+static float Kaiser(float x)
+{
+	const float t{ x / KAISER_WIDTH };
+	if (std::abs(t) >= 1.0f)
+		return 0.0f;
+	return Sinc(x) * Bessel_I0(KAISER_ALPHA * std::sqrt(1.0f - t * t)) /
+		Bessel_I0(KAISER_ALPHA);
+}
+
+/**
+ * Taps falling outside of the level above are clamped onto its edge texels. The weights of every
+ * texel are normalized so that flat areas stay flat whatever the filter.
+ */
+static Filter_Taps Make_Taps(std::int32_t source_size, std::int32_t size,
+	tilia::enums::Mip_Filter filter)
+{
+
+	const float scale{ static_cast<float>(source_size) / static_cast<float>(size) };
+	const float radius{ filter == tilia::enums::Mip_Filter::Box ? scale * 0.5f :
+		KAISER_WIDTH * scale };
+
+	Filter_Taps taps{};
+	taps.first.resize(size);
+	taps.count.resize(size);
+
+	std::vector<std::vector<float>> weights(size);
+
+	for (std::int32_t i{ 0 }; i < size; ++i)
+	{
+		const float center{ (static_cast<float>(i) + 0.5f) * scale };
+		const auto low{ static_cast<std::int32_t>(std::floor(center - radius)) };
+		const auto high{ static_cast<std::int32_t>(std::ceil(center + radius)) - 1 };
+
+		const std::int32_t first{ std::clamp(low, 0, source_size - 1) };
+		const std::int32_t last{ std::clamp(high, 0, source_size - 1) };
+		weights[i].assign(static_cast<std::size_t>(last - first + 1), 0.0f);
+
+		float sum{};
+		for (std::int32_t j{ low }; j <= high; ++j)
+		{
+			float weight{};
+			if (filter == tilia::enums::Mip_Filter::Box)
+			{
+				weight = std::min(static_cast<float>(j + 1), center + radius) -
+					std::max(static_cast<float>(j), center - radius);
+				weight = std::max(weight, 0.0f);
+			}
+			else
+			{
+				weight = Kaiser((static_cast<float>(j) + 0.5f - center) / scale);
+			}
+			weights[i][std::clamp(j, 0, source_size - 1) - first] += weight;
+			sum += weight;
+		}
+
+		for (auto& weight : weights[i])
+			weight /= sum;
+
+		taps.first[i] = first;
+		taps.count[i] = last - first + 1;
+		taps.stride = std::max(taps.stride, weights[i].size());
+	}
+
+	taps.weights.assign(taps.stride * size, 0.0f);
+	for (std::int32_t i{ 0 }; i < size; ++i)
+		std::copy(weights[i].begin(), weights[i].end(), taps.weights.begin() + i * taps.stride);
+
+	return taps;
+
+}
+
+/**
+ * @brief Sums count rows of row_size values each, the rows following each other, weighted by the
+ * given weights.
+ */
+static void Sum_Rows(float* sum, const float* rows, std::size_t row_size, const float* weights,
+	std::int32_t count)
+{
+
+	std::size_t i{ 0 };
+
+#if TILIA_AVX == 1
+
+	for (; i + 8 <= row_size; i += 8)
+	{
+		__m256 total{ _mm256_setzero_ps() };
+		for (std::int32_t k{ 0 }; k < count; ++k)
+		{
+			total = _mm256_add_ps(total, _mm256_mul_ps(_mm256_set1_ps(weights[k]),
+				_mm256_loadu_ps(rows + k * row_size + i)));
+		}
+		_mm256_storeu_ps(sum + i, total);
+	}
+
+#endif // TILIA_AVX == 1
+
+#if TILIA_SSE2 == 1
+
+	for (; i + 4 <= row_size; i += 4)
+	{
+		__m128 total{ _mm_setzero_ps() };
+		for (std::int32_t k{ 0 }; k < count; ++k)
+		{
+			total = _mm_add_ps(total, _mm_mul_ps(_mm_set1_ps(weights[k]),
+				_mm_loadu_ps(rows + k * row_size + i)));
+		}
+		_mm_storeu_ps(sum + i, total);
+	}
+
+#endif // TILIA_SSE2 == 1
+
+	for (; i < row_size; ++i)
+	{
+		float total{};
+		for (std::int32_t k{ 0 }; k < count; ++k)
+			total += weights[k] * rows[k * row_size + i];
+		sum[i] = total;
+	}
+
+}
+
+/**
+ * @brief Filters a row along its width, clamping the results to [0, max_value].
+ */
+static void Filter_Row(float* row, const float* source, const Filter_Taps& taps,
+	std::size_t channels, float max_value)
+{
+
+	const auto width{ taps.first.size() };
+
+#if TILIA_SSE2 == 1
+
+	// A texel of four channels fills a register
+	if (channels == 4)
+	{
+		const __m128 zero{ _mm_setzero_ps() };
+		const __m128 max{ _mm_set1_ps(max_value) };
+		for (std::size_t x{ 0 }; x < width; ++x)
+		{
+			const float* weights{ taps.weights.data() + x * taps.stride };
+			const float* texels{ source + taps.first[x] * channels };
+			__m128 total{ _mm_setzero_ps() };
+			for (std::int32_t k{ 0 }; k < taps.count[x]; ++k)
+			{
+				total = _mm_add_ps(total, _mm_mul_ps(_mm_set1_ps(weights[k]),
+					_mm_loadu_ps(texels + k * channels)));
+			}
+			_mm_storeu_ps(row + x * channels, _mm_min_ps(_mm_max_ps(total, zero), max));
+		}
+		return;
+	}
+
+#endif // TILIA_SSE2 == 1
+
+	for (std::size_t x{ 0 }; x < width; ++x)
+	{
+		const float* weights{ taps.weights.data() + x * taps.stride };
+		const float* texels{ source + taps.first[x] * channels };
+		for (std::size_t c{ 0 }; c < channels; ++c)
+		{
+			float total{};
+			for (std::int32_t k{ 0 }; k < taps.count[x]; ++k)
+				total += weights[k] * texels[k * channels + c];
+			row[x * channels + c] = std::clamp(total, 0.0f, max_value);
+		}
+	}
+
+}
+
+/**
+ * @brief Calls the function on the given amount of rows, split into jobs if the calling thread
+ * may run them.
+ */
+template<typename Func>
+static void Run_Rows(std::size_t rows, Func&& function)
+{
+	tilia::jobs::Job_System& job_system{ tilia::jobs::Job_System::Instance() };
+	if (job_system.Can_Run_Jobs() && rows > ROWS_PER_JOB)
+		job_system.Parallel_For(0, rows, ROWS_PER_JOB, function);
+	else
+		function(0, rows);
+}
+
+static float Get_Coverage(const std::vector<float>& texels, std::size_t channels, float cutoff)
+{
+	std::size_t passing{};
+	for (std::size_t i{ channels - 1 }; i < texels.size(); i += channels)
+		passing += texels[i] >= cutoff;
+	return static_cast<float>(passing) / static_cast<float>(texels.size() / channels);
+}
+
+/**
+ * Finds the alpha that the wanted amount of texels are at or above, and scales that alpha up or
+ * down to the cutoff.
+ */
+static float Get_Alpha_Scale(const std::vector<float>& texels, std::size_t channels,
+	float cutoff, float coverage)
+{
+
+	std::vector<float> alphas{};
+	alphas.reserve(texels.size() / channels);
+	for (std::size_t i{ channels - 1 }; i < texels.size(); i += channels)
+		alphas.push_back(texels[i]);
+
+	const auto passing{ static_cast<std::size_t>(
+		std::lround(coverage * static_cast<float>(alphas.size()))) };
+	if (passing == 0)
+		return 1.0f;
+
+	std::nth_element(alphas.begin(), alphas.begin() + (passing - 1), alphas.end(),
+		std::greater<float>{});
+
+	const float threshold{ std::max(alphas[passing - 1], cutoff / MAX_ALPHA_SCALE) };
+	// Nudged up so that the threshold is not rounded to just below the cutoff
+	return cutoff / threshold * (1.0f + 1e-5f);
+
+}
+
+/**
+ * @brief Gets the texels of an image as linear floats, linearizing the color channels of sRGB
+ * byte images.
+ */
+static std::vector<float> Get_Texels(const tilia::Image& image, bool srgb)
+{
+
+	using tilia::Pixel_Converter;
+
+	const auto channels{ static_cast<std::size_t>(*image.Channels()) };
+	const auto width{ static_cast<std::size_t>(image.Width()) };
+
+	std::vector<float> texels(width * image.Height() * channels);
+	if (image.Data_Type() == tilia::enums::Image_Data_Type::Unsigned_Byte)
+	{
+		const std::uint8_t* data{ image.Get_Data() };
+		Run_Rows(static_cast<std::size_t>(image.Height()), [&](std::size_t begin, std::size_t end)
+			{
+				const std::size_t row_size{ width * channels };
+				if (srgb)
+				{
+					Pixel_Converter::Srgb_To_Linear(data + begin * row_size,
+						texels.data() + begin * row_size, (end - begin) * width, channels);
+				}
+				else
+				{
+					Pixel_Converter::U8_To_F32(data + begin * row_size,
+						texels.data() + begin * row_size, (end - begin) * row_size);
+				}
+			});
+	}
+	else if (image.Data_Type() == tilia::enums::Image_Data_Type::Half)
+	{
+		Pixel_Converter::F16_To_F32(reinterpret_cast<const std::uint16_t*>(image.Get_Data()),
+			texels.data(), texels.size());
+	}
+	else
+	{
+		std::memcpy(texels.data(), image.Get_Data(), texels.size() * sizeof(float));
+	}
+
+	return texels;
+
+}
+
+/**
+ * @brief Filters the texels of one size into another, every row first being summed over the
+ * rows of the source and then filtered along its width.
+ */
+static void Filter_Texels(const std::vector<float>& source, std::int32_t source_width,
+	std::int32_t source_height, std::vector<float>& texels, std::int32_t width,
+	std::int32_t height, std::size_t channels, tilia::enums::Mip_Filter filter, float max_value)
+{
+
+	const Filter_Taps taps_x{ Make_Taps(source_width, width, filter) };
+	const Filter_Taps taps_y{ Make_Taps(source_height, height, filter) };
+
+	const std::size_t source_row_size{ source_width * channels };
+	const std::size_t row_size{ width * channels };
+	texels.resize(row_size * height);
+
+	Run_Rows(static_cast<std::size_t>(height), [&](std::size_t begin, std::size_t end)
+		{
+			std::vector<float> sum(source_row_size);
+			for (std::size_t y{ begin }; y < end; ++y)
+			{
+				Sum_Rows(sum.data(), source.data() + taps_y.first[y] * source_row_size,
+					source_row_size, taps_y.weights.data() + y * taps_y.stride,
+					taps_y.count[y]);
+				Filter_Row(texels.data() + y * row_size, sum.data(), taps_x, channels,
+					max_value);
+			}
+		});
+
+}
+
+/**
+ * @brief Makes an image of the given size, channels and data type from linear floats, scaling
+ * alpha by the given scale on the way out.
+ */
+static tilia::Image To_Image(const std::vector<float>& texels, std::int32_t width,
+	std::int32_t height, tilia::enums::Image_Channels image_channels,
+	tilia::enums::Image_Data_Type data_type, bool srgb, float alpha_scale, float max_value)
+{
+
+	using tilia::Pixel_Converter;
+
+	const auto channels{ static_cast<std::size_t>(*image_channels) };
+	const std::size_t alpha{ channels == 2 || channels == 4 ? channels - 1 : NO_ALPHA };
+	const std::size_t row_size{ width * channels };
+	const std::size_t size{ texels.size() * static_cast<std::size_t>(*data_type) };
+
+	std::unique_ptr<std::uint8_t[], void (*)(std::uint8_t*)> data{ new std::uint8_t[size],
+		[](std::uint8_t* image_data) { delete[] image_data; } };
+
+	Run_Rows(static_cast<std::size_t>(height), [&](std::size_t begin, std::size_t end)
+		{
+			std::vector<float> row(row_size);
+			for (std::size_t y{ begin }; y < end; ++y)
+			{
+				std::copy_n(texels.data() + y * row_size, row_size, row.data());
+				if (alpha_scale != 1.0f)
+				{
+					for (std::size_t j{ alpha }; j < row_size; j += channels)
+						row[j] = std::min(row[j] * alpha_scale, max_value);
+				}
+
+				std::uint8_t* values{ data.get() + y * row_size * (*data_type) };
+				if (data_type == tilia::enums::Image_Data_Type::Half)
+				{
+					Pixel_Converter::F32_To_F16(row.data(),
+						reinterpret_cast<std::uint16_t*>(values), row_size);
+				}
+				else if (data_type == tilia::enums::Image_Data_Type::Float)
+					std::memcpy(values, row.data(), row_size * sizeof(float));
+				else if (srgb)
+					Pixel_Converter::Linear_To_Srgb(row.data(), values, width, channels);
+				else
+					Pixel_Converter::F32_To_U8(row.data(), values, row_size);
+			}
+		});
+
+	return { std::move(data), width, height, image_channels, data_type };
+
+}
+
+static void Check_Image(const tilia::Image& image, const char* action)
+{
+	if (image.Get_Data() == nullptr || image.Width() <= 0 || image.Height() <= 0 ||
+		*image.Channels() == 0)
+	{
+		throw tilia::utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Can not ", action, " an empty image { Size: ", image.Width(), "x",
+			image.Height(), ", Channels: ", *image.Channels(), " }" } };
+	}
+}
+
+std::vector<tilia::Image> tilia::Mip_Generator::Generate(const Image& image,
+	const Mip_Settings& settings)
+{
+
+	Check_Image(image, "generate mip levels of");
+
+	const auto channels{ static_cast<std::size_t>(*image.Channels()) };
+	const bool bytes{ image.Data_Type() == enums::Image_Data_Type::Unsigned_Byte };
+	const bool srgb{ settings.srgb && bytes };
+	const std::size_t alpha{ channels == 2 || channels == 4 ? channels - 1 : NO_ALPHA };
+	const bool keep_coverage{ settings.alpha_cutoff > 0.0f && alpha != NO_ALPHA };
+	// Float and half images may hold values above 1, byte images can not
+	const float max_value{ bytes ? 1.0f : std::numeric_limits<float>::max() };
+
+	std::size_t level_count{ Get_Level_Count(image.Width(), image.Height()) };
+	if (settings.level_count > 0)
+		level_count = std::min(level_count, settings.level_count);
+
+	std::int32_t source_width{ image.Width() };
+	std::int32_t source_height{ image.Height() };
+
+	// Every level is filtered from the one above it, kept as linear floats
+	std::vector<float> source{ Get_Texels(image, srgb) };
+
+	const float coverage{ keep_coverage ?
+		Get_Coverage(source, channels, settings.alpha_cutoff) : 0.0f };
+
+	std::vector<Image> levels{};
+	levels.reserve(level_count);
+
+	std::vector<float> level{};
+
+	for (std::size_t i{ 1 }; i <= level_count; ++i)
+	{
+		const std::int32_t width{ std::max(image.Width() >> i, 1) };
+		const std::int32_t height{ std::max(image.Height() >> i, 1) };
+
+		Filter_Texels(source, source_width, source_height, level, width, height, channels,
+			settings.filter, max_value);
+
+		// The alpha of the level is scaled on the way out, the next level is filtered from the
+		// unscaled one
+		const float alpha_scale{ keep_coverage ?
+			Get_Alpha_Scale(level, channels, settings.alpha_cutoff, coverage) : 1.0f };
+
+		levels.push_back(To_Image(level, width, height, image.Channels(), image.Data_Type(),
+			srgb, alpha_scale, max_value));
+
+		source.swap(level);
+		source_width = width;
+		source_height = height;
+	}
+
+	return levels;
+
+}
+
+/**
+ * The image is filtered straight down to the size rather than through every mip level above
+ * it, the taps of the filter spanning as many texels as the size is scaled by.
+ */
+tilia::Image tilia::Mip_Generator::Resize(const Image& image, std::int32_t width,
+	std::int32_t height, const Mip_Settings& settings)
+{
+
+	Check_Image(image, "resize");
+
+	if (width <= 0 || height <= 0 || width > image.Width() || height > image.Height())
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Can only resize an image down to a size within it",
+			"\n>>> Image size: ", image.Width(), "x", image.Height(),
+			"\n>>> Size: ", width, "x", height } };
+	}
+
+	if (width == image.Width() && height == image.Height())
+		return image;
+
+	const auto channels{ static_cast<std::size_t>(*image.Channels()) };
+	const bool bytes{ image.Data_Type() == enums::Image_Data_Type::Unsigned_Byte };
+	const bool srgb{ settings.srgb && bytes };
+	const std::size_t alpha{ channels == 2 || channels == 4 ? channels - 1 : NO_ALPHA };
+	const bool keep_coverage{ settings.alpha_cutoff > 0.0f && alpha != NO_ALPHA };
+	const float max_value{ bytes ? 1.0f : std::numeric_limits<float>::max() };
+
+	const std::vector<float> source{ Get_Texels(image, srgb) };
+	std::vector<float> texels{};
+	Filter_Texels(source, image.Width(), image.Height(), texels, width, height, channels,
+		settings.filter, max_value);
+
+	const float alpha_scale{ keep_coverage ? Get_Alpha_Scale(texels, channels,
+		settings.alpha_cutoff, Get_Coverage(source, channels, settings.alpha_cutoff)) : 1.0f };
+
+	return To_Image(texels, width, height, image.Channels(), image.Data_Type(), srgb,
+		alpha_scale, max_value);
+
+}
+
+tilia::Image tilia::Mip_Generator::Fit(const Image& image, std::int32_t max_size,
+	const Mip_Settings& settings)
+{
+	const auto [width, height]{ Get_Fit_Size(image.Width(), image.Height(), max_size) };
+	try
+	{
+		return Resize(image, width, height, settings);
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to fit image within ", max_size, " texels" });
+	}
+}
+
+/**
+ * The largest side is made the max size and the other scaled by as much, rounded to the closest
+ * texel.
+ */
+std::pair<std::int32_t, std::int32_t> tilia::Mip_Generator::Get_Fit_Size(std::int32_t width,
+	std::int32_t height, std::int32_t max_size)
+{
+	const std::int32_t largest{ std::max(width, height) };
+	if (max_size <= 0 || largest <= max_size)
+		return { width, height };
+
+	const double scale{ static_cast<double>(max_size) / static_cast<double>(largest) };
+	const auto fit = [scale, max_size](std::int32_t size)
+		{
+			return std::clamp(static_cast<std::int32_t>(std::lround(size * scale)), 1, max_size);
+		};
+	return { fit(width), fit(height) };
+}
+
+std::size_t tilia::Mip_Generator::Get_Level_Count(std::int32_t width, std::int32_t height)
+{
+	std::size_t count{};
+	for (std::int32_t size{ std::max(width, height) }; size > 1; size >>= 1)
+		++count;
+	return count;
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+/**
+ * @brief Makes an image of the given size where every texel is given by the function.
+ */
+template<typename Func>
+static tilia::Image Make_Image(std::int32_t width, std::int32_t height,
+	tilia::enums::Image_Channels channels, Func&& function)
+{
+	const std::size_t channel_count{ static_cast<std::size_t>(*channels) };
+	std::vector<std::uint8_t> data(static_cast<std::size_t>(width) * height * channel_count);
+	for (std::int32_t y{ 0 }; y < height; ++y)
+		for (std::int32_t x{ 0 }; x < width; ++x)
+			for (std::size_t c{ 0 }; c < channel_count; ++c)
+				data[(y * width + x) * channel_count + c] = function(x, y, c);
+	return { data.data(), width, height, channels, tilia::enums::Image_Data_Type::Unsigned_Byte };
+}
+
+void tilia::Mip_Generator::Test()
+{
+
+	// Test the sizes and amount of levels
+
+	REQUIRE(Get_Level_Count(1, 1) == 0);
+	REQUIRE(Get_Level_Count(4, 4) == 2);
+	REQUIRE(Get_Level_Count(5, 3) == 2);
+	REQUIRE(Get_Level_Count(256, 16) == 8);
+
+	const Image flat{ Make_Image(5, 3, enums::Image_Channels::RGB,
+		[](std::int32_t, std::int32_t, std::size_t c) { return static_cast<std::uint8_t>(
+			40 + 80 * c); }) };
+
+	for (const auto filter : { enums::Mip_Filter::Box, enums::Mip_Filter::Kaiser })
+	{
+		const auto levels{ Generate(flat, { filter, true }) };
+
+		REQUIRE(levels.size() == 2);
+		REQUIRE(levels[0].Width() == 2);
+		REQUIRE(levels[0].Height() == 1);
+		REQUIRE(levels[1].Width() == 1);
+		REQUIRE(levels[1].Height() == 1);
+		REQUIRE(levels[1].Channels() == enums::Image_Channels::RGB);
+
+		// Flat images stay flat whatever the filter
+		for (const auto& level : levels)
+			for (std::int32_t i{ 0 }; i < level.Width() * level.Height() * 3; ++i)
+				REQUIRE(level.Get_Data()[i] == 40 + 80 * (i % 3));
+	}
+
+	Mip_Settings settings{};
+	settings.level_count = 1;
+
+	REQUIRE(Generate(Image{ Make_Image(64, 64, enums::Image_Channels::Grey,
+		[](std::int32_t, std::int32_t, std::size_t) { return std::uint8_t{ 0 }; }) },
+		settings).size() == 1);
+
+	// Test that black and white average to grey, in linear space for sRGB images
+
+	const Image checker{ Make_Image(8, 8, enums::Image_Channels::Grey_Alpha,
+		[](std::int32_t x, std::int32_t y, std::size_t c) { return static_cast<std::uint8_t>(
+			c == 1 ? 255 : ((x + y) % 2) * 255); }) };
+
+	const auto linear_levels{ Generate(checker) };
+	REQUIRE(std::abs(linear_levels[0].Get_Data()[0] - 128) <= 1);
+	REQUIRE(linear_levels[0].Get_Data()[1] == 255);
+
+	settings = {};
+	settings.srgb = true;
+	const auto srgb_levels{ Generate(checker, settings) };
+	// Half of the light of white is 188 in sRGB, alpha stays linear
+	REQUIRE(std::abs(srgb_levels[0].Get_Data()[0] - 188) <= 1);
+	REQUIRE(srgb_levels[0].Get_Data()[1] == 255);
+
+	// Test that the Kaiser filter keeps more contrast than the box filter
+
+	const Image stripes{ Make_Image(64, 64, enums::Image_Channels::Grey,
+		[](std::int32_t x, std::int32_t, std::size_t) { return static_cast<std::uint8_t>(
+			(x / 3) % 2 * 255); }) };
+
+	// The mean distance from grey, which blurring lowers
+	const auto get_contrast = [](const Image& level)
+		{
+			float sum{};
+			for (std::int32_t i{ 0 }; i < level.Size(); ++i)
+				sum += std::abs(static_cast<float>(level.Get_Data()[i]) - 127.5f);
+			return sum / static_cast<float>(level.Size());
+		};
+
+	settings = {};
+	const auto box_levels{ Generate(stripes, settings) };
+	settings.filter = enums::Mip_Filter::Kaiser;
+	const auto kaiser_levels{ Generate(stripes, settings) };
+
+	REQUIRE(get_contrast(kaiser_levels[0]) > get_contrast(box_levels[0]));
+
+	// Test that alpha coverage is kept
+
+	std::uint32_t seed{ 12345 };
+	const Image cutout{ Make_Image(128, 128, enums::Image_Channels::RGBA,
+		[&seed](std::int32_t, std::int32_t, std::size_t c)
+		{
+			seed = seed * 1664525 + 1013904223;
+			return static_cast<std::uint8_t>(c == 3 ? (seed >> 24) * 180 / 255 : 200);
+		}) };
+
+	const auto get_coverage = [](const Image& level)
+		{
+			std::size_t passing{};
+			for (std::int32_t i{ 3 }; i < level.Size(); i += 4)
+				passing += level.Get_Data()[i] >= 128;
+			return static_cast<float>(passing) / static_cast<float>(level.Size() / 4);
+		};
+
+	const float coverage{ get_coverage(cutout) };
+	REQUIRE(coverage > 0.2f);
+
+	settings = {};
+	const auto thinned_levels{ Generate(cutout, settings) };
+	settings.alpha_cutoff = 128.0f / 255.0f;
+	const auto kept_levels{ Generate(cutout, settings) };
+
+	REQUIRE(get_coverage(thinned_levels[2]) < coverage - 0.1f);
+	for (std::size_t i{ 0 }; i < 4; ++i)
+		REQUIRE(std::abs(get_coverage(kept_levels[i]) - coverage) < 0.05f);
+
+	// Test float images
+
+	std::vector<float> values(16 * 16 * 4, 3.5f);
+	const Image hdr{ reinterpret_cast<std::uint8_t*>(values.data()), 16, 16,
+		enums::Image_Channels::RGBA, enums::Image_Data_Type::Float };
+
+	const auto hdr_levels{ Generate(hdr, { enums::Mip_Filter::Kaiser }) };
+	REQUIRE(hdr_levels.size() == 4);
+	REQUIRE(hdr_levels.back().Data_Type() == enums::Image_Data_Type::Float);
+	for (const auto& level : hdr_levels)
+	{
+		const float* texels{ reinterpret_cast<const float*>(level.Get_Data()) };
+		for (std::int32_t i{ 0 }; i < level.Width() * level.Height() * 4; ++i)
+			REQUIRE(std::abs(texels[i] - 3.5f) < 1e-4f);
+	}
+
+	// Test resizing
+
+	REQUIRE(Get_Fit_Size(4096, 2048, 1024) == std::pair<std::int32_t, std::int32_t>{ 1024, 512 });
+	REQUIRE(Get_Fit_Size(100, 50, 0) == std::pair<std::int32_t, std::int32_t>{ 100, 50 });
+	REQUIRE(Get_Fit_Size(100, 50, 200) == std::pair<std::int32_t, std::int32_t>{ 100, 50 });
+	REQUIRE(Get_Fit_Size(3, 1000, 10) == std::pair<std::int32_t, std::int32_t>{ 1, 10 });
+
+	for (const auto filter : { enums::Mip_Filter::Box, enums::Mip_Filter::Kaiser })
+	{
+		// Flat images stay flat whatever the scale
+		const Image resized{ Resize(flat, 3, 2, { filter }) };
+
+		REQUIRE(resized.Width() == 3);
+		REQUIRE(resized.Height() == 2);
+		for (std::int32_t i{ 0 }; i < resized.Size(); ++i)
+			REQUIRE(resized.Get_Data()[i] == 40 + 80 * (i % 3));
+	}
+
+	// Halving is the same as generating the first level
+	REQUIRE(Resize(checker, 4, 4) == linear_levels[0]);
+	REQUIRE(Resize(checker, 4, 4, { enums::Mip_Filter::Box, true }) == srgb_levels[0]);
+
+	// Scales which are not powers of two still average black and white to grey
+	const Image thirds{ Resize(checker, 3, 3) };
+	for (std::int32_t i{ 0 }; i < thirds.Size(); i += 2)
+		REQUIRE(std::abs(thirds.Get_Data()[i] - 128) <= 16);
+
+	// Images already of the size are shared
+	REQUIRE(Resize(checker, 8, 8).Share_Data() == checker.Share_Data());
+	REQUIRE(Fit(checker, 16).Share_Data() == checker.Share_Data());
+
+	const Image fitted{ Fit(hdr, 5, { enums::Mip_Filter::Kaiser }) };
+	REQUIRE(fitted.Width() == 5);
+	REQUIRE(fitted.Height() == 5);
+	REQUIRE(fitted.Data_Type() == enums::Image_Data_Type::Float);
+	REQUIRE(std::abs(reinterpret_cast<const float*>(fitted.Get_Data())[0] - 3.5f) < 1e-4f);
+
+	REQUIRE_THROWS(Resize(checker, 9, 8));
+	REQUIRE_THROWS(Resize(checker, 0, 8));
+	REQUIRE_THROWS(Fit(Image{}, 8));
+
+	// Test that levels are the same when filtered as jobs
+
+	jobs::Job_System& job_system{ jobs::Job_System::Instance() };
+	job_system.Init(3);
+
+	const Image large{ Make_Image(256, 200, enums::Image_Channels::RGBA,
+		[](std::int32_t x, std::int32_t y, std::size_t c) { return static_cast<std::uint8_t>(
+			(x * 7 + y * 13 + static_cast<std::int32_t>(c) * 31) % 256); }) };
+
+	settings = {};
+	settings.filter = enums::Mip_Filter::Kaiser;
+	settings.srgb = true;
+	settings.alpha_cutoff = 0.5f;
+
+	const auto parallel_levels{ Generate(large, settings) };
+	const Image parallel_fitted{ Fit(large, 100, settings) };
+
+	job_system.Terminate();
+
+	const auto serial_levels{ Generate(large, settings) };
+
+	REQUIRE(parallel_fitted == Fit(large, 100, settings));
+
+	REQUIRE(parallel_levels.size() == serial_levels.size());
+	for (std::size_t i{ 0 }; i < serial_levels.size(); ++i)
+		REQUIRE(parallel_levels[i] == serial_levels[i]);
+
+	// Test empty images
+
+	REQUIRE_THROWS(Generate(Image{}));
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
@@ -0,0 +1,140 @@
+/**************************************************************************************************
+ * @file   Mip_Generator.hpp
+ *
+ * @brief  Generates the mip levels of images on the CPU. Texels are filtered in linear space,
+ *		   sRGB images being linearized first, with either a box or a Kaiser filter, and the
+ *		   alpha coverage of cutout images can be kept the same through every level. Rows of
+ *		   each level are filtered on the workers of the job system, so that mips can be baked
+ *		   into texture containers ahead of time instead of being generated by openGL. Images
+ *		   may also be resized down with the same filters, such as to fit a resolution budget
+ *		   when loaded.
+ *
+ * @author Gustav Fagerlind
+ * @date   19/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_MIP_GENERATOR_HPP
+#define TILIA_MIP_GENERATOR_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_IMAGE_INCLUDE
+
+namespace tilia
+{
+	namespace enums
+	{
+		// The filters mip levels can be generated with.
+		enum class Mip_Filter
+		{
+			// Averages the texels covered by each texel of the level. Fast but blurry.
+			Box,
+			// A windowed sinc, which keeps levels sharper than the box filter does.
+			Kaiser
+		}; // Mip_Filter
+	} // enums
+
+	/**
+	 * @brief How the mip levels of an image are generated, or how an image is resized.
+	 */
+	struct Mip_Settings
+	{
+		enums::Mip_Filter filter{ enums::Mip_Filter::Box };
+		// Whether or not the color channels of byte images are sRGB encoded. If so they are
+		// filtered in linear space and encoded again afterwards, alpha is always linear.
+		bool srgb{ false };
+		// The alpha from which texels are drawn when alpha tested. If above 0 the alpha of every
+		// level is scaled so that as many of its texels pass as of the image, keeping cutouts
+		// such as foliage from thinning out in the distance.
+		float alpha_cutoff{ 0.0f };
+		// The amount of levels to generate below the image, 0 for every level down to 1x1. Not
+		// used when resizing.
+		std::size_t level_count{ 0 };
+	}; // Mip_Settings
+
+	/**
+	 * @brief Generates mip levels of images. Can be used from any thread, and runs the rows of
+	 * each level as jobs when the calling thread may run jobs.
+	 */
+	class Mip_Generator
+	{
+	public:
+
+		/**
+		 * @brief Generates the mip levels below the given image, each level half the size of
+		 * the one above it, rounded down, and at least 1x1.
+		 *
+		 * @param image - The image to generate the levels of.
+		 * @param settings - How to generate the levels.
+		 *
+		 * @return The levels in order, the image itself not included. Each level has the same
+		 * channels and data type as the image.
+		 *
+		 * @exception The image is empty.
+		 */
+		static std::vector<Image> Generate(const Image& image, const Mip_Settings& settings = {});
+
+		/**
+		 * @brief Resizes an image down to the given size in a single pass of the separable
+		 * filter, however many times smaller the size is.
+		 *
+		 * @param image - The image to resize.
+		 * @param width - The width to resize the image to, at most that of the image.
+		 * @param height - The height to resize the image to, at most that of the image.
+		 * @param settings - How to filter the image.
+		 *
+		 * @return The resized image, of the same channels and data type as the image. The
+		 * image itself, sharing its data, if it is already of the size.
+		 *
+		 * @exception The image is empty or the size is not within that of the image.
+		 */
+		static Image Resize(const Image& image, std::int32_t width, std::int32_t height,
+			const Mip_Settings& settings = {});
+
+		/**
+		 * @brief Resizes an image down so that its largest side is at most the given max size,
+		 * keeping its aspect ratio. See Resize.
+		 *
+		 * @param max_size - The largest side in texels of the image, 0 for no limit.
+		 *
+		 * @exception The image is empty.
+		 */
+		static Image Fit(const Image& image, std::int32_t max_size,
+			const Mip_Settings& settings = {});
+
+		/**
+		 * @brief Gets the amount of levels below an image of the given size down to 1x1.
+		 */
+		static std::size_t Get_Level_Count(std::int32_t width, std::int32_t height);
+
+		/**
+		 * @brief Gets the size an image of the given size is resized to by Fit.
+		 *
+		 * @return The width and height, at least 1x1.
+		 */
+		static std::pair<std::int32_t, std::int32_t> Get_Fit_Size(std::int32_t width,
+			std::int32_t height, std::int32_t max_size);
+
+#if TILIA_UNIT_TESTS == 1
+
+		/**
+		 * @brief Unit test for Mip_Generator.
+		 */
+		static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		// Mip_Generator shan't be constructed
+		Mip_Generator() = delete;
+
+	}; // Mip_Generator
+
+} // tilia
+
+#endif // TILIA_MIP_GENERATOR_HPP
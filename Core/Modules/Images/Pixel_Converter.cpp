@@ -0,0 +1,989 @@
+// Standard
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// Tilia
+#include "Pixel_Converter.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+
+#if TILIA_F16C == 1
+// Standard
+#include <immintrin.h>
+#elif TILIA_SSE2 == 1
+// Standard
+#include <emmintrin.h>
+#endif // TILIA_F16C == 1
+
+static constexpr std::size_t NO_ALPHA{ std::numeric_limits<std::size_t>::max() };
+
+// The amount of values converted at a time when going through 32 bit floats
+static constexpr std::size_t CHUNK_SIZE{ 256 };
+
+// The smallest linear value with an sRGB encoding of its own, smaller ones all encode to 0, and
+// the amount of mantissa bits the encoding table is indexed by
+static constexpr std::uint32_t ENCODE_MIN_BITS{ (127 - 13) << 23 };
+static constexpr std::uint32_t ENCODE_MANTISSA_BITS{ 8 };
+// Every exponent from the smallest value up to 1, each split by the mantissa bits
+static constexpr std::size_t ENCODE_TABLE_SIZE{ 13 << ENCODE_MANTISSA_BITS };
+
+static std::size_t Get_Alpha_Channel(std::size_t channels)
+{
+	return channels == 2 || channels == 4 ? channels - 1 : NO_ALPHA;
+}
+
+static std::uint32_t To_Bits(float value)
+{
+	std::uint32_t bits{};
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+static float To_Float(std::uint32_t bits)
+{
+	float value{};
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+static double Srgb_To_Linear_Exact(double value)
+{
+	return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+}
+
+static const std::array<float, 256>& Get_Linear_Table()
+{
+	static const std::array<float, 256> table{ []()
+		{
+			std::array<float, 256> values{};
+			for (std::size_t i{ 0 }; i < values.size(); ++i)
+				values[i] = static_cast<float>(Srgb_To_Linear_Exact(i / 255.0));
+			return values;
+		}() };
+	return table;
+}
+
+/**
+ * @brief Gets the linear values from which every sRGB value is the closest encoding, halfway
+ * between it and the value below it. The last one is never reached.
+ */
+static const std::array<float, 256>& Get_Encode_Thresholds()
+{
+	static const std::array<float, 256> table{ []()
+		{
+			std::array<float, 256> values{};
+			for (std::size_t i{ 0 }; i < 255; ++i)
+				values[i] = static_cast<float>(Srgb_To_Linear_Exact((i + 0.5) / 255.0));
+			values[255] = std::numeric_limits<float>::infinity();
+			return values;
+		}() };
+	return table;
+}
+
+/**
+ * Holds the encoding of the smallest value of every range of linear values sharing an exponent
+ * and the top bits of their mantissa. Ranges are narrow enough that at most one threshold lies
+ * within each, so the encoding of any value is that of its range or the one after it.
+ */
+static const std::array<std::uint8_t, ENCODE_TABLE_SIZE>& Get_Encode_Table()
+{
+	static const std::array<std::uint8_t, ENCODE_TABLE_SIZE> table{ []()
+		{
+			const auto& thresholds{ Get_Encode_Thresholds() };
+			std::array<std::uint8_t, ENCODE_TABLE_SIZE> values{};
+			for (std::size_t i{ 0 }; i < values.size(); ++i)
+			{
+				const float value{ To_Float(ENCODE_MIN_BITS +
+					(static_cast<std::uint32_t>(i) << (23 - ENCODE_MANTISSA_BITS))) };
+				values[i] = static_cast<std::uint8_t>(std::upper_bound(thresholds.begin(),
+					thresholds.end(), value) - thresholds.begin());
+			}
+			return values;
+		}() };
+	return table;
+}
+
+static std::uint8_t To_Byte(float value)
+{
+	// Written so that NaN becomes 0
+	value = value > 0.0f ? value : 0.0f;
+	value = value < 1.0f ? value : 1.0f;
+	return static_cast<std::uint8_t>(value * 255.0f + 0.5f);
+}
+
+float tilia::Pixel_Converter::Half_To_Float(std::uint16_t value)
+{
+
+	constexpr std::uint32_t shifted_exponent{ 0x7C00 << 13 };
+
+	std::uint32_t bits{ static_cast<std::uint32_t>(value & 0x7FFF) << 13 };
+	const std::uint32_t exponent{ bits & shifted_exponent };
+	bits += (127 - 15) << 23;
+
+	if (exponent == shifted_exponent)
+	{
+		// Infinity and NaN keep every exponent bit set
+		bits += (128 - 16) << 23;
+	}
+	else if (exponent == 0)
+	{
+		// Subnormals are normalized by letting the float unit subtract the implicit one
+		bits += 1 << 23;
+		bits = To_Bits(To_Float(bits) - To_Float(113 << 23));
+	}
+
+	return To_Float(bits | static_cast<std::uint32_t>(value & 0x8000) << 16);
+
+}
+
+/**
+ * Values which become subnormal are rounded by adding a float lining their mantissa bits up with
+ * the bottom of the mantissa, and the rest are rounded by adding half an ulp, less for even
+ * mantissas so that ties go to even.
+ */
+std::uint16_t tilia::Pixel_Converter::Float_To_Half(float value)
+{
+
+	constexpr std::uint32_t infinity{ 255 << 23 };
+	constexpr std::uint32_t half_max{ (127 + 16) << 23 };
+	constexpr std::uint32_t subnormal_magic{ ((127 - 15) + (23 - 10) + 1) << 23 };
+
+	std::uint32_t bits{ To_Bits(value) };
+	const std::uint32_t sign{ bits & 0x80000000 };
+	bits ^= sign;
+
+	std::uint32_t half{};
+	if (bits >= half_max)
+	{
+		half = bits > infinity ? 0x7E00 : 0x7C00;
+	}
+	else if (bits < (113 << 23))
+	{
+		half = To_Bits(To_Float(bits) + To_Float(subnormal_magic)) - subnormal_magic;
+	}
+	else
+	{
+		const std::uint32_t odd{ (bits >> 13) & 1 };
+		bits -= (127 - 15) << 23;
+		bits += 0xFFF + odd;
+		half = bits >> 13;
+	}
+
+	return static_cast<std::uint16_t>(half | sign >> 16);
+
+}
+
+float tilia::Pixel_Converter::Srgb_To_Linear(std::uint8_t value)
+{
+	return Get_Linear_Table()[value];
+}
+
+std::uint8_t tilia::Pixel_Converter::Linear_To_Srgb(float value)
+{
+	constexpr std::uint32_t max_bits{ (127 << 23) - 1 };
+	const auto& thresholds{ Get_Encode_Thresholds() };
+	// Written so that NaN becomes 0
+	value = value > To_Float(ENCODE_MIN_BITS) ? value : To_Float(ENCODE_MIN_BITS);
+	value = value < To_Float(max_bits) ? value : To_Float(max_bits);
+	const std::uint8_t encoded{ Get_Encode_Table()[(To_Bits(value) - ENCODE_MIN_BITS) >>
+		(23 - ENCODE_MANTISSA_BITS)] };
+	return static_cast<std::uint8_t>(encoded + (value >= thresholds[encoded]));
+}
+
+/**
+ * @brief Converts texels of any channel count to any other one value at a time.
+ */
+template<typename T, typename Luma>
+static void Convert_Channels_Generic(const T* source, std::size_t source_channels,
+	T* destination, std::size_t channels, std::size_t count, T one, Luma&& luma)
+{
+
+	const std::size_t source_alpha{ Get_Alpha_Channel(source_channels) };
+	const std::size_t alpha{ Get_Alpha_Channel(channels) };
+
+	for (std::size_t i{ 0 }; i < count; ++i)
+	{
+		const T* texel{ source + i * source_channels };
+		T* converted{ destination + i * channels };
+
+		if (channels <= 2)
+		{
+			converted[0] = source_channels <= 2 ? texel[0] : luma(texel[0], texel[1], texel[2]);
+		}
+		else
+		{
+			for (std::size_t c{ 0 }; c < 3; ++c)
+				converted[c] = source_channels <= 2 ? texel[0] : texel[c];
+		}
+
+		if (alpha != NO_ALPHA)
+			converted[alpha] = source_alpha != NO_ALPHA ? texel[source_alpha] : one;
+	}
+
+}
+
+void tilia::Pixel_Converter::Convert_Channels(const std::uint8_t* source,
+	std::size_t source_channels, std::uint8_t* destination, std::size_t channels,
+	std::size_t count)
+{
+
+	if (source_channels == channels)
+	{
+		std::memcpy(destination, source, count * channels);
+		return;
+	}
+
+	std::size_t i{ 0 };
+
+	if (source_channels == 3 && channels == 4 && count > 0)
+	{
+		// Texels are read as little endian words, the fourth byte belonging to the next texel
+		// and being overwritten by alpha. The last texel has no fourth byte to read.
+		for (; i + 1 < count; ++i)
+		{
+			std::uint32_t texel{};
+			std::memcpy(&texel, source + i * 3, sizeof(texel));
+			texel |= 0xFF000000;
+			std::memcpy(destination + i * 4, &texel, sizeof(texel));
+		}
+	}
+	else if (source_channels == 4 && channels == 3 && count > 0)
+	{
+		// Whole texels are written, alpha being overwritten by the next texel. The last texel has
+		// no room for its alpha.
+		for (; i + 1 < count; ++i)
+			std::memcpy(destination + i * 3, source + i * 4, 4);
+	}
+
+#if TILIA_SSE2 == 1
+
+	else if (source_channels == 1 && channels == 4)
+	{
+		const __m128i alpha{ _mm_set1_epi32(static_cast<int>(0xFF000000)) };
+		for (; i + 16 <= count; i += 16)
+		{
+			const __m128i grey{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)) };
+			const __m128i low{ _mm_unpacklo_epi8(grey, grey) };
+			const __m128i high{ _mm_unpackhi_epi8(grey, grey) };
+			__m128i* texels{ reinterpret_cast<__m128i*>(destination + i * 4) };
+			_mm_storeu_si128(texels + 0, _mm_or_si128(_mm_unpacklo_epi16(low, low), alpha));
+			_mm_storeu_si128(texels + 1, _mm_or_si128(_mm_unpackhi_epi16(low, low), alpha));
+			_mm_storeu_si128(texels + 2, _mm_or_si128(_mm_unpacklo_epi16(high, high), alpha));
+			_mm_storeu_si128(texels + 3, _mm_or_si128(_mm_unpackhi_epi16(high, high), alpha));
+		}
+	}
+	else if (source_channels == 2 && channels == 4)
+	{
+		const __m128i low_bytes{ _mm_set1_epi16(0x00FF) };
+		for (; i + 8 <= count; i += 8)
+		{
+			// Every 16 bits hold a grey and its alpha
+			const __m128i grey_alpha{ _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>(source + i * 2)) };
+			const __m128i grey{ _mm_and_si128(grey_alpha, low_bytes) };
+			const __m128i grey_grey{ _mm_or_si128(grey, _mm_slli_epi16(grey, 8)) };
+			__m128i* texels{ reinterpret_cast<__m128i*>(destination + i * 4) };
+			_mm_storeu_si128(texels + 0, _mm_unpacklo_epi16(grey_grey, grey_alpha));
+			_mm_storeu_si128(texels + 1, _mm_unpackhi_epi16(grey_grey, grey_alpha));
+		}
+	}
+
+#endif // TILIA_SSE2 == 1
+
+	Convert_Channels_Generic(source + i * source_channels, source_channels,
+		destination + i * channels, channels, count - i, std::uint8_t{ 255 },
+		[](std::uint32_t r, std::uint32_t g, std::uint32_t b)
+		{ return static_cast<std::uint8_t>((54 * r + 183 * g + 19 * b + 128) >> 8); });
+
+}
+
+void tilia::Pixel_Converter::Convert_Channels(const float* source, std::size_t source_channels,
+	float* destination, std::size_t channels, std::size_t count)
+{
+
+	if (source_channels == channels)
+	{
+		std::memcpy(destination, source, count * channels * sizeof(float));
+		return;
+	}
+
+	Convert_Channels_Generic(source, source_channels, destination, channels, count, 1.0f,
+		[](float r, float g, float b) { return 0.2126f * r + 0.7152f * g + 0.0722f * b; });
+
+}
+
+void tilia::Pixel_Converter::U8_To_F32(const std::uint8_t* source, float* destination,
+	std::size_t count)
+{
+
+	constexpr float scale{ 1.0f / 255.0f };
+
+	std::size_t i{ 0 };
+
+#if TILIA_SSE2 == 1
+
+	const __m128i zero{ _mm_setzero_si128() };
+	const __m128 scales{ _mm_set1_ps(scale) };
+	for (; i + 16 <= count; i += 16)
+	{
+		const __m128i bytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)) };
+		const __m128i words[2]{ _mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero) };
+		for (std::size_t j{ 0 }; j < 2; ++j)
+		{
+			_mm_storeu_ps(destination + i + j * 8, _mm_mul_ps(_mm_cvtepi32_ps(
+				_mm_unpacklo_epi16(words[j], zero)), scales));
+			_mm_storeu_ps(destination + i + j * 8 + 4, _mm_mul_ps(_mm_cvtepi32_ps(
+				_mm_unpackhi_epi16(words[j], zero)), scales));
+		}
+	}
+
+#endif // TILIA_SSE2 == 1
+
+	for (; i < count; ++i)
+		destination[i] = static_cast<float>(source[i]) * scale;
+
+}
+
+void tilia::Pixel_Converter::F32_To_U8(const float* source, std::uint8_t* destination,
+	std::size_t count)
+{
+
+	std::size_t i{ 0 };
+
+#if TILIA_SSE2 == 1
+
+	const __m128 zero{ _mm_setzero_ps() };
+	const __m128 one{ _mm_set1_ps(1.0f) };
+	const __m128 max{ _mm_set1_ps(255.0f) };
+	const __m128 half{ _mm_set1_ps(0.5f) };
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i values[4]{};
+		for (std::size_t j{ 0 }; j < 4; ++j)
+		{
+			// The value is the first operand of max so that NaN becomes 0
+			const __m128 value{ _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i + j * 4), zero),
+				one) };
+			values[j] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, max), half));
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(
+			_mm_packs_epi32(values[0], values[1]), _mm_packs_epi32(values[2], values[3])));
+	}
+
+#endif // TILIA_SSE2 == 1
+
+	for (; i < count; ++i)
+		destination[i] = To_Byte(source[i]);
+
+}
+
+void tilia::Pixel_Converter::F32_To_F16(const float* source, std::uint16_t* destination,
+	std::size_t count)
+{
+
+	std::size_t i{ 0 };
+
+#if TILIA_F16C == 1
+
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(destination + i),
+			_mm_cvtps_ph(_mm_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT));
+	}
+
+#elif TILIA_SSE2 == 1
+
+	// The same as Float_To_Half with both of its paths taken and the right one picked per value
+	const __m128i sign_mask{ _mm_set1_epi32(static_cast<int>(0x80000000)) };
+	const __m128i infinity{ _mm_set1_epi32(255 << 23) };
+	const __m128i half_max{ _mm_set1_epi32(((127 + 16) << 23) - 1) };
+	const __m128i normal_min{ _mm_set1_epi32(113 << 23) };
+	const __m128i subnormal_magic{ _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23) };
+	const __m128i rebias{ _mm_set1_epi32(0xFFF - ((127 - 15) << 23)) };
+	const __m128i one{ _mm_set1_epi32(1) };
+	const __m128i nan{ _mm_set1_epi32(0x7E00) };
+	const __m128i inf{ _mm_set1_epi32(0x7C00) };
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i halves[2]{};
+		for (std::size_t j{ 0 }; j < 2; ++j)
+		{
+			__m128i bits{ _mm_castps_si128(_mm_loadu_ps(source + i + j * 4)) };
+			const __m128i sign{ _mm_and_si128(bits, sign_mask) };
+			bits = _mm_xor_si128(bits, sign);
+
+			const __m128i subnormal{ _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(
+				_mm_castsi128_ps(bits), _mm_castsi128_ps(subnormal_magic))), subnormal_magic) };
+			const __m128i odd{ _mm_and_si128(_mm_srli_epi32(bits, 13), one) };
+			const __m128i normal{ _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(bits, rebias),
+				odd), 13) };
+
+			const __m128i is_subnormal{ _mm_cmplt_epi32(bits, normal_min) };
+			__m128i half{ _mm_or_si128(_mm_and_si128(is_subnormal, subnormal),
+				_mm_andnot_si128(is_subnormal, normal)) };
+
+			const __m128i is_nan{ _mm_cmpgt_epi32(bits, infinity) };
+			const __m128i special{ _mm_or_si128(_mm_and_si128(is_nan, nan),
+				_mm_andnot_si128(is_nan, inf)) };
+			const __m128i is_special{ _mm_cmpgt_epi32(bits, half_max) };
+			half = _mm_or_si128(_mm_and_si128(is_special, special),
+				_mm_andnot_si128(is_special, half));
+
+			half = _mm_or_si128(half, _mm_srli_epi32(sign, 16));
+			// Sign extended so that packing keeps every bit
+			halves[j] = _mm_srai_epi32(_mm_slli_epi32(half, 16), 16);
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i),
+			_mm_packs_epi32(halves[0], halves[1]));
+	}
+
+#endif // TILIA_F16C == 1
+
+	for (; i < count; ++i)
+		destination[i] = Float_To_Half(source[i]);
+
+}
+
+void tilia::Pixel_Converter::F16_To_F32(const std::uint16_t* source, float* destination,
+	std::size_t count)
+{
+
+	std::size_t i{ 0 };
+
+#if TILIA_F16C == 1
+
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm_storeu_ps(destination + i, _mm_cvtph_ps(
+			_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i))));
+	}
+
+#elif TILIA_SSE2 == 1
+
+	// The same as Half_To_Float with both of its paths taken and the right one picked per value
+	const __m128i zero{ _mm_setzero_si128() };
+	const __m128i magnitude_mask{ _mm_set1_epi32(0x7FFF) };
+	const __m128i sign_mask{ _mm_set1_epi32(0x8000) };
+	const __m128i shifted_exponent{ _mm_set1_epi32(0x7C00 << 13) };
+	const __m128i rebias{ _mm_set1_epi32((127 - 15) << 23) };
+	const __m128i special_rebias{ _mm_set1_epi32((128 - 16) << 23) };
+	const __m128i implicit_one{ _mm_set1_epi32(1 << 23) };
+	const __m128 subnormal_magic{ _mm_castsi128_ps(_mm_set1_epi32(113 << 23)) };
+
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m128i words{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)) };
+		const __m128i halves[2]{ _mm_unpacklo_epi16(words, zero),
+			_mm_unpackhi_epi16(words, zero) };
+		for (std::size_t j{ 0 }; j < 2; ++j)
+		{
+			__m128i bits{ _mm_slli_epi32(_mm_and_si128(halves[j], magnitude_mask), 13) };
+			const __m128i exponent{ _mm_and_si128(bits, shifted_exponent) };
+			bits = _mm_add_epi32(bits, rebias);
+
+			const __m128i is_special{ _mm_cmpeq_epi32(exponent, shifted_exponent) };
+			bits = _mm_add_epi32(bits, _mm_and_si128(is_special, special_rebias));
+
+			const __m128i is_subnormal{ _mm_cmpeq_epi32(exponent, zero) };
+			const __m128i subnormal{ _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(
+				_mm_add_epi32(bits, implicit_one)), subnormal_magic)) };
+			bits = _mm_or_si128(_mm_and_si128(is_subnormal, subnormal),
+				_mm_andnot_si128(is_subnormal, bits));
+
+			bits = _mm_or_si128(bits, _mm_slli_epi32(_mm_and_si128(halves[j], sign_mask), 16));
+			_mm_storeu_ps(destination + i + j * 4, _mm_castsi128_ps(bits));
+		}
+	}
+
+#endif // TILIA_F16C == 1
+
+	for (; i < count; ++i)
+		destination[i] = Half_To_Float(source[i]);
+
+}
+
+void tilia::Pixel_Converter::U8_To_F16(const std::uint8_t* source, std::uint16_t* destination,
+	std::size_t count)
+{
+	float values[CHUNK_SIZE]{};
+	for (std::size_t i{ 0 }; i < count; i += CHUNK_SIZE)
+	{
+		const std::size_t chunk{ std::min(CHUNK_SIZE, count - i) };
+		U8_To_F32(source + i, values, chunk);
+		F32_To_F16(values, destination + i, chunk);
+	}
+}
+
+void tilia::Pixel_Converter::F16_To_U8(const std::uint16_t* source, std::uint8_t* destination,
+	std::size_t count)
+{
+	float values[CHUNK_SIZE]{};
+	for (std::size_t i{ 0 }; i < count; i += CHUNK_SIZE)
+	{
+		const std::size_t chunk{ std::min(CHUNK_SIZE, count - i) };
+		F16_To_F32(source + i, values, chunk);
+		F32_To_U8(values, destination + i, chunk);
+	}
+}
+
+void tilia::Pixel_Converter::Srgb_To_Linear(const std::uint8_t* source, float* destination,
+	std::size_t count, std::size_t channels)
+{
+
+	const auto& table{ Get_Linear_Table() };
+	const std::size_t alpha{ Get_Alpha_Channel(channels) };
+
+	for (std::size_t i{ 0 }; i < count; ++i)
+	{
+		for (std::size_t c{ 0 }; c < channels; ++c)
+		{
+			const std::uint8_t value{ source[i * channels + c] };
+			destination[i * channels + c] = c == alpha ?
+				static_cast<float>(value) * (1.0f / 255.0f) : table[value];
+		}
+	}
+
+}
+
+void tilia::Pixel_Converter::Linear_To_Srgb(const float* source, std::uint8_t* destination,
+	std::size_t count, std::size_t channels)
+{
+
+	const std::size_t alpha{ Get_Alpha_Channel(channels) };
+
+	for (std::size_t i{ 0 }; i < count; ++i)
+	{
+		for (std::size_t c{ 0 }; c < channels; ++c)
+		{
+			const float value{ source[i * channels + c] };
+			destination[i * channels + c] = c == alpha ? To_Byte(value) : Linear_To_Srgb(value);
+		}
+	}
+
+}
+
+/**
+ * Color is multiplied by alpha and divided by 255 rounding to nearest, the division being done
+ * as (x + (x >> 8)) >> 8 after adding half of 255, which is exact for every product of bytes.
+ */
+void tilia::Pixel_Converter::Premultiply_Alpha(std::uint8_t* texels, std::size_t count,
+	std::size_t channels)
+{
+
+	const std::size_t alpha{ Get_Alpha_Channel(channels) };
+	if (alpha == NO_ALPHA)
+		return;
+
+	std::size_t i{ 0 };
+
+#if TILIA_SSE2 == 1
+
+	if (channels == 4)
+	{
+		const __m128i zero{ _mm_setzero_si128() };
+		const __m128i bias{ _mm_set1_epi16(128) };
+		const __m128i alpha_lanes{ _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0) };
+		// Alpha is multiplied by 255 so that it stays the same
+		const __m128i alpha_factor{ _mm_and_si128(alpha_lanes, _mm_set1_epi16(255)) };
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i* block{ reinterpret_cast<__m128i*>(texels + i * 4) };
+			const __m128i bytes{ _mm_loadu_si128(block) };
+			__m128i words[2]{ _mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero) };
+			for (auto& word : words)
+			{
+				// Every texel is 4 words, alpha is copied to all of them
+				__m128i factor{ _mm_shufflehi_epi16(_mm_shufflelo_epi16(word, 0xFF), 0xFF) };
+				factor = _mm_or_si128(_mm_andnot_si128(alpha_lanes, factor), alpha_factor);
+				const __m128i product{ _mm_add_epi16(_mm_mullo_epi16(word, factor), bias) };
+				word = _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+			}
+			_mm_storeu_si128(block, _mm_packus_epi16(words[0], words[1]));
+		}
+	}
+
+#endif // TILIA_SSE2 == 1
+
+	for (; i < count; ++i)
+	{
+		std::uint8_t* texel{ texels + i * channels };
+		for (std::size_t c{ 0 }; c < alpha; ++c)
+		{
+			const std::uint32_t product{ static_cast<std::uint32_t>(texel[c]) * texel[alpha] +
+				128 };
+			texel[c] = static_cast<std::uint8_t>((product + (product >> 8)) >> 8);
+		}
+	}
+
+}
+
+void tilia::Pixel_Converter::Premultiply_Alpha(float* texels, std::size_t count,
+	std::size_t channels)
+{
+
+	const std::size_t alpha{ Get_Alpha_Channel(channels) };
+	if (alpha == NO_ALPHA)
+		return;
+
+	for (std::size_t i{ 0 }; i < count; ++i)
+	{
+		float* texel{ texels + i * channels };
+		for (std::size_t c{ 0 }; c < alpha; ++c)
+			texel[c] *= texel[alpha];
+	}
+
+}
+
+static void Check_Order(std::size_t channels, const std::array<std::uint8_t, 4>& order)
+{
+	for (std::size_t c{ 0 }; c < channels; ++c)
+	{
+		if (order[c] >= channels)
+		{
+			throw tilia::utils::Tilia_Exception{ { TILIA_LOCATION,
+				"Swizzle source channel is out of range { Channel: ", c, ", Source: ",
+				static_cast<std::uint32_t>(order[c]), ", Channels: ", channels, " }" } };
+		}
+	}
+}
+
+template<typename T>
+static void Swizzle_Generic(T* texels, std::size_t count, std::size_t channels,
+	const std::array<std::uint8_t, 4>& order)
+{
+	for (std::size_t i{ 0 }; i < count; ++i)
+	{
+		T* texel{ texels + i * channels };
+		T source[4]{};
+		std::copy(texel, texel + channels, source);
+		for (std::size_t c{ 0 }; c < channels; ++c)
+			texel[c] = source[order[c]];
+	}
+}
+
+void tilia::Pixel_Converter::Swizzle(std::uint8_t* texels, std::size_t count,
+	std::size_t channels, const std::array<std::uint8_t, 4>& order)
+{
+
+	Check_Order(channels, order);
+
+	std::size_t i{ 0 };
+
+#if TILIA_SSE2 == 1
+
+	if (channels == 4)
+	{
+		// Every texel is a 32 bit lane, each of its channels is shifted down to the bottom,
+		// masked and shifted up to where it goes. The shifts are given in registers since the
+		// order is only known at run time.
+		const __m128i mask{ _mm_set1_epi32(0xFF) };
+		__m128i shifts_down[4]{};
+		__m128i shifts_up[4]{};
+		for (std::size_t c{ 0 }; c < 4; ++c)
+		{
+			shifts_down[c] = _mm_cvtsi32_si128(static_cast<int>(order[c]) * 8);
+			shifts_up[c] = _mm_cvtsi32_si128(static_cast<int>(c) * 8);
+		}
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i* block{ reinterpret_cast<__m128i*>(texels + i * 4) };
+			const __m128i source{ _mm_loadu_si128(block) };
+			__m128i swizzled{ _mm_setzero_si128() };
+			for (std::size_t c{ 0 }; c < 4; ++c)
+			{
+				swizzled = _mm_or_si128(swizzled, _mm_sll_epi32(_mm_and_si128(
+					_mm_srl_epi32(source, shifts_down[c]), mask), shifts_up[c]));
+			}
+			_mm_storeu_si128(block, swizzled);
+		}
+	}
+
+#endif // TILIA_SSE2 == 1
+
+	Swizzle_Generic(texels + i * channels, count - i, channels, order);
+
+}
+
+void tilia::Pixel_Converter::Swizzle(float* texels, std::size_t count, std::size_t channels,
+	const std::array<std::uint8_t, 4>& order)
+{
+	Check_Order(channels, order);
+	Swizzle_Generic(texels, count, channels, order);
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Standard
+#include <vector>
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+void tilia::Pixel_Converter::Test()
+{
+
+	// Test 16 bit floats
+
+	REQUIRE(Float_To_Half(1.0f) == 0x3C00);
+	REQUIRE(Float_To_Half(-2.0f) == 0xC000);
+	REQUIRE(Float_To_Half(65504.0f) == 0x7BFF);
+	REQUIRE(Float_To_Half(65520.0f) == 0x7C00);
+	REQUIRE(Float_To_Half(0.1f) == 0x2E66);
+	REQUIRE(Float_To_Half(6e-8f) == 0x0001);
+	REQUIRE(Float_To_Half(1e-8f) == 0x0000);
+	REQUIRE(Float_To_Half(std::numeric_limits<float>::infinity()) == 0x7C00);
+	REQUIRE(Float_To_Half(std::numeric_limits<float>::quiet_NaN()) == 0x7E00);
+	// 1 + 2^-11 lies halfway between two halves and goes to the even one
+	REQUIRE(Float_To_Half(1.00048828125f) == 0x3C00);
+
+	// Every half converts to a float and back again, and the kernels agree with the scalar
+	// conversions
+
+	std::vector<std::uint16_t> halves(1 << 16);
+	for (std::size_t i{ 0 }; i < halves.size(); ++i)
+		halves[i] = static_cast<std::uint16_t>(i);
+
+	std::vector<float> floats(halves.size());
+	F16_To_F32(halves.data(), floats.data(), halves.size());
+
+	std::vector<std::uint16_t> round_trip(halves.size());
+	F32_To_F16(floats.data(), round_trip.data(), floats.size());
+
+	std::size_t mismatches{};
+	for (std::size_t i{ 0 }; i < halves.size(); ++i)
+	{
+		// NaNs only have to stay NaN, F16C quiets signaling ones
+		if ((halves[i] & 0x7C00) == 0x7C00 && (halves[i] & 0x03FF) != 0)
+		{
+			mismatches += !std::isnan(floats[i]) || (round_trip[i] & 0x7FFF) <= 0x7C00;
+			continue;
+		}
+		mismatches += To_Bits(floats[i]) != To_Bits(Half_To_Float(halves[i]));
+		mismatches += round_trip[i] != halves[i];
+	}
+	REQUIRE(mismatches == 0);
+
+	std::vector<float> values(4099);
+	std::uint32_t seed{ 1 };
+	for (auto& value : values)
+	{
+		seed = seed * 1664525 + 1013904223;
+		value = To_Float(seed);
+	}
+	std::vector<std::uint16_t> converted(values.size());
+	F32_To_F16(values.data(), converted.data(), values.size());
+
+	mismatches = 0;
+	for (std::size_t i{ 0 }; i < values.size(); ++i)
+		mismatches += converted[i] != Float_To_Half(values[i]) && !std::isnan(values[i]);
+	REQUIRE(mismatches == 0);
+
+	// Test bytes to and from floats
+
+	std::vector<std::uint8_t> bytes(259);
+	for (std::size_t i{ 0 }; i < bytes.size(); ++i)
+		bytes[i] = static_cast<std::uint8_t>(i);
+
+	std::vector<float> byte_floats(bytes.size());
+	U8_To_F32(bytes.data(), byte_floats.data(), bytes.size());
+	REQUIRE(byte_floats[0] == 0.0f);
+	REQUIRE(std::abs(byte_floats[255] - 1.0f) < 1e-6f);
+	REQUIRE(std::abs(byte_floats[51] - 0.2f) < 1e-6f);
+
+	std::vector<std::uint8_t> byte_round_trip(bytes.size());
+	F32_To_U8(byte_floats.data(), byte_round_trip.data(), byte_floats.size());
+	REQUIRE(byte_round_trip == bytes);
+
+	std::vector<std::uint16_t> byte_halves(bytes.size());
+	U8_To_F16(bytes.data(), byte_halves.data(), bytes.size());
+	F16_To_U8(byte_halves.data(), byte_round_trip.data(), byte_halves.size());
+	REQUIRE(byte_round_trip == bytes);
+
+	std::vector<float> out_of_range(20, 2.0f);
+	out_of_range[0] = -1.0f;
+	out_of_range[1] = std::numeric_limits<float>::quiet_NaN();
+	out_of_range[19] = -1.0f;
+	out_of_range[2] = 0.5f;
+	std::vector<std::uint8_t> clamped(out_of_range.size());
+	F32_To_U8(out_of_range.data(), clamped.data(), out_of_range.size());
+	REQUIRE(clamped[0] == 0);
+	REQUIRE(clamped[1] == 0);
+	REQUIRE(clamped[2] == 128);
+	REQUIRE(clamped[3] == 255);
+	REQUIRE(clamped[19] == 0);
+
+	// Test sRGB, every byte surviving linearization and encoding
+
+	REQUIRE(Srgb_To_Linear(std::uint8_t{ 0 }) == 0.0f);
+	REQUIRE(Srgb_To_Linear(std::uint8_t{ 255 }) == 1.0f);
+	REQUIRE(std::abs(Srgb_To_Linear(std::uint8_t{ 188 }) - 0.5f) < 0.003f);
+	REQUIRE(Linear_To_Srgb(-1.0f) == 0);
+	REQUIRE(Linear_To_Srgb(2.0f) == 255);
+	REQUIRE(Linear_To_Srgb(std::numeric_limits<float>::quiet_NaN()) == 0);
+
+	for (std::size_t i{ 0 }; i < 256; ++i)
+		REQUIRE(Linear_To_Srgb(Srgb_To_Linear(static_cast<std::uint8_t>(i))) == i);
+
+	// The table gives the same encoding as searching every threshold, also right at them
+
+	const auto& thresholds{ Get_Encode_Thresholds() };
+	const auto encode = [&thresholds](float value)
+		{
+			return static_cast<std::size_t>(std::upper_bound(thresholds.begin(),
+				thresholds.end(), value) - thresholds.begin());
+		};
+
+	mismatches = 0;
+	for (std::uint32_t bits{ 0 }; bits < To_Bits(1.0f); bits += 997)
+		mismatches += Linear_To_Srgb(To_Float(bits)) != encode(To_Float(bits));
+	for (std::size_t i{ 0 }; i < 255; ++i)
+	{
+		mismatches += Linear_To_Srgb(thresholds[i]) != i + 1;
+		mismatches += Linear_To_Srgb(std::nextafter(thresholds[i], 0.0f)) != i;
+	}
+	REQUIRE(mismatches == 0);
+
+	const std::uint8_t srgb_texels[4]{ 188, 188, 188, 128 };
+	float linear_texels[4]{};
+	Srgb_To_Linear(srgb_texels, linear_texels, 1, 4);
+	REQUIRE(std::abs(linear_texels[0] - 0.5f) < 0.003f);
+	REQUIRE(std::abs(linear_texels[3] - 128.0f / 255.0f) < 1e-6f);
+
+	std::uint8_t encoded_texels[4]{};
+	Linear_To_Srgb(linear_texels, encoded_texels, 1, 4);
+	REQUIRE(std::equal(encoded_texels, encoded_texels + 4, srgb_texels));
+
+	// Test channel conversions, with enough texels for the kernels and the texels after them
+
+	constexpr std::size_t count{ 37 };
+	std::vector<std::uint8_t> source(count * 4);
+	for (std::size_t i{ 0 }; i < source.size(); ++i)
+		source[i] = static_cast<std::uint8_t>(i * 7 + 3);
+
+	std::vector<std::uint8_t> destination(count * 4);
+	for (std::size_t from{ 1 }; from <= 4; ++from)
+	{
+		for (std::size_t to{ 1 }; to <= 4; ++to)
+		{
+			std::fill(destination.begin(), destination.end(), std::uint8_t{ 0 });
+			Convert_Channels(source.data(), from, destination.data(), to, count);
+
+			std::vector<float> float_source(count * from);
+			std::vector<float> float_destination(count * to);
+			for (std::size_t i{ 0 }; i < float_source.size(); ++i)
+				float_source[i] = source[i];
+			Convert_Channels(float_source.data(), from, float_destination.data(), to, count);
+
+			mismatches = 0;
+			for (std::size_t i{ 0 }; i < count; ++i)
+			{
+				const std::uint8_t* texel{ source.data() + i * from };
+				const std::uint8_t* converted{ destination.data() + i * to };
+				const std::uint8_t alpha{ from == 2 || from == 4 ? texel[from - 1] :
+					std::uint8_t{ 255 } };
+
+				if (to >= 3)
+				{
+					for (std::size_t c{ 0 }; c < 3; ++c)
+						mismatches += converted[c] != (from <= 2 ? texel[0] : texel[c]);
+				}
+				else if (from <= 2)
+				{
+					mismatches += converted[0] != texel[0];
+				}
+				else
+				{
+					// Luma of bytes and floats agree to within rounding
+					const float luma{ float_destination[i * to] };
+					mismatches += std::abs(converted[0] - luma) > 2.0f;
+				}
+				if (to == 2 || to == 4)
+					mismatches += converted[to - 1] != alpha;
+
+				// Bytes and floats convert the same, other than added alpha being 1 for floats
+				if (to >= 3 || from <= 2)
+				{
+					const bool added_alpha{ (to == 2 || to == 4) && from != 2 && from != 4 };
+					for (std::size_t c{ 0 }; c < to; ++c)
+					{
+						const float expected{ added_alpha && c == to - 1 ? 1.0f :
+							static_cast<float>(converted[c]) };
+						mismatches += float_destination[i * to + c] != expected;
+					}
+				}
+			}
+			REQUIRE(mismatches == 0);
+		}
+	}
+
+	// Test premultiplying against dividing every product of bytes
+
+	std::vector<std::uint8_t> texels(256 * 256 * 4);
+	for (std::size_t i{ 0 }; i < 256 * 256; ++i)
+	{
+		texels[i * 4 + 0] = static_cast<std::uint8_t>(i % 256);
+		texels[i * 4 + 1] = static_cast<std::uint8_t>(255 - i % 256);
+		texels[i * 4 + 2] = static_cast<std::uint8_t>(i % 256);
+		texels[i * 4 + 3] = static_cast<std::uint8_t>(i / 256);
+	}
+	std::vector<std::uint8_t> premultiplied{ texels };
+	Premultiply_Alpha(premultiplied.data(), 256 * 256, 4);
+
+	mismatches = 0;
+	for (std::size_t i{ 0 }; i < texels.size(); ++i)
+	{
+		const std::size_t alpha{ texels[i / 4 * 4 + 3] };
+		const auto expected{ i % 4 == 3 ? texels[i] :
+			std::lround(texels[i] * alpha / 255.0) };
+		mismatches += premultiplied[i] != expected;
+	}
+	REQUIRE(mismatches == 0);
+
+	std::uint8_t grey_alpha[2]{ 200, 51 };
+	Premultiply_Alpha(grey_alpha, 1, 2);
+	REQUIRE(grey_alpha[0] == 40);
+	REQUIRE(grey_alpha[1] == 51);
+
+	float float_texel[4]{ 1.0f, 0.5f, 0.25f, 0.5f };
+	Premultiply_Alpha(float_texel, 1, 4);
+	REQUIRE(float_texel[0] == 0.5f);
+	REQUIRE(float_texel[2] == 0.125f);
+	REQUIRE(float_texel[3] == 0.5f);
+
+	// Test swizzling RGBA to BGRA and back
+
+	std::vector<std::uint8_t> swizzled{ source };
+	Swizzle(swizzled.data(), count, 4, { 2, 1, 0, 3 });
+	mismatches = 0;
+	for (std::size_t i{ 0 }; i < count; ++i)
+	{
+		mismatches += swizzled[i * 4 + 0] != source[i * 4 + 2];
+		mismatches += swizzled[i * 4 + 1] != source[i * 4 + 1];
+		mismatches += swizzled[i * 4 + 2] != source[i * 4 + 0];
+		mismatches += swizzled[i * 4 + 3] != source[i * 4 + 3];
+	}
+	REQUIRE(mismatches == 0);
+	Swizzle(swizzled.data(), count, 4, { 2, 1, 0, 3 });
+	REQUIRE(swizzled == source);
+
+	// Channels may also be copied into several others
+	Swizzle(swizzled.data(), count, 4, { 3, 3, 3, 3 });
+	REQUIRE(swizzled[8] == source[11]);
+	REQUIRE(swizzled[9] == source[11]);
+
+	float float_texels[3]{ 1.0f, 2.0f, 3.0f };
+	Swizzle(float_texels, 1, 3, { 1, 2, 0 });
+	REQUIRE(float_texels[0] == 2.0f);
+	REQUIRE(float_texels[1] == 3.0f);
+	REQUIRE(float_texels[2] == 1.0f);
+
+	REQUIRE_THROWS_AS(Swizzle(float_texels, 1, 3, { 0, 1, 3 }), utils::Tilia_Exception);
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
@@ -0,0 +1,164 @@
+/**************************************************************************************************
+ * @file   Pixel_Converter.hpp
+ *
+ * @brief  Kernels converting texels between channel layouts and data types. Bytes, 16 bit
+ *		   floats and 32 bit floats convert between each other, sRGB bytes are linearized and
+ *		   encoded again through tables, and alpha can be premultiplied and channels reordered.
+ *		   Kernels use SSE2, and F16C for 16 bit floats, when they can, so that an image can be
+ *		   decoded once and every variant of it needed derived from it cheaply.
+ *
+ * @author Gustav Fagerlind
+ * @date   19/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_PIXEL_CONVERTER_HPP
+#define TILIA_PIXEL_CONVERTER_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_CONSTANTS_INCLUDE
+
+namespace tilia
+{
+
+	/**
+	 * @brief Converts texels. Sources and destinations may not overlap unless told otherwise.
+	 * Channel counts are from 1 to 4, alpha being the last channel of 2 and 4 channel texels.
+	 */
+	class Pixel_Converter
+	{
+	public:
+
+		/**
+		 * @brief Converts texels between channel counts. Grey is copied into red, green and blue
+		 * when channels are added and missing alpha is made opaque. When color channels are
+		 * removed grey is the luma of red, green and blue.
+		 *
+		 * @param source - The texels to convert.
+		 * @param source_channels - The amount of channels of every source texel.
+		 * @param destination - Where to write the converted texels.
+		 * @param channels - The amount of channels of every destination texel.
+		 * @param count - The amount of texels.
+		 */
+		static void Convert_Channels(const std::uint8_t* source, std::size_t source_channels,
+			std::uint8_t* destination, std::size_t channels, std::size_t count);
+		static void Convert_Channels(const float* source, std::size_t source_channels,
+			float* destination, std::size_t channels, std::size_t count);
+
+		/**
+		 * @brief Converts bytes to floats in [0, 1].
+		 *
+		 * @param count - The amount of values, not texels.
+		 */
+		static void U8_To_F32(const std::uint8_t* source, float* destination, std::size_t count);
+		/**
+		 * @brief Converts floats to bytes, clamping them to [0, 1] and rounding them.
+		 *
+		 * @param count - The amount of values, not texels.
+		 */
+		static void F32_To_U8(const float* source, std::uint8_t* destination, std::size_t count);
+
+		/**
+		 * @brief Converts 32 bit floats to 16 bit floats, rounding to nearest even. Values too
+		 * large become infinity.
+		 *
+		 * @param count - The amount of values, not texels.
+		 */
+		static void F32_To_F16(const float* source, std::uint16_t* destination,
+			std::size_t count);
+		/**
+		 * @brief Converts 16 bit floats to 32 bit floats, which is exact.
+		 *
+		 * @param count - The amount of values, not texels.
+		 */
+		static void F16_To_F32(const std::uint16_t* source, float* destination,
+			std::size_t count);
+
+		/**
+		 * @brief Converts bytes to 16 bit floats in [0, 1].
+		 *
+		 * @param count - The amount of values, not texels.
+		 */
+		static void U8_To_F16(const std::uint8_t* source, std::uint16_t* destination,
+			std::size_t count);
+		/**
+		 * @brief Converts 16 bit floats to bytes, clamping them to [0, 1] and rounding them.
+		 *
+		 * @param count - The amount of values, not texels.
+		 */
+		static void F16_To_U8(const std::uint16_t* source, std::uint8_t* destination,
+			std::size_t count);
+
+		/**
+		 * @brief Converts sRGB encoded bytes to linear floats. Alpha is linear already and is
+		 * only converted to float.
+		 *
+		 * @param count - The amount of texels.
+		 * @param channels - The amount of channels of every texel.
+		 */
+		static void Srgb_To_Linear(const std::uint8_t* source, float* destination,
+			std::size_t count, std::size_t channels);
+		/**
+		 * @brief Encodes linear floats as sRGB bytes, rounding to the nearest sRGB value.
+		 * Alpha is kept linear and is only converted to bytes.
+		 *
+		 * @param count - The amount of texels.
+		 * @param channels - The amount of channels of every texel.
+		 */
+		static void Linear_To_Srgb(const float* source, std::uint8_t* destination,
+			std::size_t count, std::size_t channels);
+
+		/**
+		 * @brief Multiplies the color channels of texels with their alpha, in place. Texels
+		 * without alpha are left as they are.
+		 *
+		 * @param count - The amount of texels.
+		 * @param channels - The amount of channels of every texel.
+		 */
+		static void Premultiply_Alpha(std::uint8_t* texels, std::size_t count,
+			std::size_t channels);
+		static void Premultiply_Alpha(float* texels, std::size_t count, std::size_t channels);
+
+		/**
+		 * @brief Reorders the channels of texels, in place.
+		 *
+		 * @param count - The amount of texels.
+		 * @param channels - The amount of channels of every texel.
+		 * @param order - The source channel of every channel, such as { 2, 1, 0, 3 } to swap
+		 * between RGBA and BGRA. Only the first channels are used.
+		 *
+		 * @exception A source channel is out of range.
+		 */
+		static void Swizzle(std::uint8_t* texels, std::size_t count, std::size_t channels,
+			const std::array<std::uint8_t, 4>& order);
+		static void Swizzle(float* texels, std::size_t count, std::size_t channels,
+			const std::array<std::uint8_t, 4>& order);
+
+		static float Half_To_Float(std::uint16_t value);
+		static std::uint16_t Float_To_Half(float value);
+
+		static float Srgb_To_Linear(std::uint8_t value);
+		static std::uint8_t Linear_To_Srgb(float value);
+
+#if TILIA_UNIT_TESTS == 1
+
+		/**
+		 * @brief Unit test for Pixel_Converter.
+		 */
+		static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		// Pixel_Converter shan't be constructed
+		Pixel_Converter() = delete;
+
+	}; // Pixel_Converter
+
+} // tilia
+
+#endif // TILIA_PIXEL_CONVERTER_HPP
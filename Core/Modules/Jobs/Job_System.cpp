@@ -0,0 +1,388 @@
+// Standard
+#include <exception>
+
+// Tilia
+#include "Job_System.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+#include TILIA_EXCEPTION_HANDLER_INCLUDE
+
+thread_local std::size_t tilia::jobs::Job_System::s_thread_index{
+	tilia::jobs::Job_System::s_invalid_thread_index };
+
+tilia::jobs::Job_System::~Job_System()
+{
+	Terminate();
+}
+
+void tilia::jobs::Job_System::Init(std::size_t worker_count)
+{
+	if (m_running.load())
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Job system is already initialized" } };
+	}
+
+	s_thread_index = 0;
+
+	m_thread_data.clear();
+	for (std::size_t i{ 0 }; i < worker_count + 1; ++i)
+		m_thread_data.push_back(std::make_unique<Thread_Data>());
+
+	m_running.store(true);
+
+	m_workers.reserve(worker_count);
+	for (std::size_t i{ 1 }; i <= worker_count; ++i)
+		m_workers.emplace_back(&Job_System::Worker_Loop, this, i);
+}
+
+void tilia::jobs::Job_System::Terminate()
+{
+	if (!m_running.load())
+		return;
+
+	// Let the main thread finish anything still queued
+	while (Job* job{ Get_Job() })
+		Execute(job);
+	Update();
+
+	{
+		std::lock_guard lock{ m_wake_mutex };
+		m_running.store(false);
+	}
+	m_wake_condition.notify_all();
+
+	for (auto& worker : m_workers)
+		worker.join();
+	m_workers.clear();
+
+	m_thread_data.clear();
+	m_queued_jobs.store(0);
+}
+
+tilia::jobs::Job* tilia::jobs::Job_System::Create_Job(std::function<void()> function, Job* parent)
+{
+	Check_Thread("Create_Job");
+	return Allocate_Job(std::move(function), parent, false);
+}
+
+tilia::jobs::Job* tilia::jobs::Job_System::Create_Main_Thread_Job(std::function<void()> function,
+	Job* parent)
+{
+	Check_Thread("Create_Main_Thread_Job");
+	return Allocate_Job(std::move(function), parent, true);
+}
+
+void tilia::jobs::Job_System::Run(Job* job)
+{
+	Check_Thread("Run");
+
+	if (job->main_thread_only)
+	{
+		std::lock_guard lock{ m_main_thread_mutex };
+		m_main_thread_jobs.push_back(job);
+		return;
+	}
+
+	if (!m_thread_data[s_thread_index]->deque.Push(job))
+	{
+		// Deque is full, so run the job right away instead
+		Execute(job);
+		return;
+	}
+
+	m_queued_jobs.fetch_add(1);
+
+	if (m_sleeping_workers.load() > 0)
+	{
+		// Lock so that the wake up can not happen between a worker checking for jobs and it
+		// going to sleep
+		{ std::lock_guard lock{ m_wake_mutex }; }
+		m_wake_condition.notify_one();
+	}
+}
+
+void tilia::jobs::Job_System::Wait(const Job* job)
+{
+	Check_Thread("Wait");
+
+	while (!Is_Finished(job))
+	{
+		Job* next_job{ Get_Job() };
+		if (next_job == nullptr && s_thread_index == 0)
+			next_job = Get_Main_Thread_Job();
+
+		if (next_job != nullptr)
+			Execute(next_job);
+		else
+			std::this_thread::yield();
+	}
+}
+
+void tilia::jobs::Job_System::Update()
+{
+	Check_Thread("Update");
+
+	if (s_thread_index != 0)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Update may only be called from the main thread" } };
+	}
+
+	std::vector<Job*> main_thread_jobs{};
+	{
+		std::lock_guard lock{ m_main_thread_mutex };
+		main_thread_jobs.swap(m_main_thread_jobs);
+	}
+
+	for (auto job : main_thread_jobs)
+		Execute(job);
+}
+
+void tilia::jobs::Job_System::Worker_Loop(std::size_t thread_index)
+{
+	s_thread_index = thread_index;
+
+	while (m_running.load())
+	{
+		if (Job* job{ Get_Job() })
+		{
+			Execute(job);
+			continue;
+		}
+
+		std::unique_lock lock{ m_wake_mutex };
+		m_sleeping_workers.fetch_add(1);
+		m_wake_condition.wait(lock, [this]()
+			{ return m_queued_jobs.load() > 0 || !m_running.load(); });
+		m_sleeping_workers.fetch_sub(1);
+	}
+}
+
+tilia::jobs::Job* tilia::jobs::Job_System::Allocate_Job(std::function<void()> function, Job* parent,
+	bool main_thread_only)
+{
+	Job* job{ Try_Allocate_Job(std::move(function), parent, main_thread_only) };
+
+	if (job == nullptr)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Job pool of thread ", s_thread_index, " is exhausted, more than ", s_max_jobs,
+			" jobs are unfinished" } };
+	}
+
+	return job;
+}
+
+tilia::jobs::Job* tilia::jobs::Job_System::Try_Allocate_Job(std::function<void()> function,
+	Job* parent, bool main_thread_only)
+{
+	Thread_Data& thread_data{ *m_thread_data[s_thread_index] };
+
+	Job* job{ &thread_data.job_pool[thread_data.next_job & (s_max_jobs - 1)] };
+
+	if (!Is_Finished(job))
+		return nullptr;
+
+	++thread_data.next_job;
+
+	job->function = std::move(function);
+	job->parent = parent;
+	job->main_thread_only = main_thread_only;
+	job->unfinished.store(1, std::memory_order_relaxed);
+
+	if (parent != nullptr)
+		parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+
+	return job;
+}
+
+tilia::jobs::Job* tilia::jobs::Job_System::Get_Job()
+{
+	const std::size_t thread_count{ m_thread_data.size() };
+
+	Job* job{ m_thread_data[s_thread_index]->deque.Pop() };
+
+	// Try stealing from the other threads, starting with the next one
+	for (std::size_t i{ 1 }; job == nullptr && i < thread_count; ++i)
+		job = m_thread_data[(s_thread_index + i) % thread_count]->deque.Steal();
+
+	if (job != nullptr)
+		m_queued_jobs.fetch_sub(1);
+
+	return job;
+}
+
+tilia::jobs::Job* tilia::jobs::Job_System::Get_Main_Thread_Job()
+{
+	std::lock_guard lock{ m_main_thread_mutex };
+
+	if (m_main_thread_jobs.empty())
+		return nullptr;
+
+	Job* job{ m_main_thread_jobs.back() };
+	m_main_thread_jobs.pop_back();
+	return job;
+}
+
+void tilia::jobs::Job_System::Execute(Job* job)
+{
+	try
+	{
+		job->function();
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		utils::Exception_Handler::Instance().Throw(t_e.Add_Message({ TILIA_LOCATION,
+			"Job failed on thread ", s_thread_index }));
+	}
+	catch (std::exception& e)
+	{
+		utils::Exception_Handler::Instance().Throw(e);
+	}
+
+	Finish(job);
+}
+
+void tilia::jobs::Job_System::Finish(Job* job)
+{
+	// Read before finishing, as a finished job may be handed out again by its thread
+	Job* parent{ job->parent };
+
+	// Last unfinished part of the job, so it and possibly its parent are done
+	if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		if (parent != nullptr)
+			Finish(parent);
+	}
+}
+
+void tilia::jobs::Job_System::Check_Thread(const char* function_name) const
+{
+	if (s_thread_index == s_invalid_thread_index || !m_running.load())
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Job_System::", function_name, " called from a thread which is not part of an "
+			"initialized job system" } };
+	}
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+// Standard
+#include <numeric>
+
+void tilia::jobs::Job_System::Test()
+{
+
+	Job_System& job_system{ Job_System::Instance() };
+
+	// Test for Job_System::Instance() returning correct address
+
+	REQUIRE(&job_system == &Job_System::Instance());
+
+	// Test calling from an uninitialized job system throws
+
+	REQUIRE_THROWS(job_system.Create_Job([]() {}));
+
+	job_system.Init(3);
+
+	REQUIRE(job_system.Get_Worker_Count() == 3);
+	REQUIRE(Job_System::Get_Thread_Index() == 0);
+
+	// Test a single job runs
+
+	std::atomic<std::int32_t> counter{ 0 };
+
+	Job* job{ job_system.Create_Job([&counter]() { ++counter; }) };
+	job_system.Run(job);
+	job_system.Wait(job);
+
+	REQUIRE(Is_Finished(job));
+	REQUIRE(counter == 1);
+
+	// Test a parent does not finish before all of its children
+
+	counter = 0;
+
+	Job* parent{ job_system.Create_Job([]() {}) };
+	for (std::size_t i{ 0 }; i < 100; ++i)
+	{
+		job_system.Run(job_system.Create_Job([&counter]()
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds{ 10 });
+				++counter;
+			}, parent));
+	}
+	job_system.Run(parent);
+	job_system.Wait(parent);
+
+	REQUIRE(counter == 100);
+
+	// Test parallel for covers the whole range exactly once
+
+	std::vector<std::int32_t> values(10000, 0);
+
+	job_system.Parallel_For(0, values.size(), 64, [&values](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i{ begin }; i < end; ++i)
+				values[i] += static_cast<std::int32_t>(i);
+		});
+
+	std::vector<std::int32_t> expected(values.size());
+	std::iota(expected.begin(), expected.end(), 0);
+
+	REQUIRE(values == expected);
+
+	// Test parallel for over more chunks than fit in the job pool
+
+	std::atomic<std::size_t> covered{ 0 };
+
+	job_system.Parallel_For(0, 1000000, 64, [&covered](std::size_t begin, std::size_t end)
+		{
+			covered += end - begin;
+		});
+
+	REQUIRE(covered == 1000000);
+
+	// Test main thread jobs only run on the main thread
+
+	std::atomic<std::size_t> main_thread_index{ s_invalid_thread_index };
+
+	Job* main_job{ job_system.Create_Main_Thread_Job([&main_thread_index]()
+		{ main_thread_index = Job_System::Get_Thread_Index(); }) };
+	job_system.Run(main_job);
+
+	REQUIRE(!Is_Finished(main_job));
+
+	job_system.Update();
+
+	REQUIRE(Is_Finished(main_job));
+	REQUIRE(main_thread_index == 0);
+
+	// Test jobs queued from within jobs
+
+	counter = 0;
+
+	Job* outer{ job_system.Create_Job([&job_system, &counter]()
+		{
+			job_system.Parallel_For(0, 1000, 10, [&counter](std::size_t begin, std::size_t end)
+				{ counter += static_cast<std::int32_t>(end - begin); });
+		}) };
+	job_system.Run(outer);
+	job_system.Wait(outer);
+
+	REQUIRE(counter == 1000);
+
+	// Reset to default
+
+	job_system.Terminate();
+
+	REQUIRE(job_system.Get_Worker_Count() == 0);
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
@@ -0,0 +1,303 @@
+/**************************************************************************************************
+ * @file   Job_System.hpp
+ *
+ * @brief  Holds a singleton work stealing job system. Jobs can have parent jobs which are not
+ *		   finished until all of their children are, ranges can be split over all workers and
+ *		   jobs which have to run on the main thread, such as OpenGL work, can be queued.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_JOB_SYSTEM_HPP
+#define TILIA_JOB_SYSTEM_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_WORK_STEALING_DEQUE_INCLUDE
+#include TILIA_CONSTANTS_INCLUDE
+
+namespace tilia
+{
+	namespace jobs
+	{
+
+		/**
+		 * @brief A unit of work. Is finished once its function has run and all of its children
+		 * are finished. Jobs are owned by the job system and are reused, a pointer to a job is
+		 * therefore only valid until a while after it has finished.
+		 */
+		struct Job
+		{
+			// The work to do
+			std::function<void()> function{};
+			// The job which waits on this job, may be nullptr
+			Job* parent{ nullptr };
+			// The number of unfinished jobs, counting this job and all of its children
+			std::atomic<std::int32_t> unfinished{ 0 };
+			// Whether or not the job may only run on the main thread
+			bool main_thread_only{ false };
+		}; // Job
+
+		/**
+		 * @brief Singleton job system. Holds one worker thread per given worker and one work
+		 * stealing deque per thread, including the main thread. Jobs may only be created, ran and
+		 * waited on from the main thread or from within other jobs.
+		 */
+		class Job_System
+		{
+		public:
+
+			/**
+			 * @brief First time it is called it will construct an instance of Job_System. A
+			 * reference to this instance is returned to anywhere in the program.
+			 *
+			 * @return A reference to an instance of Job_System.
+			 */
+			static Job_System& Instance()
+			{
+				static Job_System job_system{};
+				return job_system;
+			}
+
+			/**
+			 * @brief Starts the worker threads. The calling thread is made the main thread.
+			 *
+			 * @param worker_count - The number of worker threads to start, defaults to one less
+			 * than the number of hardware threads.
+			 */
+			void Init(std::size_t worker_count = Default_Worker_Count());
+
+			/**
+			 * @brief Finishes all queued jobs and then stops and joins the worker threads.
+			 */
+			void Terminate();
+
+			/**
+			 * @brief Creates a job which will run the given function. Is not queued until Run is
+			 * called on it.
+			 *
+			 * @param function - The function for the job to run.
+			 * @param parent - An optional parent which will not finish until the new job has.
+			 */
+			Job* Create_Job(std::function<void()> function, Job* parent = nullptr);
+			/**
+			 * @brief Creates a job which will only be ran on the main thread, either in Update or
+			 * while the main thread is waiting on a job.
+			 *
+			 * @param function - The function for the job to run.
+			 * @param parent - An optional parent which will not finish until the new job has.
+			 */
+			Job* Create_Main_Thread_Job(std::function<void()> function, Job* parent = nullptr);
+
+			/**
+			 * @brief Queues the given job to be ran.
+			 */
+			void Run(Job* job);
+
+			/**
+			 * @brief Helps running jobs until the given job has finished.
+			 */
+			void Wait(const Job* job);
+
+			/**
+			 * @brief Checks whether or not the given job and all of its children have finished.
+			 */
+			static bool Is_Finished(const Job* job)
+			{
+				return job->unfinished.load(std::memory_order_acquire) <= 0;
+			}
+
+			/**
+			 * @brief Runs all of the queued main thread jobs. Should be called once per frame
+			 * by the main thread.
+			 */
+			void Update();
+
+			/**
+			 * @brief Splits the range [begin, end) into chunks of at most grain_size elements and
+			 * calls the given function on every chunk in parallel. Returns once every chunk is
+			 * done. The grain size is raised so that there are at most s_max_chunks chunks, and
+			 * chunks which can not get a job, as the job pool is full, are ran right away by the
+			 * calling thread.
+			 *
+			 * @param function - Called as function(chunk_begin, chunk_end).
+			 */
+			template<typename Func>
+			void Parallel_For(std::size_t begin, std::size_t end, std::size_t grain_size,
+				Func&& function)
+			{
+				if (begin >= end)
+					return;
+				grain_size = std::max<std::size_t>(grain_size, 1);
+				grain_size = std::max(grain_size, (end - begin + s_max_chunks - 1) / s_max_chunks);
+
+				Check_Thread("Parallel_For");
+
+				Job* root{ Try_Allocate_Job([]() {}, nullptr, false) };
+				if (root == nullptr)
+				{
+					function(begin, end);
+					return;
+				}
+
+				try
+				{
+					for (std::size_t chunk_begin{ begin }; chunk_begin < end;
+						chunk_begin += grain_size)
+					{
+						const std::size_t chunk_end{ std::min(chunk_begin + grain_size, end) };
+						Job* job{ Try_Allocate_Job([&function, chunk_begin, chunk_end]()
+							{ function(chunk_begin, chunk_end); }, root, false) };
+						if (job != nullptr)
+							Run(job);
+						else
+							function(chunk_begin, chunk_end);
+					}
+				}
+				catch (...)
+				{
+					// The queued chunks refer to the function, so they have to finish first
+					Run(root);
+					Wait(root);
+					throw;
+				}
+
+				Run(root);
+				Wait(root);
+			}
+
+			/**
+			 * @brief Whether or not the calling thread may create, run and wait on jobs.
+			 */
+			bool Can_Run_Jobs() const
+			{
+				return m_running.load() && s_thread_index != s_invalid_thread_index;
+			}
+
+			/**
+			 * @brief Gets the number of worker threads, not counting the main thread.
+			 */
+			std::size_t Get_Worker_Count() const { return m_workers.size(); }
+			/**
+			 * @brief Gets the index of the calling thread, 0 for the main thread and 1 and up for
+			 * the workers.
+			 */
+			static std::size_t Get_Thread_Index() { return s_thread_index; }
+
+			/**
+			 * @brief The default number of worker threads to start.
+			 */
+			static std::size_t Default_Worker_Count()
+			{
+				const std::size_t hardware_threads{ std::thread::hardware_concurrency() };
+				return (hardware_threads > 1) ? hardware_threads - 1 : 0;
+			}
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Job_System.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		private:
+
+			// The number of jobs each thread can hold in its deque and job pool
+			static constexpr std::size_t s_max_jobs{ 4096 };
+			// The most chunks Parallel_For splits a range into, leaving room in the job pool
+			// for jobs made by the chunks themselves
+			static constexpr std::size_t s_max_chunks{ s_max_jobs / 4 };
+			// Index of a thread which is not part of the job system
+			static constexpr std::size_t s_invalid_thread_index{ static_cast<std::size_t>(-1) };
+
+			// The index of the current thread
+			static thread_local std::size_t s_thread_index;
+
+			using Deque = Work_Stealing_Deque<Job, s_max_jobs>;
+
+			/**
+			 * @brief The per-thread job storage. Jobs are handed out in a ring so no allocations
+			 * are done after Init.
+			 */
+			struct Thread_Data
+			{
+				// The deque of jobs runnable by this and other threads
+				Deque deque{};
+				// The jobs handed out by this thread
+				std::unique_ptr<Job[]> job_pool{ std::make_unique<Job[]>(s_max_jobs) };
+				// The next job in the pool to hand out, only touched by the owning thread
+				std::size_t next_job{ 0 };
+			}; // Thread_Data
+
+			Job_System() = default;
+			~Job_System();
+
+			void Worker_Loop(std::size_t thread_index);
+
+			Job* Allocate_Job(std::function<void()> function, Job* parent, bool main_thread_only);
+			/**
+			 * @brief Allocates a job as Allocate_Job, but returns nullptr instead of throwing
+			 * when the job pool of the thread is exhausted.
+			 */
+			Job* Try_Allocate_Job(std::function<void()> function, Job* parent,
+				bool main_thread_only);
+
+			Job* Get_Job();
+			Job* Get_Main_Thread_Job();
+
+			void Execute(Job* job);
+			void Finish(Job* job);
+
+			void Check_Thread(const char* function_name) const;
+
+			// The per-thread data, index 0 is the main thread
+			std::vector<std::unique_ptr<Thread_Data>> m_thread_data{};
+			// The worker threads
+			std::vector<std::thread> m_workers{};
+			// Whether or not the workers should keep running
+			std::atomic<bool> m_running{ false };
+
+			// Jobs queued for the main thread
+			std::vector<Job*> m_main_thread_jobs{};
+			// Guards the main thread jobs
+			std::mutex m_main_thread_mutex{};
+
+			// The number of jobs queued in the deques but not yet taken
+			std::atomic<std::size_t> m_queued_jobs{ 0 };
+			// The number of workers sleeping while waiting for jobs
+			std::atomic<std::size_t> m_sleeping_workers{ 0 };
+			// Used for putting idle workers to sleep
+			std::mutex m_wake_mutex{};
+			std::condition_variable m_wake_condition{};
+
+		public:
+
+			// Job_System shan't be copyable or moveable
+
+			Job_System(const Job_System& other) = delete;
+			Job_System(Job_System&& other) = delete;
+
+			Job_System& operator=(const Job_System& other) = delete;
+			Job_System& operator=(Job_System&& other) = delete;
+
+		}; // Job_System
+
+	} // jobs
+} // tilia
+
+#endif // TILIA_JOB_SYSTEM_HPP
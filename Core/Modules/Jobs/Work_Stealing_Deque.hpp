@@ -0,0 +1,157 @@
+/**************************************************************************************************
+ * @file   Work_Stealing_Deque.hpp
+ *
+ * @brief  Holds a fixed size, lock-free Chase-Lev deque which the owning thread pushes to and pops
+ *		   from at the bottom while other threads steal from the top.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_WORK_STEALING_DEQUE_HPP
+#define TILIA_WORK_STEALING_DEQUE_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <array>
+
+namespace tilia
+{
+	namespace jobs
+	{
+
+		/**
+		 * @brief A Chase-Lev work stealing deque of pointers. Push and Pop may only be called by
+		 * the thread owning the deque while Steal may be called by any thread.
+		 *
+		 * @tparam T - The type of the elements the stored pointers point to.
+		 * @tparam capacity - The max number of elements the deque can hold. Must be a power of two.
+		 */
+		template<typename T, std::size_t capacity>
+		class Work_Stealing_Deque
+		{
+		public:
+
+			static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0,
+				"Work_Stealing_Deque capacity must be a power of two");
+
+			/**
+			 * @brief Pushes an element to the bottom of the deque. May only be called by the
+			 * owning thread.
+			 *
+			 * @return False if the deque is full, otherwise true.
+			 */
+			bool Push(T* element)
+			{
+				const std::int64_t bottom{ m_bottom.load(std::memory_order_relaxed) };
+				const std::int64_t top{ m_top.load(std::memory_order_acquire) };
+
+				if (bottom - top >= static_cast<std::int64_t>(capacity))
+					return false;
+
+				m_elements[bottom & s_mask].store(element, std::memory_order_relaxed);
+				m_bottom.store(bottom + 1, std::memory_order_release);
+
+				return true;
+			}
+
+			/**
+			 * @brief Pops an element from the bottom of the deque. May only be called by the
+			 * owning thread.
+			 *
+			 * @return The popped element or nullptr if the deque was empty.
+			 */
+			T* Pop()
+			{
+				const std::int64_t bottom{ m_bottom.load(std::memory_order_relaxed) - 1 };
+				m_bottom.store(bottom, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				std::int64_t top{ m_top.load(std::memory_order_relaxed) };
+
+				if (top > bottom)
+				{
+					// Deque was empty
+					m_bottom.store(bottom + 1, std::memory_order_relaxed);
+					return nullptr;
+				}
+
+				T* element{ m_elements[bottom & s_mask].load(std::memory_order_relaxed) };
+
+				if (top != bottom)
+					return element;
+
+				// Last element, race against any thieves for it
+				if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+					std::memory_order_relaxed))
+					element = nullptr;
+
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+				return element;
+			}
+
+			/**
+			 * @brief Steals an element from the top of the deque. May be called by any thread.
+			 *
+			 * @return The stolen element or nullptr if the deque was empty or another thread won
+			 * the race for the element.
+			 */
+			T* Steal()
+			{
+				std::int64_t top{ m_top.load(std::memory_order_acquire) };
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				const std::int64_t bottom{ m_bottom.load(std::memory_order_acquire) };
+
+				if (top >= bottom)
+					return nullptr;
+
+				T* element{ m_elements[top & s_mask].load(std::memory_order_relaxed) };
+
+				if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+					std::memory_order_relaxed))
+					return nullptr;
+
+				return element;
+			}
+
+			/**
+			 * @brief Gets an approximation of the number of elements in the deque.
+			 */
+			std::size_t Size() const
+			{
+				const std::int64_t bottom{ m_bottom.load(std::memory_order_relaxed) };
+				const std::int64_t top{ m_top.load(std::memory_order_relaxed) };
+				return static_cast<std::size_t>(bottom > top ? bottom - top : 0);
+			}
+
+		private:
+
+			static constexpr std::int64_t s_mask{ static_cast<std::int64_t>(capacity - 1) };
+
+			// Index where thieves steal from, kept apart from the bottom to avoid false sharing
+			alignas(64) std::atomic<std::int64_t> m_top{ 0 };
+			// Index where the owning thread pushes and pops
+			alignas(64) std::atomic<std::int64_t> m_bottom{ 0 };
+			// The stored elements
+			std::array<std::atomic<T*>, capacity> m_elements{};
+
+		public:
+
+			Work_Stealing_Deque() = default;
+
+			// Work_Stealing_Deque shan't be copyable or moveable
+
+			Work_Stealing_Deque(const Work_Stealing_Deque& other) = delete;
+			Work_Stealing_Deque(Work_Stealing_Deque&& other) = delete;
+
+			Work_Stealing_Deque& operator=(const Work_Stealing_Deque& other) = delete;
+			Work_Stealing_Deque& operator=(Work_Stealing_Deque&& other) = delete;
+
+		}; // Work_Stealing_Deque
+
+	} // jobs
+} // tilia
+
+#endif // TILIA_WORK_STEALING_DEQUE_HPP
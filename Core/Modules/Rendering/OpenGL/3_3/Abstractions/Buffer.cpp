@@ -9,11 +9,11 @@
 
 std::unordered_map<std::uint32_t, std::uint32_t> tilia::gfx::Buffer::s_bound_IDs{ {
         *enums::Buffer_Type::Vertex_Buffer, 0 }, { *enums::Buffer_Type::Element_Buffer, 0 }, { 
-            *enums::Buffer_Type::Uniform_Buffer, 0 } };
+            *enums::Buffer_Type::Uniform_Buffer, 0 }, { *enums::Buffer_Type::Texture_Buffer, 0 } };
 
 std::unordered_map<std::uint32_t, std::uint32_t> tilia::gfx::Buffer::s_saved_IDs{ {
         *enums::Buffer_Type::Vertex_Buffer, 0 }, { *enums::Buffer_Type::Element_Buffer, 0 }, { 
-            *enums::Buffer_Type::Uniform_Buffer, 0 } };
+            *enums::Buffer_Type::Uniform_Buffer, 0 }, { *enums::Buffer_Type::Texture_Buffer, 0 } };
 
 tilia::gfx::Buffer::Buffer(const Buffer& other)
 {
@@ -0,0 +1,296 @@
+// Vendor
+#include "vendor/glad/KHR_Debug_openGL_3_3/include/glad/glad.h"
+
+// Standard
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+// Tilia
+#include "Program_Binary_Cache.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+#include TILIA_OPENGL_3_3_CONSTANTS_INCLUDE
+#include TILIA_OPENGL_3_3_UTILS_INCLUDE
+
+// The parts of ARB_get_program_binary which are not in the openGL 3.3 headers
+static constexpr GLenum PROGRAM_BINARY_RETRIEVABLE_HINT{ 0x8257 };
+static constexpr GLenum PROGRAM_BINARY_LENGTH{ 0x8741 };
+static constexpr GLenum NUM_PROGRAM_BINARY_FORMATS{ 0x87FE };
+
+typedef void (APIENTRYP Get_Program_Binary_Proc)(GLuint program, GLsizei buffer_size,
+	GLsizei* length, GLenum* format, void* binary);
+typedef void (APIENTRYP Program_Binary_Proc)(GLuint program, GLenum format, const void* binary,
+	GLsizei length);
+typedef void (APIENTRYP Program_Parameteri_Proc)(GLuint program, GLenum name, GLint value);
+
+static Get_Program_Binary_Proc get_program_binary{};
+static Program_Binary_Proc program_binary{};
+static Program_Parameteri_Proc program_parameteri{};
+
+// Starts every binary file, followed by the version of the file layout
+static constexpr char FILE_MAGIC[4]{ 'T', 'P', 'B', 'C' };
+static constexpr std::uint32_t FILE_VERSION{ 1 };
+
+bool tilia::gfx::Program_Binary_Cache::Init(const std::string& directory, Load_Proc load_proc)
+{
+
+	m_enabled = false;
+	m_stats = {};
+	m_directory = directory;
+
+	try
+	{
+
+		std::int32_t major{}, minor{};
+		GL_CALL(glGetIntegerv(GL_MAJOR_VERSION, &major));
+		GL_CALL(glGetIntegerv(GL_MINOR_VERSION, &minor));
+
+		// Core since 4.1
+		if ((major < 4 || (major == 4 && minor < 1)) && 
+			!utils::Has_Extension("GL_ARB_get_program_binary"))
+			return false;
+
+		get_program_binary = reinterpret_cast<Get_Program_Binary_Proc>(
+			load_proc("glGetProgramBinary"));
+		program_binary = reinterpret_cast<Program_Binary_Proc>(load_proc("glProgramBinary"));
+		program_parameteri = reinterpret_cast<Program_Parameteri_Proc>(
+			load_proc("glProgramParameteri"));
+
+		if (!get_program_binary || !program_binary || !program_parameteri)
+			return false;
+
+		// Some drivers support the extension without supporting a single format
+		std::int32_t format_count{};
+		GL_CALL(glGetIntegerv(NUM_PROGRAM_BINARY_FORMATS, &format_count));
+		if (format_count <= 0)
+			return false;
+
+		m_driver_hash = s_hash_basis;
+		for (const GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+		{
+			GL_CALL(const auto string{ reinterpret_cast<const char*>(glGetString(name)) });
+			if (string != nullptr)
+				m_driver_hash = Hash(string, std::strlen(string), m_driver_hash);
+		}
+
+		std::filesystem::create_directories(m_directory);
+
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to init program binary cache { Directory: ", directory, " }" });
+	}
+	catch (std::exception& e)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Failed to create program binary cache directory { Directory: ", directory, " }",
+			"\n>>> Message: ", e.what() } };
+	}
+
+	m_enabled = true;
+
+	return true;
+
+}
+
+void tilia::gfx::Program_Binary_Cache::Terminate()
+{
+	m_enabled = false;
+	get_program_binary = nullptr;
+	program_binary = nullptr;
+	program_parameteri = nullptr;
+}
+
+bool tilia::gfx::Program_Binary_Cache::Load(std::uint32_t program, std::uint64_t key)
+{
+
+	if (!m_enabled)
+		return false;
+
+	const std::string path{ Get_Path(key) };
+
+	std::ifstream file{ path, std::ios::binary };
+	if (!file)
+	{
+		++m_stats.misses;
+		return false;
+	}
+
+	char magic[sizeof(FILE_MAGIC)]{};
+	std::uint32_t version{}, format{}, length{};
+	std::uint64_t stored_key{};
+
+	file.read(magic, sizeof(magic));
+	file.read(reinterpret_cast<char*>(&version), sizeof(version));
+	file.read(reinterpret_cast<char*>(&format), sizeof(format));
+	file.read(reinterpret_cast<char*>(&length), sizeof(length));
+	file.read(reinterpret_cast<char*>(&stored_key), sizeof(stored_key));
+
+	std::vector<char> binary{};
+	if (file && std::memcmp(magic, FILE_MAGIC, sizeof(magic)) == 0 && version == FILE_VERSION &&
+		stored_key == key && length > 0)
+	{
+		binary.resize(length);
+		file.read(binary.data(), static_cast<std::streamsize>(length));
+	}
+	const bool read{ file && !binary.empty() };
+	file.close();
+
+	std::int32_t linked{ GL_FALSE };
+	if (read)
+	{
+		try
+		{
+			GL_CALL(program_binary(program, format, binary.data(),
+				static_cast<GLsizei>(length)));
+			GL_CALL(glGetProgramiv(program, GL_LINK_STATUS, &linked));
+		}
+		catch (utils::Tilia_Exception&)
+		{
+			// The driver refusing the format is no different from any other mismatch
+			linked = GL_FALSE;
+		}
+	}
+
+	if (linked == GL_FALSE)
+	{
+		// Usually a driver update, the binary is replaced once the program has been linked
+		++m_stats.rejected;
+		++m_stats.misses;
+		std::error_code error{};
+		std::filesystem::remove(path, error);
+		return false;
+	}
+
+	++m_stats.hits;
+
+	return true;
+
+}
+
+void tilia::gfx::Program_Binary_Cache::Prepare(std::uint32_t program) const
+{
+	if (!m_enabled)
+		return;
+	GL_CALL(program_parameteri(program, PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+}
+
+void tilia::gfx::Program_Binary_Cache::Store(std::uint32_t program, std::uint64_t key)
+{
+
+	if (!m_enabled)
+		return;
+
+	std::int32_t length{};
+	GL_CALL(glGetProgramiv(program, PROGRAM_BINARY_LENGTH, &length));
+	if (length <= 0)
+		return;
+
+	std::vector<char> binary(static_cast<std::size_t>(length));
+	GLenum format{};
+	GL_CALL(get_program_binary(program, length, &length, &format, binary.data()));
+
+	const std::string path{ Get_Path(key) };
+	// Written next to the real file first so that a crash never leaves half a binary behind
+	const std::string temporary_path{ path + ".tmp" };
+
+	{
+		std::ofstream file{ temporary_path, std::ios::binary | std::ios::trunc };
+
+		const std::uint32_t version{ FILE_VERSION };
+		const std::uint32_t stored_format{ format };
+		const auto stored_length{ static_cast<std::uint32_t>(length) };
+
+		file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+		file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+		file.write(reinterpret_cast<const char*>(&stored_format), sizeof(stored_format));
+		file.write(reinterpret_cast<const char*>(&stored_length), sizeof(stored_length));
+		file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+		file.write(binary.data(), length);
+
+		// Not being able to write only costs a compile on the next launch
+		if (!file)
+			return;
+	}
+
+	std::error_code error{};
+	std::filesystem::rename(temporary_path, path, error);
+	if (error)
+	{
+		std::filesystem::remove(temporary_path, error);
+		return;
+	}
+
+	++m_stats.stores;
+
+}
+
+std::uint64_t tilia::gfx::Program_Binary_Cache::Hash(const void* data, std::size_t size,
+	std::uint64_t hash)
+{
+	constexpr std::uint64_t prime{ 0x100000001b3 };
+	const auto bytes{ static_cast<const unsigned char*>(data) };
+	for (std::size_t i{ 0 }; i < size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= prime;
+	}
+	return hash;
+}
+
+std::string tilia::gfx::Program_Binary_Cache::Get_Path(std::uint64_t key) const
+{
+	char name[32]{};
+	std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+	return (std::filesystem::path{ m_directory } / name).string();
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+void tilia::gfx::Program_Binary_Cache::Test()
+{
+
+	SECTION("Hash")
+	{
+		// Reference values of 64 bit FNV-1a
+		REQUIRE(Hash("", 0) == 0xcbf29ce484222325);
+		REQUIRE(Hash("a", 1) == 0xaf63dc4c8601ec8c);
+		REQUIRE(Hash("foobar", 6) == 0x85944171f73967e8);
+
+		// Hashing in pieces gives the same hash as hashing all at once
+		REQUIRE(Hash("bar", 3, Hash("foo", 3)) == Hash("foobar", 6));
+	}
+
+	SECTION("Disabled")
+	{
+		auto& cache{ Instance() };
+		cache.Terminate();
+
+		// Nothing is looked up while disabled
+		REQUIRE_FALSE(cache.Load(1, 0));
+		cache.Store(1, 0);
+		REQUIRE(cache.Get_Stats().hits == 0);
+		REQUIRE(cache.Get_Stats().misses == 0);
+		REQUIRE(cache.Get_Stats().stores == 0);
+	}
+
+	SECTION("Hit rate")
+	{
+		Stats stats{};
+		REQUIRE(stats.Get_Hit_Rate() == 0.0f);
+		stats.hits = 3;
+		stats.misses = 1;
+		REQUIRE(stats.Get_Hit_Rate() == 0.75f);
+	}
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
@@ -0,0 +1,187 @@
+/**************************************************************************************************
+ * @file   Program_Binary_Cache.hpp
+ *
+ * @brief  Stores the binaries of linked shader programs on disk so that later launches can load
+ *		   them instead of compiling and linking every shader again. Binaries are keyed by a hash
+ *		   of the sources of every part of a program along with the driver in use.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_PROGRAM_BINARY_CACHE_HPP
+#define TILIA_OPENGL_3_3_PROGRAM_BINARY_CACHE_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_CONSTANTS_INCLUDE
+
+namespace tilia
+{
+	namespace gfx
+	{
+
+		/**
+		 * @brief Singleton cache of program binaries. Program binaries are not part of openGL
+		 * 3.3, so the entry points of ARB_get_program_binary are loaded in Init and the cache
+		 * stays disabled if the driver lacks them or supports no binary formats. Must only be
+		 * used on the thread owning the context.
+		 */
+		class Program_Binary_Cache
+		{
+		public:
+
+			// Function used to load openGL entry points, such as glfwGetProcAddress
+			using Load_Proc = void* (*)(const char* name);
+
+			/**
+			 * @brief How the cache has been used since Init, for profiling.
+			 */
+			struct Stats
+			{
+				// Programs loaded from a binary
+				std::size_t hits{};
+				// Programs which had to be compiled and linked
+				std::size_t misses{};
+				// Binaries found on disk which the driver refused, also counted as misses
+				std::size_t rejected{};
+				// Binaries written to disk
+				std::size_t stores{};
+
+				/**
+				 * @brief Gets the share of lookups which were hits, 0 if there were none.
+				 */
+				float Get_Hit_Rate() const
+				{
+					const std::size_t lookups{ hits + misses };
+					return (lookups) ? static_cast<float>(hits) / static_cast<float>(lookups) :
+						0.0f;
+				}
+			}; // Stats
+
+			/**
+			 * @brief First time it is called it will construct an instance of
+			 * Program_Binary_Cache. A reference to this instance is returned to anywhere in the
+			 * program.
+			 *
+			 * @return A reference to an instance of Program_Binary_Cache.
+			 */
+			static Program_Binary_Cache& Instance()
+			{
+				static Program_Binary_Cache program_binary_cache{};
+				return program_binary_cache;
+			}
+
+			/**
+			 * @brief Loads the entry points and enables the cache if binaries are supported.
+			 * Has to be called after openGL has been loaded.
+			 *
+			 * @param directory - The directory to keep binaries in, created if missing.
+			 * @param load_proc - Used to load the entry points.
+			 *
+			 * @return Whether or not the cache was enabled.
+			 */
+			bool Init(const std::string& directory, Load_Proc load_proc);
+
+			/**
+			 * @brief Disables the cache.
+			 */
+			void Terminate();
+
+			/**
+			 * @brief Whether or not Init enabled the cache. While disabled shader parts are
+			 * compiled straight away and nothing is loaded or stored.
+			 */
+			bool Is_Enabled() const { return m_enabled; }
+
+			/**
+			 * @brief Gets the hash of the driver in use, which every key should start from.
+			 */
+			std::uint64_t Get_Driver_Hash() const { return m_driver_hash; }
+
+			/**
+			 * @brief Tries to load the binary of the given key into the given program.
+			 *
+			 * @return Whether or not the program was loaded and is linked.
+			 */
+			bool Load(std::uint32_t program, std::uint64_t key);
+
+			/**
+			 * @brief Marks the program so that the driver keeps its binary retrievable, has to be
+			 * called before linking a program which will be stored.
+			 */
+			void Prepare(std::uint32_t program) const;
+
+			/**
+			 * @brief Writes the binary of the given linked program to disk under the given key.
+			 */
+			void Store(std::uint32_t program, std::uint64_t key);
+
+			/**
+			 * @brief Gets how the cache has been used since Init.
+			 */
+			const Stats& Get_Stats() const { return m_stats; }
+
+			/**
+			 * @brief Hashes bytes with 64 bit FNV-1a, continuing from the given hash so that
+			 * several pieces of data can be hashed together.
+			 *
+			 * @param data - The bytes to hash.
+			 * @param size - The amount of bytes.
+			 * @param hash - The hash to continue from.
+			 *
+			 * @return The new hash.
+			 */
+			static std::uint64_t Hash(const void* data, std::size_t size,
+				std::uint64_t hash = s_hash_basis);
+
+			// The start of every FNV-1a hash
+			static constexpr std::uint64_t s_hash_basis{ 0xcbf29ce484222325 };
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Program_Binary_Cache. Does not need a context.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		private:
+
+			Program_Binary_Cache() = default;
+
+			// Program_Binary_Cache shan't be copyable or moveable
+			Program_Binary_Cache(const Program_Binary_Cache&) = delete;
+			Program_Binary_Cache(Program_Binary_Cache&&) = delete;
+			Program_Binary_Cache& operator=(const Program_Binary_Cache&) = delete;
+			Program_Binary_Cache& operator=(Program_Binary_Cache&&) = delete;
+
+			/**
+			 * @brief Gets the path of the file holding the binary of the given key.
+			 */
+			std::string Get_Path(std::uint64_t key) const;
+
+			// Whether or not binaries are loaded and stored
+			bool m_enabled{ false };
+
+			// Where binaries are kept
+			std::string m_directory{};
+
+			// Hash of the vendor, renderer and version of the driver
+			std::uint64_t m_driver_hash{ s_hash_basis };
+
+			// How the cache has been used
+			Stats m_stats{};
+
+		}; // Program_Binary_Cache
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_PROGRAM_BINARY_CACHE_HPP
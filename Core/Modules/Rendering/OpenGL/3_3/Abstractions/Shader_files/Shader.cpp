@@ -2,18 +2,23 @@
 #include "vendor/glad/KHR_Debug_openGL_3_3/include/glad/glad.h"
 
 // Standard
+#include <algorithm>
 
 // Tilia
 #include "Shader.hpp"
 #include "Core/Values/Directories.hpp"
 #include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
 #include TILIA_TILIA_EXCEPTION_INCLUDE
+#include TILIA_OPENGL_3_3_PROGRAM_BINARY_CACHE_INCLUDE
+#include TILIA_OPENGL_3_3_SHADER_COMPILER_INCLUDE
 
 std::uint32_t tilia::gfx::Shader::s_bound_ID{};
 std::uint32_t tilia::gfx::Shader::s_previous_ID{};
 
 tilia::gfx::Shader::~Shader()
 {
+
+	Shader_Compiler::Instance().Forget(*this);
     
 	try
 	{
@@ -63,6 +68,8 @@ void tilia::gfx::Shader::Add_Part(std::weak_ptr<Shader_Part> shader_part, const
 
 	shader_part.lock()->m_attached_to.push_back(this);
 
+	m_parts.push_back(shader_part);
+
     if (reload)
         Reload();
 
@@ -82,6 +89,11 @@ void tilia::gfx::Shader::Remove_Part(std::weak_ptr<Shader_Part> shader_part, con
 		}
 	}
 
+	const auto part{ shader_part.lock() };
+	m_parts.erase(std::remove_if(m_parts.begin(), m_parts.end(), 
+		[&part](const std::weak_ptr<Shader_Part>& attached) 
+		{ return attached.lock() == part; }), m_parts.end());
+
     if (reload)
         Reload();
 
@@ -90,14 +102,148 @@ void tilia::gfx::Shader::Remove_Part(std::weak_ptr<Shader_Part> shader_part, con
 void tilia::gfx::Shader::Reload()
 {
 
-    GL_CALL(glLinkProgram(m_ID));
-	GL_CALL(glValidateProgram(m_ID));
+	auto& compiler{ Shader_Compiler::Instance() };
+
+	if (compiler.Is_Batching())
+	{
+		compiler.Defer(*this);
+		m_link_state = Link_State::Queued;
+		return;
+	}
+
+	// Replaces a link which was submitted earlier and never finished
+	compiler.Forget(*this);
+
+	if (Load_Binary())
+		return;
+
+	Submit_Parts();
+	Link();
+	Finish_Link();
+
+}
+
+void tilia::gfx::Shader::Move_Registration(Shader& other) noexcept
+{
+
+	Shader_Compiler::Instance().Replace(other, *this);
+
+	for (auto& part : m_parts)
+	{
+		if (auto locked{ part.lock() })
+		{
+			std::replace(locked->m_attached_to.begin(), locked->m_attached_to.end(), &other,
+				this);
+		}
+	}
+
+}
+
+void tilia::gfx::Shader::Release_Registration() noexcept
+{
+
+	Shader_Compiler::Instance().Forget(*this);
+
+	for (auto& part : m_parts)
+	{
+		if (auto locked{ part.lock() })
+		{
+			auto& attached_to{ locked->m_attached_to };
+			attached_to.erase(std::remove(attached_to.begin(), attached_to.end(), this),
+				attached_to.end());
+		}
+	}
+
+}
+
+bool tilia::gfx::Shader::Is_Ready() const
+{
+
+	switch (m_link_state)
+	{
+	case Link_State::Queued:
+		return false;
+	case Link_State::Linking:
+		return Shader_Compiler::Instance().Is_Complete(m_ID);
+	default:
+		return true;
+	}
+
+}
+
+bool tilia::gfx::Shader::Load_Binary()
+{
+
+	auto& cache{ Program_Binary_Cache::Instance() };
+
+	if (!cache.Is_Enabled())
+		return false;
+
+	m_binary_key = Get_Binary_Key();
+
+	if (!cache.Load(m_ID, m_binary_key))
+		return false;
+
+	m_link_state = Link_State::Linked;
+
+	Introspect();
+
+	return true;
+
+}
+
+void tilia::gfx::Shader::Submit_Parts()
+{
+	for (auto& part : m_parts)
+	{
+		if (auto locked{ part.lock() })
+			locked->Submit();
+	}
+}
+
+void tilia::gfx::Shader::Link()
+{
+
+	// Without the binary the program has to be linked, and stored once it is
+	Program_Binary_Cache::Instance().Prepare(m_ID);
+
+	GL_CALL(glLinkProgram(m_ID));
+
+	m_link_state = Link_State::Linking;
+
+}
+
+void tilia::gfx::Shader::Finish_Link()
+{
+
+	if (m_link_state == Link_State::Linked)
+		return;
+
+	Shader_Compiler::Instance().Forget(*this);
+
+	if (m_link_state == Link_State::Queued)
+	{
+		// Used before the batch it was queued in ended
+		if (Load_Binary())
+			return;
+
+		Submit_Parts();
+		Link();
+	}
 
     std::int32_t result;
 
 	GL_CALL(glGetProgramiv(m_ID, GL_LINK_STATUS, &result));
 
 	if (result == GL_FALSE) {
+
+		// A part failing to compile tells more than the link failing does
+		for (auto& part : m_parts)
+		{
+			if (auto locked{ part.lock() })
+				locked->Ensure_Compiled();
+		}
+
 		std::int32_t length;
 
 		GL_CALL(glGetProgramiv(m_ID, GL_INFO_LOG_LENGTH, &length));
@@ -113,20 +259,244 @@ void tilia::gfx::Shader::Reload()
 
 	}
 
+	// Only once the link succeeded, so a failed link is reported every time the shader is used
+	// until it is reloaded
+	m_link_state = Link_State::Linked;
+
+	GL_CALL(glValidateProgram(m_ID));
+
+	auto& cache{ Program_Binary_Cache::Instance() };
+	if (cache.Is_Enabled())
+		cache.Store(m_ID, m_binary_key);
+
+	Introspect();
+
+}
+
+std::uint64_t tilia::gfx::Shader::Get_Binary_Key() const
+{
+
+	auto& cache{ Program_Binary_Cache::Instance() };
+
+	std::uint64_t key{ cache.Get_Driver_Hash() };
+
+	for (auto& part : m_parts)
+	{
+		const auto locked{ part.lock() };
+		if (!locked)
+			continue;
+
+		const auto type{ *locked->m_type };
+		key = cache.Hash(&type, sizeof(type), key);
+		key = cache.Hash(locked->m_source.data(), locked->m_source.size(), key);
+	}
+
+	return key;
+
+}
+
+void tilia::gfx::Shader::Introspect()
+{
+
+	// Locations may have moved when relinking
+	m_location_cache.clear();
+	m_block_indices.clear();
+	m_uniforms.clear();
+
+	std::int32_t count{};
+	std::int32_t max_length{};
+
+	GL_CALL(glGetProgramiv(m_ID, GL_ACTIVE_UNIFORMS, &count));
+	GL_CALL(glGetProgramiv(m_ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length));
+
+	std::vector<char> name(static_cast<std::size_t>(std::max(max_length, 1)));
+
+	for (std::int32_t i{ 0 }; i < count; ++i)
+	{
+		GLsizei length{};
+		Uniform_Info info{};
+
+		GL_CALL(glGetActiveUniform(m_ID, static_cast<std::uint32_t>(i), max_length, &length, 
+			&info.count, &info.type, name.data()));
+		info.name.assign(name.data(), static_cast<std::size_t>(length));
+
+		GL_CALL(info.location = glGetUniformLocation(m_ID, info.name.c_str()));
+
+		// Members of uniform blocks have no location
+		if (info.location < 0)
+			continue;
+
+		m_location_cache[info.name] = info.location;
+
+		// Arrays are named with [0] at the end but can be set by their name alone
+		constexpr std::size_t suffix_length{ 3 };
+		if (info.name.size() > suffix_length && 
+			info.name.compare(info.name.size() - suffix_length, suffix_length, "[0]") == 0)
+		{
+			m_location_cache[info.name.substr(0, info.name.size() - suffix_length)] = 
+				info.location;
+		}
+
+		m_uniforms.push_back(std::move(info));
+	}
+
+	GL_CALL(glGetProgramiv(m_ID, GL_ACTIVE_UNIFORM_BLOCKS, &count));
+	GL_CALL(glGetProgramiv(m_ID, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_length));
+
+	name.resize(static_cast<std::size_t>(std::max(max_length, 1)));
+
+	for (std::int32_t i{ 0 }; i < count; ++i)
+	{
+		GLsizei length{};
+
+		GL_CALL(glGetActiveUniformBlockName(m_ID, static_cast<std::uint32_t>(i), max_length, 
+			&length, name.data()));
+
+		m_block_indices[std::string(name.data(), static_cast<std::size_t>(length))] = 
+			static_cast<std::uint32_t>(i);
+	}
+
+	// Names such as an element of an array are not listed and have to be looked up
+	const std::size_t handle_count{ m_handle_names.size() };
+	for (std::size_t i{ 0 }; i < handle_count; ++i)
+	{
+		m_handle_locations[i] = Get_Uniform_Location(m_handle_names[i]);
+	}
+
+	// Linking forgets the bindings, blocks which are not active are left for a later link
+	for (const auto& [block_name, block_index] : m_block_bindings)
+	{
+		const auto found{ m_block_indices.find(block_name) };
+		if (found != m_block_indices.end())
+		{
+			GL_CALL(glUniformBlockBinding(m_ID, found->second, block_index));
+		}
+	}
+
 }
 
 void tilia::gfx::Shader::Bind_Uniform_Block(const std::string& block_name, 
 	const std::uint32_t& block_index)
 {
+	m_block_bindings[block_name] = block_index;
+
+	// Set once the link finishes, so that the shader is not waited on
+	if (m_link_state != Link_State::Linked)
+		return;
+
 	GL_CALL(glUniformBlockBinding(m_ID, Get_Uniform_Block_Index(block_name), block_index));
 }
 
-void tilia::gfx::Shader::Bind() const {
+void tilia::gfx::Shader::Copy_Uniforms(Shader& source)
+{
+
+	source.Finish_Link();
+	Finish_Link();
+
+	for (const auto& uniform : source.m_uniforms)
+	{
+		// Uniforms may be left out of this shader, such as by the features of a variant
+		if (m_location_cache.count(uniform.name) == 0)
+			continue;
+
+		// Samplers and booleans are read and set as integers
+		enum class Kind { Float, Int, Uint } kind{ Kind::Int };
+		std::size_t size_x{ 1 }, size_y{ 1 };
+
+		switch (uniform.type)
+		{
+		case GL_FLOAT:				kind = Kind::Float; break;
+		case GL_FLOAT_VEC2:			kind = Kind::Float; size_x = 2; break;
+		case GL_FLOAT_VEC3:			kind = Kind::Float; size_x = 3; break;
+		case GL_FLOAT_VEC4:			kind = Kind::Float; size_x = 4; break;
+		case GL_FLOAT_MAT2:			kind = Kind::Float; size_x = 2; size_y = 2; break;
+		case GL_FLOAT_MAT3:			kind = Kind::Float; size_x = 3; size_y = 3; break;
+		case GL_FLOAT_MAT4:			kind = Kind::Float; size_x = 4; size_y = 4; break;
+		case GL_FLOAT_MAT2x3:		kind = Kind::Float; size_x = 2; size_y = 3; break;
+		case GL_FLOAT_MAT2x4:		kind = Kind::Float; size_x = 2; size_y = 4; break;
+		case GL_FLOAT_MAT3x2:		kind = Kind::Float; size_x = 3; size_y = 2; break;
+		case GL_FLOAT_MAT3x4:		kind = Kind::Float; size_x = 3; size_y = 4; break;
+		case GL_FLOAT_MAT4x2:		kind = Kind::Float; size_x = 4; size_y = 2; break;
+		case GL_FLOAT_MAT4x3:		kind = Kind::Float; size_x = 4; size_y = 3; break;
+		case GL_INT_VEC2:			case GL_BOOL_VEC2: size_x = 2; break;
+		case GL_INT_VEC3:			case GL_BOOL_VEC3: size_x = 3; break;
+		case GL_INT_VEC4:			case GL_BOOL_VEC4: size_x = 4; break;
+		case GL_UNSIGNED_INT:		kind = Kind::Uint; break;
+		case GL_UNSIGNED_INT_VEC2:	kind = Kind::Uint; size_x = 2; break;
+		case GL_UNSIGNED_INT_VEC3:	kind = Kind::Uint; size_x = 3; break;
+		case GL_UNSIGNED_INT_VEC4:	kind = Kind::Uint; size_x = 4; break;
+		default:					break;
+		}
+
+		// Elements of arrays are read one at a time, as their locations may not follow
+		constexpr std::size_t suffix_length{ 3 };
+		const bool is_array{ uniform.count > 1 };
+		const std::string base{ (is_array) ?
+			uniform.name.substr(0, uniform.name.size() - suffix_length) : uniform.name };
+
+		for (std::int32_t i{ 0 }; i < uniform.count; ++i)
+		{
+			const std::string name{ (is_array) ?
+				base + "[" + std::to_string(i) + "]" : base };
+
+			const std::int32_t from{ source.Get_Uniform_Location(name) };
+			const std::int32_t to{ Get_Uniform_Location(name) };
+			if (from < 0 || to < 0)
+				continue;
+
+			if (kind == Kind::Float)
+			{
+				float values[16]{};
+				GL_CALL(glGetUniformfv(source.m_ID, from, values));
+				if (size_y > 1)
+					Set_Uniform(to, values, size_x, size_y);
+				else
+					Set_Uniform(to, values, size_x);
+			}
+			else if (kind == Kind::Int)
+			{
+				std::int32_t values[4]{};
+				GL_CALL(glGetUniformiv(source.m_ID, from, values));
+				Set_Uniform(to, values, size_x);
+			}
+			else
+			{
+				std::uint32_t values[4]{};
+				GL_CALL(glGetUniformuiv(source.m_ID, from, values));
+				Set_Uniform(to, values, size_x);
+			}
+		}
+	}
+
+}
+
+tilia::gfx::Shader::Uniform_Handle tilia::gfx::Shader::Get_Uniform_Handle(
+	const std::string& name)
+{
+
+	Finish_Link();
+
+	const auto found{ m_handles.find(name) };
+	if (found != m_handles.end())
+		return { found->second };
+
+	const auto index{ static_cast<std::uint32_t>(m_handle_names.size()) };
+
+	m_handle_names.push_back(name);
+	m_handle_locations.push_back((m_ID) ? Get_Uniform_Location(name) : -1);
+	m_handles.emplace(name, index);
+
+	return { index };
+
+}
+
+void tilia::gfx::Shader::Bind() {
     if (!m_ID)
 	{
 		throw utils::Tilia_Exception{ { TILIA_LOCATION,
 		"Failed to bind shader { ID: ", m_ID, " }" } };
 	}
+	Finish_Link();
     GL_CALL(glUseProgram(m_ID));
     s_bound_ID = m_ID;
 }
@@ -165,26 +535,27 @@ void tilia::gfx::Shader::Rebind() {
 					   if (m_ID == s_bound_ID && m_ID != s_previous_ID)\
                        { Rebind(); }
 
-void tilia::gfx::Shader::Uniform(const std::string& loc, const float* vs, const std::size_t& size)
+void tilia::gfx::Shader::Set_Uniform(const std::int32_t& location, const float* vs, 
+	const std::size_t& size)
 {
 	try {
 		switch (size)
 		{
 		case 1:
-			SET_UNIFORM(GL_CALL(glUniform1f(Get_Uniform_Location(loc), vs[0])));
+			SET_UNIFORM(GL_CALL(glUniform1f(location, vs[0])));
 			return;
 		case 2:
-			SET_UNIFORM(GL_CALL(glUniform2f(Get_Uniform_Location(loc), vs[0], vs[1])));
+			SET_UNIFORM(GL_CALL(glUniform2f(location, vs[0], vs[1])));
 			return;
 		case 3:
-			SET_UNIFORM(GL_CALL(glUniform3f(Get_Uniform_Location(loc), vs[0], vs[1], vs[2])));
+			SET_UNIFORM(GL_CALL(glUniform3f(location, vs[0], vs[1], vs[2])));
 			return;
 		case 4:
-			SET_UNIFORM(GL_CALL(glUniform4f(Get_Uniform_Location(loc), vs[0], vs[1], vs[2], 
+			SET_UNIFORM(GL_CALL(glUniform4f(location, vs[0], vs[1], vs[2], 
 				vs[3])));
 			return;
 		default:
-			SET_UNIFORM(GL_CALL(glUniform1fv(Get_Uniform_Location(loc), static_cast<GLsizei>(size), 
+			SET_UNIFORM(GL_CALL(glUniform1fv(location, static_cast<GLsizei>(size), 
 				vs)))
 				return;
 		}
@@ -195,27 +566,27 @@ void tilia::gfx::Shader::Uniform(const std::string& loc, const float* vs, const
 	}
 }
 
-void tilia::gfx::Shader::Uniform(const std::string& loc, const std::int32_t* vs, 
+void tilia::gfx::Shader::Set_Uniform(const std::int32_t& location, const std::int32_t* vs, 
 	const std::size_t& size)
 {
 	try {
 		switch (size)
 		{
 		case 1:
-			SET_UNIFORM(GL_CALL(glUniform1i(Get_Uniform_Location(loc), vs[0])));
+			SET_UNIFORM(GL_CALL(glUniform1i(location, vs[0])));
 			return;
 		case 2:
-			SET_UNIFORM(GL_CALL(glUniform2i(Get_Uniform_Location(loc), vs[0], vs[1])));
+			SET_UNIFORM(GL_CALL(glUniform2i(location, vs[0], vs[1])));
 			return;
 		case 3:
-			SET_UNIFORM(GL_CALL(glUniform3i(Get_Uniform_Location(loc), vs[0], vs[1], vs[2])));
+			SET_UNIFORM(GL_CALL(glUniform3i(location, vs[0], vs[1], vs[2])));
 			return;
 		case 4:
-			SET_UNIFORM(GL_CALL(glUniform4i(Get_Uniform_Location(loc), vs[0], vs[1], vs[2], 
+			SET_UNIFORM(GL_CALL(glUniform4i(location, vs[0], vs[1], vs[2], 
 				vs[3])));
 			return;
 		default:
-			SET_UNIFORM(GL_CALL(glUniform1iv(Get_Uniform_Location(loc), static_cast<GLsizei>(size), 
+			SET_UNIFORM(GL_CALL(glUniform1iv(location, static_cast<GLsizei>(size), 
 				vs)))
 				return;
 		}
@@ -226,27 +597,27 @@ void tilia::gfx::Shader::Uniform(const std::string& loc, const std::int32_t* vs,
 	}
 }
 
-void tilia::gfx::Shader::Uniform(const std::string& loc, const std::uint32_t* vs, 
+void tilia::gfx::Shader::Set_Uniform(const std::int32_t& location, const std::uint32_t* vs, 
 	const std::size_t& size)
 {
 	try {
 		switch (size)
 		{
 		case 1:
-			SET_UNIFORM(GL_CALL(glUniform1ui(Get_Uniform_Location(loc), vs[0])));
+			SET_UNIFORM(GL_CALL(glUniform1ui(location, vs[0])));
 			return;
 		case 2:
-			SET_UNIFORM(GL_CALL(glUniform2ui(Get_Uniform_Location(loc), vs[0], vs[1])));
+			SET_UNIFORM(GL_CALL(glUniform2ui(location, vs[0], vs[1])));
 			return;
 		case 3:
-			SET_UNIFORM(GL_CALL(glUniform3ui(Get_Uniform_Location(loc), vs[0], vs[1], vs[2])));
+			SET_UNIFORM(GL_CALL(glUniform3ui(location, vs[0], vs[1], vs[2])));
 			return;
 		case 4:
-			SET_UNIFORM(GL_CALL(glUniform4ui(Get_Uniform_Location(loc), vs[0], vs[1], vs[2], 
+			SET_UNIFORM(GL_CALL(glUniform4ui(location, vs[0], vs[1], vs[2], 
 				vs[3])));
 			return;
 		default:
-			SET_UNIFORM(GL_CALL(glUniform1uiv(Get_Uniform_Location(loc), 
+			SET_UNIFORM(GL_CALL(glUniform1uiv(location, 
 				static_cast<GLsizei>(size), vs)))
 				return;
 		}
@@ -257,7 +628,7 @@ void tilia::gfx::Shader::Uniform(const std::string& loc, const std::uint32_t* vs
 	}
 }
 
-void tilia::gfx::Shader::Uniform(const std::string& loc, const float* vs, 
+void tilia::gfx::Shader::Set_Uniform(const std::int32_t& location, const float* vs, 
 	const std::size_t& size_x, const std::size_t& size_y)
 {
 
@@ -268,15 +639,15 @@ void tilia::gfx::Shader::Uniform(const std::string& loc, const float* vs,
 			switch (size_y)
 			{
 			case 2:
-				SET_UNIFORM(GL_CALL(glUniformMatrix2fv(Get_Uniform_Location(loc), 1, GL_FALSE, 
+				SET_UNIFORM(GL_CALL(glUniformMatrix2fv(location, 1, GL_FALSE, 
 					vs)))
 				return;
 			case 3:
-				SET_UNIFORM(GL_CALL(glUniformMatrix2x3fv(Get_Uniform_Location(loc), 1, GL_FALSE, 
+				SET_UNIFORM(GL_CALL(glUniformMatrix2x3fv(location, 1, GL_FALSE, 
 					vs)))
 				return;
 			case 4:
-				SET_UNIFORM(GL_CALL(glUniformMatrix2x4fv(Get_Uniform_Location(loc), 1, GL_FALSE, 
+				SET_UNIFORM(GL_CALL(glUniformMatrix2x4fv(location, 1, GL_FALSE, 
 					vs)))
 				return;
 			}
@@ -285,15 +656,15 @@ void tilia::gfx::Shader::Uniform(const std::string& loc, const float* vs,
 			switch (size_y)
 			{
 			case 2:
-				SET_UNIFORM(GL_CALL(glUniformMatrix3x2fv(Get_Uniform_Location(loc), 1, GL_FALSE, 
+				SET_UNIFORM(GL_CALL(glUniformMatrix3x2fv(location, 1, GL_FALSE, 
 					vs)))
 				return;
 			case 3:
-				SET_UNIFORM(GL_CALL(glUniformMatrix3fv(Get_Uniform_Location(loc), 1, GL_FALSE, 
+				SET_UNIFORM(GL_CALL(glUniformMatrix3fv(location, 1, GL_FALSE, 
 					vs)))
 				return;
 			case 4:
-				SET_UNIFORM(GL_CALL(glUniformMatrix3x4fv(Get_Uniform_Location(loc), 1, GL_FALSE, 
+				SET_UNIFORM(GL_CALL(glUniformMatrix3x4fv(location, 1, GL_FALSE, 
 					vs)))
 				return;
 			}
@@ -302,15 +673,15 @@ void tilia::gfx::Shader::Uniform(const std::string& loc, const float* vs,
 			switch (size_y)
 			{
 			case 2:
-				SET_UNIFORM(GL_CALL(glUniformMatrix4x2fv(Get_Uniform_Location(loc), 1, GL_FALSE, 
+				SET_UNIFORM(GL_CALL(glUniformMatrix4x2fv(location, 1, GL_FALSE, 
 					vs)))
 				return;
 			case 3:
-				SET_UNIFORM(GL_CALL(glUniformMatrix4x3fv(Get_Uniform_Location(loc), 1, GL_FALSE, 
+				SET_UNIFORM(GL_CALL(glUniformMatrix4x3fv(location, 1, GL_FALSE, 
 					vs)))
 				return;
 			case 4:
-				SET_UNIFORM(GL_CALL(glUniformMatrix4fv(Get_Uniform_Location(loc), 1, GL_FALSE, 
+				SET_UNIFORM(GL_CALL(glUniformMatrix4fv(location, 1, GL_FALSE, 
 					vs)))
 				return;
 			}
@@ -326,12 +697,14 @@ void tilia::gfx::Shader::Uniform(const std::string& loc, const float* vs,
 
 std::int32_t tilia::gfx::Shader::Get_Uniform_Location(const std::string& name)
 {
-	if (m_location_cache.find(name) != m_location_cache.end())
-		return m_location_cache[name];
+	Finish_Link();
 
-	GL_CALL(std::int32_t location = glGetUniformLocation(m_ID, name.c_str()));
+	const auto found{ m_location_cache.find(name) };
+	if (found != m_location_cache.end())
+		return found->second;
 
-	// Check is -1
+	// Not one of the active uniforms listed when linking, such as an element of an array
+	GL_CALL(std::int32_t location = glGetUniformLocation(m_ID, name.c_str()));
 
 	m_location_cache[name] = location;
 
@@ -340,14 +713,21 @@ std::int32_t tilia::gfx::Shader::Get_Uniform_Location(const std::string& name)
 
 std::int32_t tilia::gfx::Shader::Get_Uniform_Block_Index(const std::string& name)
 {
-	if (m_location_cache.find(name) != m_location_cache.end())
-		return m_location_cache[name];
+	Finish_Link();
 
-	GL_CALL(std::int32_t location = glGetUniformBlockIndex(m_ID, name.c_str()));
+	const auto found{ m_block_indices.find(name) };
+	if (found != m_block_indices.end())
+		return static_cast<std::int32_t>(found->second);
 
-	// Check is -1
+	GL_CALL(std::uint32_t index = glGetUniformBlockIndex(m_ID, name.c_str()));
 
-	m_location_cache[name] = location;
+	if (index == GL_INVALID_INDEX)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Shader { ID: ", m_ID, " } has no active uniform block named ", name } };
+	}
 
-	return location;
-}
\ No newline at end of file
+	m_block_indices[name] = index;
+
+	return static_cast<std::int32_t>(index);
+}
@@ -32,12 +32,40 @@ namespace tilia
 {
 	namespace gfx 
 	{
+
+		// Predefinition
+		class Shader_Variants;
+
 		/**
 		 * @brief Abstraction for openGL shader. Backend for Shader class.
 		 */
 		class Shader {
 		public:
 
+			/**
+			 * @brief A small integer naming a uniform of a shader. Setting a uniform through a
+			 * handle only indexes an array, and handles stay valid when the shader is reloaded.
+			 */
+			struct Uniform_Handle
+			{
+				std::uint32_t index{};
+			}; // Uniform_Handle
+
+			/**
+			 * @brief An active uniform of the linked program, found by introspection.
+			 */
+			struct Uniform_Info
+			{
+				// The name, where arrays end with [0]
+				std::string name{};
+				// The location
+				std::int32_t location{ -1 };
+				// The openGL type such as GL_FLOAT_VEC3
+				std::uint32_t type{};
+				// The amount of elements, which is 1 for non arrays
+				std::int32_t count{};
+			}; // Uniform_Info
+
 			Shader() = default;
 
 			~Shader();
@@ -51,6 +79,9 @@ namespace tilia
 			Shader(const Shader& other) noexcept
 			{
 				m_location_cache = other.m_location_cache;
+				m_handle_names = other.m_handle_names;
+				m_handle_locations = other.m_handle_locations;
+				m_handles = other.m_handles;
 			}
 			/**
 			 * @brief Move-constructor which moves all resources from given Shader_Data and then
@@ -62,7 +93,19 @@ namespace tilia
 			{
 				m_ID = other.m_ID;
 				other.m_ID = 0;
+				m_parts = std::move(other.m_parts);
+				m_link_state = other.m_link_state;
+				m_binary_key = other.m_binary_key;
+				m_variants = other.m_variants;
+				m_variant_mask = other.m_variant_mask;
+				m_block_bindings = std::move(other.m_block_bindings);
 				m_location_cache = std::move(other.m_location_cache);
+				m_block_indices = std::move(other.m_block_indices);
+				m_uniforms = std::move(other.m_uniforms);
+				m_handle_names = std::move(other.m_handle_names);
+				m_handle_locations = std::move(other.m_handle_locations);
+				m_handles = std::move(other.m_handles);
+				Move_Registration(other);
 			}
 
 			Shader& operator=(const Shader& other) noexcept
@@ -71,6 +114,9 @@ namespace tilia
 					return *this;
 
 				m_location_cache = other.m_location_cache;
+				m_handle_names = other.m_handle_names;
+				m_handle_locations = other.m_handle_locations;
+				m_handles = other.m_handles;
 
 				return *this;
 			}
@@ -80,9 +126,23 @@ namespace tilia
 				if (&other == this)
 					return *this;
 
+				Release_Registration();
+
 				m_ID = other.m_ID;
 				other.m_ID = 0;
+				m_parts = std::move(other.m_parts);
+				m_link_state = other.m_link_state;
+				m_binary_key = other.m_binary_key;
+				m_variants = other.m_variants;
+				m_variant_mask = other.m_variant_mask;
+				m_block_bindings = std::move(other.m_block_bindings);
 				m_location_cache = std::move(other.m_location_cache);
+				m_block_indices = std::move(other.m_block_indices);
+				m_uniforms = std::move(other.m_uniforms);
+				m_handle_names = std::move(other.m_handle_names);
+				m_handle_locations = std::move(other.m_handle_locations);
+				m_handles = std::move(other.m_handles);
+				Move_Registration(other);
 
 				return *this;
 			}
@@ -95,17 +155,95 @@ namespace tilia
 
 			void Remove_Part(std::weak_ptr<Shader_Part> shader_part, const bool& reload = true);
 
+			/**
+			 * @brief Links the program and then finds its active uniforms and uniform blocks,
+			 * updating the locations of every handle. If the program binary cache is enabled
+			 * the program is loaded from its binary when one matches the sources of the parts,
+			 * otherwise the parts are compiled and linked and the binary is stored. During a
+			 * batch of the Shader_Compiler the program is only queued, and is linked once
+			 * the batch ends no matter how many times it was reloaded.
+			 */
 			void Reload();
 
+			/**
+			 * @brief Whether or not the program can be used without waiting on the driver.
+			 * False while queued in a batch and, if the driver compiles in parallel, while it
+			 * is still being linked.
+			 */
+			bool Is_Ready() const;
+
 			inline auto Get_ID() { return m_ID; }
 
+			/**
+			 * @brief Binds a uniform block to a binding point. The binding is remembered and
+			 * set again every time the program is linked, and is only set once the link has
+			 * finished if the shader is not yet ready.
+			 *
+			 * @param block_name - The name of the uniform block.
+			 * @param block_index - The binding point.
+			 */
 			void Bind_Uniform_Block(const std::string& block_name, 
 				const std::uint32_t& block_index);
 
 			/**
-			 * @brief Binds the shader.
+			 * @brief Gets the variants the shader is one of, nullptr if it is not a variant.
+			 */
+			Shader_Variants* Get_Variants() const { return m_variants; }
+
+			/**
+			 * @brief Gets the features of the variant the shader is, 0 if it is not a variant.
 			 */
-			void Bind() const;
+			std::uint32_t Get_Variant_Mask() const { return m_variant_mask; }
+
+			/**
+			 * @brief Gets the handle of a uniform, handing out a new one the first time a name is
+			 * asked for. Names of uniforms which are not active get a handle as well, setting
+			 * through it does nothing until a reload makes the uniform active.
+			 *
+			 * @param name - The name of the uniform.
+			 *
+			 * @return The handle.
+			 */
+			Uniform_Handle Get_Uniform_Handle(const std::string& name);
+
+			/**
+			 * @brief Gets the location of the uniform of a handle, which is -1 if the uniform is
+			 * not active.
+			 */
+			std::int32_t Get_Location(const Uniform_Handle& handle)
+			{
+				Finish_Link();
+				return m_handle_locations[handle.index];
+			}
+
+			/**
+			 * @brief Gets the active uniforms found when the program was last linked. Members of
+			 * uniform blocks are not included, and nothing is found until the shader has been
+			 * used or is ready.
+			 */
+			const std::vector<Uniform_Info>& Get_Active_Uniforms() const { return m_uniforms; }
+
+			/**
+			 * @brief Gets the indices of the active uniform blocks found when the program was
+			 * last linked.
+			 */
+			const std::unordered_map<std::string, std::uint32_t>& Get_Active_Uniform_Blocks() const
+			{
+				return m_block_indices;
+			}
+
+			/**
+			 * @brief Sets every uniform outside of uniform blocks which is active in both shaders
+			 * to the value it has in the source, waiting for both to be linked.
+			 *
+			 * @param source - The shader to read the values from.
+			 */
+			void Copy_Uniforms(Shader& source);
+
+			/**
+			 * @brief Binds the shader, first waiting for it to be linked if it is not yet.
+			 */
+			void Bind();
 
 			/**
 			 * @brief Binds the given shader.
@@ -137,32 +275,186 @@ namespace tilia
 			template<typename T, glm::length_t size, glm::qualifier Q,
 			std::enable_if_t<std::is_same<float, T>::value || std::is_same<std::int32_t, T>::value 
 				|| std::is_same<std::uint32_t, T>::value>* = nullptr>
-			void Uniform(const std::string& loc, glm::vec<size, T, Q> v)
+			void Uniform(const std::string& loc, const glm::vec<size, T, Q>& v)
 			{
 				Uniform(loc, glm::value_ptr(v), size);
 			}
 
 			template<glm::length_t size_x, glm::length_t size_y, glm::qualifier Q>
-			void Uniform(const std::string& loc, glm::mat<size_x, size_y, float, Q> v)
+			void Uniform(const std::string& loc, const glm::mat<size_x, size_y, float, Q>& v)
 			{
 				Uniform(loc, glm::value_ptr(v), size_x, size_y);
 			}
 
-			void Uniform(const std::string& loc, const float* vs, const std::size_t& size);
+			void Uniform(const std::string& loc, const float* vs, const std::size_t& size)
+			{
+				Set_Uniform(Get_Uniform_Location(loc), vs, size);
+			}
 
-			void Uniform(const std::string& loc, const std::int32_t* vs, const std::size_t& size);
+			void Uniform(const std::string& loc, const std::int32_t* vs, const std::size_t& size)
+			{
+				Set_Uniform(Get_Uniform_Location(loc), vs, size);
+			}
 
-			void Uniform(const std::string& loc, const std::uint32_t* vs, const std::size_t& size);
+			void Uniform(const std::string& loc, const std::uint32_t* vs, const std::size_t& size)
+			{
+				Set_Uniform(Get_Uniform_Location(loc), vs, size);
+			}
 
 			void Uniform(const std::string& loc, const float* vs, const std::size_t& size_x, 
-				const std::size_t& size_y);
+				const std::size_t& size_y)
+			{
+				Set_Uniform(Get_Uniform_Location(loc), vs, size_x, size_y);
+			}
+
+			template<typename T,
+			std::enable_if_t<std::is_same<float, T>::value || std::is_same<std::int32_t, T>::value 
+				|| std::is_same<std::uint32_t, T>::value>* = nullptr>
+			void Uniform(const Uniform_Handle& handle, std::initializer_list<T> vs)
+			{
+				Set_Uniform(Get_Location(handle), vs.begin(), vs.size());
+			}
+
+			template<typename T, glm::length_t size, glm::qualifier Q,
+			std::enable_if_t<std::is_same<float, T>::value || std::is_same<std::int32_t, T>::value 
+				|| std::is_same<std::uint32_t, T>::value>* = nullptr>
+			void Uniform(const Uniform_Handle& handle, const glm::vec<size, T, Q>& v)
+			{
+				Set_Uniform(Get_Location(handle), glm::value_ptr(v), size);
+			}
+
+			template<glm::length_t size_x, glm::length_t size_y, glm::qualifier Q>
+			void Uniform(const Uniform_Handle& handle, 
+				const glm::mat<size_x, size_y, float, Q>& v)
+			{
+				Set_Uniform(Get_Location(handle), glm::value_ptr(v), size_x, size_y);
+			}
+
+			template<typename T,
+			std::enable_if_t<std::is_same<float, T>::value || std::is_same<std::int32_t, T>::value 
+				|| std::is_same<std::uint32_t, T>::value>* = nullptr>
+			void Uniform(const Uniform_Handle& handle, const T* vs, const std::size_t& size)
+			{
+				Set_Uniform(Get_Location(handle), vs, size);
+			}
+
+			void Uniform(const Uniform_Handle& handle, const float* vs, const std::size_t& size_x,
+				const std::size_t& size_y)
+			{
+				Set_Uniform(Get_Location(handle), vs, size_x, size_y);
+			}
 
 		private:
 
+			friend class Shader_Compiler;
+			friend class Shader_Variants;
+
+			/**
+			 * @brief Where the program is in being linked.
+			 */
+			enum class Link_State
+			{
+				// Linked and introspected
+				Linked,
+				// Waiting for the batch it was reloaded in to end
+				Queued,
+				// Handed to the driver without asking for the result, or failed to link
+				Linking
+			}; // Link_State
+
 			std::uint32_t m_ID{};
 
+			// Where the program is in being linked
+			Link_State m_link_state{ Link_State::Linked };
+
+			// The key of the program in the program binary cache when it was last reloaded
+			std::uint64_t m_binary_key{};
+
+			// The variants the shader is one of and the features of the variant it is
+			Shader_Variants* m_variants{};
+			std::uint32_t m_variant_mask{};
+
+			// The binding point of every uniform block which has been bound
+			std::unordered_map<std::string, std::uint32_t> m_block_bindings{};
+
+			// The attached parts, in the order they were attached
+			std::vector<std::weak_ptr<Shader_Part>> m_parts{};
+
 			std::unordered_map<std::string, std::int32_t> m_location_cache{};
 
+			// The indices of the active uniform blocks by name
+			std::unordered_map<std::string, std::uint32_t> m_block_indices{};
+
+			// The active uniforms found when the program was last linked
+			std::vector<Uniform_Info> m_uniforms{};
+
+			// The names and locations of the handed out handles, indexed by handle
+			std::vector<std::string> m_handle_names{};
+			std::vector<std::int32_t> m_handle_locations{};
+			// The handle of every name which has been handed one
+			std::unordered_map<std::string, std::uint32_t> m_handles{};
+
+			/**
+			 * @brief Makes the compiler and the attached parts, which keep pointers to the
+			 * given shader, point to this shader instead. Called once this shader has taken
+			 * the program and parts of the given one.
+			 */
+			void Move_Registration(Shader& other) noexcept;
+
+			/**
+			 * @brief Makes the compiler and the attached parts forget this shader, before it
+			 * is given the program and parts of another.
+			 */
+			void Release_Registration() noexcept;
+
+			/**
+			 * @brief Finds the active uniforms and uniform blocks of the linked program,
+			 * updates the locations of the handles and sets the bound uniform blocks.
+			 */
+			void Introspect();
+
+			/**
+			 * @brief Gets the key of the program in the program binary cache, which is a hash of
+			 * the types and sources of every part.
+			 */
+			std::uint64_t Get_Binary_Key() const;
+
+			/**
+			 * @brief Tries to load the program from the program binary cache.
+			 *
+			 * @return Whether or not the program was loaded, in which case it is linked.
+			 */
+			bool Load_Binary();
+
+			/**
+			 * @brief Hands every part which has not been compiled to the driver, without asking
+			 * for the results.
+			 */
+			void Submit_Parts();
+
+			/**
+			 * @brief Hands the program to the driver to be linked, without asking for the result.
+			 */
+			void Link();
+
+			/**
+			 * @brief Waits for the link of the program if one is queued or submitted, throwing
+			 * if it failed and otherwise storing its binary and introspecting it.
+			 */
+			void Finish_Link();
+
+			void Set_Uniform(const std::int32_t& location, const float* vs, 
+				const std::size_t& size);
+
+			void Set_Uniform(const std::int32_t& location, const std::int32_t* vs, 
+				const std::size_t& size);
+
+			void Set_Uniform(const std::int32_t& location, const std::uint32_t* vs, 
+				const std::size_t& size);
+
+			void Set_Uniform(const std::int32_t& location, const float* vs, 
+				const std::size_t& size_x, const std::size_t& size_y);
+
 			std::int32_t Get_Uniform_Location(const std::string& name);
 
 			std::int32_t Get_Uniform_Block_Index(const std::string& name);
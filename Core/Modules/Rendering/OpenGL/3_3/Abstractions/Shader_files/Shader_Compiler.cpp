@@ -0,0 +1,233 @@
+// Vendor
+#include "vendor/glad/KHR_Debug_openGL_3_3/include/glad/glad.h"
+
+// Standard
+#include <algorithm>
+
+// Tilia
+#include "Shader_Compiler.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+#include TILIA_OPENGL_3_3_SHADER_INCLUDE
+#include TILIA_OPENGL_3_3_SHADER_PART_INCLUDE
+#include TILIA_OPENGL_3_3_UTILS_INCLUDE
+
+// The parts of KHR_parallel_shader_compile which are not in the openGL 3.3 headers, the ARB
+// extension uses the same value
+static constexpr GLenum COMPLETION_STATUS{ 0x91B1 };
+// Lets the driver use as many threads as it wants
+static constexpr GLuint ANY_THREAD_COUNT{ 0xFFFFFFFF };
+
+typedef void (APIENTRYP Max_Shader_Compiler_Threads_Proc)(GLuint count);
+
+bool tilia::gfx::Shader_Compiler::Init(Load_Proc load_proc)
+{
+
+	m_parallel = false;
+
+	try
+	{
+
+		const char* name{};
+		if (utils::Has_Extension("GL_KHR_parallel_shader_compile"))
+			name = "glMaxShaderCompilerThreadsKHR";
+		else if (utils::Has_Extension("GL_ARB_parallel_shader_compile"))
+			name = "glMaxShaderCompilerThreadsARB";
+		else
+			return false;
+
+		const auto max_shader_compiler_threads{
+			reinterpret_cast<Max_Shader_Compiler_Threads_Proc>(load_proc(name)) };
+		if (!max_shader_compiler_threads)
+			return false;
+
+		GL_CALL(max_shader_compiler_threads(ANY_THREAD_COUNT));
+
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION, "Failed to init shader compiler" });
+	}
+
+	m_parallel = true;
+
+	return true;
+
+}
+
+void tilia::gfx::Shader_Compiler::Terminate()
+{
+	m_parallel = false;
+}
+
+void tilia::gfx::Shader_Compiler::Begin_Batch()
+{
+	++m_depth;
+}
+
+void tilia::gfx::Shader_Compiler::End_Batch()
+{
+
+	if (m_depth == 0)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Shader compiler batch was ended without being begun" } };
+	}
+
+	if (--m_depth > 0)
+		return;
+
+	const std::vector<Shader_Part*> parts{ std::move(m_parts) };
+	const std::vector<Shader*> shaders{ std::move(m_shaders) };
+	m_parts.clear();
+	m_shaders.clear();
+
+	try
+	{
+
+		std::vector<Shader*> linking{};
+		for (auto shader : shaders)
+		{
+			if (!shader->Load_Binary())
+				linking.push_back(shader);
+		}
+
+		// Every compile is handed to the driver before any link so that they can be worked on
+		// at the same time
+		for (auto part : parts)
+			part->Submit();
+		for (auto shader : linking)
+			shader->Submit_Parts();
+
+		for (auto shader : linking)
+		{
+			shader->Link();
+			m_linking.push_back(shader);
+		}
+
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION, "Failed to submit shader compiler batch" });
+	}
+
+}
+
+bool tilia::gfx::Shader_Compiler::Poll()
+{
+
+	// Finishing a shader removes it from the list
+	const std::vector<Shader*> linking{ m_linking };
+	for (auto shader : linking)
+	{
+		if (shader->Is_Ready())
+			shader->Finish_Link();
+	}
+
+	return m_linking.empty() && m_shaders.empty();
+
+}
+
+void tilia::gfx::Shader_Compiler::Finish()
+{
+	while (!m_linking.empty())
+		m_linking.front()->Finish_Link();
+}
+
+bool tilia::gfx::Shader_Compiler::Is_Complete(std::uint32_t program) const
+{
+
+	// Without the extension asking would wait on the driver
+	if (!m_parallel)
+		return true;
+
+	std::int32_t complete{ GL_TRUE };
+	GL_CALL(glGetProgramiv(program, COMPLETION_STATUS, &complete));
+
+	return complete == GL_TRUE;
+
+}
+
+void tilia::gfx::Shader_Compiler::Defer(Shader& shader)
+{
+	if (std::find(m_shaders.begin(), m_shaders.end(), &shader) == m_shaders.end())
+		m_shaders.push_back(&shader);
+}
+
+void tilia::gfx::Shader_Compiler::Defer(Shader_Part& part)
+{
+	if (std::find(m_parts.begin(), m_parts.end(), &part) == m_parts.end())
+		m_parts.push_back(&part);
+}
+
+void tilia::gfx::Shader_Compiler::Forget(const Shader& shader)
+{
+	m_shaders.erase(std::remove(m_shaders.begin(), m_shaders.end(), &shader), m_shaders.end());
+	m_linking.erase(std::remove(m_linking.begin(), m_linking.end(), &shader), m_linking.end());
+}
+
+void tilia::gfx::Shader_Compiler::Replace(const Shader& from, Shader& to)
+{
+	std::replace(m_shaders.begin(), m_shaders.end(), const_cast<Shader*>(&from), &to);
+	std::replace(m_linking.begin(), m_linking.end(), const_cast<Shader*>(&from), &to);
+}
+
+void tilia::gfx::Shader_Compiler::Forget(const Shader_Part& part)
+{
+	m_parts.erase(std::remove(m_parts.begin(), m_parts.end(), &part), m_parts.end());
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+void tilia::gfx::Shader_Compiler::Test()
+{
+
+	auto& compiler{ Instance() };
+
+	SECTION("Nested batches")
+	{
+		REQUIRE_FALSE(compiler.Is_Batching());
+
+		compiler.Begin_Batch();
+		compiler.Begin_Batch();
+		REQUIRE(compiler.Is_Batching());
+
+		compiler.End_Batch();
+		REQUIRE(compiler.Is_Batching());
+
+		compiler.End_Batch();
+		REQUIRE_FALSE(compiler.Is_Batching());
+	}
+
+	SECTION("Unbalanced batch")
+	{
+		REQUIRE_THROWS_AS(compiler.End_Batch(), utils::Tilia_Exception);
+		REQUIRE_FALSE(compiler.Is_Batching());
+	}
+
+	SECTION("Nothing pending")
+	{
+		compiler.Begin_Batch();
+		compiler.End_Batch();
+
+		REQUIRE(compiler.Get_Pending_Count() == 0);
+		REQUIRE(compiler.Poll());
+		compiler.Finish();
+	}
+
+	SECTION("Not parallel")
+	{
+		compiler.Terminate();
+
+		// Every program counts as complete without asking the driver
+		REQUIRE_FALSE(compiler.Is_Parallel());
+		REQUIRE(compiler.Is_Complete(1));
+	}
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
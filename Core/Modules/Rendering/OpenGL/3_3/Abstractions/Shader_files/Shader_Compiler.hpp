@@ -0,0 +1,197 @@
+/**************************************************************************************************
+ * @file   Shader_Compiler.hpp
+ *
+ * @brief  Batches the compiling of shader parts and linking of shaders. Everything changed
+ *		   during a batch is handed to the driver at once when the batch ends, every part is
+ *		   compiled before any program is linked and every program is linked exactly once. The
+ *		   results are not asked for until a shader is first used, so that drivers supporting
+ *		   KHR_parallel_shader_compile can work on all of them at the same time.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_SHADER_COMPILER_HPP
+#define TILIA_OPENGL_3_3_SHADER_COMPILER_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_CONSTANTS_INCLUDE
+
+namespace tilia
+{
+	namespace gfx
+	{
+
+		// Predefinitions
+		class Shader;
+		class Shader_Part;
+
+		/**
+		 * @brief Singleton batching shader compiles and links. Loading code wraps the creation
+		 * of its shaders in a batch and may then poll every frame until they are ready:
+		 *
+		 *	compiler.Begin_Batch();
+		 *	shader->Init({ vertex_part }, { fragment_part }, {});
+		 *	compiler.End_Batch();
+		 *
+		 *	while (!compiler.Poll())
+		 *		Draw_Loading_Screen();
+		 *
+		 * A shader used before it is ready waits for its link and throws any error then. Must
+		 * only be used on the thread owning the context.
+		 */
+		class Shader_Compiler
+		{
+		public:
+
+			// Function used to load openGL entry points, such as glfwGetProcAddress
+			using Load_Proc = void* (*)(const char* name);
+
+			/**
+			 * @brief First time it is called it will construct an instance of Shader_Compiler.
+			 * A reference to this instance is returned to anywhere in the program.
+			 *
+			 * @return A reference to an instance of Shader_Compiler.
+			 */
+			static Shader_Compiler& Instance()
+			{
+				static Shader_Compiler shader_compiler{};
+				return shader_compiler;
+			}
+
+			/**
+			 * @brief Lets the driver compile on as many threads as it wants if it supports
+			 * KHR_parallel_shader_compile or ARB_parallel_shader_compile. Batches work without
+			 * calling Init, although waiting on one shader may then wait on all of them.
+			 *
+			 * @param load_proc - Used to load the entry points.
+			 *
+			 * @return Whether or not shaders are compiled in parallel.
+			 */
+			bool Init(Load_Proc load_proc);
+
+			/**
+			 * @brief Stops asking the driver whether shaders are done.
+			 */
+			void Terminate();
+
+			/**
+			 * @brief Whether or not Init found parallel compiling to be supported.
+			 */
+			bool Is_Parallel() const { return m_parallel; }
+
+			/**
+			 * @brief Starts a batch. Until the batch ends parts which are compiled and shaders
+			 * which are reloaded are only queued. Batches may be nested, in which case nothing is
+			 * submitted until the outermost one ends.
+			 */
+			void Begin_Batch();
+
+			/**
+			 * @brief Ends a batch, submitting everything queued during it without waiting on the
+			 * results. Shaders with a binary in the program binary cache are loaded from it.
+			 */
+			void End_Batch();
+
+			/**
+			 * @brief Whether or not a batch has been started and not yet ended.
+			 */
+			bool Is_Batching() const { return m_depth > 0; }
+
+			/**
+			 * @brief Finishes the shaders which are done linking, throwing the error of any
+			 * which failed.
+			 *
+			 * @return Whether or not every submitted shader is done.
+			 */
+			bool Poll();
+
+			/**
+			 * @brief Waits for every submitted shader, throwing the error of any which failed.
+			 */
+			void Finish();
+
+			/**
+			 * @brief Gets the amount of shaders which are queued or have been submitted and are
+			 * not yet finished.
+			 */
+			std::size_t Get_Pending_Count() const { return m_shaders.size() + m_linking.size(); }
+
+			/**
+			 * @brief Whether or not the driver is done linking the given program, without
+			 * waiting on it. Always true unless compiling in parallel.
+			 */
+			bool Is_Complete(std::uint32_t program) const;
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Shader_Compiler. Only tests the batching and so does not need
+			 * a context.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		private:
+
+			friend class Shader;
+			friend class Shader_Part;
+
+			Shader_Compiler() = default;
+
+			// Shader_Compiler shan't be copyable or moveable
+			Shader_Compiler(const Shader_Compiler&) = delete;
+			Shader_Compiler(Shader_Compiler&&) = delete;
+			Shader_Compiler& operator=(const Shader_Compiler&) = delete;
+			Shader_Compiler& operator=(Shader_Compiler&&) = delete;
+
+			/**
+			 * @brief Queues a shader to be linked when the batch ends, once no matter how often
+			 * it is queued.
+			 */
+			void Defer(Shader& shader);
+			/**
+			 * @brief Queues a part to be compiled when the batch ends.
+			 */
+			void Defer(Shader_Part& part);
+
+			/**
+			 * @brief Stops keeping track of a shader, such as when it is destroyed.
+			 */
+			void Forget(const Shader& shader);
+			/**
+			 * @brief Stops keeping track of a part, such as when it is destroyed.
+			 */
+			void Forget(const Shader_Part& part);
+
+			/**
+			 * @brief Keeps track of a shader which was moved from another in place of it.
+			 */
+			void Replace(const Shader& from, Shader& to);
+
+			// Whether or not the driver compiles in parallel
+			bool m_parallel{ false };
+
+			// How many batches have been started and not yet ended
+			std::uint32_t m_depth{};
+
+			// Parts and shaders queued in the current batch
+			std::vector<Shader_Part*> m_parts{};
+			std::vector<Shader*> m_shaders{};
+
+			// Shaders which have been submitted and not yet finished
+			std::vector<Shader*> m_linking{};
+
+		}; // Shader_Compiler
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_SHADER_COMPILER_HPP
@@ -10,15 +10,15 @@
 #include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
 #include TILIA_TILIA_EXCEPTION_INCLUDE
 #include TILIA_OPENGL_3_3_UTILS_INCLUDE
-#include TILIA_WINDOWS_FILE_SYSTEM_INCLUDE
 #include TILIA_OPENGL_3_3_SHADER_INCLUDE
-
-// The file system defined in another file
-extern tilia::utils::File_System file_system;
+#include TILIA_OPENGL_3_3_PROGRAM_BINARY_CACHE_INCLUDE
+#include TILIA_OPENGL_3_3_SHADER_COMPILER_INCLUDE
 
 tilia::gfx::Shader_Part::~Shader_Part()
 {
 
+	Shader_Compiler::Instance().Forget(*this);
+
 	try
 	{
 		GL_CALL(glDeleteShader(m_ID));
@@ -42,6 +42,8 @@ void tilia::gfx::Shader_Part::Init(const bool& reload)
 		
 		GL_CALL(m_ID = glCreateShader(*m_type));
 
+		m_source_hash = 0;
+
 		if (reload)
 			Compile(true);
 
@@ -57,7 +59,9 @@ void tilia::gfx::Shader_Part::Source()
 {
 
 	try {
-		m_source = file_system.Load_File(m_path);
+		m_expansion = Shader_Preprocessor::Instance().Expand(m_path, m_defines);
+		m_source = std::move(m_expansion.text);
+		m_expansion.text.clear();
 	}
 	catch(utils::Tilia_Exception& t_e)
 	{
@@ -75,41 +79,40 @@ void tilia::gfx::Shader_Part::Compile(const bool& source)
 		if (source)
 			Source();
 
+		// Unchanged sources are told apart by their hash alone
+		const std::uint64_t source_hash{ (source) ? m_expansion.hash : 0 };
+		if (source_hash != 0 && source_hash == m_source_hash)
+			return;
+
 		const char* src{ m_source.c_str() };
 
 		GL_CALL(glShaderSource(m_ID, 1, &src, nullptr));
 
-		GL_CALL(glCompileShader(m_ID));
-
-		std::int32_t result;
-
-		GL_CALL(glGetShaderiv(m_ID, GL_COMPILE_STATUS, &result));
-
-		if (result == GL_FALSE) {
-			std::int32_t length;
-
-			GL_CALL(glGetShaderiv(m_ID, GL_INFO_LOG_LENGTH, &length));
-
-			std::vector<char> message(static_cast<size_t>(length));
-
-			GL_CALL(glGetShaderInfoLog(m_ID, length, &length, &message.front()));
-			message[static_cast<size_t>(length) - 1] = '\0';
+		m_source_hash = 0;
 
-			GL_CALL(glDeleteShader(m_ID));
+		m_submitted = false;
+		m_compiled = false;
 
-			throw utils::Tilia_Exception{ { TILIA_LOCATION,
-				"Shader part { ID: ", m_ID, " } failed to be created",
-				"\n>>> Part type: ", utils::Get_Shader_Type_String(m_type),
-				"\n>>> Message: ", &message.front() } };
+		auto& compiler{ Shader_Compiler::Instance() };
 
+		// With the cache the shaders may not need the part compiled at all
+		if (!Program_Binary_Cache::Instance().Is_Enabled())
+		{
+			if (compiler.Is_Batching())
+				compiler.Defer(*this);
+			else
+				Ensure_Compiled();
 		}
 	
+		// Only queued during a batch, so that each shader is linked once
 		for (auto& shader : m_attached_to)
 		{
 			if (shader != nullptr)
 				shader->Reload();
 		}
 
+		m_source_hash = source_hash;
+
 	}
 	catch(utils::Tilia_Exception& t_e) {
 		throw t_e.Add_Message({ TILIA_LOCATION, 
@@ -117,3 +120,54 @@ void tilia::gfx::Shader_Part::Compile(const bool& source)
 	}
 
 }
+
+void tilia::gfx::Shader_Part::Submit()
+{
+
+	if (m_submitted)
+		return;
+
+	GL_CALL(glCompileShader(m_ID));
+
+	m_submitted = true;
+
+}
+
+void tilia::gfx::Shader_Part::Ensure_Compiled()
+{
+
+	if (m_compiled)
+		return;
+
+	Submit();
+
+	std::int32_t result;
+
+	GL_CALL(glGetShaderiv(m_ID, GL_COMPILE_STATUS, &result));
+
+	if (result == GL_FALSE) {
+		std::int32_t length;
+
+		GL_CALL(glGetShaderiv(m_ID, GL_INFO_LOG_LENGTH, &length));
+
+		std::vector<char> message(static_cast<size_t>(length));
+
+		GL_CALL(glGetShaderInfoLog(m_ID, length, &length, &message.front()));
+		message[static_cast<size_t>(length) - 1] = '\0';
+
+		// Points at the included files rather than the expanded source
+		const std::string log{ (m_expansion.files.empty()) ? std::string{ &message.front() } :
+			m_expansion.Remap(&message.front()) };
+
+		GL_CALL(glDeleteShader(m_ID));
+
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Shader part { ID: ", m_ID, " } failed to be created",
+			"\n>>> Part type: ", utils::Get_Shader_Type_String(m_type),
+			"\n>>> Message: ", log } };
+
+	}
+
+	m_compiled = true;
+
+}
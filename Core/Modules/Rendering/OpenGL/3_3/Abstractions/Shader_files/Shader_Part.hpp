@@ -14,10 +14,12 @@
 #include <cstdint>
 #include <string>
 #include <memory>
+#include <vector>
 
 // Tilia
 #include "Core/Values/Directories.hpp"
 #include TILIA_OPENGL_3_3_CONSTANTS_INCLUDE
+#include TILIA_OPENGL_3_3_SHADER_PREPROCESSOR_INCLUDE
 
 namespace tilia {
 
@@ -34,6 +36,7 @@ namespace tilia {
 			~Shader_Part();
 
 			friend class Shader;
+			friend class Shader_Compiler;
 
 			Shader_Part(const std::string& path, const enums::Shader_Type& type, 
 				const bool& init = false) : m_type{ type }, m_path{ path } 
@@ -46,13 +49,20 @@ namespace tilia {
 			Shader_Part(const Shader_Part& other, const bool& init = false) noexcept :
 				m_type{ other.m_type },
 				m_path{ other.m_path },
-				m_source{ other.m_source } { if (init) Init(true); }
+				m_source{ other.m_source },
+				m_defines{ other.m_defines },
+				m_expansion{ other.m_expansion } { if (init) Init(true); }
 
 			Shader_Part(Shader_Part&& other, const bool& init = false) noexcept :
 				m_ID{ other.m_ID },
 				m_type{ other.m_type },
 				m_path{ std::move(other.m_path) },
-				m_source{ std::move(other.m_source) } { other.m_ID = 0; if (init) Init(true); }
+				m_source{ std::move(other.m_source) },
+				m_defines{ std::move(other.m_defines) },
+				m_expansion{ std::move(other.m_expansion) },
+				m_source_hash{ other.m_source_hash },
+				m_submitted{ other.m_submitted },
+				m_compiled{ other.m_compiled } { other.m_ID = 0; if (init) Init(true); }
 
 			Shader_Part& operator=(const Shader_Part& other) noexcept
 			{
@@ -62,6 +72,8 @@ namespace tilia {
 				m_type = other.m_type;
 				m_path = other.m_path;
 				m_source = other.m_source;
+				m_defines = other.m_defines;
+				m_expansion = other.m_expansion;
 
 				return *this;
 			}
@@ -75,6 +87,11 @@ namespace tilia {
 				m_type = other.m_type;
 				m_path = std::move(other.m_path);
 				m_source = std::move(other.m_source);
+				m_defines = std::move(other.m_defines);
+				m_expansion = std::move(other.m_expansion);
+				m_source_hash = other.m_source_hash;
+				m_submitted = other.m_submitted;
+				m_compiled = other.m_compiled;
 
 				return *this;
 			}
@@ -90,19 +107,63 @@ namespace tilia {
 
 			inline std::string Get_Path() const { return m_path; }
 
-			inline void Set_Source(const std::string& source) { m_source = source; }
-			inline void Set_Source(std::string&& source) { m_source = std::move(source); }
+			inline void Set_Source(const std::string& source) 
+			{ m_source = source; m_expansion = {}; }
+			inline void Set_Source(std::string&& source) 
+			{ m_source = std::move(source); m_expansion = {}; }
 
 			inline std::string Get_Source() const { return m_source; }
 
+			/**
+			 * @brief Sets the macros defined after the #version line when the source is next
+			 * loaded from the path.
+			 */
+			inline void Set_Defines(const std::vector<Shader_Define>& defines) 
+			{ m_defines = defines; }
+			inline void Set_Defines(std::vector<Shader_Define>&& defines) 
+			{ m_defines = std::move(defines); }
+
+			inline const std::vector<Shader_Define>& Get_Defines() const { return m_defines; }
+
+			/**
+			 * @brief Gets the files and lines the source was expanded from, which is empty if
+			 * the source was set rather than loaded from the path.
+			 */
+			inline const Shader_Source& Get_Expansion() const { return m_expansion; }
+
 			void Init(const bool& reload = false);
 
+			/**
+			 * @brief Loads the source from the path through the Shader_Preprocessor, expanding
+			 * its includes and injecting the defines.
+			 */
 			void Source();
 
+			/**
+			 * @brief Hands the source to openGL and reloads every shader the part is attached
+			 * to. While the program binary cache is enabled the source is only compiled once a
+			 * shader fails to find its binary, see Ensure_Compiled. During a batch of the
+			 * Shader_Compiler the compile is only queued. Nothing is done if the source loaded
+			 * from the path is the same as when last compiled.
+			 *
+			 * @param source - Whether or not to load the source from the path first.
+			 */
 			void Compile(const bool& source = false);
 
 		private:
 
+			/**
+			 * @brief Hands the source given to openGL to the driver to be compiled if it has not
+			 * been already, without asking for the result.
+			 */
+			void Submit();
+
+			/**
+			 * @brief Compiles the source given to openGL if it has not been already and throws
+			 * if it failed.
+			 */
+			void Ensure_Compiled();
+
 			// The ID of the Shader_Part
 			std::uint32_t m_ID{};
 
@@ -112,6 +173,20 @@ namespace tilia {
 			// Path and source code of the Shader_Part
 			std::string m_path{}, m_source{};
 
+			// The macros defined when loading the source
+			std::vector<Shader_Define> m_defines{};
+
+			// The files and lines the source was expanded from, its text is moved into m_source
+			Shader_Source m_expansion{};
+
+			// The hash of the expansion last handed to openGL, 0 if it was not expanded
+			std::uint64_t m_source_hash{};
+
+			// Whether or not the source given to openGL has been handed to the driver to compile
+			bool m_submitted{ false };
+			// Whether or not the source given to openGL has been compiled without errors
+			bool m_compiled{ false };
+
 			std::vector<Shader*> m_attached_to{};
 
 		};
@@ -0,0 +1,365 @@
+// Standard
+#include <algorithm>
+#include <cctype>
+
+// Tilia
+#include "Shader_Preprocessor.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+#include TILIA_WINDOWS_FILE_SYSTEM_INCLUDE
+#include TILIA_OPENGL_3_3_PROGRAM_BINARY_CACHE_INCLUDE
+
+// The file system defined in another file
+extern tilia::utils::File_System file_system;
+
+std::string tilia::gfx::Shader_Source::Remap(const std::string& log) const
+{
+
+	std::string remapped{};
+	remapped.reserve(log.size());
+
+	const std::size_t size{ log.size() };
+	std::size_t i{ 0 };
+
+	while (i < size)
+	{
+		// The expanded text is handed to openGL as source string 0, which drivers write as
+		// either 0(line) or 0:line
+		const bool is_line{ log[i] == '0' &&
+			(i == 0 || !std::isalnum(static_cast<unsigned char>(log[i - 1]))) &&
+			i + 2 < size && (log[i + 1] == '(' || log[i + 1] == ':') &&
+			std::isdigit(static_cast<unsigned char>(log[i + 2])) };
+
+		if (!is_line)
+		{
+			remapped += log[i++];
+			continue;
+		}
+
+		std::size_t end{ i + 2 };
+		std::size_t line{};
+		while (end < size && std::isdigit(static_cast<unsigned char>(log[end])))
+			line = line * 10 + static_cast<std::size_t>(log[end++] - '0');
+
+		const bool parenthesized{ log[i + 1] == '(' };
+
+		if ((parenthesized && (end >= size || log[end] != ')')) || line == 0 ||
+			line > lines.size())
+		{
+			remapped += log[i++];
+			continue;
+		}
+
+		const Line_Origin& origin{ lines[line - 1] };
+		remapped += files[origin.file];
+		remapped += (parenthesized) ? '(' : ':';
+		remapped += std::to_string(origin.line);
+
+		// A closing parenthesis is copied along with the rest
+		i = end;
+	}
+
+	return remapped;
+
+}
+
+tilia::gfx::Shader_Source tilia::gfx::Shader_Preprocessor::Expand(const std::string& path,
+	const std::vector<Shader_Define>& defines)
+{
+
+	Shader_Source source{};
+
+	source.hash = Program_Binary_Cache::s_hash_basis;
+	for (const auto& define : defines)
+	{
+		// Separated so that the name and value can not run into each other
+		source.hash = Program_Binary_Cache::Hash(define.name.data(), define.name.size() + 1,
+			source.hash);
+		source.hash = Program_Binary_Cache::Hash(define.value.data(), define.value.size() + 1,
+			source.hash);
+	}
+
+	try
+	{
+		Expand_File(source, std::filesystem::path{ path }.lexically_normal().generic_string(),
+			defines, 0);
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to preprocess shader source { Path: ", path, " }" });
+	}
+
+	return source;
+
+}
+
+void tilia::gfx::Shader_Preprocessor::Set_File(const std::string& path, std::string text)
+{
+	const std::string normal_path{ std::filesystem::path{ path }.lexically_normal()
+		.generic_string() };
+	m_files[normal_path] = Tokenize(normal_path, text);
+}
+
+void tilia::gfx::Shader_Preprocessor::Invalidate(const std::string& path)
+{
+	m_files.erase(std::filesystem::path{ path }.lexically_normal().generic_string());
+}
+
+std::string tilia::gfx::Shader_Preprocessor::Resolve(const std::string& including_path,
+	const std::string& name)
+{
+	const std::filesystem::path directory{ std::filesystem::path{ including_path }
+		.parent_path() };
+	return (directory / name).lexically_normal().generic_string();
+}
+
+const tilia::gfx::Shader_Preprocessor::File& tilia::gfx::Shader_Preprocessor::Get_File(
+	const std::string& path)
+{
+
+	const auto found{ m_files.find(path) };
+	if (found != m_files.end() && !found->second.on_disk)
+		return found->second;
+
+	// Only asks the file system when it was written, which is far cheaper than reading it
+	std::error_code error{};
+	const auto write_time{ std::filesystem::last_write_time(path, error) };
+
+	if (found != m_files.end() && (error || found->second.write_time == write_time))
+		return found->second;
+
+	File file{ Tokenize(path, file_system.Load_File(path)) };
+	file.write_time = write_time;
+	file.on_disk = true;
+
+	++m_read_count;
+
+	File& cached{ m_files[path] };
+	cached = std::move(file);
+
+	return cached;
+
+}
+
+tilia::gfx::Shader_Preprocessor::File tilia::gfx::Shader_Preprocessor::Tokenize(
+	const std::string& path, const std::string& text)
+{
+
+	File file{};
+	file.hash = Program_Binary_Cache::Hash(text.data(), text.size());
+
+	std::size_t begin{ 0 };
+	while (begin < text.size())
+	{
+		std::size_t end{ text.find('\n', begin) };
+		if (end == std::string::npos)
+			end = text.size();
+
+		Line line{};
+		line.text = text.substr(begin, end - begin);
+		if (!line.text.empty() && line.text.back() == '\r')
+			line.text.pop_back();
+
+		begin = end + 1;
+
+		const std::size_t first{ line.text.find_first_not_of(" \t") };
+
+		if (first != std::string::npos && line.text.compare(first, 8, "#version") == 0)
+		{
+			line.kind = Line::Kind::Version;
+		}
+		else if (first != std::string::npos && line.text.compare(first, 8, "#include") == 0)
+		{
+			const std::size_t name_begin{ line.text.find('"', first) };
+			const std::size_t name_end{ (name_begin != std::string::npos) ?
+				line.text.find('"', name_begin + 1) : std::string::npos };
+
+			if (name_end == std::string::npos)
+			{
+				throw utils::Tilia_Exception{ { TILIA_LOCATION,
+					"Shader include is missing a quoted path { Path: ", path,
+					", Line: ", line.text, " }" } };
+			}
+
+			line.kind = Line::Kind::Include;
+			line.text = Resolve(path,
+				line.text.substr(name_begin + 1, name_end - name_begin - 1));
+		}
+
+		file.lines.push_back(std::move(line));
+	}
+
+	return file;
+
+}
+
+void tilia::gfx::Shader_Preprocessor::Expand_File(Shader_Source& source,
+	const std::string& path, const std::vector<Shader_Define>& defines, std::size_t depth)
+{
+
+	if (depth > s_max_include_depth)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Shader includes are nested too deep { Path: ", path, " }" } };
+	}
+
+	const auto file_index{ static_cast<std::uint32_t>(source.files.size()) };
+	source.files.push_back(path);
+
+	// Stays valid when other files are added since the cache is node based
+	const File& file{ Get_File(path) };
+
+	source.hash = Program_Binary_Cache::Hash(&file.hash, sizeof(file.hash), source.hash);
+
+	const auto append{ [&source, file_index](const std::string& text, std::size_t line)
+	{
+		source.text += text;
+		source.text += '\n';
+		source.lines.push_back({ file_index, static_cast<std::uint32_t>(line) });
+	} };
+
+	const auto append_defines{ [&append, &defines](std::size_t line)
+	{
+		for (const auto& define : defines)
+			append("#define " + define.name + " " + define.value, line);
+	} };
+
+	// The #version line has to come before anything else, including the defines
+	const bool root{ depth == 0 };
+	bool defined{ !root };
+	if (!defined)
+	{
+		bool has_version{ false };
+		for (const auto& line : file.lines)
+			has_version = has_version || line.kind == Line::Kind::Version;
+
+		if (!has_version)
+		{
+			append_defines(1);
+			defined = true;
+		}
+	}
+
+	const std::size_t count{ file.lines.size() };
+	for (std::size_t i{ 0 }; i < count; ++i)
+	{
+		const Line& line{ file.lines[i] };
+
+		switch (line.kind)
+		{
+		case Line::Kind::Version:
+			// Included files are written for the version of the file including them
+			if (!root)
+				break;
+			append(line.text, i + 1);
+			if (!defined)
+			{
+				append_defines(i + 1);
+				defined = true;
+			}
+			break;
+		case Line::Kind::Include:
+			// Files are only included once
+			if (std::find(source.files.begin(), source.files.end(), line.text) ==
+				source.files.end())
+			{
+				Expand_File(source, line.text, defines, depth + 1);
+			}
+			break;
+		default:
+			append(line.text, i + 1);
+			break;
+		}
+	}
+
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+void tilia::gfx::Shader_Preprocessor::Test()
+{
+
+	auto& preprocessor{ Instance() };
+
+	preprocessor.Clear();
+	preprocessor.Set_File("test/a.vert",
+		"#version 330 core\n#include \"include/b.glsl\"\nvoid main() {}\n");
+	preprocessor.Set_File("test/include/b.glsl",
+		"#include \"../include/b.glsl\"\r\nfloat b;\r\n#include \"c.glsl\"\n");
+	preprocessor.Set_File("test/include/c.glsl", "#version 330 core\nfloat c;");
+
+	SECTION("Resolve")
+	{
+		REQUIRE(Resolve("a/b/c.glsl", "../d.glsl") == "a/d.glsl");
+		REQUIRE(Resolve("c.glsl", "d.glsl") == "d.glsl");
+	}
+
+	SECTION("Expand")
+	{
+		const Shader_Source source{ preprocessor.Expand("test/a.vert", { { "LIT", "1" } }) };
+
+		// Defines follow the version, included versions are dropped and every file is only
+		// included once
+		REQUIRE(source.text ==
+			"#version 330 core\n#define LIT 1\nfloat b;\nfloat c;\nvoid main() {}\n");
+		REQUIRE(source.files == std::vector<std::string>{ "test/a.vert",
+			"test/include/b.glsl", "test/include/c.glsl" });
+
+		REQUIRE(source.lines.size() == 5);
+		REQUIRE(source.lines[2].file == 1);
+		REQUIRE(source.lines[2].line == 2);
+		REQUIRE(source.lines[4].file == 0);
+		REQUIRE(source.lines[4].line == 3);
+
+		// Nothing was read from disk
+		REQUIRE(preprocessor.Get_Read_Count() == 0);
+	}
+
+	SECTION("Defines without a version")
+	{
+		const Shader_Source source{ preprocessor.Expand("test/include/b.glsl",
+			{ { "A", "" }, { "B", "2" } }) };
+
+		REQUIRE(source.text == "#define A \n#define B 2\nfloat b;\nfloat c;\n");
+	}
+
+	SECTION("Hash")
+	{
+		const auto hash{ preprocessor.Expand("test/a.vert").hash };
+		REQUIRE(preprocessor.Expand("test/a.vert").hash == hash);
+		REQUIRE(preprocessor.Expand("test/a.vert", { { "LIT", "1" } }).hash != hash);
+		REQUIRE(preprocessor.Expand("test/a.vert", { { "LI", "T1" } }).hash !=
+			preprocessor.Expand("test/a.vert", { { "LIT", "1" } }).hash);
+
+		// Changing an included file changes the hash
+		preprocessor.Set_File("test/include/c.glsl", "float c = 1.0;");
+		REQUIRE(preprocessor.Expand("test/a.vert").hash != hash);
+	}
+
+	SECTION("Remap")
+	{
+		const Shader_Source source{ preprocessor.Expand("test/a.vert") };
+
+		// Lines 2 and 4 of the text are line 2 of b.glsl and line 3 of a.vert
+		REQUIRE(source.Remap("0(2) : error C0000: b\nERROR: 0:4: 'main' : x\n10(3)") ==
+			"test/include/b.glsl(2) : error C0000: b\nERROR: test/a.vert:3: 'main' : x\n"
+			"10(3)");
+		// Lines outside of the text are left alone
+		REQUIRE(source.Remap("0(99)") == "0(99)");
+	}
+
+	SECTION("Missing quotes")
+	{
+		REQUIRE_THROWS_AS(preprocessor.Set_File("test/d.glsl", "#include <b.glsl>"),
+			utils::Tilia_Exception);
+	}
+
+	preprocessor.Clear();
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
@@ -0,0 +1,236 @@
+/**************************************************************************************************
+ * @file   Shader_Preprocessor.hpp
+ *
+ * @brief  Expands the #include directives of GLSL sources and injects #defines after the
+ *		   #version line. Every file is read and split into lines once and then kept in a cache
+ *		   along with a hash of its contents, so that shaders sharing code do not read it again
+ *		   and an unchanged expansion can be told apart by its hash alone. The lines of every
+ *		   expansion are mapped back to the file they came from for error messages.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_SHADER_PREPROCESSOR_HPP
+#define TILIA_OPENGL_3_3_SHADER_PREPROCESSOR_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_CONSTANTS_INCLUDE
+
+namespace tilia
+{
+	namespace gfx
+	{
+
+		/**
+		 * @brief A macro defined for a source, written as #define name value.
+		 */
+		struct Shader_Define
+		{
+			std::string name{};
+			std::string value{};
+		}; // Shader_Define
+
+		/**
+		 * @brief A source with every include expanded.
+		 */
+		struct Shader_Source
+		{
+
+			/**
+			 * @brief Where a line of the expanded text came from.
+			 */
+			struct Line_Origin
+			{
+				// Index into files
+				std::uint32_t file{};
+				// The line in that file, starting at 1
+				std::uint32_t line{};
+			}; // Line_Origin
+
+			// The expanded text
+			std::string text{};
+
+			// Hash of the contents of every file included and every define, 0 if empty
+			std::uint64_t hash{};
+
+			// The files included, starting with the one expanded
+			std::vector<std::string> files{};
+
+			// The origin of every line of text
+			std::vector<Line_Origin> lines{};
+
+			/**
+			 * @brief Replaces the line numbers of the expanded text in an info log, such as
+			 * 0(12) and 0:12, with the files and lines they came from.
+			 *
+			 * @param log - The info log of compiling the expanded text.
+			 *
+			 * @return The remapped info log.
+			 */
+			std::string Remap(const std::string& log) const;
+
+		}; // Shader_Source
+
+		/**
+		 * @brief Singleton expanding GLSL sources. Included paths are relative to the directory
+		 * of the including file and every file is included at most once per expansion, so
+		 * headers need no guards. Files read from disk are read again once they have been
+		 * written to.
+		 */
+		class Shader_Preprocessor
+		{
+		public:
+
+			// The deepest includes may be nested
+			static constexpr std::size_t s_max_include_depth{ 16 };
+
+			/**
+			 * @brief First time it is called it will construct an instance of
+			 * Shader_Preprocessor. A reference to this instance is returned to anywhere in the
+			 * program.
+			 *
+			 * @return A reference to an instance of Shader_Preprocessor.
+			 */
+			static Shader_Preprocessor& Instance()
+			{
+				static Shader_Preprocessor shader_preprocessor{};
+				return shader_preprocessor;
+			}
+
+			/**
+			 * @brief Expands the includes of a file and injects defines after its #version line,
+			 * or before its first line if it has none.
+			 *
+			 * @param path - The path of the file.
+			 * @param defines - The macros to define.
+			 *
+			 * @return The expanded source.
+			 */
+			Shader_Source Expand(const std::string& path,
+				const std::vector<Shader_Define>& defines = {});
+
+			/**
+			 * @brief Caches the given text as the contents of a path, for sources which are not
+			 * on disk. The text is kept until set again or cleared.
+			 */
+			void Set_File(const std::string& path, std::string text);
+
+			/**
+			 * @brief Drops a file from the cache so that it is read again when next included.
+			 */
+			void Invalidate(const std::string& path);
+
+			/**
+			 * @brief Drops every file from the cache.
+			 */
+			void Clear() { m_files.clear(); }
+
+			/**
+			 * @brief Gets the amount of files in the cache.
+			 */
+			std::size_t Get_File_Count() const { return m_files.size(); }
+
+			/**
+			 * @brief Gets the amount of times a file has been read from disk.
+			 */
+			std::size_t Get_Read_Count() const { return m_read_count; }
+
+			/**
+			 * @brief Gets the path of a file included by another, which is relative to the
+			 * directory of the including file.
+			 *
+			 * @param including_path - The path of the including file.
+			 * @param name - The path in the #include directive.
+			 */
+			static std::string Resolve(const std::string& including_path,
+				const std::string& name);
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Shader_Preprocessor. Only uses files set with Set_File.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		private:
+
+			/**
+			 * @brief A line of a file, sorted by what the preprocessor does with it.
+			 */
+			struct Line
+			{
+				enum class Kind
+				{
+					Text,
+					Version,
+					Include
+				}; // Kind
+
+				Kind kind{ Kind::Text };
+				// The text of the line, or the resolved path of an include
+				std::string text{};
+			}; // Line
+
+			/**
+			 * @brief A file in the cache.
+			 */
+			struct File
+			{
+				std::vector<Line> lines{};
+				// Hash of the contents
+				std::uint64_t hash{};
+				// When the file was written to, unused for files which were set
+				std::filesystem::file_time_type write_time{};
+				// Whether or not the file was read from disk
+				bool on_disk{ false };
+			}; // File
+
+			Shader_Preprocessor() = default;
+
+			// Shader_Preprocessor shan't be copyable or moveable
+			Shader_Preprocessor(const Shader_Preprocessor&) = delete;
+			Shader_Preprocessor(Shader_Preprocessor&&) = delete;
+			Shader_Preprocessor& operator=(const Shader_Preprocessor&) = delete;
+			Shader_Preprocessor& operator=(Shader_Preprocessor&&) = delete;
+
+			/**
+			 * @brief Gets a file from the cache, reading it if it is missing or has been written
+			 * to since.
+			 */
+			const File& Get_File(const std::string& path);
+
+			/**
+			 * @brief Splits text into lines and sorts them.
+			 */
+			static File Tokenize(const std::string& path, const std::string& text);
+
+			/**
+			 * @brief Appends the lines of a file to an expansion, expanding its includes.
+			 */
+			void Expand_File(Shader_Source& source, const std::string& path,
+				const std::vector<Shader_Define>& defines, std::size_t depth);
+
+			// The files read or set, by path
+			std::unordered_map<std::string, File> m_files{};
+
+			// The amount of times a file has been read from disk
+			std::size_t m_read_count{};
+
+		}; // Shader_Preprocessor
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_SHADER_PREPROCESSOR_HPP
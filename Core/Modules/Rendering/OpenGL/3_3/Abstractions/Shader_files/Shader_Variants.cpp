@@ -0,0 +1,222 @@
+// Standard
+#include <algorithm>
+
+// Tilia
+#include "Shader_Variants.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+
+void tilia::gfx::Shader_Variants::Init(const std::string& vertex_path,
+	const std::string& fragment_path, const std::string& geometry_path,
+	std::vector<Shader_Feature> features)
+{
+
+	if (features.size() > s_max_features)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Shader variants were given too many features { Vertex path: ", vertex_path,
+			", Feature count: ", features.size(), ", Max: ", s_max_features, " }" } };
+	}
+
+	m_variants.clear();
+	m_paths[0] = vertex_path;
+	m_paths[1] = fragment_path;
+	m_paths[2] = geometry_path;
+	m_features = std::move(features);
+
+}
+
+tilia::gfx::Shader_Variants::Feature_Mask tilia::gfx::Shader_Variants::Get_Mask(
+	std::initializer_list<std::string> keywords) const
+{
+
+	Feature_Mask mask{};
+
+	for (const auto& keyword : keywords)
+	{
+		const auto found{ std::find_if(m_features.begin(), m_features.end(),
+			[&keyword](const Shader_Feature& feature) { return feature.keyword == keyword; }) };
+
+		if (found == m_features.end())
+		{
+			throw utils::Tilia_Exception{ { TILIA_LOCATION,
+				"Shader variants have no feature named ", keyword,
+				" { Vertex path: ", m_paths[0], " }" } };
+		}
+
+		mask |= Feature_Mask{ 1 } << (found - m_features.begin());
+	}
+
+	return mask;
+
+}
+
+std::shared_ptr<tilia::gfx::Shader> tilia::gfx::Shader_Variants::Get(Feature_Mask mask)
+{
+
+	const auto found{ m_variants.find(mask) };
+	if (found != m_variants.end())
+		return found->second.shader;
+
+	std::vector<Shader_Define> defines{};
+	const std::size_t count{ m_features.size() };
+	for (std::size_t i{ 0 }; i < count; ++i)
+	{
+		if (mask & (Feature_Mask{ 1 } << i))
+			defines.push_back({ m_features[i].keyword, "1" });
+	}
+
+	Variant variant{};
+
+	try
+	{
+
+		constexpr enums::Shader_Type types[3]{ enums::Shader_Type::Vertex,
+			enums::Shader_Type::Fragment, enums::Shader_Type::Geometry };
+
+		for (std::size_t i{ 0 }; i < 3; ++i)
+		{
+			if (m_paths[i].empty())
+				continue;
+
+			variant.parts[i] = std::make_shared<Shader_Part>(m_paths[i], types[i]);
+			variant.parts[i]->Set_Defines(defines);
+			variant.parts[i]->Init(true);
+		}
+
+		variant.shader = std::make_shared<Shader>();
+		variant.shader->m_variants = this;
+		variant.shader->m_variant_mask = mask;
+
+		if (variant.parts[2])
+			variant.shader->Init({ variant.parts[0] }, { variant.parts[1] }, { variant.parts[2] });
+		else
+			variant.shader->Init({ variant.parts[0] }, { variant.parts[1] }, {});
+
+		for (const auto& [block_name, block_index] : m_block_bindings)
+		{
+			// Blocks may be left out of variants by their features
+			if (variant.shader->m_link_state != Shader::Link_State::Linked ||
+				variant.shader->m_block_indices.count(block_name))
+			{
+				variant.shader->Bind_Uniform_Block(block_name, block_index);
+			}
+		}
+
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to compile shader variant { Vertex path: ", m_paths[0],
+			", Mask: ", mask, " }" });
+	}
+
+	return m_variants.emplace(mask, std::move(variant)).first->second.shader;
+
+}
+
+void tilia::gfx::Shader_Variants::Bind_Uniform_Block(const std::string& block_name,
+	std::uint32_t block_index)
+{
+
+	const auto found{ std::find_if(m_block_bindings.begin(), m_block_bindings.end(),
+		[&block_name](const std::pair<std::string, std::uint32_t>& binding)
+		{ return binding.first == block_name; }) };
+	if (found != m_block_bindings.end())
+		found->second = block_index;
+	else
+		m_block_bindings.emplace_back(block_name, block_index);
+
+	for (auto& [mask, variant] : m_variants)
+	{
+		if (variant.shader->m_link_state != Shader::Link_State::Linked ||
+			variant.shader->m_block_indices.count(block_name))
+		{
+			variant.shader->Bind_Uniform_Block(block_name, block_index);
+		}
+	}
+
+}
+
+float tilia::gfx::Shader_Variants::Get_Merge_Cost(Feature_Mask mask) const
+{
+
+	float cost{};
+
+	const std::size_t count{ m_features.size() };
+	for (std::size_t i{ 0 }; i < count; ++i)
+	{
+		if (mask & (Feature_Mask{ 1 } << i))
+			cost += m_features[i].merge_cost;
+	}
+
+	return cost;
+
+}
+
+bool tilia::gfx::Shader_Variants::Can_Merge(Feature_Mask required, Feature_Mask merged) const
+{
+	if ((required & merged) != required)
+		return false;
+	return Get_Merge_Cost(merged & ~required) <= m_merge_budget;
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+void tilia::gfx::Shader_Variants::Test()
+{
+
+	Shader_Variants variants{};
+	variants.Init("a.vert", "a.frag", "", {
+		{ "TEXTURED" }, { "LIT", 2.0f }, { "FOG", 1.0f }, { "INSTANCED", 0.0f } });
+
+	SECTION("Masks")
+	{
+		REQUIRE(variants.Get_Mask({}) == 0);
+		REQUIRE(variants.Get_Mask({ "TEXTURED" }) == 0b0001);
+		REQUIRE(variants.Get_Mask({ "FOG", "LIT" }) == 0b0110);
+		REQUIRE_THROWS_AS(variants.Get_Mask({ "SHADOWS" }), utils::Tilia_Exception);
+	}
+
+	SECTION("Too many features")
+	{
+		std::vector<Shader_Feature> features(s_max_features + 1);
+		REQUIRE_THROWS_AS(variants.Init("a.vert", "a.frag", "", features),
+			utils::Tilia_Exception);
+	}
+
+	SECTION("Merging")
+	{
+		const auto lit{ variants.Get_Mask({ "LIT" }) };
+		const auto fog{ variants.Get_Mask({ "FOG" }) };
+		const auto textured{ variants.Get_Mask({ "TEXTURED" }) };
+		const auto instanced{ variants.Get_Mask({ "INSTANCED" }) };
+
+		REQUIRE(variants.Get_Merge_Cost(lit | fog) == 3.0f);
+
+		// Nothing may be added without a budget, except for free features
+		REQUIRE(variants.Can_Merge(lit, lit));
+		REQUIRE_FALSE(variants.Can_Merge(lit, lit | fog));
+		REQUIRE(variants.Can_Merge(lit, lit | instanced));
+
+		variants.Set_Merge_Budget(2.5f);
+		REQUIRE(variants.Can_Merge(lit, lit | fog));
+		REQUIRE(variants.Can_Merge(0, lit));
+		REQUIRE_FALSE(variants.Can_Merge(0, lit | fog));
+
+		// Features changing the result are never added
+		variants.Set_Merge_Budget(1000.0f);
+		REQUIRE_FALSE(variants.Can_Merge(lit, lit | textured));
+
+		// Required features have to be kept
+		REQUIRE_FALSE(variants.Can_Merge(lit | fog, lit));
+	}
+
+	REQUIRE(variants.Get_Variant_Count() == 0);
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
@@ -0,0 +1,185 @@
+/**************************************************************************************************
+ * @file   Shader_Variants.hpp
+ *
+ * @brief  An uber shader whose features, such as textured or lit, are switched on and off by
+ *		   defines. Every combination of features is a variant named by a bitmask, compiled the
+ *		   first time it is asked for. Batches holding meshes of different variants may be
+ *		   merged into one drawn with a variant having the features of all of them, as long as
+ *		   running the extra features costs little.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_SHADER_VARIANTS_HPP
+#define TILIA_OPENGL_3_3_SHADER_VARIANTS_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <initializer_list>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_SHADER_INCLUDE
+
+namespace tilia
+{
+	namespace gfx
+	{
+
+		/**
+		 * @brief A feature which variants may have.
+		 */
+		struct Shader_Feature
+		{
+			// Defined as 1 in the sources of the variants having the feature
+			std::string keyword{};
+			// What running the feature costs for meshes which do not need it, in the same
+			// unit as the merge budget. Infinite for features which change how meshes without
+			// them look, so that they are never added to such meshes
+			float merge_cost{ std::numeric_limits<float>::infinity() };
+		}; // Shader_Feature
+
+		/**
+		 * @brief The variants of an uber shader. Variants go through the Shader_Preprocessor and
+		 * so through the program binary cache like any other shader, and are only queued if
+		 * asked for during a batch of the Shader_Compiler. Uniforms set on one variant are not
+		 * set on the others, so values shared by every variant are best kept in uniform blocks
+		 * bound through Bind_Uniform_Block. Batches drawing meshes with a merged variant copy the
+		 * other uniforms of the meshes' own variants into it through Shader::Copy_Uniforms.
+		 */
+		class Shader_Variants
+		{
+		public:
+
+			// One bit per feature, in the order the features were given
+			using Feature_Mask = std::uint32_t;
+
+			// The most features a shader may have
+			static constexpr std::size_t s_max_features{ sizeof(Feature_Mask) * 8 };
+
+			Shader_Variants() = default;
+
+			// Shader_Variants shan't be copyable or moveable, as variants point back at it
+			Shader_Variants(const Shader_Variants&) = delete;
+			Shader_Variants(Shader_Variants&&) = delete;
+			Shader_Variants& operator=(const Shader_Variants&) = delete;
+			Shader_Variants& operator=(Shader_Variants&&) = delete;
+
+			/**
+			 * @brief Sets the sources and features. No variant is compiled until asked for.
+			 *
+			 * @param vertex_path - The path of the vertex source.
+			 * @param fragment_path - The path of the fragment source.
+			 * @param geometry_path - The path of the geometry source, empty if there is none.
+			 * @param features - The features, at most s_max_features.
+			 */
+			void Init(const std::string& vertex_path, const std::string& fragment_path,
+				const std::string& geometry_path, std::vector<Shader_Feature> features);
+
+			/**
+			 * @brief Destroys every variant.
+			 */
+			void Terminate() { m_variants.clear(); }
+
+			/**
+			 * @brief Gets the mask of the given features.
+			 *
+			 * @param keywords - The keywords of the features.
+			 */
+			Feature_Mask Get_Mask(std::initializer_list<std::string> keywords) const;
+
+			/**
+			 * @brief Gets the variant with the given features, compiling it if it has not been
+			 * asked for before.
+			 *
+			 * @param mask - The features of the variant.
+			 */
+			std::shared_ptr<Shader> Get(Feature_Mask mask);
+
+			/**
+			 * @brief Whether or not the variant with the given features has been compiled.
+			 */
+			bool Has(Feature_Mask mask) const { return m_variants.count(mask) != 0; }
+
+			/**
+			 * @brief Gets the amount of variants which have been compiled.
+			 */
+			std::size_t Get_Variant_Count() const { return m_variants.size(); }
+
+			/**
+			 * @brief Binds a uniform block of every variant having it, including variants
+			 * compiled later.
+			 */
+			void Bind_Uniform_Block(const std::string& block_name, std::uint32_t block_index);
+
+			/**
+			 * @brief Sets how much the features added to a mesh when merging may cost.
+			 */
+			void Set_Merge_Budget(float budget) { m_merge_budget = budget; }
+			float Get_Merge_Budget() const { return m_merge_budget; }
+
+			/**
+			 * @brief Gets what running the given features costs for meshes which do not need
+			 * them.
+			 */
+			float Get_Merge_Cost(Feature_Mask mask) const;
+
+			/**
+			 * @brief Whether or not meshes needing the required features may be drawn with the
+			 * merged variant, which has to have every required feature while its other
+			 * features fit in the merge budget.
+			 *
+			 * @param required - The features every mesh needs.
+			 * @param merged - The features of the variant the meshes would be drawn with.
+			 */
+			bool Can_Merge(Feature_Mask required, Feature_Mask merged) const;
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Shader_Variants. Does not compile any variant and so does not
+			 * need a context.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		private:
+
+			/**
+			 * @brief A compiled variant.
+			 */
+			struct Variant
+			{
+				std::shared_ptr<Shader_Part> parts[3]{};
+				std::shared_ptr<Shader> shader{};
+			}; // Variant
+
+			// The paths of the vertex, fragment and geometry sources
+			std::string m_paths[3]{};
+
+			// The features, indexed by bit
+			std::vector<Shader_Feature> m_features{};
+
+			// How much the features added to a mesh when merging may cost
+			float m_merge_budget{};
+
+			// The compiled variants by features
+			std::unordered_map<Feature_Mask, Variant> m_variants{};
+
+			// The uniform blocks bound on every variant
+			std::vector<std::pair<std::string, std::uint32_t>> m_block_bindings{};
+
+		}; // Shader_Variants
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_SHADER_VARIANTS_HPP
@@ -0,0 +1,323 @@
+/**************************************************************************************************
+ * @file   Uniform_Block.hpp
+ *
+ * @brief  Typed uniform blocks whose std140 layout is calculated at compile time from a list of
+ *		   C++ types. Members are set by index and written straight into the local buffer of an
+ *		   underlying Uniform_Buffer, so no names are looked up at runtime.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_UNIFORM_BLOCK_HPP
+#define TILIA_OPENGL_3_3_UNIFORM_BLOCK_HPP
+
+// Vendor
+#include "vendor/glm/include/glm/glm.hpp"
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <tuple>
+#include <type_traits>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_UNIFORM_BUFFER_INCLUDE
+
+namespace tilia
+{
+	namespace gfx
+	{
+
+		/**
+		 * @brief Aligns a size to the closest higher multiple of an alignment.
+		 */
+		constexpr std::size_t Std140_Align(std::size_t size, std::size_t alignment)
+		{
+			return ((size + alignment - 1) / alignment) * alignment;
+		}
+
+		/**
+		 * @brief The std140 alignment and size of a type, along with how to write it into a
+		 * block. Only specialized for the types GLSL blocks can hold, so that using any other
+		 * type fails to compile.
+		 */
+		template<typename T, typename = void>
+		struct Std140;
+
+		/**
+		 * @brief Scalars. Bools take up four bytes in GLSL and are written as a uint.
+		 */
+		template<typename T>
+		struct Std140<T, std::enable_if_t<std::is_same<float, T>::value ||
+			std::is_same<std::int32_t, T>::value || std::is_same<std::uint32_t, T>::value ||
+			std::is_same<bool, T>::value>>
+		{
+			static constexpr std::size_t s_alignment{ 4 };
+			static constexpr std::size_t s_size{ 4 };
+			// Whether or not the type is laid out in memory as its columns one after another
+			static constexpr bool s_packable{ !std::is_same<bool, T>::value };
+			static constexpr std::size_t s_column_count{ 1 };
+			static constexpr std::size_t s_column_size{ s_size };
+
+			static void Write(Uniform_Buffer::Byte* destination, const T& value)
+			{
+				if constexpr (std::is_same<bool, T>::value)
+				{
+					const std::uint32_t as_uint{ value };
+					std::memcpy(destination, &as_uint, s_size);
+				}
+				else
+					std::memcpy(destination, &value, s_size);
+			}
+		}; // Std140
+
+		/**
+		 * @brief Vectors. Two component vectors are aligned to eight bytes, three and four
+		 * component vectors to sixteen.
+		 */
+		template<glm::length_t L, typename T, glm::qualifier Q>
+		struct Std140<glm::vec<L, T, Q>, std::enable_if_t<(L >= 2 && L <= 4)>>
+		{
+			static constexpr std::size_t s_alignment{ (L == 2) ? 8u : 16u };
+			static constexpr std::size_t s_size{ Std140<T>::s_size * L };
+			static constexpr bool s_packable{ Std140<T>::s_packable &&
+				sizeof(glm::vec<L, T, Q>) == s_size };
+			static constexpr std::size_t s_column_count{ 1 };
+			static constexpr std::size_t s_column_size{ s_size };
+
+			static void Write(Uniform_Buffer::Byte* destination, const glm::vec<L, T, Q>& value)
+			{
+				if constexpr (std::is_same<bool, T>::value)
+				{
+					for (glm::length_t i{ 0 }; i < L; ++i)
+						Std140<T>::Write(destination + Std140<T>::s_size * i, value[i]);
+				}
+				else
+					std::memcpy(destination, &value[0], s_size);
+			}
+		}; // Std140
+
+		/**
+		 * @brief Float matrices, stored as an array of column vectors with each column taking up
+		 * a full vector4.
+		 */
+		template<glm::length_t C, glm::length_t R, glm::qualifier Q>
+		struct Std140<glm::mat<C, R, float, Q>, std::enable_if_t<(C >= 2 && C <= 4 && R >= 2 &&
+			R <= 4)>>
+		{
+			static constexpr std::size_t s_alignment{ 16 };
+			static constexpr std::size_t s_size{ 16u * C };
+			static constexpr bool s_packable{ sizeof(glm::mat<C, R, float, Q>) ==
+				sizeof(float) * C * R };
+			static constexpr std::size_t s_column_count{ C };
+			static constexpr std::size_t s_column_size{ sizeof(float) * R };
+
+			static void Write(Uniform_Buffer::Byte* destination,
+				const glm::mat<C, R, float, Q>& value)
+			{
+				if constexpr (s_packable)
+				{
+					Uniform_Buffer::Pack(destination, &value[0][0], s_column_size, C, 16);
+				}
+				else
+				{
+					for (glm::length_t i{ 0 }; i < C; ++i)
+						std::memcpy(destination + 16u * i, &value[i][0], s_column_size);
+				}
+			}
+		}; // Std140
+
+		/**
+		 * @brief Arrays, where every element is aligned to sixteen bytes.
+		 */
+		template<typename T, std::size_t N>
+		struct Std140<std::array<T, N>, std::enable_if_t<(N > 0)>>
+		{
+			static constexpr std::size_t s_stride{ Std140_Align(Std140<T>::s_size, 16) };
+			static constexpr std::size_t s_alignment{ 16 };
+			static constexpr std::size_t s_size{ s_stride * N };
+			// GLSL has no arrays of arrays
+			static constexpr bool s_packable{ false };
+
+			static void Write(Uniform_Buffer::Byte* destination, const std::array<T, N>& value)
+			{
+				// Every column of every element is aligned to a vector4, so the whole array is
+				// packed in one pass
+				if constexpr (Std140<T>::s_packable)
+				{
+					Uniform_Buffer::Pack(destination, value.data(), Std140<T>::s_column_size,
+						N * Std140<T>::s_column_count, 16);
+				}
+				else
+				{
+					for (std::size_t i{ 0 }; i < N; ++i)
+						Std140<T>::Write(destination + s_stride * i, value[i]);
+				}
+			}
+		}; // Std140
+
+		/**
+		 * @brief The std140 layout of a uniform block holding the given types in order.
+		 *
+		 * @tparam Ts - The types of the members of the block.
+		 */
+		template<typename... Ts>
+		class Std140_Layout
+		{
+		public:
+
+			static_assert(sizeof...(Ts) > 0, "A uniform block needs at least one member");
+
+			// The amount of members
+			static constexpr std::size_t s_count{ sizeof...(Ts) };
+
+			// The type of a member
+			template<std::size_t I>
+			using Type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+		private:
+
+			static constexpr std::array<std::size_t, s_count + 1> Calculate_Offsets()
+			{
+				constexpr std::size_t alignments[]{ Std140<Ts>::s_alignment... };
+				constexpr std::size_t sizes[]{ Std140<Ts>::s_size... };
+
+				std::array<std::size_t, s_count + 1> offsets{};
+				std::size_t offset{};
+				for (std::size_t i{ 0 }; i < s_count; ++i)
+				{
+					offsets[i] = Std140_Align(offset, alignments[i]);
+					offset = offsets[i] + sizes[i];
+				}
+				// The block itself is padded to a multiple of a vector4
+				offsets[s_count] = Std140_Align(offset, 16);
+				return offsets;
+			}
+
+			static constexpr std::array<std::size_t, s_count + 1> s_offsets{ Calculate_Offsets() };
+
+		public:
+
+			/**
+			 * @brief Gets the offset in bytes of a member from the start of the block.
+			 */
+			template<std::size_t I>
+			static constexpr std::size_t Offset()
+			{
+				static_assert(I < s_count, "Uniform block member index out of range");
+				return s_offsets[I];
+			}
+
+			// The total size in bytes of the block
+			static constexpr std::size_t s_size{ s_offsets[s_count] };
+
+		}; // Std140_Layout
+
+		/**
+		 * @brief A uniform block with a layout known at compile time. Members are referred to by
+		 * index, which is easiest to keep readable with an enum mirroring the block in GLSL:
+		 *
+		 *	using Matrices = Uniform_Block<glm::mat4, glm::mat4>;
+		 *	enum Matrices_Member : std::size_t { Projection, View };
+		 *	static_assert(Matrices::Layout::Offset<View>() == 64);
+		 *
+		 *	matrices.Set<View>(view);
+		 *	matrices.Upload();
+		 *
+		 * @tparam Ts - The types of the members of the block.
+		 */
+		template<typename... Ts>
+		class Uniform_Block
+		{
+		public:
+
+			// The std140 layout of the block
+			using Layout = Std140_Layout<Ts...>;
+
+			/**
+			 * @brief Generates the ubo and allocates the block.
+			 *
+			 * @param bind_point - If positive the binding point to bind to.
+			 */
+			void Init(const std::int32_t& bind_point = -1)
+			{
+				m_buffer.Init({}, false);
+				m_buffer.Reset(Layout::s_size);
+				if (bind_point >= 0)
+					m_buffer.Set_Bind_Point(static_cast<std::uint32_t>(bind_point));
+			}
+
+			/**
+			 * @brief Deletes the ubo.
+			 */
+			void Terminate() { m_buffer.Terminate(); }
+
+			/**
+			 * @brief Writes a member into the local buffer and marks it as dirty. Nothing is sent
+			 * to openGL until Upload is called.
+			 *
+			 * @tparam I - The index of the member.
+			 *
+			 * @param value - The value to write.
+			 */
+			template<std::size_t I>
+			void Set(const typename Layout::template Type<I>& value)
+			{
+				using Member = Std140<typename Layout::template Type<I>>;
+				Member::Write(m_buffer.Get_Block_Data() + Layout::template Offset<I>(), value);
+				m_buffer.Mark_Dirty(Layout::template Offset<I>(), Member::s_size);
+			}
+
+			/**
+			 * @brief Uploads the members set since the last upload to the ubo.
+			 */
+			void Upload() { m_buffer.Flush(); }
+
+			/**
+			 * @brief Sets the binding point of the ubo.
+			 */
+			void Set_Bind_Point(const std::uint32_t& bind_point)
+			{
+				m_buffer.Set_Bind_Point(bind_point);
+			}
+
+			/**
+			 * @brief Gets the latest bound to binding point.
+			 */
+			auto Get_Bind_Point() const { return m_buffer.Get_Bind_Point(); }
+
+			/**
+			 * @brief Gets the underlying uniform buffer.
+			 */
+			const Uniform_Buffer& Get_Buffer() const { return m_buffer; }
+
+		private:
+
+			// The ubo and local buffer the members are written to
+			Uniform_Buffer m_buffer{};
+
+		}; // Uniform_Block
+
+		// Checks the layout rules against the examples of the std140 rules in the openGL
+		// specification
+		static_assert(Std140_Layout<float, glm::vec2, glm::vec3>::Offset<1>() == 8);
+		static_assert(Std140_Layout<float, glm::vec2, glm::vec3>::Offset<2>() == 16);
+		static_assert(Std140_Layout<float, glm::vec2, glm::vec3>::s_size == 32);
+		static_assert(Std140_Layout<glm::vec3, float>::Offset<1>() == 12);
+		static_assert(Std140_Layout<float, std::array<float, 2>, glm::mat3, bool>::Offset<1>() ==
+			16);
+		static_assert(Std140_Layout<float, std::array<float, 2>, glm::mat3, bool>::Offset<2>() ==
+			48);
+		static_assert(Std140_Layout<float, std::array<float, 2>, glm::mat3, bool>::Offset<3>() ==
+			96);
+		static_assert(Std140_Layout<glm::mat4, glm::mat4>::s_size == 128);
+		static_assert(Std140_Layout<std::array<glm::mat4, 2>, glm::uvec2>::Offset<1>() == 128);
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_UNIFORM_BLOCK_HPP
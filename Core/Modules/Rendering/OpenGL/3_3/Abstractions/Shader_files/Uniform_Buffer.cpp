@@ -3,6 +3,7 @@
 
 // Standard
 #include <iostream>
+#include <algorithm>
 
 // Tilia
 #include "Uniform_Buffer.hpp"
@@ -11,9 +12,16 @@
 #include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
 #include TILIA_OPENGL_3_3_UTILS_INCLUDE
 
+#if TILIA_SSE2 == 1
+// Standard
+#include <emmintrin.h>
+#endif // TILIA_SSE2 == 1
+
 // Defines static variables
 std::uint32_t tilia::gfx::Uniform_Buffer::s_bound_ID{};
 std::uint32_t tilia::gfx::Uniform_Buffer::s_previous_ID{};
+tilia::gfx::Uniform_Buffer::Upload_Stats tilia::gfx::Uniform_Buffer::s_frame_stats{};
+tilia::gfx::Uniform_Buffer::Upload_Stats tilia::gfx::Uniform_Buffer::s_last_frame_stats{};
 
 /**
  * @brief Aligns a number to the closest higher multiple of another number.
@@ -53,7 +61,8 @@ tilia::gfx::Uniform_Buffer::Uniform_Buffer(Uniform_Buffer&& other,
       m_bind_point{ other.m_bind_point },
       m_variables{ std::move(other.m_variables) },
       m_block_data{ std::move(other.m_block_data) },
-      m_block_size{ other.m_block_size }
+      m_block_size{ other.m_block_size },
+      m_dirty_ranges{ std::move(other.m_dirty_ranges) }
 {
     // We set the other id to 0 since we don't want shared openGL data between two uniform buffers
     other.m_ID = 0;
@@ -96,6 +105,7 @@ tilia::gfx::Uniform_Buffer& tilia::gfx::Uniform_Buffer::operator=(Uniform_Buffer
     // We move other block data to ours
     m_block_data = std::move(other.m_block_data);
     m_block_size = other.m_block_size;
+    m_dirty_ranges = std::move(other.m_dirty_ranges);
     // We set the other block size to 0 to show that it contains nothing
     other.m_block_size = 0;
     return *this;
@@ -173,6 +183,14 @@ void tilia::gfx::Uniform_Buffer::Reset(
 
 }
 
+void tilia::gfx::Uniform_Buffer::Reset(const std::size_t& block_size)
+{
+    // We clear the old variables
+    Clear();
+    // Block size has to end in a multiple of a vector4
+    Allocate_Data(align_to(block_size, VEC4_SIZE));
+}
+
 void tilia::gfx::Uniform_Buffer::Clear()
 {
     // We clear the stored variables
@@ -181,6 +199,7 @@ void tilia::gfx::Uniform_Buffer::Clear()
     // We reset the local buffer to nullptr since the variable size is 0
     m_block_data.reset();
     m_block_size = 0;
+    m_dirty_ranges.clear();
 
 }
 
@@ -256,181 +275,208 @@ void tilia::gfx::Uniform_Buffer::Rebind() {
 void tilia::gfx::Uniform_Buffer::Uniform(const std::size_t& offset, const std::size_t& size, 
     const void* vs, const bool& delay, Byte* buffer)
 {
-    
-    // If we decide to delay the upload to openGL then we just don't make the calls
-    if (!delay)
-    {
-        // If ubo is not already bound then binds it
-        if (m_ID != s_bound_ID)
-        {
-            Unbind(true);
-            Bind();
-        }
 
-        // Sets the data of the offset and size with the given data
-        GL_CALL(glBufferSubData(GL_UNIFORM_BUFFER, offset, size, vs));
-
-        // If just bound the ubo then rebinds the old one
-        if (m_ID == s_bound_ID && m_ID != s_previous_ID)
-            Rebind();
-    }
-
-    // Buffers the uniform data to a local buffer
-    // We take in a buffer to write to but if it is nullptr we write to our local buffer block data
-    if (buffer == nullptr)
-    {
-        std::memcpy(m_block_data.get() + offset, vs, size);
-    }
-    // If buffer isn't nullptr then we write to it instead
-    else
+    // We take in a buffer to write to but if it isn't nullptr we only write to it
+    if (buffer != nullptr)
     {
         std::memcpy(buffer + offset, vs, size);
+        return;
     }
 
+    // Buffers the uniform data to our local buffer and remembers the changed range
+    std::memcpy(m_block_data.get() + offset, vs, size);
+    Mark_Dirty(offset, size);
+
+    // If we don't delay the upload to openGL then the changes are uploaded straight away
+    if (!delay)
+        Flush();
+
 }
 
 void tilia::gfx::Uniform_Buffer::Uniform(const std::string& loc, const std::size_t& var_size, 
     const void* vs, const bool& delay)
 {
+    // Looks up the variable once, without inserting a new one if the name is wrong
+    const auto found{ m_variables.find(loc) };
+    if (found == m_variables.end())
+    {
+        throw utils::Tilia_Exception{ { TILIA_LOCATION,
+            "Uniform buffer { ID: ", m_ID, " } has no variable named ", loc } };
+    }
     // The offset to the start of the variable in the uniform block
-    const std::size_t& start_offset{ m_variables[loc].first };
+    const std::size_t& start_offset{ found->second.first };
     // The variable of which to set the uniform data for
-    const GLSL_Variable& variable{ m_variables[loc].second };
+    const GLSL_Variable& variable{ found->second.second };
     const std::size_t array_count{ variable.Get_Array_Count() };
-    // The total size of the variable.   
-    const std::size_t total_variable_size{ utils::Get_GLSL_Scalar_Size(variable.Get_Scalar_Type()) 
-        * *variable.Get_Container_Type() * ((array_count)? array_count : 1) };
-    // Local variable data buffer which will help if uploading array or matrix in that it will
-    // reduce calls to openGL. Only needed if we don't already buffer everything to a local buffer
-    // with delay.
-    std::unique_ptr<Byte[]> variable_data{ nullptr };
+    // Whether or not the variable, or each element of it if it is an array, is a matrix
+    const bool is_matrix{ *variable.Get_Container_Type() >= *enums::GLSL_Container_Type::Matrix2 };
+    // The amount of columns of each element, which are each aligned to a vector4
+    const std::size_t column_count{ (is_matrix) ? static_cast<std::size_t>(
+        *variable.Get_Container_Type() / *enums::GLSL_Container_Type::Vector4) : 1 };
+    // The total amount of vectors or scalars to write
+    const std::size_t element_count{ ((array_count) ? array_count : 1) * column_count };
+    // The size in bytes between each element in the uniform block, matrix columns and array
+    // elements are both aligned to a vector4
+    const std::size_t stride{ (element_count > 1) ? align_to(var_size, VEC4_SIZE) : var_size };
+    // Scatters every element into the local buffer in one pass
+    Pack(m_block_data.get() + start_offset, vs, var_size, element_count, stride);
+    Mark_Dirty(start_offset, stride * element_count);
+    // If we don't delay the upload then the whole variable is uploaded now
     if (!delay)
-        variable_data = std::make_unique<Byte[]>(total_variable_size);
+        Flush();
+}
+
+void tilia::gfx::Uniform_Buffer::Map_Data()
+{
     // If ubo is not already bound then binds it
     if (m_ID != s_bound_ID)
     {
         Unbind(true);
         Bind();
     }
-    // If variable is not an array
-    if (!array_count)
+    // Sets the data of the offset and size with the given data
+    GL_CALL(glBufferSubData(GL_UNIFORM_BUFFER, 0, m_block_size, m_block_data.get()));
+    ++s_frame_stats.calls;
+    s_frame_stats.bytes += m_block_size;
+    // Everything has been uploaded
+    m_dirty_ranges.clear();
+    // If just bound the ubo then rebinds the old one
+    if (m_ID == s_bound_ID && m_ID != s_previous_ID)
+        Rebind();
+}
+
+void tilia::gfx::Uniform_Buffer::Mark_Dirty(const std::size_t& offset, const std::size_t& size)
+{
+    if (!size)
+        return;
+    const std::size_t end{ offset + size };
+    // Writes often follow each other, in which case the last range is just grown
+    if (!m_dirty_ranges.empty())
     {
-        // If variable is not matrix
-        if (*variable.Get_Container_Type() < *enums::GLSL_Container_Type::Matrix2)
+        auto& last{ m_dirty_ranges.back() };
+        if (offset <= last.second + s_merge_distance && end + s_merge_distance >= last.first)
         {
-            // Sets the uniform data for the given variable
-            // Also unbinds if just bound the ubo
-            Uniform(start_offset, var_size, vs, delay);
-            // Early return
+            last.first = std::min(last.first, offset);
+            last.second = std::max(last.second, end);
             return;
         }
-        // If variable is matrix
-        // The size in bytes between each element (vector4)
-        const std::size_t stride{ VEC4_SIZE };
-        // However many elements (vector4) there are in the matrix
-        const std::size_t element_count{ static_cast<std::size_t>(*variable.Get_Container_Type() / 
-            *enums::GLSL_Container_Type::Vector4) };
-        for (std::size_t u{ 0 }; u < element_count; ++u)
-        {
-            // If variable data nullptr then we just set uniforms normally
-            if (variable_data == nullptr)
-            {
-                // Sets the uniform data for the element of the given matrix
-                // Also unbinds if just bound the ubo
-                Uniform(start_offset + stride * u, var_size, 
-                    static_cast<const void*>(static_cast<const char*>(vs) + var_size * u), delay);
-            }
-            else
-            {
-                // Sets the uniform data for the element of the given matrix to the local buffer
-                // variable data
-                Uniform(stride * u, var_size, static_cast<const void*>(static_cast<const char*>(vs) 
-                    + var_size * u), true, variable_data.get());
-            }
-        }
     }
-    // If variable is array
-    // The size in bytes between each element in the array
-    const std::size_t stride{ align_to(var_size, VEC4_SIZE) };
-    for (std::size_t i{ 0 }; i < array_count; ++i)
+    m_dirty_ranges.emplace_back(offset, end);
+}
+
+void tilia::gfx::Uniform_Buffer::Flush()
+{
+    // Nothing has changed since the last upload
+    if (m_dirty_ranges.empty())
+        return;
+    Coalesce_Dirty_Ranges();
+    // If ubo is not already bound then binds it
+    if (m_ID != s_bound_ID)
+    {
+        Unbind(true);
+        Bind();
+    }
+    // Uploads each of the merged ranges
+    for (const auto& range : m_dirty_ranges)
+    {
+        GL_CALL(glBufferSubData(GL_UNIFORM_BUFFER, range.first, range.second - range.first, 
+            m_block_data.get() + range.first));
+        ++s_frame_stats.calls;
+        s_frame_stats.bytes += range.second - range.first;
+    }
+    m_dirty_ranges.clear();
+    // If just bound the ubo then rebinds the old one
+    if (m_ID == s_bound_ID && m_ID != s_previous_ID)
+        Rebind();
+}
+
+void tilia::gfx::Uniform_Buffer::Pack(Byte* destination, const void* source, 
+    const std::size_t& element_size, const std::size_t& count, const std::size_t& stride)
+{
+    const Byte* elements{ static_cast<const Byte*>(source) };
+    // Tightly packed elements are already laid out like the block
+    if (element_size == stride)
+    {
+        std::memcpy(destination, elements, element_size * count);
+        return;
+    }
+    std::size_t i{ 0 };
+#if TILIA_SSE2 == 1
+    // Only the bits are moved, so float loads are fine for ints as well
+    if (stride == VEC4_SIZE)
     {
-        // If element of array is not matrix
-        if (*variable.Get_Container_Type() < *enums::GLSL_Container_Type::Matrix2)
+        switch (element_size)
         {
-            // If variable data nullptr then we just set uniforms normally
-            if (variable_data == nullptr)
-            {
-                // Sets the uniform data for the element of the given array
-                // Also unbinds if just bound the ubo
-                Uniform(start_offset + stride * i, var_size, 
-                    static_cast<const void*>(static_cast<const char*>(vs) + var_size * i), delay);
-            }
-            else
+        case 12:
+        {
+            // Loads each element along with the first scalar of the next which is masked away.
+            // The last element is left for the scalar path so as not to read past the source.
+            const __m128 mask{ _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)) };
+            for (; i + 1 < count; ++i)
             {
-                // Sets the uniform data for the element of the given array to the local buffer
-                // variable data
-                Uniform(stride * i, var_size, static_cast<const void*>(static_cast<const char*>(vs) 
-                    + var_size * i), true, variable_data.get());
+                _mm_storeu_ps(reinterpret_cast<float*>(destination + 16 * i), _mm_and_ps(
+                    _mm_loadu_ps(reinterpret_cast<const float*>(elements + 12 * i)), mask));
             }
-            
-            // Early return
-            if (i == array_count - 1)
-                return;
-            // Early continue
-            continue;
+            break;
         }
-        // The amount of elements in the matrix
-        const std::size_t element_count{ static_cast<std::size_t>(*variable.Get_Container_Type() / 
-            *enums::GLSL_Container_Type::Vector4) };
-        for (std::size_t u{ 0 }; u < element_count; ++u)
-        {
-            // If variable data nullptr then we just set uniforms normally
-            if (variable_data == nullptr)
+        case 8:
+            for (; i < count; ++i)
             {
-                // Sets the uniform data of the matrix element of the array
-                // Also unbinds if just bound the ubo
-                Uniform(start_offset + (stride * element_count * i) + (stride * u), var_size, 
-                    static_cast<const void*>(static_cast<const char*>(vs) + (var_size * 
-                        element_count * i) + (var_size * u)), delay);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 16 * i), 
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(elements + 8 * i)));
             }
-            else
+            break;
+        case 4:
+            for (; i < count; ++i)
             {
-                // Sets the uniform data of the matrix element of the array to the local buffer
-                // variable data
-                Uniform((stride * element_count * i) + (stride * u), var_size, static_cast<const 
-                    void*>(static_cast<const char*>(vs) + (var_size * element_count * i) + 
-                        (var_size * u)), true, variable_data.get());
+                std::int32_t scalar;
+                std::memcpy(&scalar, elements + 4 * i, sizeof(scalar));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 16 * i), 
+                    _mm_cvtsi32_si128(scalar));
             }
-
+            break;
+        default:
+            break;
         }
     }
-    // If delay was false and we buffered data to our local buffer then we need to finally upload
-    // it
-    if (!delay)
+#endif // TILIA_SSE2 == 1
+    // Writes the elements not handled above
+    for (; i < count; ++i)
     {
-        Uniform(start_offset, total_variable_size, variable_data.get(), false);
+        std::memcpy(destination + stride * i, elements + element_size * i, element_size);
+        std::memset(destination + stride * i + element_size, 0, stride - element_size);
     }
 }
 
-void tilia::gfx::Uniform_Buffer::Map_Data()
+void tilia::gfx::Uniform_Buffer::Next_Frame()
 {
-    // If ubo is not already bound then binds it
-    if (m_ID != s_bound_ID)
+    s_last_frame_stats = s_frame_stats;
+    s_frame_stats = {};
+}
+
+void tilia::gfx::Uniform_Buffer::Coalesce_Dirty_Ranges()
+{
+    std::sort(m_dirty_ranges.begin(), m_dirty_ranges.end());
+    // Merges every range into the last kept one if they overlap or lie close enough
+    std::size_t kept{ 0 };
+    for (std::size_t i{ 1 }; i < m_dirty_ranges.size(); ++i)
     {
-        Unbind(true);
-        Bind();
+        auto& last{ m_dirty_ranges[kept] };
+        if (m_dirty_ranges[i].first <= last.second + s_merge_distance)
+        {
+            last.second = std::max(last.second, m_dirty_ranges[i].second);
+            continue;
+        }
+        m_dirty_ranges[++kept] = m_dirty_ranges[i];
     }
-    // Sets the data of the offset and size with the given data
-    GL_CALL(glBufferSubData(GL_UNIFORM_BUFFER, 0, m_block_size, m_block_data.get()));
-    // If just bound the ubo then rebinds the old one
-    if (m_ID == s_bound_ID && m_ID != s_previous_ID)
-        Rebind();
+    m_dirty_ranges.resize(kept + 1);
 }
 
 void tilia::gfx::Uniform_Buffer::Allocate_Data(const std::size_t& block_size)
 {
     m_block_size = block_size;
     m_block_data = std::make_unique<Byte[]>(block_size);
+    m_dirty_ranges.clear();
     GL_CALL(glBindBuffer(GL_UNIFORM_BUFFER, m_ID));
     // Allocates memory for the total size of the uniform block
     glBufferData(GL_UNIFORM_BUFFER, block_size, NULL, GL_DYNAMIC_DRAW);
@@ -549,4 +595,125 @@ std::size_t tilia::gfx::Uniform_Buffer::Push_Variable(std::size_t block_size,
     // Returns the new block size
     return block_size;
 
-}
\ No newline at end of file
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "vendor/Catch2/Catch2.hpp"
+
+void tilia::gfx::Uniform_Buffer::Test()
+{
+
+    SECTION("Packing")
+    {
+        // Checks every element against a plain copy and every padding byte against zero
+        const auto check{ [](const std::vector<Byte>& packed, const std::vector<float>& source, 
+            std::size_t element_size, std::size_t count, std::size_t stride)
+        {
+            for (std::size_t i{ 0 }; i < count; ++i)
+            {
+                REQUIRE(std::memcmp(packed.data() + stride * i, 
+                    reinterpret_cast<const Byte*>(source.data()) + element_size * i, 
+                    element_size) == 0);
+                for (std::size_t u{ element_size }; u < stride; ++u)
+                    REQUIRE(packed[stride * i + u] == 0);
+            }
+        } };
+
+        std::vector<float> source(4 * 37);
+        for (std::size_t i{ 0 }; i < source.size(); ++i)
+            source[i] = static_cast<float>(i) + 0.5f;
+
+        // Odd counts to hit the leftover elements, and matrix columns
+        for (const std::size_t element_size : { 4, 8, 12, 16 })
+        {
+            for (const std::size_t count : { 1, 2, 9, 37 })
+            {
+                std::vector<Byte> packed(VEC4_SIZE * count, Byte{ 0x7f });
+                Pack(packed.data(), source.data(), element_size, count, VEC4_SIZE);
+                check(packed, source, element_size, count, VEC4_SIZE);
+            }
+        }
+
+        // Other strides are not vectorized
+        std::vector<Byte> packed(32 * 6, Byte{ 0x7f });
+        Pack(packed.data(), source.data(), 12, 6, 32);
+        check(packed, source, 12, 6, 32);
+    }
+
+    SECTION("Packing benchmark")
+    {
+        // A skinning palette of mat3
+        constexpr std::size_t column_count{ 256 * 3 };
+        std::vector<float> source(column_count * 3, 1.0f);
+        std::vector<Byte> packed(column_count * VEC4_SIZE);
+
+        BENCHMARK("Pack 256 mat3")
+        {
+            Pack(packed.data(), source.data(), 12, column_count, VEC4_SIZE);
+            return packed[0];
+        };
+
+        BENCHMARK("Copy 256 mat3 column by column")
+        {
+            for (std::size_t i{ 0 }; i < column_count; ++i)
+            {
+                std::memcpy(packed.data() + VEC4_SIZE * i, source.data() + 3 * i, 12);
+            }
+            return packed[0];
+        };
+    }
+
+    SECTION("Dirty ranges")
+    {
+        Uniform_Buffer buffer{};
+
+        // Touching writes grow the same range
+        buffer.Mark_Dirty(0, 16);
+        buffer.Mark_Dirty(16, 16);
+        REQUIRE(buffer.Get_Dirty_Ranges().size() == 1);
+        REQUIRE(buffer.Get_Dirty_Ranges()[0] == std::make_pair<std::size_t, std::size_t>(0, 32));
+
+        // Empty writes change nothing
+        buffer.Mark_Dirty(128, 0);
+        REQUIRE(buffer.Get_Dirty_Ranges().size() == 1);
+
+        // Far apart writes are kept apart
+        buffer.Mark_Dirty(400, 16);
+        buffer.Mark_Dirty(200, 4);
+        REQUIRE(buffer.Get_Dirty_Ranges().size() == 3);
+
+        // Close writes out of order are merged when coalescing
+        buffer.Mark_Dirty(40, 4);
+        buffer.Coalesce_Dirty_Ranges();
+        const auto& ranges{ buffer.Get_Dirty_Ranges() };
+        REQUIRE(ranges.size() == 3);
+        REQUIRE(ranges[0] == std::make_pair<std::size_t, std::size_t>(0, 44));
+        REQUIRE(ranges[1] == std::make_pair<std::size_t, std::size_t>(200, 204));
+        REQUIRE(ranges[2] == std::make_pair<std::size_t, std::size_t>(400, 416));
+
+        buffer.Mark_Dirty(100, 60);
+        buffer.Coalesce_Dirty_Ranges();
+        REQUIRE(buffer.Get_Dirty_Ranges().size() == 2);
+        REQUIRE(buffer.Get_Dirty_Ranges()[0] == 
+            std::make_pair<std::size_t, std::size_t>(0, 204));
+
+        buffer.Clear();
+        REQUIRE(buffer.Get_Dirty_Ranges().empty());
+    }
+
+    SECTION("Upload stats")
+    {
+        s_frame_stats = { 3, 96 };
+        Next_Frame();
+        REQUIRE(Get_Upload_Stats().calls == 3);
+        REQUIRE(Get_Upload_Stats().bytes == 96);
+        Next_Frame();
+        REQUIRE(Get_Upload_Stats().calls == 0);
+    }
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
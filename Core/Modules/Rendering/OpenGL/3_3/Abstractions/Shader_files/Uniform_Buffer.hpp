@@ -29,6 +29,7 @@
 // Tilia
 #include "Core/Values/Directories.hpp"
 #include TILIA_OPENGL_3_3_CONSTANTS_INCLUDE
+#include TILIA_CONSTANTS_INCLUDE
 
 namespace tilia
 {
@@ -86,10 +87,25 @@ namespace tilia
 
 			};
 
+        public:
+
 			// Alias for byte assuming char is 1 byte.
 			using Byte = char;
 
-        public:
+			/**
+			 * @brief The amount of uploads made to uniform buffers, used for profiling.
+			 */
+			struct Upload_Stats
+			{
+				// The amount of calls made to openGL
+				std::size_t calls{};
+				// The amount of bytes uploaded
+				std::size_t bytes{};
+			}; // Upload_Stats
+
+			// Dirty ranges closer to each other than this many bytes are uploaded as one, since
+			// uploading the few bytes between them is cheaper than another call
+			static constexpr std::size_t s_merge_distance{ 64 };
 
 			Uniform_Buffer() = default;
 
@@ -172,6 +188,15 @@ namespace tilia
 			void Reset(std::vector<std::pair<std::string, GLSL_Variable>> block_variables, 
 				const bool& indexing = false);
 
+			/**
+			 * @brief Clears the stored variables and allocates a block of the given size. Used by
+			 * blocks whose layout is known at compile time and which write straight into the
+			 * local buffer instead of going through named variables, see Uniform_Block.
+			 *
+			 * @param block_size - The size in bytes of the block.
+			 */
+			void Reset(const std::size_t& block_size);
+
 			/**
 			 * @brief Clears the stored variables and resets the local buffer.
 			 */
@@ -212,6 +237,13 @@ namespace tilia
 			 */
 			inline auto Get_Block_Size() const { return m_block_size; }
 
+			/**
+			 * @brief Gets the locally stored data which is uploaded by Map_Data.
+			 * 
+			 * @return A pointer to the start of the local buffer.
+			 */
+			inline Byte* Get_Block_Data() { return m_block_data.get(); }
+
 			/**
 			 * @brief Binds the uniform buffer.
 			 */
@@ -346,8 +378,68 @@ namespace tilia
 			 */
 			void Map_Data();
 
+			/**
+			 * @brief Marks a range of the local buffer as changed, so that it is uploaded by the
+			 * next call to Flush.
+			 * 
+			 * @param offset - The offset to the start of the range.
+			 * @param size - The size of the range.
+			 */
+			void Mark_Dirty(const std::size_t& offset, const std::size_t& size);
+
+			/**
+			 * @brief Uploads the changed ranges of the local buffer. Ranges which overlap or lie
+			 * close to each other are merged first so that as few calls as possible are made.
+			 * Meant to be called once per frame, after every delayed uniform has been set.
+			 */
+			void Flush();
+
+			/**
+			 * @brief Gets the changed ranges of the local buffer which have not been flushed, as
+			 * pairs of begin and end offsets.
+			 */
+			inline const auto& Get_Dirty_Ranges() const { return m_dirty_ranges; }
+
+			/**
+			 * @brief Scatters tightly packed elements into a std140 layout in one pass, writing
+			 * each element at the given stride and zeroing the padding after it. Matrices are
+			 * packed as arrays of their columns. The common cases of three, two and one
+			 * component elements at a stride of a vector4 are vectorized.
+			 * 
+			 * @param destination - Where to write the first element.
+			 * @param source - The tightly packed elements.
+			 * @param element_size - The size in bytes of each element.
+			 * @param count - The amount of elements.
+			 * @param stride - The size in bytes between each element in the destination, which
+			 * has to be at least the element size.
+			 */
+			static void Pack(Byte* destination, const void* source, 
+				const std::size_t& element_size, const std::size_t& count, 
+				const std::size_t& stride);
+
+			/**
+			 * @brief Gets the amount of uploads made by all uniform buffers during the last
+			 * frame.
+			 */
+			static Upload_Stats Get_Upload_Stats() { return s_last_frame_stats; }
+
+			/**
+			 * @brief Ends the current frame of upload stats.
+			 */
+			static void Next_Frame();
+
 			#undef TILIA_ENABLE_IF_UNIFORM
 			#endif // TILIA_UNIFORM_BUFFER_UNIFORMS
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Uniform_Buffer. Only tests the dirty ranges and so does not
+			 * need a context.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
 			
         private:
 
@@ -360,6 +452,12 @@ namespace tilia
 			 */
 			void Allocate_Data(const std::size_t& block_size);
 
+			/**
+			 * @brief Sorts the dirty ranges and merges those which overlap or are closer than
+			 * s_merge_distance to each other.
+			 */
+			void Coalesce_Dirty_Ranges();
+
 			/**
 			 * @brief Sets the data for a given uniform name in the bound uniform block.
 			 * 
@@ -406,11 +504,19 @@ namespace tilia
 			// The total size in bytes that the variables take up in the uniform block.
 			std::size_t m_block_size{};
 
+			// The begin and end offsets of the ranges of the local buffer changed since the last
+			// upload.
+			std::vector<std::pair<std::size_t, std::size_t>> m_dirty_ranges{};
+
 			// The currently bound ubo.
             static std::uint32_t s_bound_ID;
 			// The direct previously bound ubo.
 			static std::uint32_t s_previous_ID;
 
+			// The uploads of the current and of the last frame.
+			static Upload_Stats s_frame_stats;
+			static Upload_Stats s_last_frame_stats;
+
         }; // Uniform_Buffer
     } // gfx
 } // tilia
@@ -3,6 +3,7 @@
 
 // Standard
 #include <stdexcept>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -53,6 +54,9 @@ void tilia::gfx::Cube_Map::Reload()
     for (size_t i = 0; i < cube_sides; i++)
     {
 
+        m_cube_map_data.sides[i].color_format =
+            Get_Supported_Format(m_cube_map_data.sides[i].color_format);
+
         // Checks for faulty data
         if (   !m_cube_map_data.size 
             || !*m_cube_map_data.sides[i].color_format
@@ -73,7 +77,7 @@ void tilia::gfx::Cube_Map::Reload()
                 utils::Get_Cube_Map_Side_String(*enums::Cube_Map_Sides::Positive_X +
                     static_cast<int32_t>(i)),
                 "\n>>> Data: 0x",
-                static_cast<void*>(m_cube_map_data.sides[i].texture_data.get()) } };
+                static_cast<const void*>(m_cube_map_data.sides[i].texture_data.get()) } };
 
         }
 
@@ -99,12 +103,46 @@ void tilia::gfx::Cube_Map::Reload()
         // Sets openGL data
         try
         {
-            GL_CALL(glTexImage2D(*enums::Cube_Map_Sides::Positive_X + static_cast<int32_t>(i), 0,
-                *m_cube_map_data.sides[i].color_format,
-                m_cube_map_data.size, m_cube_map_data.size, 0,
-                *m_cube_map_data.sides[i].data_color_format,
-                GL_UNSIGNED_BYTE,
-                m_cube_map_data.sides[i].texture_data.get()));
+            if (utils::Is_Compressed_Format(*m_cube_map_data.sides[i].color_format))
+            {
+                const auto block_format{ Get_Block_Format(
+                    m_cube_map_data.sides[i].color_format) };
+
+                // Sides of a file are read from the encoded images kept by Block_Encoder, as
+                // long as the file is not larger than the max size
+                Block_Image block_image{};
+                if (!m_cube_map_data.sides[i].file_path.empty())
+                {
+                    block_image = Block_Encoder::Instance().Load(
+                        m_cube_map_data.sides[i].file_path, block_format, true);
+                }
+                if (block_image.width != m_cube_map_data.size ||
+                    block_image.height != m_cube_map_data.size)
+                {
+                    block_image = Block_Encoder::Encode(
+                        m_cube_map_data.sides[i].texture_data.get(),
+                        m_cube_map_data.size, m_cube_map_data.size,
+                        static_cast<int32_t>(utils::Get_Color_Format_Count(
+                            *m_cube_map_data.sides[i].data_color_format)),
+                        block_format);
+                }
+                GL_CALL(glCompressedTexImage2D(
+                    *enums::Cube_Map_Sides::Positive_X + static_cast<int32_t>(i), 0,
+                    *m_cube_map_data.sides[i].color_format,
+                    m_cube_map_data.size, m_cube_map_data.size, 0,
+                    static_cast<GLsizei>(block_image.data.size()),
+                    block_image.data.data()));
+            }
+            else
+            {
+                GL_CALL(glTexImage2D(*enums::Cube_Map_Sides::Positive_X + 
+                    static_cast<int32_t>(i), 0,
+                    *m_cube_map_data.sides[i].color_format,
+                    m_cube_map_data.size, m_cube_map_data.size, 0,
+                    *m_cube_map_data.sides[i].data_color_format,
+                    utils::Get_Color_Format_Type(*m_cube_map_data.sides[i].color_format),
+                    m_cube_map_data.sides[i].texture_data.get()));
+            }
         }
         catch (utils::Tilia_Exception& t_e)
         {
@@ -122,7 +160,7 @@ void tilia::gfx::Cube_Map::Reload()
                     static_cast<int32_t>(i)),
                 "\n>>> Size: ", m_cube_map_data.size,
                 "\n>>> Data: 0x",
-                static_cast<void*>(m_cube_map_data.sides[i].texture_data.get()),
+                static_cast<const void*>(m_cube_map_data.sides[i].texture_data.get()),
                 "\n>>> Path: ", m_cube_map_data.sides[i].file_path });
 
         }
@@ -131,6 +169,85 @@ void tilia::gfx::Cube_Map::Reload()
 
     Rebind();
 
+    Set_Levels(1);
+
+}
+
+void tilia::gfx::Cube_Map::Load_Container(const Texture_Container& container,
+    std::size_t first_level)
+{
+
+    constexpr size_t cube_sides{ *enums::Geometry_Features::Cube_Faces };
+
+    if (!container.Is_Open() || container.Get_Face_Count() != cube_sides ||
+        container.Get_Width() != container.Get_Height())
+    {
+        throw utils::Tilia_Exception{ { TILIA_LOCATION,
+            "Cube map { ID: ", m_ID, " } can only load an open container of six square faces",
+            "\n>>> Path: ", container.Get_Path(),
+            "\n>>> Face count: ", container.Get_Face_Count(),
+            "\n>>> Size: ", container.Get_Width(), "x", container.Get_Height() } };
+    }
+
+    m_cube_map_data.size = container.Get_Width();
+    for (size_t i = 0; i < cube_sides; i++)
+    {
+        m_cube_map_data.sides[i].file_path = container.Get_Path();
+        m_cube_map_data.sides[i].texture_data.reset();
+        m_cube_map_data.sides[i].color_format =
+            Get_Supported_Format(container.Get_Color_Format());
+        m_cube_map_data.sides[i].data_color_format = container.Get_Data_Color_Format();
+    }
+
+    first_level = std::min(std::max(first_level, Get_Fit_Level(container.Get_Width(),
+        container.Get_Height(), container.Get_Level_Count(), Get_Max_Size())),
+        container.Get_Level_Count() - 1);
+
+    Unbind(true);
+
+    try
+    {
+        // Levels of another size are left in a texture given fewer levels, so a new one is made
+        if (first_level != Get_First_Level())
+        {
+            std::uint32_t ID{};
+            GL_CALL(glGenTextures(1, &ID));
+            Replace_ID(ID);
+        }
+
+        Bind();
+
+        GL_CALL(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, 
+            *m_cube_map_data.filter_min));
+        GL_CALL(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, 
+            *m_cube_map_data.filter_mag));
+        GL_CALL(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, *m_cube_map_data.wrap_s));
+        GL_CALL(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, *m_cube_map_data.wrap_t));
+        GL_CALL(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, *m_cube_map_data.wrap_r));
+        GL_CALL(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL,
+            static_cast<GLint>(container.Get_Level_Count() - first_level - 1)));
+
+        for (size_t level = first_level; level < container.Get_Level_Count(); level++)
+        {
+            for (size_t i = 0; i < cube_sides; i++)
+            {
+                container.Upload(*enums::Cube_Map_Sides::Positive_X + static_cast<uint32_t>(i),
+                    level, i, first_level);
+            }
+        }
+    }
+    catch (utils::Tilia_Exception& t_e)
+    {
+        Rebind();
+        throw t_e.Add_Message({ TILIA_LOCATION,
+            "Cube map { ID: ", m_ID, " } failed to load container",
+            "\n>>> Path: ", container.Get_Path() });
+    }
+
+    Rebind();
+
+    Set_Levels(container.Get_Level_Count(), true, first_level);
+
 }
 
 void tilia::gfx::Cube_Map::Generate_Mipmaps()
@@ -146,6 +263,15 @@ void tilia::gfx::Cube_Map::Generate_Mipmaps()
                 "\n>>> Side: ", utils::Get_Cube_Map_Side_String(
                     *enums::Cube_Map_Sides::Positive_X + static_cast<int32_t>(i)) } };
         }
+        // Compressed formats can not be rendered to and so can not have mipmaps generated
+        if (utils::Is_Compressed_Format(*m_cube_map_data.sides[i].color_format))
+        {
+            throw utils::Tilia_Exception{ { TILIA_LOCATION,
+                "Cube map { ID: ", m_ID, " } could not generate mipmaps ",
+                "because its color format is compressed",
+                "\n>>> Side: ", utils::Get_Cube_Map_Side_String(
+                    *enums::Cube_Map_Sides::Positive_X + static_cast<int32_t>(i)) } };
+        }
     }
     try
     {
@@ -160,6 +286,7 @@ void tilia::gfx::Cube_Map::Generate_Mipmaps()
             "Cube map { ID: ", m_ID, " } failed to generate mipmaps" });
     }
     Rebind();
+    Set_Levels(Mip_Generator::Get_Level_Count(m_cube_map_data.size, m_cube_map_data.size) + 1);
 }
 
 void tilia::gfx::Cube_Map::Set_Filter(const enums::Filter_Size& filter_size, 
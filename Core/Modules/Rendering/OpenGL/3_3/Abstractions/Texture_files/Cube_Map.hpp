@@ -21,6 +21,7 @@
 #include "Core/Values/Directories.hpp"
 #include TILIA_OPENGL_3_3_TEXTURE__INCLUDE
 #include TILIA_OPENGL_3_3_CUBE_MAP_DATA_INCLUDE
+#include TILIA_OPENGL_3_3_TEXTURE_CONTAINER_INCLUDE
 
 namespace tilia {
 
@@ -59,7 +60,10 @@ namespace tilia {
             inline operator const Cube_Map_Data&() const { return m_cube_map_data; }
             
             /**
-             * @brief Reloads the data for all of the sides of the cube map. 
+             * @brief Reloads the data for all of the sides of the cube map. Sides of a block 
+             * compressed color format are loaded through Block_Encoder, so that the image of a
+             * file is only encoded once, while sides without a file are encoded every time.
+             * Block compressed formats the driver can not sample fall back to uncompressed ones.
              * 
              * @exception Guarantee: Basic
              * @exception Reasons:
@@ -67,6 +71,23 @@ namespace tilia {
              */
             void Reload();
 
+            /**
+             * @brief Uploads the mip levels of every side of a texture container straight from
+             * its mapping. The filtering and wrapping of the cube map data are kept while its
+             * size and formats are set to those of the container, the size being that of the
+             * first level of the container whichever levels are loaded. No texture data is kept.
+             * 
+             * @param container - The open container, which has to have six square faces.
+             * @param first_level - The first level to load, raised to the first level within
+             * the max size of Texture_ and clamped to the last one. The levels before it are
+             * left out, as when streaming mip levels.
+             * 
+             * @exception Guarantee: Basic
+             * @exception Reasons:
+             * @exception The container is not open or is not a cube map.
+             */
+            void Load_Container(const Texture_Container& container, std::size_t first_level = 0);
+
             /**
              * @brief Reloads the texture data of the cube map data to the loaded textures from the
              * contained paths.
@@ -82,6 +103,7 @@ namespace tilia {
              * @exception Reasons:
              * @exception Any of the side of the cube map is missing texture data.
              * @exception The cube map is not cube complete.
+             * @exception Any of the sides is of a block compressed color format.
              */
             void Generate_Mipmaps() override;
 
@@ -227,19 +249,30 @@ namespace tilia {
             }
 
             /**
-             * @brief Gets the data from the given index. If specified then the ownership of the
-             * data will be released.
+             * @brief Shares the data of the given image with the side of the given index, see
+             * Cube_Map_Data::Set_Image.
+             *
+             * @param index - The index of the side of which data to set.
+             * @param image - The image for which to share the data of.
+             */
+            inline void Set_Data(const std::size_t& index, Image image) {
+                m_cube_map_data.Set_Image(index, std::move(image));
+            }
+
+            /**
+             * @brief Gets the data from the given index, which is shared with the side. If
+             * specified then the side lets go of the data.
              * 
              * @param index - The index of the side of which data to get.
-             * @param take_ownership - Wheter or not to release the ownership of the data.
+             * @param take_ownership - Wheter or not the side lets go of the data.
              * 
              * @return The texture data of the index.
              */
             inline auto Get_Data(const std::size_t& index, const bool& take_ownership = false) {
                 if (take_ownership)
-                    return m_cube_map_data.sides[index].texture_data.release();
+                    return std::move(m_cube_map_data.sides[index].texture_data);
                 else
-                    return m_cube_map_data.sides[index].texture_data.get();
+                    return m_cube_map_data.sides[index].texture_data;
             }
 
             /**
@@ -363,6 +396,9 @@ namespace tilia {
             // The info pertaining to this Texture_
             Cube_Map_Data m_cube_map_data{};
 
+            // Sets the data of streamed cube maps once they are whole
+            friend class Texture_Streamer;
+
         }; // Cube_Map
 
     } // gfx
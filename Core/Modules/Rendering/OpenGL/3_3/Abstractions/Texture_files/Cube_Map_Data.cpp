@@ -6,13 +6,10 @@
 // Headers
 #include "Cube_Map_Data.hpp"
 #include "Core/Values/Directories.hpp"
-#include TILIA_WINDOWS_FILE_SYSTEM_INCLUDE
 #include TILIA_TILIA_EXCEPTION_INCLUDE
 #include TILIA_LOGGING_INCLUDE
 #include TILIA_OPENGL_3_3_UTILS_INCLUDE
-
-// The file system defined in another file
-extern tilia::utils::File_System file_system;
+#include TILIA_OPENGL_3_3_TEXTURE_CACHE_INCLUDE
 
 tilia::gfx::Cube_Map_Data& tilia::gfx::Cube_Map_Data::operator=(const Cube_Map_Data& other) 
 noexcept
@@ -26,13 +23,8 @@ noexcept
     for (std::size_t i = 0; i < side_count; i++)
     {
         this->sides[i].file_path = other.sides[i].file_path;
-        // If there is any, copies the data of that side
-        if (other.sides[i].texture_data) {
-            uint32_t byte_count{ static_cast<uint32_t>((powf(static_cast<float>(this->size), 2.0f) 
-                * utils::Get_Color_Format_Count(
-                static_cast<uint32_t>(*other.sides[i].data_color_format)))) };
-            this->Copy_Data(i, other.sides[i].texture_data.get(), byte_count);
-        }
+        // Shares the data of that side
+        this->sides[i].texture_data = other.sides[i].texture_data;
         this->sides[i].color_format = other.sides[i].color_format;
         this->sides[i].data_color_format = other.sides[i].data_color_format;
     }
@@ -58,11 +50,8 @@ tilia::gfx::Cube_Map_Data& tilia::gfx::Cube_Map_Data::operator=(Cube_Map_Data&&
     for (std::size_t i = 0; i < side_count; i++)
     {
         this->sides[i].file_path = std::move(other.sides[i].file_path);
-        // If there is any, moves the data of that side
-        if (other.sides[i].texture_data) {
-            this->sides[i].texture_data.reset(other.sides[i].texture_data.get());
-            other.sides[i].texture_data.reset();
-        }
+        // Moves the data of that side
+        this->sides[i].texture_data = std::move(other.sides[i].texture_data);
         this->sides[i].color_format = other.sides[i].color_format;
         this->sides[i].data_color_format = other.sides[i].data_color_format;
     }
@@ -92,11 +81,14 @@ void tilia::gfx::Cube_Map_Data::Reload(const std::size_t& index)
 
     // Loads in the data from the stored path with the given index
     if (this->sides[index].file_path != "") {
-        std::int32_t temp{}, format{};
-        this->sides[index].texture_data.reset(file_system.Load_Image(
-            this->sides[index].file_path.c_str(),
-            temp, temp, format, 0, true));
-        this->sides[index].data_color_format = utils::Get_Data_Color_Format(format);
+        // The file may have changed since it was cached
+        Texture_Cache::Instance().Invalidate(this->sides[index].file_path);
+        const Image image{ Texture_Cache::Instance().Get_Image(this->sides[index].file_path,
+            enums::Image_Channels::Largest, Get_Data_Type(index), true,
+            Texture_::Get_Max_Size(), Texture_::Get_Resize_Filter()) };
+        this->sides[index].texture_data = image.Share_Data();
+        this->sides[index].data_color_format = utils::Get_Data_Color_Format(
+            static_cast<std::uint32_t>(*image.Channels()));
     }
     else
     {
@@ -112,16 +104,26 @@ void tilia::gfx::Cube_Map_Data::Reload(const std::size_t& index)
 void tilia::gfx::Cube_Map_Data::Reload()
 {
 
+    // The files may have changed since they were cached, sides of the same file still share
+    // the data loaded again
+    for (const auto& side : this->sides)
+    {
+        if (side.file_path != "")
+            Texture_Cache::Instance().Invalidate(side.file_path);
+    }
+
     // Loads in the data from the stored paths
     for (std::size_t i = 0; i < *enums::Geometry_Features::Cube_Faces; i++)
     {
 
         if (this->sides[i].file_path != "") {
-            int32_t format{};
-            this->sides[i].texture_data.reset(file_system.Load_Image(
-                this->sides[i].file_path.c_str(),
-                this->size, this->size, format, 0, true));
-            this->sides[i].data_color_format = utils::Get_Data_Color_Format(format);
+            const Image image{ Texture_Cache::Instance().Get_Image(this->sides[i].file_path,
+                enums::Image_Channels::Largest, Get_Data_Type(i), true,
+                Texture_::Get_Max_Size(), Texture_::Get_Resize_Filter()) };
+            this->size = image.Width();
+            this->sides[i].texture_data = image.Share_Data();
+            this->sides[i].data_color_format = utils::Get_Data_Color_Format(
+                static_cast<std::uint32_t>(*image.Channels()));
         }
         else
         {
@@ -140,14 +142,47 @@ void tilia::gfx::Cube_Map_Data::Copy_Data(const std::size_t& index, uint8_t* tex
     uint32_t byte_count)
 {
     if (!byte_count) {
-        // Calculates the byte count by taking the square of the size and multiplying by the number
-        // of color channels.
+        // Calculates the byte count by taking the square of the size and multiplying by the size
+        // of a texel.
         byte_count = static_cast<uint32_t>((powf(static_cast<float>(this->size), 2.0f) *
-            utils::Get_Color_Format_Count(
+            utils::Get_Color_Format_Size(
                 static_cast<uint32_t>(*this->sides[index].color_format))));
     }
 
     // Allocates memory of size byte count and then copies the given data to that memory location.
-    this->sides[index].texture_data = std::make_unique<uint8_t[]>(static_cast<size_t>(byte_count));
-    std::copy(texture_data, texture_data + byte_count, this->sides[index].texture_data.get());
+    std::shared_ptr<uint8_t[]> data{ new uint8_t[static_cast<size_t>(byte_count)] };
+    std::copy(texture_data, texture_data + byte_count, data.get());
+    this->sides[index].texture_data = std::move(data);
+}
+
+void tilia::gfx::Cube_Map_Data::Set_Image(const std::size_t& index, Image image)
+{
+    if (image.Size() <= 0 || image.Width() != image.Height() ||
+        image.Channels() == enums::Image_Channels::Grey_Alpha)
+    {
+        throw utils::Tilia_Exception{ { TILIA_LOCATION,
+            "Cube map side can only be set to a non empty square image",
+            " with one, three or four channels",
+            "\n>>> Side: ", utils::Get_Cube_Map_Side_String(
+                *enums::Cube_Map_Sides::Positive_X + static_cast<uint32_t>(index)),
+            "\n>>> Size: ", image.Width(), "x", image.Height(),
+            "\n>>> Channels: ", *image.Channels(),
+            "\n>>> Data type: ", *image.Data_Type() } };
+    }
+
+    const auto data_type{ Get_Data_Type(index) };
+    if (image.Data_Type() != data_type)
+        image = image.Convert(enums::Image_Channels::Largest, data_type);
+
+    this->size = image.Width();
+    this->sides[index].texture_data = image.Share_Data();
+    this->sides[index].data_color_format = utils::Get_Data_Color_Format(
+        static_cast<std::uint32_t>(*image.Channels()));
+}
+
+tilia::enums::Image_Data_Type tilia::gfx::Cube_Map_Data::Get_Data_Type(
+    const std::size_t& index) const
+{
+    return (utils::Is_Half_Format(*this->sides[index].color_format)) ?
+        enums::Image_Data_Type::Half : enums::Image_Data_Type::Unsigned_Byte;
 }
@@ -19,6 +19,7 @@
 #include "Core/Values/Directories.hpp"
 #define TILIA_INCLUDE_OPENGL_3_3_CONSTANTS
 #include TILIA_CONSTANTS_INCLUDE
+#include TILIA_IMAGE_INCLUDE
 
 namespace tilia {
 
@@ -37,8 +38,8 @@ namespace tilia {
             struct Cube_Side {
                 // The file path.
                 std::string                                 file_path{};
-                // The texture data.
-                std::unique_ptr<uint8_t[]>                  texture_data{};
+                // The texture data, shared by copies of the side.
+                Image::Shared_Data                          texture_data{};
                 // The color format.
                 enums::Color_Format	                        color_format{ 
                     enums::Color_Format::RGBA8 };
@@ -65,16 +66,16 @@ namespace tilia {
             enums::Wrap_Mode				                wrap_r{ enums::Wrap_Mode::Repeat };
 
             /**
-             * @brief Copy-assignment. Shallow copies everything except for the data of all the
-             * sides. It will instead be reset to a new pointer and then have the data copied over.
+             * @brief Copy-assignment. Shallow copies everything, the data of all the sides being
+             * shared instead of copied.
              *
              * @param other - The Cube_Map_Data for which to copy from.
              */
             Cube_Map_Data& operator=(const Cube_Map_Data& other) noexcept;
 
             /**
-             * @brief Move-assignment. Copies everything except for the data of all the sides. It
-             * will instead be reset to the pointer of the other data.
+             * @brief Move-assignment. Copies everything except for the data of all the sides,
+             * which is moved from the other data.
              *
              * @param other - The Cube_Map_Data for which to move from.
              */
@@ -98,7 +99,8 @@ namespace tilia {
 
             /**
              * @brief Reloads the texture data of the side with the given index with the path of
-             * the index.
+             * the index. The file is read again, its images being invalidated in Texture_Cache
+             * first, and the data is resized down to the max size of Texture_.
              *
              * @param index - The index of the side to reload the data of.
              */
@@ -106,6 +108,9 @@ namespace tilia {
 
             /**
              * @brief Reloads the texture data of all of the sides with the paths of all the sides.
+             * The files are read again, their images being invalidated in Texture_Cache first.
+             * Sides of the same file share the data loaded, which is resized down to the max
+             * size of Texture_.
              */
             void Reload();
 
@@ -118,6 +123,27 @@ namespace tilia {
              */
             void Copy_Data(const std::size_t& index, uint8_t* texture_data, uint32_t byte_count);
 
+            /**
+             * @brief Sets the data of the side with the given index to that of the given image,
+             * sharing it instead of copying it. Moving the image in leaves the side as the only
+             * holder of the data. The size is set to that of the image.
+             *
+             * @param index - The index of the side for which to set the data of.
+             * @param image - The square image with one, three or four channels. It is converted
+             * to the data type of the color format of the side should it not be of it.
+             *
+             * @exception The image is empty, not square or of two channels.
+             */
+            void Set_Image(const std::size_t& index, Image image);
+
+            /**
+             * @brief Gets the data type images of the side with the given index are loaded as,
+             * half floats for half color formats and unsigned bytes otherwise.
+             *
+             * @param index - The index of the side.
+             */
+            enums::Image_Data_Type Get_Data_Type(const std::size_t& index) const;
+
         }; // Cube_Map_Data
         
 	} // gfx
@@ -24,6 +24,7 @@
 
 // Standard
 #include <string.h>
+#include <algorithm>
 
 // Headers
 #include "Texture_.hpp"
@@ -37,6 +38,15 @@
 std::unordered_map<tilia::enums::Texture_Type_, uint32_t> tilia::gfx::Texture_::s_bound_ID{};
 // Initialize static member which holds the previously bound textures ids
 std::unordered_map<tilia::enums::Texture_Type_, uint32_t> tilia::gfx::Texture_::s_previous_ID{};
+// Initialize static member which holds the current frame
+std::uint64_t tilia::gfx::Texture_::s_frame{ 0 };
+// Initialize static member which holds the largest side textures are loaded with
+std::atomic<std::int32_t> tilia::gfx::Texture_::s_max_size{ 0 };
+// Initialize static member which holds the filter images are resized down with
+std::atomic<tilia::enums::Mip_Filter> tilia::gfx::Texture_::s_resize_filter{
+	tilia::enums::Mip_Filter::Box };
+// Initialize static member which holds whether or not BC1 and BC3 can be sampled
+std::atomic<bool> tilia::gfx::Texture_::s_has_s3tc{ true };
 
 /**
  * @brief Returns the type of texture as a string
@@ -77,6 +87,10 @@ void tilia::gfx::Texture_::Generate_Texture()
 	try
 	{
 		GL_CALL(glGenTextures(1, &m_ID));
+
+		// Asked once while a context is current, so that formats can be picked on any thread
+		static const bool has_s3tc{ utils::Has_Extension("GL_EXT_texture_compression_s3tc") };
+		s_has_s3tc = has_s3tc;
 	}
 	catch (utils::Tilia_Exception& t_e)
 	{
@@ -91,6 +105,31 @@ void tilia::gfx::Texture_::Generate_Texture()
 	//created", m_ID);
 }
 
+void tilia::gfx::Texture_::Set_Levels(std::size_t level_count, bool from_container,
+	std::size_t first_level)
+{
+	m_level_count = level_count;
+	m_from_container = from_container;
+	m_first_level = first_level;
+}
+
+void tilia::gfx::Texture_::Replace_ID(std::uint32_t ID)
+{
+
+	const std::uint32_t old_ID{ m_ID };
+	m_ID = ID;
+
+	for (auto stored : { &s_bound_ID, &s_previous_ID })
+	{
+		auto found{ stored->find(m_texture_type) };
+		if (found != stored->end() && found->second == old_ID)
+			found->second = m_ID;
+	}
+
+	GL_CALL(glDeleteTextures(1, &old_ID));
+
+}
+
 /**
  * Deletes the texture from openGL and frees m_texture_def.texture_data
  */
@@ -130,6 +169,7 @@ void tilia::gfx::Texture_::Bind(const uint32_t& slot) const
 	GL_CALL(glBindTexture(*m_texture_type, m_ID));
 
 	s_bound_ID[m_texture_type] = m_ID;
+	Mark_Used();
 
 }
 
@@ -204,3 +244,49 @@ void tilia::gfx::Texture_::Rebind(const enums::Texture_Type_& texture_type)
 	GL_CALL(glBindTexture(*texture_type, s_previous_ID[texture_type]));
 
 }
+
+tilia::enums::Block_Format tilia::gfx::Texture_::Get_Block_Format(
+	const enums::Color_Format& color_format)
+{
+	switch (color_format)
+	{
+	case enums::Color_Format::BC1:
+		return enums::Block_Format::BC1;
+	case enums::Color_Format::BC3:
+		return enums::Block_Format::BC3;
+	case enums::Color_Format::BC4:
+		return enums::Block_Format::BC4;
+	case enums::Color_Format::BC5:
+		return enums::Block_Format::BC5;
+	default:
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Color format is not block compressed { Format: ", *color_format, " }" } };
+	}
+}
+
+tilia::enums::Color_Format tilia::gfx::Texture_::Get_Supported_Format(
+	const enums::Color_Format& color_format)
+{
+	if (s_has_s3tc)
+		return color_format;
+	switch (color_format)
+	{
+	case enums::Color_Format::BC1:
+		return enums::Color_Format::RGB8;
+	case enums::Color_Format::BC3:
+		return enums::Color_Format::RGBA8;
+	default:
+		return color_format;
+	}
+}
+
+std::size_t tilia::gfx::Texture_::Get_Fit_Level(std::int32_t width, std::int32_t height,
+	std::size_t level_count, std::int32_t max_size)
+{
+	if (max_size <= 0)
+		return 0;
+	std::size_t level{ 0 };
+	while (level + 1 < level_count && std::max(width >> level, height >> level) > max_size)
+		++level;
+	return level;
+}
@@ -22,17 +22,25 @@
 
 // Standard
 #include <stdint.h>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 
 // Headers
 #include "Core/Values/Directories.hpp"
 #include TILIA_OPENGL_3_3_CONSTANTS_INCLUDE
+#include TILIA_BLOCK_ENCODER_INCLUDE
+#include TILIA_MIP_GENERATOR_INCLUDE
 
 namespace tilia {
 
 	namespace gfx {
 
+		class Texture_Streamer;
+		class Texture_Residency;
+
 		// Base class for texture classes
 		class Texture_ {
 		public:
@@ -59,7 +67,7 @@ namespace tilia {
 
 			/**
 			 * @brief Binds the texture to the given texture slot. If slot is outside of 
-			 * range, prints errors.
+			 * range, prints errors. The texture counts as used in the current frame.
 			 * 
 			 * @param slot - The texture slot to bind this texture to
 			 */
@@ -102,6 +110,46 @@ namespace tilia {
 			 */
 			inline const uint32_t& Get_ID() { return m_ID; }
 
+			/**
+			 * @brief Gets the type of the openGL texture
+			 * 
+			 * @return m_texture_type - The openGL texture type
+			 */
+			inline enums::Texture_Type_ Get_Type() const { return m_texture_type; }
+
+			/**
+			 * @brief Gets the amount of mip levels the texture has when whole, which is kept
+			 * while the texture is evicted by Texture_Residency.
+			 */
+			inline std::size_t Get_Level_Count() const { return m_level_count; }
+
+			/**
+			 * @brief Whether or not the texture was loaded from a texture container.
+			 */
+			inline bool Is_From_Container() const { return m_from_container; }
+
+			/**
+			 * @brief Gets the first mip level the texture holds, 0 when whole, and s_evicted when
+			 * it only holds a placeholder.
+			 */
+			inline std::size_t Get_First_Level() const { return m_first_level; }
+
+			/**
+			 * @brief Gets the frame the texture was last bound in, see Get_Frame.
+			 */
+			inline std::uint64_t Get_Last_Used_Frame() const { return m_last_used_frame; }
+
+			/**
+			 * @brief Makes the texture count as used in the current frame, for textures bound
+			 * other than through Bind, such as by replaying a command buffer.
+			 */
+			inline void Mark_Used() const { m_last_used_frame = s_frame; }
+
+			/**
+			 * @brief Gets the current frame, which is advanced by Texture_Residency::Update.
+			 */
+			static std::uint64_t Get_Frame() { return s_frame; }
+
 			/**
 			 * @brief Sets the filtering mode for the given filtering size
 			 *
@@ -120,6 +168,55 @@ namespace tilia {
 			virtual void Set_Wrapping(const enums::Wrap_Sides& wrap_side, 
 				const enums::Wrap_Mode& wrap_mode) = 0;
 
+			/**
+			 * @brief Gets the block format a texture of the given block compressed color format
+			 * is encoded to.
+			 *
+			 * @exception The color format is not block compressed
+			 */
+			static enums::Block_Format Get_Block_Format(const enums::Color_Format& color_format);
+
+			/**
+			 * @brief Gets the color format a texture asking for the given one is made with. BC1
+			 * and BC3 need GL_EXT_texture_compression_s3tc, without which they fall back to RGB8
+			 * and RGBA8, while BC4 and BC5 are core. May be called from any thread once a
+			 * texture has been generated.
+			 */
+			static enums::Color_Format Get_Supported_Format(
+				const enums::Color_Format& color_format);
+
+			/**
+			 * @brief Sets the largest side in texels textures are loaded with, 0 for no limit,
+			 * so that lower tiers of hardware may use less memory and upload time. Images larger
+			 * than it are resized down once decoded and the larger mip levels of texture
+			 * containers are skipped. Only textures loaded afterwards are affected. May be
+			 * called from any thread.
+			 */
+			static void Set_Max_Size(std::int32_t max_size) { s_max_size = max_size; }
+			static std::int32_t Get_Max_Size() { return s_max_size; }
+
+			/**
+			 * @brief Sets the filter images are resized down to the max size with, the box
+			 * filter being the fastest and the Kaiser filter the sharpest.
+			 */
+			static void Set_Resize_Filter(enums::Mip_Filter filter) { s_resize_filter = filter; }
+			static enums::Mip_Filter Get_Resize_Filter() { return s_resize_filter; }
+
+			/**
+			 * @brief Gets the first mip level whose largest side is within the given size, or
+			 * the last level if none is. 0 when the size is not above 0.
+			 *
+			 * @param width - The width of the first level of the texture.
+			 * @param height - The height of the first level of the texture.
+			 * @param level_count - The amount of levels of the texture.
+			 * @param max_size - The largest side a level may have.
+			 */
+			static std::size_t Get_Fit_Level(std::int32_t width, std::int32_t height,
+				std::size_t level_count, std::int32_t max_size);
+
+			// The first level of a texture which only holds a placeholder
+			static constexpr std::size_t s_evicted{ static_cast<std::size_t>(-1) };
+
 		protected:
 
 			uint32_t m_ID{}; // The id of the openGL texture
@@ -131,8 +228,44 @@ namespace tilia {
 			*/
 			void Generate_Texture();
 
+			/**
+			 * @brief Sets the mip levels of the texture once its data has been set.
+			 *
+			 * @param level_count - The amount of mip levels the texture has.
+			 * @param from_container - Whether or not the data is from a texture container.
+			 * @param first_level - The first mip level the texture holds, only loading
+			 * containers from a smaller level leaving the texture not whole.
+			 */
+			void Set_Levels(std::size_t level_count, bool from_container = false,
+				std::size_t first_level = 0);
+
+			/**
+			 * @brief Makes the texture use the openGL texture of the given id, deleting its
+			 * own. Any stored binding of the old id is moved along with it so that a later
+			 * Rebind does not bind a deleted texture.
+			 */
+			void Replace_ID(std::uint32_t ID);
+
 		private:
 
+			// The amount of mip levels of the texture when whole
+			std::size_t m_level_count{ 1 };
+			// Whether or not the data of the texture is from a texture container
+			bool m_from_container{ false };
+			// The first mip level held, set by Texture_Residency when evicting or streaming
+			std::size_t m_first_level{ 0 };
+			// The frame the texture was last bound in
+			mutable std::uint64_t m_last_used_frame{ 0 };
+
+			static std::uint64_t s_frame; // The current frame
+
+			// The largest side in texels textures are loaded with, 0 for no limit
+			static std::atomic<std::int32_t> s_max_size;
+			// The filter images are resized down to the max size with
+			static std::atomic<enums::Mip_Filter> s_resize_filter;
+			// Whether or not the driver can sample BC1 and BC3, asked when generating a texture
+			static std::atomic<bool> s_has_s3tc;
+
 			static std::unordered_map<enums::Texture_Type_, uint32_t> s_bound_ID; // The stored
 			// perviously bound ids
 
@@ -146,6 +279,11 @@ namespace tilia {
 			 */
 			std::string Get_Type_String() const;
 
+			// Swaps streamed textures in for their placeholders
+			friend class Texture_Streamer;
+			// Evicts textures and tracks their use
+			friend class Texture_Residency;
+
 		};
 
 	}
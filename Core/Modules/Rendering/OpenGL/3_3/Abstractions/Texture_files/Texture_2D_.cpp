@@ -25,18 +25,27 @@
 
 // Standard
 #include <stdexcept>
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 // Headers
 #include "Texture_2D_.hpp"
 #include "Core/Values/Directories.hpp"
 #include TILIA_OPENGL_3_3_UTILS_INCLUDE
+#include TILIA_OPENGL_3_3_TEXTURE_CACHE_INCLUDE
 #include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
 #include TILIA_LOGGING_INCLUDE
-#include TILIA_WINDOWS_FILE_SYSTEM_INCLUDE
 #include TILIA_TILIA_EXCEPTION_INCLUDE
 
-extern tilia::utils::File_System file_system;
+/**
+ * @brief Hands encoded blocks over to be shared as texture data, without copying them.
+ */
+static tilia::Image::Shared_Data Share_Blocks(std::vector<std::uint8_t>&& blocks)
+{
+	const auto shared_blocks{ std::make_shared<std::vector<std::uint8_t>>(std::move(blocks)) };
+	return { shared_blocks, shared_blocks->data() };
+}
 
 /**
  * Checks a couple of enums pertaining to the color format, wrapping modes, 
@@ -47,18 +56,42 @@ void tilia::gfx::Texture_2D_::Print_Information() const
 {
 
 	// Color format C-string
-	char format_text[6]{};
+	char format_text[8]{};
 	// Get color format string
 	switch (m_texture_def.color_format)
 	{
+	case enums::Color_Format::None:
+		strcpy_s(format_text, 8, "None\0");
+		break;
 	case enums::Color_Format::Red8:
-		strcpy_s(format_text, 6, "Red8\0");
+		strcpy_s(format_text, 8, "Red8\0");
 		break;
 	case enums::Color_Format::RGB8:
-		strcpy_s(format_text, 6, "RGB8\0");
+		strcpy_s(format_text, 8, "RGB8\0");
 		break;
 	case enums::Color_Format::RGBA8:
-		strcpy_s(format_text, 6, "RGBA8");
+		strcpy_s(format_text, 8, "RGBA8");
+		break;
+	case enums::Color_Format::BC1:
+		strcpy_s(format_text, 8, "BC1\0");
+		break;
+	case enums::Color_Format::BC3:
+		strcpy_s(format_text, 8, "BC3\0");
+		break;
+	case enums::Color_Format::BC4:
+		strcpy_s(format_text, 8, "BC4\0");
+		break;
+	case enums::Color_Format::BC5:
+		strcpy_s(format_text, 8, "BC5\0");
+		break;
+	case enums::Color_Format::R16F:
+		strcpy_s(format_text, 8, "R16F\0");
+		break;
+	case enums::Color_Format::RGB16F:
+		strcpy_s(format_text, 8, "RGB16F\0");
+		break;
+	case enums::Color_Format::RGBA16F:
+		strcpy_s(format_text, 8, "RGBA16F");
 		break;
 	}
 	// Filtering C-strings
@@ -136,40 +169,39 @@ tilia::gfx::Texture_2D_::Texture_2D_()
 #include <iostream>
 
 /**
- * Firstly it copies the data from the given Texture_Def to the member Texture_Def. It also uses
- * std::make_unique to create a new pointer for 
- * texture_data of the member Texture_Def. If the passed Texture_Def does not hold any texture data
- * then the texture_data 
- * of the memeber Texture_Def is loaded in using stbi_load using the passed Texture_Def's member
- * file_path. After that is sets the load_color_format 
- * according to the amount of loaded channels Then it sets the unpack alignment according to the
- * color format. Then it binds the texture and sets 
- * the filtering and wrapping options. After that it finally sets the pixel data of the openGL
- * texture and then unbinds the texture. It also prints 
- * information about the texture
+ * Firstly it copies the data from the given Texture_Def to the member Texture_Def, which shares
+ * texture_data with the given Texture_Def instead of copying it. If the passed Texture_Def does
+ * not hold any texture data then the texture_data of the member Texture_Def is loaded in through
+ * an Image using the passed Texture_Def's member file_path through Texture_Cache, so that
+ * files already loaded are not decoded again, the Image handing its data over without a copy.
+ * After that is sets the load_color_format according to the amount of loaded
+ * channels and uploads the data.
  */
 void tilia::gfx::Texture_2D_::Set_Texture(const Texture_2D_Def& texture_def)
 {
 	// Copies passed Texture_Def
 	m_texture_def = texture_def;
+	m_texture_def.color_format = Get_Supported_Format(texture_def.color_format);
 
-	int32_t nr_load_channels{ 0 };
+	if (utils::Is_Compressed_Format(*m_texture_def.color_format))
+	{
+		Set_Compressed_Texture(texture_def);
+		return;
+	}
 
-	int32_t nr_channels{ 0 };
+	int32_t nr_load_channels{ 0 };
 
-	// Copies texture_data or loads new data using file_path
+	// Checks shared texture_data or loads new data using file_path
 	if (texture_def.texture_data) {
 
 		switch (m_texture_def.color_format)
 		{
 		case enums::Color_Format::Red8:
-			nr_channels = 1;
-			break;
 		case enums::Color_Format::RGB8:
-			nr_channels = 3;
-			break;
 		case enums::Color_Format::RGBA8:
-			nr_channels = 4;
+		case enums::Color_Format::R16F:
+		case enums::Color_Format::RGB16F:
+		case enums::Color_Format::RGBA16F:
 			break;
 		default:
 			throw utils::Tilia_Exception{ { TILIA_LOCATION,
@@ -177,31 +209,25 @@ void tilia::gfx::Texture_2D_::Set_Texture(const Texture_2D_Def& texture_def)
 				"\n>>> Format: ", *m_texture_def.color_format } };
 		}
 
-		uint32_t byte_count{ static_cast<uint32_t>((m_texture_def.width * m_texture_def.height * 
-			nr_channels)) };
-
-		if (!byte_count) {
+		if (m_texture_def.width <= 0 || m_texture_def.height <= 0) {
 			throw utils::Tilia_Exception{ { TILIA_LOCATION,
 			"Texture_2D_ {ID: ", m_ID, "} failed to copy texture data" } };
 		}
-
-		m_texture_def.texture_data = std::make_unique<uint8_t[]>(static_cast<size_t>(byte_count));
-		// Copies data
-		std::copy(texture_def.texture_data.get(), texture_def.texture_data.get() + byte_count, 
-			m_texture_def.texture_data.get());
-		if (!m_texture_def.texture_data)
-		{
-			throw utils::Tilia_Exception{ { TILIA_LOCATION,
-			"Texture_2D_ { ID: ", m_ID, " } failed to copy texture data" } };
-		}
 	}
 	else if (!texture_def.texture_data) {
 		// Loads data
 		try
 		{
-			m_texture_def.texture_data.reset(file_system.Load_Image
-			(texture_def.file_path.c_str(), m_texture_def.width, m_texture_def.height, 
-				nr_load_channels, 0, true));
+			// Half color formats are loaded as half floats, resized down to the max size
+			const Image image{ Texture_Cache::Instance().Get_Image(texture_def.file_path,
+				enums::Image_Channels::Largest,
+				(utils::Is_Half_Format(*m_texture_def.color_format)) ?
+				enums::Image_Data_Type::Half : enums::Image_Data_Type::Unsigned_Byte, true,
+				Get_Max_Size(), Get_Resize_Filter()) };
+			m_texture_def.texture_data = image.Share_Data();
+			m_texture_def.width = image.Width();
+			m_texture_def.height = image.Height();
+			nr_load_channels = static_cast<int32_t>(*image.Channels());
 		}
 		catch (utils::Tilia_Exception& t_e)
 		{
@@ -232,8 +258,68 @@ void tilia::gfx::Texture_2D_::Set_Texture(const Texture_2D_Def& texture_def)
 		break;
 	}
 
-	if (m_texture_def.color_format == enums::Color_Format::None)
-		//m_texture_def.color_format = m_texture_def.load_color_format;
+	Upload_Texture();
+
+	//log::Log(log::Type::INFO, "TEXTURE_2D", "Texture_ { ID: %u } data has been set", m_ID);
+
+	//Print_Information();
+
+}
+
+/**
+ * Uncompressed color formats keep the data of the image itself, compressed ones keep the blocks
+ * it is encoded to. The image is freed before uploading so that a moved in image leaves the
+ * texture as the only holder of its data.
+ */
+void tilia::gfx::Texture_2D_::Set_Texture(Image image, const Texture_2D_Def& texture_def)
+{
+
+	if (image.Size() <= 0 || image.Channels() == enums::Image_Channels::Grey_Alpha)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Texture_2D_ { ID: ", m_ID, " } can only be set to a non empty image",
+			" with one, three or four channels",
+			"\n>>> Size: ", image.Width(), "x", image.Height(),
+			"\n>>> Channels: ", *image.Channels(),
+			"\n>>> Data type: ", *image.Data_Type() } };
+	}
+
+	m_texture_def = texture_def;
+	m_texture_def.color_format = Get_Supported_Format(texture_def.color_format);
+	m_texture_def.width = image.Width();
+	m_texture_def.height = image.Height();
+
+	const auto data_type{ (utils::Is_Half_Format(*m_texture_def.color_format)) ?
+		enums::Image_Data_Type::Half : enums::Image_Data_Type::Unsigned_Byte };
+	if (image.Data_Type() != data_type)
+		image = image.Convert(enums::Image_Channels::Largest, data_type);
+
+	if (utils::Is_Compressed_Format(*m_texture_def.color_format))
+	{
+		Block_Image block_image{ Block_Encoder::Encode(image,
+			Get_Block_Format(m_texture_def.color_format)) };
+		image.Free();
+		m_texture_def.texture_data = Share_Blocks(std::move(block_image.data));
+		Set_Compressed_Texture(m_texture_def);
+		return;
+	}
+
+	m_texture_def.texture_data = image.Share_Data();
+	m_texture_def.load_color_format = utils::Get_Data_Color_Format(
+		static_cast<std::uint32_t>(*image.Channels()));
+	image.Free();
+
+	Upload_Texture();
+
+}
+
+/**
+ * Sets the unpack alignment according to the load color format, then binds the texture and
+ * sets the filtering and wrapping options. After that it finally sets the pixel data of the
+ * openGL texture and then unbinds the texture.
+ */
+void tilia::gfx::Texture_2D_::Upload_Texture()
+{
 
 	// Set unpack alignment
 	if (m_texture_def.load_color_format == enums::Data_Color_Format::RGBA)
@@ -261,15 +347,80 @@ void tilia::gfx::Texture_2D_::Set_Texture(const Texture_2D_Def& texture_def)
 		*m_texture_def.color_format, 
 		m_texture_def.width, m_texture_def.height, 0, 
 		*m_texture_def.load_color_format, 
-		GL_UNSIGNED_BYTE, 
+		utils::Get_Color_Format_Type(*m_texture_def.color_format), 
 		m_texture_def.texture_data.get()));
 	
 	// Unbinds texture
 	Rebind();
 
-	//log::Log(log::Type::INFO, "TEXTURE_2D", "Texture_ { ID: %u } data has been set", m_ID);
+	Set_Levels(1);
 
-	//Print_Information();
+}
+
+/**
+ * Given data is taken to be encoded already, otherwise the image at the file path is loaded
+ * through Block_Encoder, which only encodes it the first time. The blocks are kept as the
+ * texture data and uploaded as they are.
+ */
+void tilia::gfx::Texture_2D_::Set_Compressed_Texture(const Texture_2D_Def& texture_def)
+{
+
+	const auto block_format{ Get_Block_Format(m_texture_def.color_format) };
+
+	std::size_t byte_count{};
+
+	if (texture_def.texture_data)
+	{
+		if (m_texture_def.width <= 0 || m_texture_def.height <= 0)
+		{
+			throw utils::Tilia_Exception{ { TILIA_LOCATION,
+				"Texture_2D_ { ID: ", m_ID, " } failed to copy compressed texture data",
+				"\n>>> Size: ", m_texture_def.width, "x", m_texture_def.height } };
+		}
+
+		byte_count = Block_Encoder::Get_Encoded_Size(block_format, m_texture_def.width,
+			m_texture_def.height);
+	}
+	else
+	{
+		try
+		{
+			Block_Image block_image{ Block_Encoder::Instance().Load(texture_def.file_path,
+				block_format, true) };
+
+			m_texture_def.width = block_image.width;
+			m_texture_def.height = block_image.height;
+
+			byte_count = block_image.data.size();
+			m_texture_def.texture_data = Share_Blocks(std::move(block_image.data));
+		}
+		catch (utils::Tilia_Exception& t_e)
+		{
+			throw t_e.Add_Message({ TILIA_LOCATION,
+				"Texture_2D_ { ID: ", m_ID, " } compressed data not loaded properly" });
+		}
+	}
+
+	m_texture_def.load_color_format = enums::Data_Color_Format::None;
+
+	Unbind(true);
+
+	Bind();
+
+	GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, *m_texture_def.filter_min));
+	GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, *m_texture_def.filter_mag));
+	GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, *m_texture_def.wrap_s));
+	GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, *m_texture_def.wrap_t));
+
+	GL_CALL(glCompressedTexImage2D(GL_TEXTURE_2D, 0,
+		*m_texture_def.color_format,
+		m_texture_def.width, m_texture_def.height, 0,
+		static_cast<GLsizei>(byte_count),
+		m_texture_def.texture_data.get()));
+
+	Rebind();
+
+	Set_Levels(1);
 
 }
 
@@ -290,6 +441,71 @@ void tilia::gfx::Texture_2D_::Set_Texture(const std::string& texture_path)
 	return Set_Texture(def);
 }
 
+/**
+ * The highest mip level is set to the last one of the container, so that the texture is
+ * complete however many levels it holds.
+ */
+void tilia::gfx::Texture_2D_::Load_Container(const Texture_Container& container,
+	std::size_t first_level)
+{
+
+	if (!container.Is_Open() || container.Get_Face_Count() != 1)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Texture_2D_ { ID: ", m_ID, " } can only load an open container of one face",
+			"\n>>> Path: ", container.Get_Path(),
+			"\n>>> Face count: ", container.Get_Face_Count() } };
+	}
+
+	m_texture_def.file_path = container.Get_Path();
+	m_texture_def.texture_data.reset();
+	m_texture_def.width = container.Get_Width();
+	m_texture_def.height = container.Get_Height();
+	m_texture_def.color_format = Get_Supported_Format(container.Get_Color_Format());
+	m_texture_def.load_color_format = container.Get_Data_Color_Format();
+
+	first_level = std::min(std::max(first_level, Get_Fit_Level(container.Get_Width(),
+		container.Get_Height(), container.Get_Level_Count(), Get_Max_Size())),
+		container.Get_Level_Count() - 1);
+
+	Unbind(true);
+
+	try
+	{
+		// Levels of another size are left in a texture given fewer levels, so a new one is made
+		if (first_level != Get_First_Level())
+		{
+			std::uint32_t ID{};
+			GL_CALL(glGenTextures(1, &ID));
+			Replace_ID(ID);
+		}
+
+		Bind();
+
+		GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, *m_texture_def.filter_min));
+		GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, *m_texture_def.filter_mag));
+		GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, *m_texture_def.wrap_s));
+		GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, *m_texture_def.wrap_t));
+		GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+			static_cast<GLint>(container.Get_Level_Count() - first_level - 1)));
+
+		for (std::size_t level{ first_level }; level < container.Get_Level_Count(); ++level)
+			container.Upload(GL_TEXTURE_2D, level, 0, first_level);
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		Rebind();
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Texture_2D_ { ID: ", m_ID, " } failed to load container",
+			"\n>>> Path: ", container.Get_Path() });
+	}
+
+	Rebind();
+
+	Set_Levels(container.Get_Level_Count(), true, first_level);
+
+}
+
 /**
  * Generates mipmaps for the openGL texture using glGenerateMipmap
  */
@@ -308,10 +524,20 @@ void tilia::gfx::Texture_2D_::Generate_Mipmaps()
 			"Texture_2D_ { ID: ", m_ID,
 			" } failed to generate mipmaps because there is no data" } };
 	}
+	// Compressed formats can not be rendered to and so can not have mipmaps generated
+	if (utils::Is_Compressed_Format(*m_texture_def.color_format))
+	{
+		Rebind();
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Texture_2D_ { ID: ", m_ID,
+			" } failed to generate mipmaps because its color format is compressed",
+			"\n>>> Format: ", *m_texture_def.color_format } };
+	}
 	GL_CALL(glGenerateMipmap(GL_TEXTURE_2D));
 	//log::Log(log::Type::INFO, "TEXTURE_2D", "Mipmaps for texture { ID: %u } has been generated", 
 	//m_ID);
 	Rebind();
+	Set_Levels(Mip_Generator::Get_Level_Count(m_texture_def.width, m_texture_def.height) + 1);
 }
 
 /**
@@ -29,6 +29,8 @@
 #include "Core/Values/Directories.hpp"
 #include TILIA_OPENGL_3_3_TEXTURE__INCLUDE
 #include TILIA_OPENGL_3_3_CONSTANTS_INCLUDE
+#include TILIA_OPENGL_3_3_TEXTURE_CONTAINER_INCLUDE
+#include TILIA_IMAGE_INCLUDE
 
 namespace tilia {
 
@@ -38,7 +40,8 @@ namespace tilia {
 		 * @brief A struct that holds information for the Texture_2D_ class
 		 *
 		 * @param file_path	        - The file path of the texture
-		 * @param texture_data      - The texel data of the texture
+		 * @param texture_data      - The texel data of the texture, shared by copies of the struct.
+		 * Half floats for half color formats and unsigned bytes otherwise
 		 * @param width             - The width of the texture
 		 * @param height		    - The height of the texture
 		 * @param color_format      - The color format of the texture						  -
@@ -57,7 +60,7 @@ namespace tilia {
 		struct Texture_2D_Def
 		{
 			std::string 					   file_path{};
-			std::unique_ptr<uint8_t[]>		   texture_data{};
+			Image::Shared_Data				   texture_data{};
 			int32_t							   width{};
 			int32_t							   height{};
 			enums::Color_Format	   color_format{ enums::Color_Format::RGBA8 };
@@ -67,26 +70,6 @@ namespace tilia {
 			enums::Filter_Mode				   filter_mag{ enums::Filter_Mode::Point };
 			enums::Wrap_Mode				   wrap_s{ enums::Wrap_Mode::Repeat };
 			enums::Wrap_Mode				   wrap_t{ enums::Wrap_Mode::Repeat };
-			/**
-			 * @brief Assignment operator. Shallow copies everything except for texture_data which will get reset to nullptr
-			 */
-			const Texture_2D_Def& operator=(const Texture_2D_Def& other) {
-				if (&other == this)
-					return *this;
-				
-				this->file_path = other.file_path;
-				this->texture_data.reset();
-				this->width = other.width;
-				this->height = other.height;
-				this->color_format = other.color_format;
-				this->load_color_format = other.load_color_format;
-				this->filter_min = other.filter_min;
-				this->filter_mag = other.filter_mag;
-				this->wrap_s = other.wrap_s;
-				this->wrap_t = other.wrap_t;
-
-				return *this;
-			}
 		};
 
 		/**
@@ -105,7 +88,9 @@ namespace tilia {
 			/**
 			 * @brief Sets the Texture_Def of this Texture_ to the param Texture_Def.
 			 * If the texture_data of the given texture_def is null then the texture data
-			 * is set to the loaded data from the given file_path
+			 * is set to the loaded data from the given file_path. Given texture_data is shared
+			 * rather than copied. Block compressed color formats take texture_data already
+			 * encoded, or encode the loaded data through Block_Encoder
 			 *
 			 * @param texture_def - The Texture_Def for which to set this Texture_'s Texture_Def to
 			 * 
@@ -116,6 +101,20 @@ namespace tilia {
 			 */
 			void Set_Texture(const Texture_2D_Def& texture_def);
 
+			/**
+			 * @brief Sets the texture to the given image, sharing its data instead of copying it.
+			 * Moving the image in leaves the texture as the only holder of the data. The size
+			 * and load color format are those of the image, and block compressed color formats
+			 * encode the image through Block_Encoder. Images are converted to half floats for
+			 * half color formats and to bytes for others, unless they already are.
+			 *
+			 * @param image - The image with one, three or four channels.
+			 * @param texture_def - The color format, filtering and wrapping of the texture.
+			 *
+			 * @exception The image is empty or of two channels.
+			 */
+			void Set_Texture(Image image, const Texture_2D_Def& texture_def = {});
+
 			/**
 			 * @brief Sets the Texture_Def of this Texture_ to have the path given.
 			 * Then loads in the texture data from this file path.
@@ -128,11 +127,27 @@ namespace tilia {
 			 */
 			void Set_Texture(const std::string& texture_path);
 
+			/**
+			 * @brief Uploads the mip levels of a texture container straight from its mapping.
+			 * The filtering and wrapping of the Texture_Def are kept while its size and formats
+			 * are set to those of the container, the size being that of the first level of the
+			 * container whichever levels are loaded. No texture data is kept.
+			 *
+			 * @param container - The open container, which has to have a single face.
+			 * @param first_level - The first level to load, raised to the first level within the
+			 * max size of Texture_ and clamped to the last one. The levels before it are left
+			 * out, as when streaming mip levels.
+			 *
+			 * @exception The container is not open or is a cube map.
+			 */
+			void Load_Container(const Texture_Container& container, std::size_t first_level = 0);
+
 			/**
 			 * @brief Generates all mipmap levels for the texture
 			 *
 			 * @exception Texture_ is not loaded
 			 * @exception There is no texture_data
+			 * @exception The color format is block compressed
 			 */
 			void Generate_Mipmaps() override;
 
@@ -185,6 +200,19 @@ namespace tilia {
 			 */
 			void Print_Information() const;
 
+			/**
+			 * @brief Sets the data of a texture of a block compressed color format.
+			 */
+			void Set_Compressed_Texture(const Texture_2D_Def& texture_def);
+
+			/**
+			 * @brief Uploads the uncompressed texture data of the Texture_Def.
+			 */
+			void Upload_Texture();
+
+			// Sets the definition of streamed textures once they are whole
+			friend class Texture_Streamer;
+
 		};
 
 	}
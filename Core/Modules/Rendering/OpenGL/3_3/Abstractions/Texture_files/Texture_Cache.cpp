@@ -0,0 +1,392 @@
+// Standard
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <tuple>
+
+// Tilia
+#include "Texture_Cache.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+#include TILIA_OPENGL_3_3_UTILS_INCLUDE
+
+bool tilia::gfx::Texture_Cache::Image_Key::operator<(const Image_Key& other) const
+{
+	return std::tie(path, image_channels, data_type, flip_vertical, max_size, resize_filter) <
+		std::tie(other.path, other.image_channels, other.data_type, other.flip_vertical,
+			other.max_size, other.resize_filter);
+}
+
+bool tilia::gfx::Texture_Cache::Texture_Key::operator<(const Texture_Key& other) const
+{
+	return std::tie(path, color_format, filter_min, filter_mag, wrap_s, wrap_t, max_size,
+		resize_filter) < std::tie(other.path, other.color_format, other.filter_min,
+			other.filter_mag, other.wrap_s, other.wrap_t, other.max_size, other.resize_filter);
+}
+
+/**
+ * The first thread to ask for an image puts a future of it in the cache and loads it without
+ * holding the lock, others asking for it meanwhile waiting on the future. Should the load fail
+ * the entry is dropped again and every waiting thread gets the exception.
+ */
+tilia::Image tilia::gfx::Texture_Cache::Get_Image(const std::string& path,
+	enums::Image_Channels image_channels, enums::Image_Data_Type data_type, bool flip_vertical,
+	std::int32_t max_size, enums::Mip_Filter resize_filter)
+{
+	const Image_Key key{ Get_Canonical_Path(path), image_channels, data_type, flip_vertical,
+		std::max(max_size, 0), resize_filter };
+
+	std::promise<Image> promise{};
+	std::unique_lock<std::mutex> lock{ m_mutex };
+	const auto found{ m_images.find(key) };
+	if (found != m_images.end())
+	{
+		++m_image_stats.hits;
+		const auto image{ found->second };
+		lock.unlock();
+		return image.get();
+	}
+	++m_image_stats.misses;
+	m_images.emplace(key, promise.get_future().share());
+	lock.unlock();
+
+	try
+	{
+		Image image{ path, image_channels, data_type, flip_vertical };
+		if (key.max_size > 0)
+		{
+			Mip_Settings settings{};
+			settings.filter = resize_filter;
+			image = Mip_Generator::Fit(image, key.max_size, settings);
+		}
+		promise.set_value(image);
+		return image;
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		lock.lock();
+		m_images.erase(key);
+		lock.unlock();
+		promise.set_exception(std::current_exception());
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Texture_Cache failed to load image",
+			"\n>>> Path: ", path });
+	}
+	catch (...)
+	{
+		lock.lock();
+		m_images.erase(key);
+		lock.unlock();
+		promise.set_exception(std::current_exception());
+		throw;
+	}
+}
+
+std::shared_ptr<tilia::gfx::Texture_2D_> tilia::gfx::Texture_Cache::Get_Texture(
+	const std::string& path, const Texture_2D_Def& texture_def)
+{
+	const Texture_Key key{ Get_Canonical_Path(path), texture_def.color_format,
+		texture_def.filter_min, texture_def.filter_mag, texture_def.wrap_s, texture_def.wrap_t,
+		std::max(Texture_::Get_Max_Size(), 0), Texture_::Get_Resize_Filter() };
+
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+		const auto found{ m_textures.find(key) };
+		if (found != m_textures.end())
+		{
+			if (auto texture{ found->second.lock() })
+			{
+				++m_texture_stats.hits;
+				return texture;
+			}
+		}
+		++m_texture_stats.misses;
+	}
+
+	auto texture{ std::make_shared<Texture_2D_>() };
+	try
+	{
+		Texture_2D_Def def{ texture_def };
+		def.file_path = path;
+		def.texture_data.reset();
+		texture->Set_Texture(Get_Image(path, enums::Image_Channels::Largest,
+			(utils::Is_Half_Format(*def.color_format)) ? enums::Image_Data_Type::Half :
+			enums::Image_Data_Type::Unsigned_Byte, true, key.max_size, key.resize_filter), def);
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Texture_Cache failed to load texture",
+			"\n>>> Path: ", path });
+	}
+
+	std::lock_guard<std::mutex> lock{ m_mutex };
+	m_textures[key] = texture;
+	return texture;
+}
+
+/**
+ * An image only held by the cache is not shared, images still being loaded are kept.
+ */
+std::size_t tilia::gfx::Texture_Cache::Trim()
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+
+	std::size_t freed_bytes{ 0 };
+	for (auto iterator{ m_images.begin() }; iterator != m_images.end(); )
+	{
+		const auto& image{ iterator->second };
+		if (image.wait_for(std::chrono::seconds{ 0 }) == std::future_status::ready &&
+			!image.get().Is_Shared())
+		{
+			freed_bytes += static_cast<std::size_t>(image.get().Size());
+			iterator = m_images.erase(iterator);
+		}
+		else
+			++iterator;
+	}
+
+	for (auto iterator{ m_textures.begin() }; iterator != m_textures.end(); )
+	{
+		if (iterator->second.expired())
+			iterator = m_textures.erase(iterator);
+		else
+			++iterator;
+	}
+
+	return freed_bytes;
+}
+
+/**
+ * Images still being loaded are dropped as well, the threads waiting for them still getting
+ * them.
+ */
+void tilia::gfx::Texture_Cache::Invalidate(const std::string& path)
+{
+	const std::string canonical_path{ Get_Canonical_Path(path) };
+
+	std::lock_guard<std::mutex> lock{ m_mutex };
+
+	for (auto iterator{ m_images.begin() }; iterator != m_images.end(); )
+	{
+		if (iterator->first.path == canonical_path)
+			iterator = m_images.erase(iterator);
+		else
+			++iterator;
+	}
+
+	for (auto iterator{ m_textures.begin() }; iterator != m_textures.end(); )
+	{
+		if (iterator->first.path == canonical_path)
+			iterator = m_textures.erase(iterator);
+		else
+			++iterator;
+	}
+}
+
+void tilia::gfx::Texture_Cache::Clear()
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+	m_images.clear();
+	m_textures.clear();
+}
+
+tilia::gfx::Texture_Cache::Stats tilia::gfx::Texture_Cache::Get_Image_Stats() const
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+	return m_image_stats;
+}
+
+tilia::gfx::Texture_Cache::Stats tilia::gfx::Texture_Cache::Get_Texture_Stats() const
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+	return m_texture_stats;
+}
+
+std::size_t tilia::gfx::Texture_Cache::Get_Image_Count() const
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+	return m_images.size();
+}
+
+std::string tilia::gfx::Texture_Cache::Get_Canonical_Path(const std::string& path)
+{
+	std::error_code error{};
+	const auto canonical_path{ std::filesystem::canonical(path, error) };
+	if (!error)
+		return canonical_path.generic_string();
+	return std::filesystem::path{ path }.lexically_normal().generic_string();
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+// Standard
+#include <atomic>
+#include <thread>
+#include <vector>
+
+void tilia::gfx::Texture_Cache::Test()
+{
+
+	auto& texture_cache{ Texture_Cache::Instance() };
+	texture_cache.Clear();
+
+	const std::string path{ "res/textures/container2.png" };
+
+	SECTION("Canonical path")
+	{
+		REQUIRE(Get_Canonical_Path("res/textures/../textures/container2.png") ==
+			Get_Canonical_Path(path));
+		REQUIRE(Get_Canonical_Path("./res/textures/container2.png") ==
+			Get_Canonical_Path(path));
+		// Missing files are made lexically normal
+		REQUIRE(Get_Canonical_Path("res/missing/../missing.png") == "res/missing.png");
+	}
+
+	SECTION("Images")
+	{
+		const auto stats{ texture_cache.Get_Image_Stats() };
+
+		const Image first{ texture_cache.Get_Image(path) };
+		REQUIRE(first.Size() > 0);
+		REQUIRE(texture_cache.Get_Image_Stats().misses == stats.misses + 1);
+
+		// The same file spelled differently shares the data of the first load
+		const Image second{ texture_cache.Get_Image("res/textures/../textures/container2.png") };
+		REQUIRE(second.Get_Data() == first.Get_Data());
+		REQUIRE(texture_cache.Get_Image_Stats().hits == stats.hits + 1);
+
+		// Other parameters are loaded on their own
+		const Image flipped{ texture_cache.Get_Image(path, enums::Image_Channels::Largest,
+			enums::Image_Data_Type::Unsigned_Byte, true) };
+		REQUIRE(flipped.Get_Data() != first.Get_Data());
+		const Image grey{ texture_cache.Get_Image(path, enums::Image_Channels::Grey) };
+		REQUIRE(grey.Channels() == enums::Image_Channels::Grey);
+		REQUIRE(texture_cache.Get_Image_Stats().misses == stats.misses + 3);
+		REQUIRE(texture_cache.Get_Image_Count() == 3);
+
+		// Changing an image leaves the cached one as it is
+		Image changed{ first };
+		changed.Get_Data()[0] = static_cast<std::uint8_t>(~first.Get_Data()[0]);
+		REQUIRE(texture_cache.Get_Image(path) == first);
+		REQUIRE(texture_cache.Get_Image(path) != changed);
+	}
+
+	SECTION("Failures")
+	{
+		const auto stats{ texture_cache.Get_Image_Stats() };
+		REQUIRE_THROWS_AS(texture_cache.Get_Image("res/textures/missing.png"),
+			utils::Tilia_Exception);
+		REQUIRE(texture_cache.Get_Image_Count() == 0);
+		// Not cached, so loaded again
+		REQUIRE_THROWS_AS(texture_cache.Get_Image("res/textures/missing.png"),
+			utils::Tilia_Exception);
+		REQUIRE(texture_cache.Get_Image_Stats().misses == stats.misses + 2);
+	}
+
+	SECTION("Threads")
+	{
+		const auto stats{ texture_cache.Get_Image_Stats() };
+
+		constexpr std::size_t thread_count{ 8 };
+		std::vector<Image> images(thread_count);
+		std::vector<std::thread> threads{};
+		std::atomic<bool> start{ false };
+		for (std::size_t i{ 0 }; i < thread_count; ++i)
+		{
+			threads.emplace_back([&, i]()
+				{
+					while (!start)
+						std::this_thread::yield();
+					images[i] = texture_cache.Get_Image(path);
+				});
+		}
+		start = true;
+		for (auto& thread : threads)
+			thread.join();
+
+		// Loaded once and shared by every thread
+		const auto new_stats{ texture_cache.Get_Image_Stats() };
+		REQUIRE(new_stats.misses == stats.misses + 1);
+		REQUIRE(new_stats.hits == stats.hits + thread_count - 1);
+		for (const auto& image : images)
+			REQUIRE(image.Share_Data() == images.front().Share_Data());
+	}
+
+	SECTION("Trim")
+	{
+		{
+			const Image image{ texture_cache.Get_Image(path) };
+			texture_cache.Get_Image(path, enums::Image_Channels::Grey);
+			// The held image is kept
+			REQUIRE(texture_cache.Trim() == static_cast<std::size_t>(image.Width() *
+				image.Height()));
+			REQUIRE(texture_cache.Get_Image_Count() == 1);
+		}
+		REQUIRE(texture_cache.Trim() > 0);
+		REQUIRE(texture_cache.Get_Image_Count() == 0);
+	}
+
+	SECTION("Invalidate")
+	{
+		const Image first{ texture_cache.Get_Image(path) };
+		texture_cache.Get_Image(path, enums::Image_Channels::Grey);
+		texture_cache.Get_Image("res/textures/container2_specular.png");
+
+		// Every image of the file is dropped, other files are kept
+		texture_cache.Invalidate("res/textures/../textures/container2.png");
+		REQUIRE(texture_cache.Get_Image_Count() == 1);
+
+		// Read again, while the image gotten before is left as it was
+		const auto stats{ texture_cache.Get_Image_Stats() };
+		const Image second{ texture_cache.Get_Image(path) };
+		REQUIRE(texture_cache.Get_Image_Stats().misses == stats.misses + 1);
+		REQUIRE(second.Get_Data() != first.Get_Data());
+		REQUIRE(second == first);
+	}
+
+	SECTION("Max size")
+	{
+		const Image full{ texture_cache.Get_Image(path) };
+		const Image fitted{ texture_cache.Get_Image(path, enums::Image_Channels::Largest,
+			enums::Image_Data_Type::Unsigned_Byte, false, 64, enums::Mip_Filter::Kaiser) };
+		REQUIRE(std::max(fitted.Width(), fitted.Height()) == 64);
+		REQUIRE(fitted.Channels() == full.Channels());
+		REQUIRE(texture_cache.Get_Image_Count() == 2);
+
+		// Only the resized image is cached for the max size
+		const auto stats{ texture_cache.Get_Image_Stats() };
+		REQUIRE(texture_cache.Get_Image(path, enums::Image_Channels::Largest,
+			enums::Image_Data_Type::Unsigned_Byte, false, 64, enums::Mip_Filter::Kaiser)
+			.Share_Data() == fitted.Share_Data());
+		REQUIRE(texture_cache.Get_Image_Stats().hits == stats.hits + 1);
+
+		// Images within the max size are left as they are
+		const Image within{ texture_cache.Get_Image(path, enums::Image_Channels::Largest,
+			enums::Image_Data_Type::Unsigned_Byte, false, 4096) };
+		REQUIRE(within == full);
+
+		// The levels of textures within the max size
+		REQUIRE(Texture_::Get_Fit_Level(512, 256, 10, 0) == 0);
+		REQUIRE(Texture_::Get_Fit_Level(512, 256, 10, 64) == 3);
+		REQUIRE(Texture_::Get_Fit_Level(512, 256, 2, 64) == 1);
+		REQUIRE(Texture_::Get_Fit_Level(32, 32, 6, 64) == 0);
+	}
+
+	SECTION("Stats")
+	{
+		Stats stats{};
+		REQUIRE(stats.Get_Hit_Rate() == 0.0f);
+		stats.hits = 3;
+		stats.misses = 1;
+		REQUIRE(stats.Get_Hit_Rate() == 0.75f);
+	}
+
+	texture_cache.Clear();
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
@@ -0,0 +1,229 @@
+/**************************************************************************************************
+ * @file   Texture_Cache.hpp
+ *
+ * @brief  Caches loaded images and textures by the canonical path of their file along with the
+ *		   parameters they were loaded with, so that a file used from several places is only
+ *		   decoded and uploaded once. Handles are shared rather than copied.
+ *
+ * @author Gustav Fagerlind
+ * @date   19/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_TEXTURE_CACHE_HPP
+#define TILIA_OPENGL_3_3_TEXTURE_CACHE_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_CONSTANTS_INCLUDE
+#include TILIA_IMAGE_INCLUDE
+#include TILIA_MIP_GENERATOR_INCLUDE
+#include TILIA_OPENGL_3_3_TEXTURE_2D__INCLUDE
+
+namespace tilia
+{
+	namespace gfx
+	{
+
+		/**
+		 * @brief Singleton cache of images and 2d textures. Images may be gotten from any
+		 * thread, a thread asking for an image being loaded by another waiting for it instead
+		 * of loading it again. The cache holds on to images until trimmed, while textures are
+		 * only held by those using them and are loaded again once all of them are gone.
+		 * Textures must only be gotten on the thread owning the context.
+		 */
+		class Texture_Cache
+		{
+		public:
+
+			/**
+			 * @brief How the cache has been used, for profiling.
+			 */
+			struct Stats
+			{
+				// Lookups finding what was asked for already loaded or being loaded
+				std::size_t hits{};
+				// Lookups which had to load what was asked for
+				std::size_t misses{};
+
+				/**
+				 * @brief Gets the share of lookups which were hits, 0 if there were none.
+				 */
+				float Get_Hit_Rate() const
+				{
+					const std::size_t lookups{ hits + misses };
+					return (lookups) ? static_cast<float>(hits) / static_cast<float>(lookups) :
+						0.0f;
+				}
+			}; // Stats
+
+			/**
+			 * @brief First time it is called it will construct an instance of Texture_Cache.
+			 * A reference to this instance is returned to anywhere in the program.
+			 *
+			 * @return A reference to an instance of Texture_Cache.
+			 */
+			static Texture_Cache& Instance()
+			{
+				static Texture_Cache texture_cache{};
+				return texture_cache;
+			}
+
+			/**
+			 * @brief Gets the image of the given file loaded with the given parameters, loading
+			 * it if it is not cached. The image shares its data with the cache, so changing it
+			 * copies the data first.
+			 *
+			 * @param path - The path of the image file.
+			 * @param image_channels - The channels to load the image with.
+			 * @param data_type - The data type to load the image as.
+			 * @param flip_vertical - Whether or not to load the image flipped.
+			 * @param max_size - The largest side in texels of the image, 0 for no limit. Larger
+			 * images are resized down once decoded through Mip_Generator::Fit, only the resized
+			 * image being cached.
+			 * @param resize_filter - The filter to resize the image down with.
+			 *
+			 * @exception The image failed to load, which is not cached.
+			 */
+			Image Get_Image(const std::string& path, enums::Image_Channels image_channels =
+				enums::Image_Channels::Largest, enums::Image_Data_Type data_type =
+				enums::Image_Data_Type::Unsigned_Byte, bool flip_vertical = false,
+				std::int32_t max_size = 0, enums::Mip_Filter resize_filter =
+				enums::Mip_Filter::Box);
+
+			/**
+			 * @brief Gets the texture of the given file with the color format, filtering and
+			 * wrapping of the given Texture_Def, loading it if no one holds it. The image is
+			 * loaded flipped, as by Texture_2D_::Set_Texture, through Get_Image. It is of half
+			 * floats for half color formats and of unsigned bytes otherwise, and is resized
+			 * down to the max size of Texture_.
+			 *
+			 * @param path - The path of the image file.
+			 * @param texture_def - The color format, filtering and wrapping of the texture.
+			 *
+			 * @exception The texture failed to load, which is not cached.
+			 */
+			std::shared_ptr<Texture_2D_> Get_Texture(const std::string& path,
+				const Texture_2D_Def& texture_def = {});
+
+			/**
+			 * @brief Drops the cached images which are not shared with anything outside the
+			 * cache, along with entries of textures no one holds.
+			 *
+			 * @return The amount of bytes of image data freed.
+			 */
+			std::size_t Trim();
+
+			/**
+			 * @brief Drops the cached images and textures of the given file, whatever they were
+			 * loaded with, so that the file is read again the next time it is asked for. Those
+			 * in use are left as they are.
+			 *
+			 * @param path - The path of the image file.
+			 */
+			void Invalidate(const std::string& path);
+
+			/**
+			 * @brief Drops every cached image and texture. Those in use are left as they are.
+			 */
+			void Clear();
+
+			/**
+			 * @brief Gets how images have been looked up.
+			 */
+			Stats Get_Image_Stats() const;
+			/**
+			 * @brief Gets how textures have been looked up.
+			 */
+			Stats Get_Texture_Stats() const;
+
+			/**
+			 * @brief Gets the amount of cached images, including those being loaded.
+			 */
+			std::size_t Get_Image_Count() const;
+
+			/**
+			 * @brief Gets the path that files are cached by, which is the canonical path of the
+			 * file if it exists and the path made lexically normal otherwise.
+			 */
+			static std::string Get_Canonical_Path(const std::string& path);
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Texture_Cache. Only tests images and so does not need a
+			 * context.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		private:
+
+			/**
+			 * @brief What a cached image was loaded from and how.
+			 */
+			struct Image_Key
+			{
+				std::string path{};
+				enums::Image_Channels image_channels{ enums::Image_Channels::Largest };
+				enums::Image_Data_Type data_type{ enums::Image_Data_Type::Unsigned_Byte };
+				bool flip_vertical{ false };
+				std::int32_t max_size{ 0 };
+				enums::Mip_Filter resize_filter{ enums::Mip_Filter::Box };
+
+				bool operator<(const Image_Key& other) const;
+			}; // Image_Key
+
+			/**
+			 * @brief What a cached texture was loaded from and how.
+			 */
+			struct Texture_Key
+			{
+				std::string path{};
+				enums::Color_Format color_format{ enums::Color_Format::RGBA8 };
+				enums::Filter_Mode filter_min{ enums::Filter_Mode::Point };
+				enums::Filter_Mode filter_mag{ enums::Filter_Mode::Point };
+				enums::Wrap_Mode wrap_s{ enums::Wrap_Mode::Repeat };
+				enums::Wrap_Mode wrap_t{ enums::Wrap_Mode::Repeat };
+				std::int32_t max_size{ 0 };
+				enums::Mip_Filter resize_filter{ enums::Mip_Filter::Box };
+
+				bool operator<(const Texture_Key& other) const;
+			}; // Texture_Key
+
+			Texture_Cache() = default;
+
+			// Texture_Cache shan't be copyable or moveable
+			Texture_Cache(const Texture_Cache&) = delete;
+			Texture_Cache(Texture_Cache&&) = delete;
+			Texture_Cache& operator=(const Texture_Cache&) = delete;
+			Texture_Cache& operator=(Texture_Cache&&) = delete;
+
+			// Guards the images, textures and stats
+			mutable std::mutex m_mutex{};
+
+			// The cached images, ready once loaded
+			std::map<Image_Key, std::shared_future<Image>> m_images{};
+			// The cached textures, held by those using them
+			std::map<Texture_Key, std::weak_ptr<Texture_2D_>> m_textures{};
+
+			// How images have been looked up
+			Stats m_image_stats{};
+			// How textures have been looked up
+			Stats m_texture_stats{};
+
+		}; // Texture_Cache
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_TEXTURE_CACHE_HPP
@@ -0,0 +1,678 @@
+// Vendor
+#include "vendor/glad/KHR_Debug_openGL_3_3/include/glad/glad.h"
+
+// Standard
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+// Tilia
+#include "Texture_Container.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_TEXTURE__INCLUDE
+#include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
+#include TILIA_OPENGL_3_3_UTILS_INCLUDE
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+#include TILIA_BLOCK_ENCODER_INCLUDE
+#include TILIA_IMAGE_INCLUDE
+#include TILIA_MIP_GENERATOR_INCLUDE
+
+static constexpr char FILE_MAGIC[4]{ 'T', 'T', 'E', 'X' };
+static constexpr std::uint32_t FILE_VERSION{ 1 };
+
+// The most mip levels a container may have, enough for any texture openGL allows
+static constexpr std::uint32_t MAX_LEVELS{ 32 };
+
+/**
+ * The start of every container, followed by an entry for every image.
+ */
+struct Container_Header
+{
+	char magic[4];
+	std::uint32_t version;
+	std::uint32_t color_format;
+	std::uint32_t data_color_format;
+	std::int32_t width;
+	std::int32_t height;
+	std::uint32_t face_count;
+	std::uint32_t level_count;
+}; // Container_Header
+
+/**
+ * Where an image lies within the container.
+ */
+struct Container_Entry
+{
+	std::uint64_t offset;
+	std::uint64_t size;
+}; // Container_Entry
+
+static_assert(sizeof(Container_Header) == 32, "Container header has to be tightly packed");
+static_assert(sizeof(Container_Entry) == 16, "Container entry has to be tightly packed");
+
+static std::size_t Align(std::size_t offset)
+{
+	constexpr auto alignment{ tilia::gfx::Texture_Container::s_alignment };
+	return (offset + alignment - 1) / alignment * alignment;
+}
+
+static std::int32_t Get_Level_Size(std::int32_t size, std::size_t level)
+{
+	return std::max(size >> level, 1);
+}
+
+/**
+ * Nothing is read here besides the header and the entries, every image is left for the system
+ * to page in once it is uploaded.
+ */
+void tilia::gfx::Texture_Container::Open(const std::string& path)
+{
+
+	Close();
+
+	try
+	{
+		m_file.Open(path);
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to open texture container { Path: ", path, " }" });
+	}
+
+	auto fail{ [this, &path](const char* reason)
+	{
+		Close();
+		return utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Texture container is not valid { Path: ", path, " }",
+			"\n>>> Reason: ", reason } };
+	} };
+
+	const std::uint8_t* const data{ m_file.Get_Data() };
+	const std::size_t file_size{ m_file.Get_Size() };
+
+	Container_Header header{};
+	if (file_size < sizeof(header))
+		throw fail("File is smaller than the header");
+	std::memcpy(&header, data, sizeof(header));
+
+	if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+		throw fail("File is not a texture container");
+	if (header.version != FILE_VERSION)
+		throw fail("Container is of another version");
+	if (header.face_count != 1 && header.face_count != *enums::Geometry_Features::Cube_Faces)
+		throw fail("Face count has to be 1 or 6");
+	if (header.level_count == 0 || header.level_count > MAX_LEVELS)
+		throw fail("Level count is out of range");
+	if (header.width <= 0 || header.height <= 0)
+		throw fail("Size has to be positive");
+
+	m_color_format = static_cast<enums::Color_Format>(header.color_format);
+	m_data_color_format = static_cast<enums::Data_Color_Format>(header.data_color_format);
+	m_width = header.width;
+	m_height = header.height;
+	m_face_count = header.face_count;
+	m_level_count = header.level_count;
+
+	const std::size_t image_count{ m_face_count * m_level_count };
+	if (file_size < sizeof(header) + image_count * sizeof(Container_Entry))
+		throw fail("File is smaller than its entries");
+
+	m_images.resize(image_count);
+	for (std::size_t i{ 0 }; i < image_count; ++i)
+	{
+		Container_Entry entry{};
+		std::memcpy(&entry, data + sizeof(header) + i * sizeof(entry), sizeof(entry));
+
+		Image_Data& image{ m_images[i] };
+		image.width = Get_Level_Size(m_width, i / m_face_count);
+		image.height = Get_Level_Size(m_height, i / m_face_count);
+
+		if (entry.offset % s_alignment != 0)
+			throw fail("Image is not aligned");
+		if (entry.offset > file_size || entry.size > file_size - entry.offset)
+			throw fail("Image lies outside of the file");
+		if (entry.size != Get_Image_Size(m_color_format, m_data_color_format, image.width,
+			image.height))
+			throw fail("Image is not of the size its format asks for");
+
+		image.data = data + entry.offset;
+		image.size = static_cast<std::size_t>(entry.size);
+	}
+
+	m_path = path;
+
+}
+
+void tilia::gfx::Texture_Container::Close()
+{
+	m_file.Close();
+	m_path.clear();
+	m_color_format = enums::Color_Format::None;
+	m_data_color_format = enums::Data_Color_Format::None;
+	m_width = 0;
+	m_height = 0;
+	m_face_count = 0;
+	m_level_count = 0;
+	m_images.clear();
+}
+
+tilia::gfx::Texture_Container::Image_Data tilia::gfx::Texture_Container::Get_Image(
+	std::size_t level, std::size_t face) const
+{
+	if (level >= m_level_count || face >= m_face_count)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Texture container has no such image { Path: ", m_path, ", Level: ", level,
+			", Face: ", face, " }" } };
+	}
+	return m_images[level * m_face_count + face];
+}
+
+void tilia::gfx::Texture_Container::Upload(std::uint32_t target, std::size_t level,
+	std::size_t face, std::size_t first_level) const
+{
+
+	const Image_Data image{ Get_Image(level, face) };
+	const auto texture_level{ static_cast<GLint>(level - first_level) };
+	const auto color_format{ Texture_::Get_Supported_Format(m_color_format) };
+
+	if (color_format != m_color_format)
+	{
+		// Decoded when the driver can not sample the blocks
+		Block_Image block_image{ Texture_::Get_Block_Format(m_color_format), image.width,
+			image.height, { image.data, image.data + image.size } };
+		const Image decoded{ Block_Encoder::Decode(block_image) };
+		GL_CALL(glTexImage2D(target, texture_level, *color_format, image.width,
+			image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, decoded.Get_Data()));
+	}
+	else if (utils::Is_Compressed_Format(*m_color_format))
+	{
+		GL_CALL(glCompressedTexImage2D(target, texture_level, *m_color_format,
+			image.width, image.height, 0, static_cast<GLsizei>(image.size), image.data));
+	}
+	else
+	{
+		// Rows are stored tightly packed, the alignment of other uploads is put back after
+		GLint alignment{};
+		GL_CALL(glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment));
+		GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+		GL_CALL(glTexImage2D(target, texture_level, *m_color_format, image.width,
+			image.height, 0, *m_data_color_format,
+			utils::Get_Color_Format_Type(*m_color_format), image.data));
+		GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, alignment));
+	}
+
+}
+
+/**
+ * The header and the entries come first, followed by the images in order, each padded out to
+ * the alignment.
+ */
+void tilia::gfx::Texture_Container::Write(const std::string& path,
+	enums::Color_Format color_format, enums::Data_Color_Format data_color_format,
+	std::size_t face_count, const std::vector<Image_Data>& images)
+{
+
+	if ((face_count != 1 && face_count != *enums::Geometry_Features::Cube_Faces) ||
+		images.empty() || images.size() % face_count != 0 ||
+		images.size() / face_count > MAX_LEVELS)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Texture container can not hold the given images { Path: ", path,
+			", Face count: ", face_count, ", Image count: ", images.size(), " }" } };
+	}
+
+	const std::int32_t width{ images.front().width };
+	const std::int32_t height{ images.front().height };
+
+	std::vector<Container_Entry> entries(images.size());
+	std::size_t offset{ Align(sizeof(Container_Header) + entries.size() * sizeof(Container_Entry)) };
+
+	for (std::size_t i{ 0 }; i < images.size(); ++i)
+	{
+		const Image_Data& image{ images[i] };
+		const std::size_t level{ i / face_count };
+		if (width <= 0 || height <= 0 || !image.data ||
+			image.width != Get_Level_Size(width, level) ||
+			image.height != Get_Level_Size(height, level) ||
+			image.size != Get_Image_Size(color_format, data_color_format, image.width,
+				image.height))
+		{
+			throw utils::Tilia_Exception{ { TILIA_LOCATION,
+				"Texture container image does not fit its level { Path: ", path,
+				", Level: ", level, ", Size: ", image.width, "x", image.height,
+				", Bytes: ", image.size, " }" } };
+		}
+
+		entries[i] = { offset, image.size };
+		offset = Align(offset + image.size);
+	}
+
+	Container_Header header{};
+	std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+	header.version = FILE_VERSION;
+	header.color_format = static_cast<std::uint32_t>(*color_format);
+	header.data_color_format = static_cast<std::uint32_t>(*data_color_format);
+	header.width = width;
+	header.height = height;
+	header.face_count = static_cast<std::uint32_t>(face_count);
+	header.level_count = static_cast<std::uint32_t>(images.size() / face_count);
+
+	std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+	if (!file)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Failed to open texture container for writing { Path: ", path, " }" } };
+	}
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(entries.data()),
+		static_cast<std::streamsize>(entries.size() * sizeof(Container_Entry)));
+
+	const char padding[s_alignment]{};
+	std::size_t written{ sizeof(header) + entries.size() * sizeof(Container_Entry) };
+	for (std::size_t i{ 0 }; i < images.size(); ++i)
+	{
+		file.write(padding, static_cast<std::streamsize>(entries[i].offset - written));
+		file.write(reinterpret_cast<const char*>(images[i].data),
+			static_cast<std::streamsize>(images[i].size));
+		written = static_cast<std::size_t>(entries[i].offset) + images[i].size;
+	}
+
+	if (!file)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Failed to write texture container { Path: ", path, " }" } };
+	}
+
+}
+
+/**
+ * Block compressed formats are encoded from the channels their block format is encoded from.
+ */
+tilia::enums::Image_Channels tilia::gfx::Texture_Container::Get_Bake_Channels(
+	enums::Color_Format color_format)
+{
+	switch (color_format)
+	{
+	case enums::Color_Format::Red8:
+		return enums::Image_Channels::Grey;
+	case enums::Color_Format::RGB8:
+		return enums::Image_Channels::RGB;
+	case enums::Color_Format::RGBA8:
+		return enums::Image_Channels::RGBA;
+	default:
+		if (utils::Is_Compressed_Format(*color_format))
+		{
+			return Block_Encoder::Get_Image_Channels(Texture_::Get_Block_Format(color_format));
+		}
+		return enums::Image_Channels::RGBA;
+	}
+}
+
+/**
+ * Images are flipped when loaded, the same as when textures load them, so that the first row
+ * is the bottom one as openGL expects.
+ */
+void tilia::gfx::Texture_Container::Bake(const std::vector<std::string>& source_paths,
+	const std::string& path, enums::Color_Format color_format, bool generate_mipmaps,
+	const Mip_Settings& mip_settings)
+{
+
+	std::vector<Image> faces{};
+	faces.reserve(source_paths.size());
+
+	try
+	{
+		for (const auto& source_path : source_paths)
+		{
+			faces.emplace_back(source_path, Get_Bake_Channels(color_format),
+				enums::Image_Data_Type::Unsigned_Byte, true);
+		}
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to bake texture container { Path: ", path, " }" });
+	}
+
+	Bake(faces, path, color_format, generate_mipmaps, mip_settings);
+
+}
+
+void tilia::gfx::Texture_Container::Bake(const std::vector<Image>& source_faces,
+	const std::string& path, enums::Color_Format color_format, bool generate_mipmaps,
+	const Mip_Settings& mip_settings)
+{
+
+	if (source_faces.size() != 1 && source_faces.size() != *enums::Geometry_Features::Cube_Faces)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Texture container has to be baked from 1 or 6 images { Path: ", path,
+			", Image count: ", source_faces.size(), " }" } };
+	}
+
+	const bool compressed{ utils::Is_Compressed_Format(*color_format) };
+
+	const enums::Image_Channels channels{ Get_Bake_Channels(color_format) };
+	enums::Data_Color_Format data_color_format{ enums::Data_Color_Format::None };
+	switch (color_format)
+	{
+	case enums::Color_Format::Red8:
+		data_color_format = enums::Data_Color_Format::Red;
+		break;
+	case enums::Color_Format::RGB8:
+		data_color_format = enums::Data_Color_Format::RGB;
+		break;
+	case enums::Color_Format::RGBA8:
+		data_color_format = enums::Data_Color_Format::RGBA;
+		break;
+	default:
+		if (!compressed)
+		{
+			throw utils::Tilia_Exception{ { TILIA_LOCATION,
+				"Texture container can not be baked to the given format { Path: ", path,
+				", Format: ", *color_format, " }" } };
+		}
+		break;
+	}
+
+	std::vector<Image> faces{};
+	faces.reserve(source_faces.size());
+	std::int32_t width{}, height{};
+
+	try
+	{
+		for (std::size_t i{ 0 }; i < source_faces.size(); ++i)
+		{
+			const Image& face{ source_faces[i] };
+			if (i > 0 && (face.Width() != width || face.Height() != height))
+			{
+				throw utils::Tilia_Exception{ { TILIA_LOCATION,
+					"Faces have to be of the same size { Face: ", i,
+					", Size: ", face.Width(), "x", face.Height(), " }" } };
+			}
+			width = face.Width();
+			height = face.Height();
+			// Faces already of the channels and data type share their data
+			faces.push_back((face.Channels() == channels &&
+				face.Data_Type() == enums::Image_Data_Type::Unsigned_Byte) ? face :
+				face.Convert(channels, enums::Image_Data_Type::Unsigned_Byte));
+		}
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to bake texture container { Path: ", path, " }" });
+	}
+
+	if (faces.size() > 1 && width != height)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Cube map faces have to be square { Path: ", path,
+			", Size: ", width, "x", height, " }" } };
+	}
+
+	const std::size_t level_count{ generate_mipmaps ? Get_Mip_Count(width, height) : 1 };
+
+	// The levels below the image of every face
+	std::vector<std::vector<Image>> mips(faces.size());
+	if (level_count > 1)
+	{
+		Mip_Settings settings{ mip_settings };
+		settings.level_count = level_count - 1;
+		for (std::size_t i{ 0 }; i < faces.size(); ++i)
+			mips[i] = Mip_Generator::Generate(faces[i], settings);
+	}
+
+	// Encoded images are kept until written
+	std::vector<std::vector<std::uint8_t>> encoded{};
+	encoded.reserve(level_count * faces.size());
+	std::vector<Image_Data> images{};
+
+	for (std::size_t level{ 0 }; level < level_count; ++level)
+	{
+		for (std::size_t i{ 0 }; i < faces.size(); ++i)
+		{
+			const Image& image{ level == 0 ? faces[i] : mips[i][level - 1] };
+
+			if (compressed)
+			{
+				encoded.push_back(Block_Encoder::Encode(image,
+					Texture_::Get_Block_Format(color_format)).data);
+				images.push_back({ image.Width(), image.Height(), encoded.back().data(),
+					encoded.back().size() });
+			}
+			else
+			{
+				images.push_back({ image.Width(), image.Height(), image.Get_Data(),
+					static_cast<std::size_t>(image.Size()) });
+			}
+		}
+	}
+
+	Write(path, color_format, data_color_format, faces.size(), images);
+
+}
+
+std::size_t tilia::gfx::Texture_Container::Get_Mip_Count(std::int32_t width,
+	std::int32_t height)
+{
+	std::size_t count{ 1 };
+	for (std::int32_t size{ std::max(width, height) }; size > 1; size >>= 1)
+		++count;
+	return count;
+}
+
+std::size_t tilia::gfx::Texture_Container::Get_Image_Size(enums::Color_Format color_format,
+	enums::Data_Color_Format data_color_format, std::int32_t width, std::int32_t height)
+{
+	if (width <= 0 || height <= 0)
+		return 0;
+	if (utils::Is_Compressed_Format(*color_format))
+	{
+		return Block_Encoder::Get_Encoded_Size(Texture_::Get_Block_Format(color_format), width,
+			height);
+	}
+	// Half formats take two bytes per channel
+	return static_cast<std::size_t>(width) * height *
+		utils::Get_Color_Format_Count(*data_color_format) *
+		((utils::Is_Half_Format(*color_format)) ? sizeof(std::uint16_t) : 1);
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Standard
+#include <cstdio>
+#include <iterator>
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+// Tilia
+#include TILIA_CHANNEL_PACKER_INCLUDE
+
+void tilia::gfx::Texture_Container::Test()
+{
+
+	const std::string path{ "texture_container_test.ttex" };
+
+	// An RGBA image of 4x2 and its two mip levels
+	std::vector<std::uint8_t> texels[3]{ std::vector<std::uint8_t>(4 * 2 * 4),
+		std::vector<std::uint8_t>(2 * 1 * 4), std::vector<std::uint8_t>(1 * 1 * 4) };
+	for (std::size_t i{ 0 }; i < 3; ++i)
+	{
+		for (std::size_t j{ 0 }; j < texels[i].size(); ++j)
+			texels[i][j] = static_cast<std::uint8_t>(i * 64 + j);
+	}
+	const std::vector<Image_Data> images{
+		{ 4, 2, texels[0].data(), texels[0].size() },
+		{ 2, 1, texels[1].data(), texels[1].size() },
+		{ 1, 1, texels[2].data(), texels[2].size() } };
+
+	SECTION("Sizes")
+	{
+		REQUIRE(Get_Mip_Count(4, 2) == 3);
+		REQUIRE(Get_Mip_Count(1, 1) == 1);
+		REQUIRE(Get_Mip_Count(1024, 1) == 11);
+		REQUIRE(Get_Image_Size(enums::Color_Format::RGB8, enums::Data_Color_Format::RGB, 3, 3)
+			== 27);
+		REQUIRE(Get_Image_Size(enums::Color_Format::BC1, enums::Data_Color_Format::None, 5, 5)
+			== 4 * 8);
+	}
+
+	SECTION("Write and open")
+	{
+		Write(path, enums::Color_Format::RGBA8, enums::Data_Color_Format::RGBA, 1, images);
+
+		Texture_Container container{};
+		container.Open(path);
+
+		REQUIRE(container.Is_Open());
+		REQUIRE(container.Get_Color_Format() == enums::Color_Format::RGBA8);
+		REQUIRE(container.Get_Data_Color_Format() == enums::Data_Color_Format::RGBA);
+		REQUIRE(container.Get_Width() == 4);
+		REQUIRE(container.Get_Height() == 2);
+		REQUIRE(container.Get_Face_Count() == 1);
+		REQUIRE(container.Get_Level_Count() == 3);
+
+		for (std::size_t level{ 0 }; level < 3; ++level)
+		{
+			const Image_Data image{ container.Get_Image(level) };
+			REQUIRE(image.width == images[level].width);
+			REQUIRE(image.height == images[level].height);
+			REQUIRE(image.size == texels[level].size());
+			REQUIRE(reinterpret_cast<std::uintptr_t>(image.data) % s_alignment == 0);
+			REQUIRE(std::memcmp(image.data, texels[level].data(), image.size) == 0);
+		}
+
+		REQUIRE_THROWS_AS(container.Get_Image(3), utils::Tilia_Exception);
+		REQUIRE_THROWS_AS(container.Get_Image(0, 1), utils::Tilia_Exception);
+
+		container.Close();
+		REQUIRE_FALSE(container.Is_Open());
+	}
+
+	SECTION("Compressed")
+	{
+		const Block_Image blocks{ Block_Encoder::Encode(texels[0].data(), 4, 2, 4,
+			enums::Block_Format::BC3) };
+		Write(path, enums::Color_Format::BC3, enums::Data_Color_Format::None, 1,
+			{ { 4, 2, blocks.data.data(), blocks.data.size() } });
+
+		Texture_Container container{};
+		container.Open(path);
+		REQUIRE(container.Get_Level_Count() == 1);
+		REQUIRE(container.Get_Image(0).size == 16);
+		REQUIRE(std::memcmp(container.Get_Image(0).data, blocks.data.data(), 16) == 0);
+	}
+
+	SECTION("Bake images")
+	{
+		const Image image{ texels[0].data(), 4, 2, enums::Image_Channels::RGBA,
+			enums::Image_Data_Type::Unsigned_Byte };
+
+		Bake({ image }, path, enums::Color_Format::RGBA8, false);
+
+		Texture_Container container{};
+		container.Open(path);
+		REQUIRE(container.Get_Level_Count() == 1);
+		REQUIRE(container.Get_Image(0).size == texels[0].size());
+		REQUIRE(std::memcmp(container.Get_Image(0).data, texels[0].data(),
+			texels[0].size()) == 0);
+		container.Close();
+
+		// Converted to the channels of the color format
+		Bake({ image }, path, enums::Color_Format::RGB8, true);
+		container.Open(path);
+		REQUIRE(container.Get_Level_Count() == 3);
+		REQUIRE(container.Get_Image(0).size == 4 * 2 * 3);
+		REQUIRE(std::memcmp(container.Get_Image(0).data, texels[0].data(), 3) == 0);
+		container.Close();
+
+		REQUIRE_THROWS_AS(Bake({ image, image }, path, enums::Color_Format::RGBA8),
+			utils::Tilia_Exception);
+		REQUIRE_THROWS_AS(Bake(std::vector<Image>{ 6, image }, path,
+			enums::Color_Format::RGBA8), utils::Tilia_Exception);
+	}
+
+	SECTION("Bake packed channels")
+	{
+		using Map = enums::Material_Map;
+
+		const std::uint8_t occlusion_texels[]{ 10, 20, 30, 40 };
+		const std::uint8_t roughness_texels[]{ 50, 60, 70, 80 };
+		const Image occlusion{ occlusion_texels, 2, 2, enums::Image_Channels::Grey,
+			enums::Image_Data_Type::Unsigned_Byte };
+		const Image roughness{ roughness_texels, 2, 2, enums::Image_Channels::Grey,
+			enums::Image_Data_Type::Unsigned_Byte };
+
+		// The masks of the packing select the channels the maps are baked into
+		for (const std::size_t map_count : { std::size_t{ 1 }, std::size_t{ 2 } })
+		{
+			std::vector<Packed_Map> maps{ { Map::Occlusion, occlusion } };
+			if (map_count == 2)
+				maps.push_back({ Map::Roughness, roughness });
+			Channel_Packing packing{};
+			Bake({ Channel_Packer::Pack(Image{}, 0, maps, packing) }, path,
+				enums::Color_Format::RGBA8, false);
+
+			Texture_Container container{};
+			container.Open(path);
+			const Image_Data image{ container.Get_Image(0) };
+			for (std::size_t i{ 0 }; i < maps.size(); ++i)
+			{
+				const auto mask{ packing.Get_Mask(maps[i].map) };
+				const auto channel{ static_cast<std::size_t>(
+					std::find(mask.begin(), mask.end(), 1.0f) - mask.begin()) };
+				REQUIRE(channel < 4);
+				for (std::size_t j{ 0 }; j < 4; ++j)
+					REQUIRE(image.data[j * 4 + channel] == maps[i].image.Get_Data()[j]);
+			}
+			container.Close();
+		}
+	}
+
+	SECTION("Invalid containers")
+	{
+		// Levels have to halve
+		std::vector<Image_Data> wrong_levels{ images };
+		wrong_levels[1].width = 3;
+		REQUIRE_THROWS_AS(Write(path, enums::Color_Format::RGBA8,
+			enums::Data_Color_Format::RGBA, 1, wrong_levels), utils::Tilia_Exception);
+
+		// Cube maps need six faces
+		REQUIRE_THROWS_AS(Write(path, enums::Color_Format::RGBA8,
+			enums::Data_Color_Format::RGBA, 6, images), utils::Tilia_Exception);
+
+		Texture_Container container{};
+
+		{
+			std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+			file << "Not a texture container, though long enough to hold a header";
+		}
+		REQUIRE_THROWS_AS(container.Open(path), utils::Tilia_Exception);
+		REQUIRE_FALSE(container.Is_Open());
+
+		// Cut off within the last image
+		Write(path, enums::Color_Format::RGBA8, enums::Data_Color_Format::RGBA, 1, images);
+		std::vector<char> bytes{};
+		{
+			std::ifstream file{ path, std::ios::binary };
+			bytes.assign(std::istreambuf_iterator<char>{ file }, {});
+		}
+		{
+			std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+			file.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 2));
+		}
+		REQUIRE_THROWS_AS(container.Open(path), utils::Tilia_Exception);
+
+		REQUIRE_THROWS_AS(container.Open("missing.ttex"), utils::Tilia_Exception);
+	}
+
+	std::remove(path.c_str());
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
@@ -0,0 +1,209 @@
+/**************************************************************************************************
+ * @file   Texture_Container.hpp
+ *
+ * @brief  The texture files of the engine. A container holds the faces of a texture in the
+ *		   format they are uploaded in, along with all of their mip levels, each image aligned
+ *		   within the file. Containers are baked from image files ahead of time and memory
+ *		   mapped when loaded, so textures upload straight from the mapping without anything
+ *		   being decoded, encoded or copied on the way.
+ *
+ * @author Gustav Fagerlind
+ * @date   19/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_TEXTURE_CONTAINER_HPP
+#define TILIA_OPENGL_3_3_TEXTURE_CONTAINER_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_CONSTANTS_INCLUDE
+#include TILIA_OPENGL_3_3_CONSTANTS_INCLUDE
+#include TILIA_WINDOWS_MAPPED_FILE_INCLUDE
+#include TILIA_IMAGE_INCLUDE
+#include TILIA_MIP_GENERATOR_INCLUDE
+
+namespace tilia
+{
+	namespace gfx
+	{
+
+		/**
+		 * @brief A memory mapped texture container. Images are ordered by mip level and then by
+		 * face, the faces of a cube map following the order of the cube map sides.
+		 */
+		class Texture_Container
+		{
+		public:
+
+			// The alignment of every image within the file in bytes
+			static constexpr std::size_t s_alignment{ 64 };
+
+			/**
+			 * @brief A face of a mip level. Points into the mapping when read from a container.
+			 */
+			struct Image_Data
+			{
+				std::int32_t width{};
+				std::int32_t height{};
+				const std::uint8_t* data{ nullptr };
+				std::size_t size{};
+			}; // Image_Data
+
+			/**
+			 * @brief Maps the container at the given path and checks that every image of it
+			 * lies within the file and is of the size its format asks for.
+			 *
+			 * @exception The file could not be mapped or is not a valid container.
+			 */
+			void Open(const std::string& path);
+
+			/**
+			 * @brief Unmaps the container.
+			 */
+			void Close();
+
+			bool Is_Open() const { return m_file.Is_Open(); }
+
+			const std::string& Get_Path() const { return m_path; }
+
+			enums::Color_Format Get_Color_Format() const { return m_color_format; }
+			/**
+			 * @brief Gets the format of the data of uncompressed containers, None for block
+			 * compressed ones.
+			 */
+			enums::Data_Color_Format Get_Data_Color_Format() const { return m_data_color_format; }
+
+			std::int32_t Get_Width() const { return m_width; }
+			std::int32_t Get_Height() const { return m_height; }
+
+			/**
+			 * @brief Gets the amount of faces, 1 for 2D textures and 6 for cube maps.
+			 */
+			std::size_t Get_Face_Count() const { return m_face_count; }
+			std::size_t Get_Level_Count() const { return m_level_count; }
+
+			/**
+			 * @brief Gets a face of a mip level.
+			 *
+			 * @exception The level or face is out of range.
+			 */
+			Image_Data Get_Image(std::size_t level, std::size_t face = 0) const;
+
+			/**
+			 * @brief Uploads a face of a mip level straight from the mapping to the texture
+			 * bound to the given target. Needs a current context. Blocks the driver can not
+			 * sample are decoded and uploaded in the format Texture_::Get_Supported_Format
+			 * falls back to.
+			 *
+			 * @param target - The target to upload to, a side of a cube map for cube maps.
+			 * @param level - The mip level to upload.
+			 * @param face - The face to upload.
+			 * @param first_level - The level uploaded as the first level of the texture, so
+			 * that a texture may hold only the smaller levels.
+			 */
+			void Upload(std::uint32_t target, std::size_t level, std::size_t face = 0,
+				std::size_t first_level = 0) const;
+
+			/**
+			 * @brief Writes a container.
+			 *
+			 * @param path - The path to write to.
+			 * @param color_format - The format the images are uploaded as.
+			 * @param data_color_format - The format of the data of the images, None if the color
+			 * format is block compressed.
+			 * @param face_count - The amount of faces, 1 or 6.
+			 * @param images - The images ordered by mip level and then by face, every level
+			 * half the size of the one before it.
+			 *
+			 * @exception The images do not fit the formats or the file could not be written.
+			 */
+			static void Write(const std::string& path, enums::Color_Format color_format,
+				enums::Data_Color_Format data_color_format, std::size_t face_count,
+				const std::vector<Image_Data>& images);
+
+			/**
+			 * @brief Bakes the given image files into a container, one file per face. Mip levels
+			 * are generated through Mip_Generator and block compressed formats are encoded
+			 * through Block_Encoder.
+			 *
+			 * @param source_paths - The paths of the images of the faces.
+			 * @param path - The path of the container to write.
+			 * @param color_format - The format to store the images in.
+			 * @param generate_mipmaps - Whether or not to store every mip level.
+			 * @param mip_settings - How to generate the mip levels, the level count is ignored.
+			 *
+			 * @exception The images could not be loaded or are not of the same size.
+			 */
+			static void Bake(const std::vector<std::string>& source_paths,
+				const std::string& path, enums::Color_Format color_format,
+				bool generate_mipmaps = true, const Mip_Settings& mip_settings = {});
+
+			/**
+			 * @brief Bakes the given images into a container, one image per face, as the
+			 * overload taking files. Lets images made when building assets, such as those
+			 * packed by Channel_Packer, be baked without writing them to files first. The
+			 * images are expected to be flipped already.
+			 *
+			 * @param source_faces - The images of the faces, converted to the channels of the
+			 * color format as needed.
+			 *
+			 * @exception See the overload taking files.
+			 */
+			static void Bake(const std::vector<Image>& source_faces, const std::string& path,
+				enums::Color_Format color_format, bool generate_mipmaps = true,
+				const Mip_Settings& mip_settings = {});
+
+			/**
+			 * @brief Gets the amount of mip levels down to 1x1 of an image of the given size.
+			 */
+			static std::size_t Get_Mip_Count(std::int32_t width, std::int32_t height);
+
+			/**
+			 * @brief Gets the size in bytes of an image of the given formats and size.
+			 */
+			static std::size_t Get_Image_Size(enums::Color_Format color_format,
+				enums::Data_Color_Format data_color_format, std::int32_t width,
+				std::int32_t height);
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Texture_Container. Writes and opens containers without a
+			 * context.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		private:
+
+			/**
+			 * @brief Gets the channels images are baked from for the given color format.
+			 */
+			static enums::Image_Channels Get_Bake_Channels(enums::Color_Format color_format);
+
+			utils::Mapped_File m_file{};
+			std::string m_path{};
+
+			enums::Color_Format m_color_format{ enums::Color_Format::None };
+			enums::Data_Color_Format m_data_color_format{ enums::Data_Color_Format::None };
+			std::int32_t m_width{};
+			std::int32_t m_height{};
+			std::size_t m_face_count{};
+			std::size_t m_level_count{};
+
+			// The images of the container, pointing into the mapping
+			std::vector<Image_Data> m_images{};
+
+		}; // Texture_Container
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_TEXTURE_CONTAINER_HPP
@@ -0,0 +1,785 @@
+// Vendor
+#include "vendor/glad/KHR_Debug_openGL_3_3/include/glad/glad.h"
+
+// Standard
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+// Tilia
+#include "Texture_Residency.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_TEXTURE_2D__INCLUDE
+#include TILIA_OPENGL_3_3_CUBE_MAP_INCLUDE
+#include TILIA_OPENGL_3_3_TEXTURE_STREAMER_INCLUDE
+#include TILIA_OPENGL_3_3_TEXTURE_CONTAINER_INCLUDE
+#include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
+#include TILIA_OPENGL_3_3_UTILS_INCLUDE
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+
+/**
+ * @brief The size and format of a texture when whole.
+ */
+struct Texture_Info
+{
+	tilia::enums::Color_Format color_format{ tilia::enums::Color_Format::None };
+	std::int32_t width{};
+	std::int32_t height{};
+	std::size_t face_count{ 1 };
+};
+
+static Texture_Info Get_Info(const tilia::gfx::Texture_& texture)
+{
+	if (texture.Get_Type() == tilia::enums::Texture_Type_::Cube_Map)
+	{
+		const auto& cube_map_data{
+			static_cast<const tilia::gfx::Cube_Map&>(texture).Get_Cube_Map_Data() };
+		return { cube_map_data.sides.front().color_format, cube_map_data.size,
+			cube_map_data.size, *tilia::enums::Geometry_Features::Cube_Faces };
+	}
+	const auto& texture_def{
+		static_cast<const tilia::gfx::Texture_2D_&>(texture).Get_Texture_Def() };
+	return { texture_def.color_format, texture_def.width, texture_def.height, 1 };
+}
+
+/**
+ * Gets the target of a face when reading from or uploading to it.
+ */
+static GLenum Get_Face_Target(tilia::enums::Texture_Type_ texture_type, std::size_t face)
+{
+	if (texture_type == tilia::enums::Texture_Type_::Cube_Map)
+		return *tilia::enums::Cube_Map_Sides::Positive_X + static_cast<GLenum>(face);
+	return *texture_type;
+}
+
+void tilia::gfx::Texture_Residency::Track(const std::shared_ptr<Texture_>& texture)
+{
+	const bool tracked{ std::any_of(m_entries.begin(), m_entries.end(),
+		[&texture](const Entry& entry) { return entry.texture.lock() == texture; }) };
+	if (!tracked)
+		m_entries.push_back({ texture });
+}
+
+void tilia::gfx::Texture_Residency::Request_Level(const Texture_& texture, std::size_t level)
+{
+	std::lock_guard<std::mutex> lock{ m_request_mutex };
+	const auto [request, inserted]{ m_requests.try_emplace(&texture, level) };
+	if (!inserted)
+		request->second = std::min(request->second, level);
+}
+
+void tilia::gfx::Texture_Residency::Request_Screen_Size(const Texture_& texture,
+	float screen_size, float uv_extent)
+{
+	const Texture_Info info{ Get_Info(texture) };
+	Request_Level(texture, Get_Required_Level(info.width, info.height, texture.m_level_count,
+		screen_size, uv_extent));
+}
+
+void tilia::gfx::Texture_Residency::Untrack(const Texture_& texture)
+{
+	m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+		[&texture](const Entry& entry) { return entry.texture.lock().get() == &texture; }),
+		m_entries.end());
+}
+
+/**
+ * Requested mip levels are streamed first. Textures bound since they were evicted are then
+ * restored before anything is evicted, and count as whole while they are streamed back in so
+ * that the budget is kept once they are, while streamed textures are left to their requests.
+ * Textures are then evicted down to a low mip level, the least recently bound first, and only
+ * if that is not enough are they evicted out entirely.
+ */
+std::size_t tilia::gfx::Texture_Residency::Update()
+{
+
+	const std::uint64_t frame{ ++Texture_::s_frame };
+
+	m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+		[](const Entry& entry) { return entry.texture.expired(); }), m_entries.end());
+
+	std::size_t evicted_bytes{ Stream_Requests() };
+
+	std::size_t resident_bytes{};
+
+	for (auto& entry : m_entries)
+	{
+		const auto texture{ entry.texture.lock() };
+
+		// Data set since, by a finished stream or otherwise, makes the texture whole again
+		if (texture->m_first_level == 0)
+			entry.restoring = false;
+
+		if (!entry.streamed && texture->m_first_level != 0 && !entry.restoring &&
+			texture->m_last_used_frame > entry.evicted_frame)
+		{
+			try
+			{
+				entry.restoring = Restore(texture);
+			}
+			catch (utils::Tilia_Exception& t_e)
+			{
+				throw t_e.Add_Message({ TILIA_LOCATION,
+					"Texture { ID: ", texture->Get_ID(), " } failed to be restored" });
+			}
+		}
+
+		const Texture_Info info{ Get_Info(*texture) };
+		resident_bytes += Get_Size(info.color_format, info.width, info.height,
+			texture->m_level_count, entry.restoring ? 0 : texture->m_first_level,
+			info.face_count);
+	}
+
+	m_resident_bytes = resident_bytes;
+
+	if (m_resident_bytes <= m_budget)
+	{
+		m_evicted_bytes += evicted_bytes;
+		return evicted_bytes;
+	}
+
+	std::vector<std::pair<std::shared_ptr<Texture_>, Entry*>> candidates{};
+	for (auto& entry : m_entries)
+	{
+		auto texture{ entry.texture.lock() };
+		// Streamed textures are left to their requests
+		if (!entry.streamed && !entry.restoring &&
+			texture->m_first_level != Texture_::s_evicted &&
+			texture->m_last_used_frame + m_unused_frames < frame && Can_Restore(*texture))
+		{
+			candidates.push_back({ std::move(texture), &entry });
+		}
+	}
+
+	std::stable_sort(candidates.begin(), candidates.end(),
+		[](const auto& lhs, const auto& rhs)
+		{ return lhs.first->m_last_used_frame < rhs.first->m_last_used_frame; });
+
+	// Down to a low mip level first, then out entirely
+	for (const bool out : { false, true })
+	{
+		for (auto& [texture, entry] : candidates)
+		{
+			if (m_resident_bytes <= m_budget)
+				break;
+
+			const Texture_Info info{ Get_Info(*texture) };
+			const std::size_t first_level{ out ? Texture_::s_evicted :
+				Texture_::Get_Fit_Level(info.width, info.height, texture->m_level_count,
+				m_evicted_size) };
+			if (texture->m_first_level == Texture_::s_evicted ||
+				(!out && first_level <= texture->m_first_level))
+				continue;
+
+			const std::size_t size{ Get_Resident_Size(*texture) };
+			const std::size_t evicted_size{ Get_Size(info.color_format, info.width,
+				info.height, texture->m_level_count, first_level, info.face_count) };
+
+			try
+			{
+				Evict(*texture, first_level);
+			}
+			catch (utils::Tilia_Exception& t_e)
+			{
+				throw t_e.Add_Message({ TILIA_LOCATION,
+					"Texture { ID: ", texture->Get_ID(), " } failed to be evicted" });
+			}
+
+			entry->evicted_frame = frame;
+			m_resident_bytes -= size - evicted_size;
+			evicted_bytes += size - evicted_size;
+		}
+	}
+
+	m_evicted_bytes += evicted_bytes;
+
+	return evicted_bytes;
+
+}
+
+std::size_t tilia::gfx::Texture_Residency::Get_Size(enums::Color_Format color_format,
+	std::int32_t width, std::int32_t height, std::size_t level_count, std::size_t first_level,
+	std::size_t face_count)
+{
+
+	if (first_level == Texture_::s_evicted)
+		return sizeof(Texture_Streamer::s_placeholder_texel) * face_count;
+
+	const bool compressed{ utils::Is_Compressed_Format(*color_format) };
+
+	std::size_t size{};
+	for (std::size_t level{ first_level }; level < level_count; ++level)
+	{
+		const std::int32_t level_width{ std::max(width >> level, 1) };
+		const std::int32_t level_height{ std::max(height >> level, 1) };
+		if (compressed)
+		{
+			size += Block_Encoder::Get_Encoded_Size(Texture_::Get_Block_Format(color_format),
+				level_width, level_height);
+		}
+		else
+		{
+			size += static_cast<std::size_t>(level_width) * level_height *
+				utils::Get_Color_Format_Size(*color_format);
+		}
+	}
+
+	return size * face_count;
+
+}
+
+std::size_t tilia::gfx::Texture_Residency::Get_Required_Level(std::int32_t width,
+	std::int32_t height, std::size_t level_count, float screen_size, float uv_extent)
+{
+	if (level_count <= 1)
+		return 0;
+	// Not on screen at all
+	if (!(screen_size > 0.0f))
+		return level_count - 1;
+
+	const float texels_per_pixel{ static_cast<float>(std::max(width, height)) * uv_extent /
+		screen_size };
+	if (!(texels_per_pixel >= 2.0f))
+		return 0;
+
+	const auto level{ static_cast<std::size_t>(std::floor(std::log2(texels_per_pixel))) };
+	return std::min(level, level_count - 1);
+}
+
+float tilia::gfx::Texture_Residency::Get_Screen_Size(float radius, float distance, float fov,
+	float viewport_height)
+{
+	if (distance <= radius)
+		return std::numeric_limits<float>::max();
+	return radius / (distance * std::tan(fov * 0.5f)) * viewport_height;
+}
+
+std::size_t tilia::gfx::Texture_Residency::Get_Resident_Size(const Texture_& texture)
+{
+	const Texture_Info info{ Get_Info(texture) };
+	return Get_Size(info.color_format, info.width, info.height, texture.m_level_count,
+		texture.m_first_level, info.face_count);
+}
+
+/**
+ * Streamed textures only get mipmaps back by generating them, which block compressed formats
+ * can not, so those are only restored from texture containers.
+ */
+bool tilia::gfx::Texture_Residency::Can_Restore(const Texture_& texture)
+{
+
+	if (texture.m_texture_type == enums::Texture_Type_::Cube_Map)
+	{
+		const auto& sides{ static_cast<const Cube_Map&>(texture).Get_Cube_Map_Data().sides };
+		const bool has_paths{ std::none_of(sides.begin(), sides.end(),
+			[](const Cube_Map_Data::Cube_Side& side) { return side.file_path.empty(); }) };
+		if (!has_paths)
+			return false;
+	}
+	else if (static_cast<const Texture_2D_&>(texture).Get_Texture_Def().file_path.empty())
+	{
+		return false;
+	}
+
+	if (texture.m_from_container)
+		return true;
+
+	const auto color_format{ Get_Info(texture).color_format };
+	return texture.m_level_count == 1 || !utils::Is_Compressed_Format(*color_format);
+
+}
+
+bool tilia::gfx::Texture_Residency::Restore(const std::shared_ptr<Texture_>& texture)
+{
+
+	if (texture->m_from_container)
+	{
+		Stream_Level(*texture, 0);
+		return false;
+	}
+
+	const bool generate_mipmaps{ texture->m_level_count > 1 };
+
+	if (texture->m_texture_type == enums::Texture_Type_::Cube_Map)
+	{
+		Texture_Streamer::Instance().Stream(std::static_pointer_cast<Cube_Map>(texture),
+			generate_mipmaps);
+		return true;
+	}
+
+	const auto texture_2D{ std::static_pointer_cast<Texture_2D_>(texture) };
+	Texture_Streamer::Instance().Stream(texture_2D, texture_2D->Get_Texture_Def(),
+		generate_mipmaps);
+	return true;
+
+}
+
+/**
+ * Levels are read back before the openGL texture holding every level is deleted, which is the
+ * only way to free the memory of levels with openGL 3.3. The filtering and wrapping of the
+ * texture are kept.
+ */
+void tilia::gfx::Texture_Residency::Evict(Texture_& texture, std::size_t first_level)
+{
+
+	const Texture_Info info{ Get_Info(texture) };
+	const auto target{ static_cast<GLenum>(*texture.m_texture_type) };
+	const bool placeholder{ first_level == Texture_::s_evicted };
+	const bool compressed{ utils::Is_Compressed_Format(*info.color_format) };
+	const std::size_t level_count{ placeholder ? 1 : texture.m_level_count - first_level };
+	const GLenum data_format{ compressed ? GL_NONE : static_cast<GLenum>(
+		*utils::Get_Data_Color_Format(utils::Get_Color_Format_Count(*info.color_format))) };
+	const GLenum data_type{ compressed ? GL_NONE : static_cast<GLenum>(
+		utils::Get_Color_Format_Type(*info.color_format)) };
+
+	// Ordered by level and then by face
+	std::vector<std::vector<std::uint8_t>> levels(level_count * info.face_count);
+
+	std::uint32_t ID{};
+
+	// Levels are read and written tightly packed, the alignments of others are put back after
+	GLint pack_alignment{ 4 };
+	GLint unpack_alignment{ 4 };
+
+	Texture_::Unbind(texture.m_texture_type, true);
+
+	try
+	{
+
+		GL_CALL(glGetIntegerv(GL_PACK_ALIGNMENT, &pack_alignment));
+		GL_CALL(glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpack_alignment));
+
+		GL_CALL(glBindTexture(target, texture.m_ID));
+
+		constexpr GLenum parameter_names[]{ GL_TEXTURE_MIN_FILTER, GL_TEXTURE_MAG_FILTER,
+			GL_TEXTURE_WRAP_S, GL_TEXTURE_WRAP_T, GL_TEXTURE_WRAP_R };
+		GLint parameters[std::size(parameter_names)]{};
+		for (std::size_t i{ 0 }; i < std::size(parameter_names); ++i)
+		{
+			GL_CALL(glGetTexParameteriv(target, parameter_names[i], &parameters[i]));
+		}
+
+		if (!placeholder)
+		{
+			GL_CALL(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+			for (std::size_t level{ 0 }; level < level_count; ++level)
+			{
+				const auto source_level{ static_cast<GLint>(first_level + level) };
+				for (std::size_t face{ 0 }; face < info.face_count; ++face)
+				{
+					auto& data{ levels[level * info.face_count + face] };
+					const GLenum face_target{ Get_Face_Target(texture.m_texture_type, face) };
+					if (compressed)
+					{
+						GLint size{};
+						GL_CALL(glGetTexLevelParameteriv(face_target, source_level,
+							GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size));
+						data.resize(static_cast<std::size_t>(size));
+						GL_CALL(glGetCompressedTexImage(face_target, source_level, data.data()));
+					}
+					else
+					{
+						data.resize(Get_Size(info.color_format, info.width, info.height,
+							first_level + level + 1, first_level + level));
+						GL_CALL(glGetTexImage(face_target, source_level, data_format,
+							data_type, data.data()));
+					}
+				}
+			}
+		}
+
+		GL_CALL(glGenTextures(1, &ID));
+		GL_CALL(glBindTexture(target, ID));
+
+		for (std::size_t i{ 0 }; i < std::size(parameter_names); ++i)
+		{
+			GL_CALL(glTexParameteri(target, parameter_names[i], parameters[i]));
+		}
+		GL_CALL(glTexParameteri(target, GL_TEXTURE_MAX_LEVEL,
+			static_cast<GLint>(level_count - 1)));
+
+		GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+		for (std::size_t level{ 0 }; level < level_count; ++level)
+		{
+			const std::size_t source_level{ first_level + level };
+			const GLsizei width{ placeholder ? 1 : std::max(info.width >> source_level, 1) };
+			const GLsizei height{ placeholder ? 1 : std::max(info.height >> source_level, 1) };
+			for (std::size_t face{ 0 }; face < info.face_count; ++face)
+			{
+				const auto& data{ levels[level * info.face_count + face] };
+				const GLenum face_target{ Get_Face_Target(texture.m_texture_type, face) };
+				const auto upload_level{ static_cast<GLint>(level) };
+				if (placeholder)
+				{
+					GL_CALL(glTexImage2D(face_target, 0, GL_RGBA8, 1, 1, 0, GL_RGBA,
+						GL_UNSIGNED_BYTE, Texture_Streamer::s_placeholder_texel));
+				}
+				else if (compressed)
+				{
+					GL_CALL(glCompressedTexImage2D(face_target, upload_level,
+						*info.color_format, width, height, 0,
+						static_cast<GLsizei>(data.size()), data.data()));
+				}
+				else
+				{
+					GL_CALL(glTexImage2D(face_target, upload_level, *info.color_format,
+						width, height, 0, data_format, data_type, data.data()));
+				}
+			}
+		}
+
+		GL_CALL(glPixelStorei(GL_PACK_ALIGNMENT, pack_alignment));
+		GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment));
+
+		texture.Replace_ID(ID);
+
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		if (ID)
+			glDeleteTextures(1, &ID);
+		glPixelStorei(GL_PACK_ALIGNMENT, pack_alignment);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, unpack_alignment);
+		Texture_::Rebind(texture.m_texture_type);
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to evict texture { ID: ", texture.m_ID, ", Level: ", first_level, " }" });
+	}
+
+	Texture_::Rebind(texture.m_texture_type);
+
+	texture.m_first_level = first_level;
+
+}
+
+void tilia::gfx::Texture_Residency::Stream_Level(Texture_& texture, std::size_t first_level)
+{
+	Texture_Container container{};
+	if (texture.m_texture_type == enums::Texture_Type_::Cube_Map)
+	{
+		auto& cube_map{ static_cast<Cube_Map&>(texture) };
+		container.Open(cube_map.Get_Path(0));
+		cube_map.Load_Container(container, first_level);
+		return;
+	}
+	auto& texture_2D{ static_cast<Texture_2D_&>(texture) };
+	container.Open(texture_2D.Get_Texture_Def().file_path);
+	texture_2D.Load_Container(container, first_level);
+}
+
+/**
+ * Larger levels than those held are streamed in straight away, the textures missing the most
+ * levels first, while held levels are only dropped once smaller ones have been requested for
+ * long enough. Streamed textures not requested for as long are handed back to be evicted when
+ * unused, such as once they are out of view.
+ */
+std::size_t tilia::gfx::Texture_Residency::Stream_Requests()
+{
+
+	std::unordered_map<const Texture_*, std::size_t> requests{};
+	{
+		std::lock_guard<std::mutex> lock{ m_request_mutex };
+		requests.swap(m_requests);
+	}
+
+	struct Stream
+	{
+		std::shared_ptr<Texture_> texture{};
+		std::size_t level{};
+		// The amount of levels missing, the placeholder missing every level
+		std::size_t missing_levels{};
+	}; // Stream
+
+	std::vector<Stream> streams{};
+	std::size_t dropped_bytes{};
+
+	for (auto& entry : m_entries)
+	{
+		auto texture{ entry.texture.lock() };
+		const auto request{ requests.find(texture.get()) };
+
+		// Levels are only dropped after being too large for frames in a row
+		if (request == requests.end())
+		{
+			entry.drop_frames = 0;
+			if (entry.streamed && ++entry.unrequested_frames > m_drop_frames)
+			{
+				// Only binds from now on restore the levels it holds
+				entry.streamed = false;
+				entry.unrequested_frames = 0;
+				entry.evicted_frame = Texture_::s_frame;
+			}
+			continue;
+		}
+
+		if (!texture->m_from_container)
+			continue;
+
+		entry.streamed = true;
+		entry.restoring = false;
+		entry.unrequested_frames = 0;
+
+		// Levels larger than the max size are never streamed in
+		const Texture_Info info{ Get_Info(*texture) };
+		const std::size_t level{ std::min(std::max(request->second,
+			Texture_::Get_Fit_Level(info.width, info.height, texture->m_level_count,
+			Texture_::Get_Max_Size())),
+			texture->m_level_count - 1) };
+		if (level < texture->m_first_level)
+		{
+			entry.drop_frames = 0;
+			const std::size_t held_level{ std::min(texture->m_first_level,
+				texture->m_level_count) };
+			streams.push_back({ std::move(texture), level, held_level - level });
+		}
+		else if (level > texture->m_first_level && ++entry.drop_frames > m_drop_frames)
+		{
+			entry.drop_frames = 0;
+			const std::size_t size{ Get_Resident_Size(*texture) };
+			try
+			{
+				Stream_Level(*texture, level);
+			}
+			catch (utils::Tilia_Exception& t_e)
+			{
+				throw t_e.Add_Message({ TILIA_LOCATION,
+					"Texture { ID: ", texture->Get_ID(), " } failed to drop levels",
+					"\n>>> Level: ", level });
+			}
+			dropped_bytes += size - Get_Resident_Size(*texture);
+		}
+		else if (level == texture->m_first_level)
+		{
+			entry.drop_frames = 0;
+		}
+	}
+
+	std::stable_sort(streams.begin(), streams.end(),
+		[](const Stream& lhs, const Stream& rhs)
+		{ return lhs.missing_levels > rhs.missing_levels; });
+
+	std::size_t streamed_bytes{};
+	for (const auto& stream : streams)
+	{
+		const Texture_Info info{ Get_Info(*stream.texture) };
+		const std::size_t size{ Get_Size(info.color_format, info.width, info.height,
+			stream.texture->m_level_count, stream.level, info.face_count) };
+		// The rest are requested again by later frames
+		if (streamed_bytes != 0 && streamed_bytes + size > m_stream_bytes)
+			continue;
+
+		try
+		{
+			Stream_Level(*stream.texture, stream.level);
+		}
+		catch (utils::Tilia_Exception& t_e)
+		{
+			throw t_e.Add_Message({ TILIA_LOCATION,
+				"Texture { ID: ", stream.texture->Get_ID(), " } failed to stream levels",
+				"\n>>> Level: ", stream.level });
+		}
+		streamed_bytes += size;
+	}
+
+	m_streamed_bytes += streamed_bytes;
+
+	return dropped_bytes;
+
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Standard
+#include <cstdio>
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+void tilia::gfx::Texture_Residency::Test()
+{
+
+	SECTION("Size")
+	{
+		// A single level
+		REQUIRE(Get_Size(enums::Color_Format::RGBA8, 16, 8) == 16 * 8 * 4);
+		REQUIRE(Get_Size(enums::Color_Format::RGB8, 16, 8) == 16 * 8 * 3);
+		REQUIRE(Get_Size(enums::Color_Format::Red8, 16, 8) == 16 * 8);
+		// Every level, the last ones being at least 1 texel wide
+		REQUIRE(Get_Size(enums::Color_Format::RGBA8, 4, 2, 3) == (8 + 2 + 1) * 4);
+		// Levels from the first one asked for
+		REQUIRE(Get_Size(enums::Color_Format::RGBA8, 4, 2, 3, 1) == (2 + 1) * 4);
+		// Every face
+		REQUIRE(Get_Size(enums::Color_Format::Red8, 4, 4, 1, 0, 6) == 16 * 6);
+		// Blocks of 8 bytes, levels smaller than a block still taking up a whole one
+		REQUIRE(Get_Size(enums::Color_Format::BC1, 8, 8, 4) == (4 + 1 + 1 + 1) * 8);
+		REQUIRE(Get_Size(enums::Color_Format::BC3, 8, 8) == 4 * 16);
+		// Only the placeholder
+		REQUIRE(Get_Size(enums::Color_Format::RGBA8, 1024, 1024, 11, Texture_::s_evicted) ==
+			4);
+		REQUIRE(Get_Size(enums::Color_Format::RGBA8, 1024, 1024, 11, Texture_::s_evicted, 6) ==
+			4 * 6);
+	}
+
+	SECTION("Evicted level")
+	{
+		REQUIRE(Texture_::Get_Fit_Level(1024, 1024, 11, 64) == 4);
+		REQUIRE(Texture_::Get_Fit_Level(1024, 4096, 13, 64) == 6);
+		REQUIRE(Texture_::Get_Fit_Level(64, 64, 7, 64) == 0);
+		// No levels to evict down to
+		REQUIRE(Texture_::Get_Fit_Level(1024, 1024, 1, 64) == 0);
+		// Not enough levels to get down to the size
+		REQUIRE(Texture_::Get_Fit_Level(1024, 1024, 3, 64) == 2);
+	}
+
+	SECTION("Required level")
+	{
+		// A texel to a pixel, or fewer than two
+		REQUIRE(Get_Required_Level(1024, 1024, 11, 1024.0f) == 0);
+		REQUIRE(Get_Required_Level(1024, 1024, 11, 600.0f) == 0);
+		// Two texels to a pixel
+		REQUIRE(Get_Required_Level(1024, 1024, 11, 512.0f) == 1);
+		REQUIRE(Get_Required_Level(1024, 512, 11, 100.0f) == 3);
+		// Repeating textures need more texels
+		REQUIRE(Get_Required_Level(1024, 1024, 11, 100.0f, 4.0f) == 5);
+		REQUIRE(Get_Required_Level(1024, 1024, 11, 100.0f, 0.25f) == 1);
+		// Clamped to the last level
+		REQUIRE(Get_Required_Level(1024, 1024, 11, 0.01f) == 10);
+		REQUIRE(Get_Required_Level(1024, 1024, 4, 1.0f) == 3);
+		REQUIRE(Get_Required_Level(1024, 1024, 1, 1.0f) == 0);
+		// Off screen only needs the last level
+		REQUIRE(Get_Required_Level(1024, 1024, 11, 0.0f) == 10);
+		// Filling the screen needs every level
+		REQUIRE(Get_Required_Level(1024, 1024, 11, std::numeric_limits<float>::max()) == 0);
+	}
+
+	SECTION("Screen size")
+	{
+		constexpr float fov{ 1.5707963f };
+		// Half of the view at 90 degrees is as wide as it is far
+		REQUIRE(Get_Screen_Size(1.0f, 10.0f, fov, 1000.0f) == Approx(100.0f));
+		REQUIRE(Get_Screen_Size(1.0f, 20.0f, fov, 1000.0f) == Approx(50.0f));
+		REQUIRE(Get_Screen_Size(2.0f, 20.0f, fov, 1000.0f) == Approx(100.0f));
+		// The camera within the sphere
+		REQUIRE(Get_Screen_Size(1.0f, 0.5f, fov, 1000.0f) ==
+			std::numeric_limits<float>::max());
+	}
+
+	SECTION("Settings")
+	{
+		auto& residency{ Instance() };
+
+		residency.Set_Budget(1024);
+		REQUIRE(residency.Get_Budget() == 1024);
+		residency.Set_Budget(s_default_budget);
+
+		residency.Set_Evicted_Size(32);
+		REQUIRE(residency.Get_Evicted_Size() == 32);
+		residency.Set_Evicted_Size(s_default_evicted_size);
+
+		residency.Set_Unused_Frames(10);
+		REQUIRE(residency.Get_Unused_Frames() == 10);
+		residency.Set_Unused_Frames(s_default_unused_frames);
+
+		residency.Set_Stream_Bytes(1024);
+		REQUIRE(residency.Get_Stream_Bytes() == 1024);
+		residency.Set_Stream_Bytes(s_default_stream_bytes);
+
+		residency.Set_Drop_Frames(5);
+		REQUIRE(residency.Get_Drop_Frames() == 5);
+		residency.Set_Drop_Frames(s_default_drop_frames);
+	}
+
+	SECTION("Used textures")
+	{
+		auto& residency{ Instance() };
+
+		// Needs the context the tests are run with
+		Texture_2D_Def texture_def{};
+		texture_def.file_path = "res/textures/container2.png";
+		const auto used{ std::make_shared<Texture_2D_>() };
+		const auto unused{ std::make_shared<Texture_2D_>() };
+		used->Set_Texture(texture_def);
+		unused->Set_Texture(texture_def);
+
+		residency.Track(used);
+		residency.Track(unused);
+		residency.Set_Budget(0);
+
+		// Marked the way Batch::Upload marks the textures its recorded commands bind
+		for (std::uint64_t i{ 0 }; i < s_default_unused_frames + 2; ++i)
+		{
+			used->Mark_Used();
+			residency.Update();
+		}
+
+		REQUIRE(used->Get_First_Level() == 0);
+		REQUIRE(unused->Get_First_Level() == Texture_::s_evicted);
+
+		residency.Untrack(*used);
+		residency.Untrack(*unused);
+		residency.Set_Budget(s_default_budget);
+	}
+
+	SECTION("Unrequested textures")
+	{
+		auto& residency{ Instance() };
+
+		// An RGBA image of 4x2 and its two mip levels, loaded with the context the tests are
+		// run with
+		const std::string path{ "texture_residency_test.ttex" };
+		std::vector<std::uint8_t> texels[3]{ std::vector<std::uint8_t>(4 * 2 * 4),
+			std::vector<std::uint8_t>(2 * 1 * 4), std::vector<std::uint8_t>(1 * 1 * 4) };
+		Texture_Container::Write(path, enums::Color_Format::RGBA8,
+			enums::Data_Color_Format::RGBA, 1, {
+			{ 4, 2, texels[0].data(), texels[0].size() },
+			{ 2, 1, texels[1].data(), texels[1].size() },
+			{ 1, 1, texels[2].data(), texels[2].size() } });
+
+		Texture_Container container{};
+		container.Open(path);
+		const auto texture{ std::make_shared<Texture_2D_>() };
+		texture->Load_Container(container, 0);
+		container.Close();
+
+		residency.Track(texture);
+		residency.Set_Budget(0);
+		residency.Set_Drop_Frames(2);
+
+		// Kept while requested, even though unused and over the budget
+		for (std::uint64_t i{ 0 }; i < s_default_unused_frames + 4; ++i)
+		{
+			residency.Request_Screen_Size(*texture, 4.0f);
+			residency.Update();
+		}
+
+		REQUIRE(texture->Get_First_Level() == 0);
+
+		// Evicted once no longer requested for the drop frames and then unused
+		for (std::uint64_t i{ 0 }; i < s_default_unused_frames + 4; ++i)
+			residency.Update();
+
+		REQUIRE(texture->Get_First_Level() == Texture_::s_evicted);
+
+		residency.Untrack(*texture);
+		residency.Set_Budget(s_default_budget);
+		residency.Set_Drop_Frames(s_default_drop_frames);
+		std::remove(path.c_str());
+	}
+
+	SECTION("Frames")
+	{
+		auto& residency{ Instance() };
+
+		REQUIRE(residency.Get_Tracked_Count() == 0);
+
+		// Nothing tracked so nothing touches openGL
+		const std::uint64_t frame{ Texture_::Get_Frame() };
+		REQUIRE(residency.Update() == 0);
+		REQUIRE(Texture_::Get_Frame() == frame + 1);
+		REQUIRE(residency.Get_Resident_Bytes() == 0);
+		REQUIRE(residency.Get_Streamed_Bytes() == 0);
+	}
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
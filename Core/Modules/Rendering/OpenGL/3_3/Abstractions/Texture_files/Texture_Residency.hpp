@@ -0,0 +1,318 @@
+/**************************************************************************************************
+ * @file   Texture_Residency.hpp
+ *
+ * @brief  Keeps the textures held by openGL within a budget of bytes. Every tracked texture is
+ *		   accounted for along with its mip levels, and once the budget is exceeded the least
+ *		   recently bound textures are evicted, first down to a low mip level and then out
+ *		   entirely, leaving only a placeholder. Evicted textures are restored from where they
+ *		   were loaded from once they are bound again. Textures loaded from texture containers
+ *		   may also have their mip levels streamed, holding only the levels needed for how
+ *		   large they are on screen.
+ *
+ * @author Gustav Fagerlind
+ * @date   19/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_TEXTURE_RESIDENCY_HPP
+#define TILIA_OPENGL_3_3_TEXTURE_RESIDENCY_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_CONSTANTS_INCLUDE
+#include TILIA_OPENGL_3_3_TEXTURE__INCLUDE
+
+namespace tilia
+{
+	namespace gfx
+	{
+
+		/**
+		 * @brief Singleton managing the residency of textures. Update has to be called once per
+		 * frame by the thread owning the context, which is where textures are evicted and
+		 * restored. Only textures which can be loaded again, either streamed from their image
+		 * files through Texture_Streamer or from their texture container, are ever evicted,
+		 * others are only accounted for.
+		 */
+		class Texture_Residency
+		{
+		public:
+
+			// The default amount of bytes textures may take up
+			static constexpr std::size_t s_default_budget{ 256 * 1024 * 1024 };
+			// The default largest side in texels of the mip level textures are evicted down to
+			static constexpr std::int32_t s_default_evicted_size{ 64 };
+			// The default amount of frames a texture has to be unused for to be evicted
+			static constexpr std::uint64_t s_default_unused_frames{ 2 };
+			// The default amount of bytes of mip levels streamed in per Update
+			static constexpr std::size_t s_default_stream_bytes{ 8 * 1024 * 1024 };
+			// The default amount of frames smaller levels have to be requested for to be dropped
+			static constexpr std::uint64_t s_default_drop_frames{ 30 };
+
+			/**
+			 * @brief First time it is called it will construct an instance of Texture_Residency.
+			 * A reference to this instance is returned to anywhere in the program.
+			 *
+			 * @return A reference to an instance of Texture_Residency.
+			 */
+			static Texture_Residency& Instance()
+			{
+				static Texture_Residency texture_residency{};
+				return texture_residency;
+			}
+
+			/**
+			 * @brief Starts tracking a texture, which is dropped once destroyed. Tracking a
+			 * texture twice does nothing.
+			 */
+			void Track(const std::shared_ptr<Texture_>& texture);
+
+			/**
+			 * @brief Stops tracking a texture, which is left as it is.
+			 */
+			void Untrack(const Texture_& texture);
+
+			/**
+			 * @brief Requests the mip levels of a texture from the given level for this frame,
+			 * such as the level from Get_Required_Level of a mesh found visible while culling.
+			 * The smallest level requested in a frame is streamed in by the next Update. Only
+			 * textures tracked and loaded from texture containers are streamed, others are left
+			 * as they are. May be called from any thread.
+			 */
+			void Request_Level(const Texture_& texture, std::size_t level);
+
+			/**
+			 * @brief Requests the level from Get_Required_Level of a texture drawn on a mesh of
+			 * the given size on screen, as Request_Level. May be called from any thread.
+			 *
+			 * @param screen_size - The size in pixels of the mesh on screen, such as from
+			 * Get_Screen_Size.
+			 * @param uv_extent - How many times the texture spans the mesh.
+			 */
+			void Request_Screen_Size(const Texture_& texture, float screen_size,
+				float uv_extent = 1.0f);
+
+			/**
+			 * @brief Advances the frame, streams the mip levels requested this frame, restores
+			 * evicted textures bound since they were evicted and evicts textures until the
+			 * budget is kept, the least recently bound first. Textures are evicted down to a low
+			 * mip level before any is evicted out entirely. Stream and restore failures are
+			 * thrown from here.
+			 *
+			 * @return The amount of bytes evicted, including mip levels no longer requested.
+			 */
+			std::size_t Update();
+
+			/**
+			 * @brief Sets the amount of bytes tracked textures may take up.
+			 */
+			void Set_Budget(std::size_t budget) { m_budget = budget; }
+			std::size_t Get_Budget() const { return m_budget; }
+
+			/**
+			 * @brief Sets the largest side in texels of the mip level textures are evicted down
+			 * to.
+			 */
+			void Set_Evicted_Size(std::int32_t evicted_size) { m_evicted_size = evicted_size; }
+			std::int32_t Get_Evicted_Size() const { return m_evicted_size; }
+
+			/**
+			 * @brief Sets the amount of frames a texture has to be unused for to be evicted, so
+			 * that textures in view are not evicted and restored over and over.
+			 */
+			void Set_Unused_Frames(std::uint64_t unused_frames) { m_unused_frames = unused_frames; }
+			std::uint64_t Get_Unused_Frames() const { return m_unused_frames; }
+
+			/**
+			 * @brief Sets the amount of bytes of mip levels streamed in per Update, the textures
+			 * missing the most levels first. A texture is always streamed in if no other has
+			 * been so that large textures are not starved.
+			 */
+			void Set_Stream_Bytes(std::size_t stream_bytes) { m_stream_bytes = stream_bytes; }
+			std::size_t Get_Stream_Bytes() const { return m_stream_bytes; }
+
+			/**
+			 * @brief Sets the amount of frames in a row smaller levels than those held have to
+			 * be requested for before the larger ones are dropped, so that levels are not
+			 * streamed in and out over and over as objects move. Streamed textures not
+			 * requested for as many frames are no longer streamed and may be evicted.
+			 */
+			void Set_Drop_Frames(std::uint64_t drop_frames) { m_drop_frames = drop_frames; }
+			std::uint64_t Get_Drop_Frames() const { return m_drop_frames; }
+
+			/**
+			 * @brief Gets the amount of bytes the tracked textures took up after the last Update.
+			 */
+			std::size_t Get_Resident_Bytes() const { return m_resident_bytes; }
+
+			/**
+			 * @brief Gets the amount of bytes evicted since the first Update.
+			 */
+			std::size_t Get_Evicted_Bytes() const { return m_evicted_bytes; }
+
+			/**
+			 * @brief Gets the amount of bytes of mip levels streamed in since the first Update.
+			 */
+			std::size_t Get_Streamed_Bytes() const { return m_streamed_bytes; }
+
+			/**
+			 * @brief Gets the amount of tracked textures.
+			 */
+			std::size_t Get_Tracked_Count() const { return m_entries.size(); }
+
+			/**
+			 * @brief Gets the amount of bytes of the given mip levels of a texture.
+			 *
+			 * @param color_format - The color format of the texture.
+			 * @param width - The width of the first level of the texture.
+			 * @param height - The height of the first level of the texture.
+			 * @param level_count - The amount of levels of the texture.
+			 * @param first_level - The first level to count, s_evicted for a placeholder.
+			 * @param face_count - The amount of faces, 6 for cube maps.
+			 */
+			static std::size_t Get_Size(enums::Color_Format color_format, std::int32_t width,
+				std::int32_t height, std::size_t level_count = 1, std::size_t first_level = 0,
+				std::size_t face_count = 1);
+
+			/**
+			 * @brief Gets the first mip level needed for less than two texels of a texture to
+			 * span a pixel, from how many texels of it span how many pixels.
+			 *
+			 * @param width - The width of the first level of the texture.
+			 * @param height - The height of the first level of the texture.
+			 * @param level_count - The amount of levels of the texture.
+			 * @param screen_size - The size in pixels of the mesh on screen, such as from
+			 * Get_Screen_Size.
+			 * @param uv_extent - How many times the texture spans the mesh, from the extent of
+			 * its texture coordinates. Larger when the texture repeats.
+			 */
+			static std::size_t Get_Required_Level(std::int32_t width, std::int32_t height,
+				std::size_t level_count, float screen_size, float uv_extent = 1.0f);
+
+			/**
+			 * @brief Gets the size in pixels on screen of a bounding sphere seen through a
+			 * perspective projection, the largest float when the camera is within it.
+			 *
+			 * @param radius - The radius of the sphere.
+			 * @param distance - The distance from the camera to the center of the sphere.
+			 * @param fov - The vertical field of view in radians.
+			 * @param viewport_height - The height of the viewport in pixels.
+			 */
+			static float Get_Screen_Size(float radius, float distance, float fov,
+				float viewport_height);
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Texture_Residency. Sections evicting textures need a
+			 * context.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		private:
+
+			/**
+			 * @brief A tracked texture.
+			 */
+			struct Entry
+			{
+				std::weak_ptr<Texture_> texture{};
+				// The frame the texture was evicted in
+				std::uint64_t evicted_frame{};
+				// Whether or not the texture is being streamed back in
+				bool restoring{ false };
+				// Whether or not the mip levels of the texture are streamed
+				bool streamed{ false };
+				// The amount of frames in a row smaller levels than those held were requested
+				std::uint64_t drop_frames{};
+				// The amount of frames in a row the streamed texture was not requested
+				std::uint64_t unrequested_frames{};
+			}; // Entry
+
+			Texture_Residency() = default;
+
+			// Texture_Residency shan't be copyable or moveable
+			Texture_Residency(const Texture_Residency&) = delete;
+			Texture_Residency(Texture_Residency&&) = delete;
+			Texture_Residency& operator=(const Texture_Residency&) = delete;
+			Texture_Residency& operator=(Texture_Residency&&) = delete;
+
+			/**
+			 * @brief Gets the amount of bytes a texture takes up with the levels it holds.
+			 */
+			static std::size_t Get_Resident_Size(const Texture_& texture);
+
+			/**
+			 * @brief Whether or not a texture can be loaded again once evicted.
+			 */
+			static bool Can_Restore(const Texture_& texture);
+
+			/**
+			 * @brief Loads a texture again, streaming it from its image files or loading it
+			 * from its texture container.
+			 *
+			 * @return Whether or not the texture is being streamed.
+			 */
+			static bool Restore(const std::shared_ptr<Texture_>& texture);
+
+			/**
+			 * @brief Replaces the openGL texture of a texture with one holding the given level
+			 * and every level after it, read back from the texture, or only a placeholder if
+			 * the level is s_evicted.
+			 */
+			static void Evict(Texture_& texture, std::size_t first_level);
+
+			/**
+			 * @brief Loads the levels of a texture from the given level from its texture
+			 * container.
+			 */
+			static void Stream_Level(Texture_& texture, std::size_t first_level);
+
+			/**
+			 * @brief Streams in and drops the mip levels requested this frame.
+			 *
+			 * @return The amount of bytes dropped.
+			 */
+			std::size_t Stream_Requests();
+
+			// The tracked textures
+			std::vector<Entry> m_entries{};
+
+			// Guards the requests
+			std::mutex m_request_mutex{};
+			// The smallest level requested this frame of every requested texture
+			std::unordered_map<const Texture_*, std::size_t> m_requests{};
+
+			// The amount of bytes textures may take up
+			std::size_t m_budget{ s_default_budget };
+			// The largest side in texels of the level textures are evicted down to
+			std::int32_t m_evicted_size{ s_default_evicted_size };
+			// The amount of frames a texture has to be unused for to be evicted
+			std::uint64_t m_unused_frames{ s_default_unused_frames };
+			// The amount of bytes of mip levels streamed in per Update
+			std::size_t m_stream_bytes{ s_default_stream_bytes };
+			// The amount of frames smaller levels have to be requested for to be dropped
+			std::uint64_t m_drop_frames{ s_default_drop_frames };
+
+			// The amount of bytes the textures took up after the last Update
+			std::size_t m_resident_bytes{};
+			// The amount of bytes evicted since the first Update
+			std::size_t m_evicted_bytes{};
+			// The amount of bytes of mip levels streamed in since the first Update
+			std::size_t m_streamed_bytes{};
+
+		}; // Texture_Residency
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_TEXTURE_RESIDENCY_HPP
@@ -0,0 +1,711 @@
+// Vendor
+#include "vendor/glad/KHR_Debug_openGL_3_3/include/glad/glad.h"
+
+// Standard
+#include <algorithm>
+#include <cstring>
+
+// Tilia
+#include "Texture_Streamer.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
+#include TILIA_OPENGL_3_3_UTILS_INCLUDE
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+#include TILIA_JOB_SYSTEM_INCLUDE
+#include TILIA_MIP_GENERATOR_INCLUDE
+
+/**
+ * Gets the target of a face when uploading to it.
+ */
+static GLenum Get_Face_Target(tilia::enums::Texture_Type_ texture_type, std::size_t face)
+{
+	if (texture_type == tilia::enums::Texture_Type_::Cube_Map)
+		return *tilia::enums::Cube_Map_Sides::Positive_X + static_cast<GLenum>(face);
+	return *texture_type;
+}
+
+void tilia::gfx::Texture_Streamer::Init(std::size_t buffer_count, std::size_t buffer_size,
+	std::size_t frame_budget)
+{
+
+	Terminate();
+
+	m_buffer_size = buffer_size;
+	m_frame_budget = frame_budget;
+	m_uploaded_bytes = 0;
+
+	try
+	{
+		m_buffers.resize(buffer_count);
+		for (auto& buffer : m_buffers)
+		{
+			GL_CALL(glGenBuffers(1, &buffer.ID));
+			GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.ID));
+			GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(buffer_size),
+				nullptr, GL_STREAM_DRAW));
+		}
+		GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to init texture streamer { Buffer count: ", buffer_count,
+			", Buffer size: ", buffer_size, " }" });
+	}
+
+}
+
+void tilia::gfx::Texture_Streamer::Terminate()
+{
+
+	for (auto& request : m_requests)
+		Drop(*request);
+	m_requests.clear();
+
+	for (auto& buffer : m_buffers)
+	{
+		if (buffer.fence)
+		{
+			GL_CALL(glDeleteSync(static_cast<GLsync>(buffer.fence)));
+		}
+		GL_CALL(glDeleteBuffers(1, &buffer.ID));
+	}
+	m_buffers.clear();
+	m_next_buffer = 0;
+
+}
+
+void tilia::gfx::Texture_Streamer::Stream(const std::shared_ptr<Texture_2D_>& texture,
+	const Texture_2D_Def& texture_def, bool generate_mipmaps)
+{
+
+	if (texture_def.file_path.empty())
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Texture_2D_ { ID: ", texture->Get_ID(), " } can not be streamed without a path" } };
+	}
+
+	const auto color_format{ Texture_::Get_Supported_Format(texture_def.color_format) };
+
+	if (generate_mipmaps && utils::Is_Compressed_Format(*color_format))
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Texture_2D_ { ID: ", texture->Get_ID(),
+			" } can not generate mipmaps of a compressed format { Format: ",
+			*color_format, " }" } };
+	}
+
+	auto request{ std::make_shared<Request>() };
+	request->texture = texture;
+	request->texture_type = enums::Texture_Type_::TwoD;
+	request->faces.resize(1);
+	request->faces[0].file_path = texture_def.file_path;
+	request->faces[0].color_format = color_format;
+	request->filter_min = texture_def.filter_min;
+	request->filter_mag = texture_def.filter_mag;
+	request->wrap_s = texture_def.wrap_s;
+	request->wrap_t = texture_def.wrap_t;
+	request->generate_mipmaps = generate_mipmaps;
+
+	Submit(std::move(request), *texture, texture->Get_Width() > 0);
+
+}
+
+void tilia::gfx::Texture_Streamer::Stream(const std::shared_ptr<Texture_2D_>& texture,
+	const std::string& texture_path, bool generate_mipmaps)
+{
+	Texture_2D_Def texture_def{};
+	texture_def.file_path = texture_path;
+	Stream(texture, texture_def, generate_mipmaps);
+}
+
+void tilia::gfx::Texture_Streamer::Stream(const std::shared_ptr<Cube_Map>& cube_map,
+	bool generate_mipmaps)
+{
+
+	const Cube_Map_Data& cube_map_data{ cube_map->Get_Cube_Map_Data() };
+
+	auto request{ std::make_shared<Request>() };
+	request->texture = cube_map;
+	request->texture_type = enums::Texture_Type_::Cube_Map;
+	request->faces.resize(*enums::Geometry_Features::Cube_Faces);
+	for (std::size_t i{ 0 }; i < request->faces.size(); ++i)
+	{
+		if (cube_map_data.sides[i].file_path.empty())
+		{
+			throw utils::Tilia_Exception{ { TILIA_LOCATION,
+				"Cube map { ID: ", cube_map->Get_ID(), " } can not be streamed without a path",
+				"\n>>> Side: ", utils::Get_Cube_Map_Side_String(
+					*enums::Cube_Map_Sides::Positive_X + static_cast<std::uint32_t>(i)) } };
+		}
+		const auto color_format{
+			Texture_::Get_Supported_Format(cube_map_data.sides[i].color_format) };
+		if (generate_mipmaps && utils::Is_Compressed_Format(*color_format))
+		{
+			throw utils::Tilia_Exception{ { TILIA_LOCATION,
+				"Cube map { ID: ", cube_map->Get_ID(),
+				" } can not generate mipmaps of a compressed format { Format: ",
+				*color_format, " }" } };
+		}
+		request->faces[i].file_path = cube_map_data.sides[i].file_path;
+		request->faces[i].color_format = color_format;
+	}
+	request->filter_min = cube_map_data.filter_min;
+	request->filter_mag = cube_map_data.filter_mag;
+	request->wrap_s = cube_map_data.wrap_s;
+	request->wrap_t = cube_map_data.wrap_t;
+	request->wrap_r = cube_map_data.wrap_r;
+	request->generate_mipmaps = generate_mipmaps;
+
+	Submit(std::move(request), *cube_map, cube_map_data.size > 0);
+
+}
+
+/**
+ * Rows are uploaded from the first decoded request onwards, so that a large image still being
+ * decoded does not hold back those after it. A request is only swapped in once every row of
+ * every face is uploaded, which keeps a half uploaded texture from ever being seen.
+ */
+std::size_t tilia::gfx::Texture_Streamer::Update()
+{
+
+	std::size_t uploaded{};
+
+	auto iter{ m_requests.begin() };
+	while (iter != m_requests.end())
+	{
+
+		Request& request{ **iter };
+
+		const auto texture{ request.texture.lock() };
+		if (!texture)
+		{
+			Drop(request);
+			iter = m_requests.erase(iter);
+			continue;
+		}
+
+		if (!request.decoded.load(std::memory_order_acquire))
+		{
+			++iter;
+			continue;
+		}
+
+		if (!request.error.empty())
+		{
+			const std::string error{ std::move(request.error) };
+			Drop(request);
+			m_requests.erase(iter);
+			throw utils::Tilia_Exception{ { TILIA_LOCATION,
+				"Texture { ID: ", texture->Get_ID(), " } failed to stream",
+				"\n>>> ", error } };
+		}
+
+		if (uploaded >= m_frame_budget && uploaded > 0)
+			break;
+
+		bool whole{ true };
+		try
+		{
+			uploaded += Upload(request, m_frame_budget - std::min(uploaded, m_frame_budget));
+
+			for (const auto& face : request.faces)
+				whole = whole && face.uploaded_rows == face.row_count;
+
+			if (whole)
+				Finish(request, *texture);
+		}
+		catch (utils::Tilia_Exception& t_e)
+		{
+			Drop(request);
+			m_requests.erase(iter);
+			throw t_e.Add_Message({ TILIA_LOCATION,
+				"Texture { ID: ", texture->Get_ID(), " } failed to stream" });
+		}
+
+		// Out of budget or out of free buffers
+		if (!whole)
+			break;
+
+		iter = m_requests.erase(iter);
+
+	}
+
+	m_uploaded_bytes += uploaded;
+
+	return uploaded;
+
+}
+
+bool tilia::gfx::Texture_Streamer::Is_Streaming(const Texture_& texture) const
+{
+	return std::any_of(m_requests.begin(), m_requests.end(),
+		[&texture](const std::shared_ptr<Request>& request)
+		{ return request->texture.lock().get() == &texture; });
+}
+
+std::size_t tilia::gfx::Texture_Streamer::Get_Upload_Rows(std::size_t row_size,
+	std::size_t rows_left, std::size_t budget_left, std::size_t buffer_size)
+{
+	if (row_size == 0)
+		return rows_left;
+	return std::min(rows_left, std::min(budget_left, buffer_size) / row_size);
+}
+
+tilia::enums::Image_Channels tilia::gfx::Texture_Streamer::Get_Image_Channels(
+	enums::Color_Format color_format)
+{
+	switch (color_format)
+	{
+	case enums::Color_Format::Red8:
+	case enums::Color_Format::R16F:
+		return enums::Image_Channels::Grey;
+	case enums::Color_Format::RGB8:
+	case enums::Color_Format::RGB16F:
+		return enums::Image_Channels::RGB;
+	default:
+		return enums::Image_Channels::RGBA;
+	}
+}
+
+tilia::enums::Image_Data_Type tilia::gfx::Texture_Streamer::Get_Image_Data_Type(
+	enums::Color_Format color_format)
+{
+	return (utils::Is_Half_Format(*color_format)) ? enums::Image_Data_Type::Half :
+		enums::Image_Data_Type::Unsigned_Byte;
+}
+
+/**
+ * A texture without data gets a single placeholder texel so that it can be drawn at once. Its
+ * minifying filter is set along with it since the default one needs mipmaps, without which the
+ * texture would be incomplete and sample as black.
+ */
+void tilia::gfx::Texture_Streamer::Submit(std::shared_ptr<Request> request, Texture_& texture,
+	bool has_data)
+{
+
+	const auto earlier{ std::find_if(m_requests.begin(), m_requests.end(),
+		[&texture](const std::shared_ptr<Request>& other)
+		{ return other->texture.lock().get() == &texture; }) };
+	if (earlier != m_requests.end())
+	{
+		Drop(**earlier);
+		m_requests.erase(earlier);
+	}
+
+	if (!has_data)
+	{
+		const auto target{ static_cast<GLenum>(*request->texture_type) };
+		try
+		{
+			texture.Unbind(true);
+			texture.Bind();
+			GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+			GL_CALL(glTexParameteri(target, GL_TEXTURE_MIN_FILTER, *request->filter_min));
+			GL_CALL(glTexParameteri(target, GL_TEXTURE_MAG_FILTER, *request->filter_mag));
+			for (std::size_t i{ 0 }; i < request->faces.size(); ++i)
+			{
+				GL_CALL(glTexImage2D(Get_Face_Target(request->texture_type, i), 0, GL_RGBA8,
+					1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, s_placeholder_texel));
+			}
+			texture.Rebind();
+		}
+		catch (utils::Tilia_Exception& t_e)
+		{
+			texture.Rebind();
+			throw t_e.Add_Message({ TILIA_LOCATION,
+				"Texture { ID: ", texture.Get_ID(), " } failed to get a placeholder" });
+		}
+	}
+
+	m_requests.push_back(request);
+
+	// The job keeps the request alive should it be dropped while decoding
+	auto decode{ [request]() { Decode(*request); } };
+
+	jobs::Job_System& job_system{ jobs::Job_System::Instance() };
+	if (job_system.Can_Run_Jobs())
+		job_system.Run(job_system.Create_Job(std::move(decode)));
+	else
+		decode();
+
+}
+
+void tilia::gfx::Texture_Streamer::Decode(Request& request)
+{
+
+	try
+	{
+		for (auto& face : request.faces)
+		{
+			// Compressed faces are encoded, or read from the encoded images kept on disk
+			if (utils::Is_Compressed_Format(*face.color_format))
+			{
+				face.blocks = Block_Encoder::Instance().Load(face.file_path,
+					Texture_::Get_Block_Format(face.color_format), true);
+				face.width = face.blocks.width;
+				face.height = face.blocks.height;
+				face.row_count = face.blocks.Get_Blocks_Y();
+				continue;
+			}
+
+			face.image.Reload(face.file_path, Get_Image_Channels(face.color_format),
+				Get_Image_Data_Type(face.color_format), true);
+			// Resized down to the max size on the worker, so that less is uploaded
+			Mip_Settings settings{};
+			settings.filter = Texture_::Get_Resize_Filter();
+			face.image = Mip_Generator::Fit(face.image, Texture_::Get_Max_Size(), settings);
+			face.width = face.image.Width();
+			face.height = face.image.Height();
+			face.row_count = static_cast<std::size_t>(face.height);
+			face.data_color_format = utils::Get_Data_Color_Format(*face.image.Channels());
+			if (face.color_format == enums::Color_Format::None)
+				face.color_format = utils::Get_Color_Format(*face.image.Channels());
+		}
+
+		if (request.texture_type == enums::Texture_Type_::Cube_Map)
+		{
+			const Face& first{ request.faces.front() };
+			for (const auto& face : request.faces)
+			{
+				if (face.width != face.height || face.width != first.width)
+				{
+					throw utils::Tilia_Exception{ { TILIA_LOCATION,
+						"Cube map sides have to be square and of the same size",
+						"\n>>> Path: ", face.file_path,
+						"\n>>> Size: ", face.width, "x", face.height } };
+				}
+			}
+		}
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		request.error = t_e.what();
+	}
+
+	request.decoded.store(true, std::memory_order_release);
+
+}
+
+/**
+ * Every chunk of rows is copied into the next buffer of the ring and uploaded from there, so
+ * that the copy is done by the driver while the frame goes on. A buffer is only written to
+ * once the fence placed after its last upload has signaled, and the ring being full ends the
+ * uploads of the frame rather than waiting on it.
+ */
+std::size_t tilia::gfx::Texture_Streamer::Upload(Request& request, std::size_t budget_left)
+{
+
+	const auto target{ static_cast<GLenum>(*request.texture_type) };
+
+	std::size_t uploaded{};
+
+	Texture_::Unbind(request.texture_type, true);
+
+	try
+	{
+
+		if (!request.staging_ID)
+		{
+			GL_CALL(glGenTextures(1, &request.staging_ID));
+			GL_CALL(glBindTexture(target, request.staging_ID));
+
+			GL_CALL(glTexParameteri(target, GL_TEXTURE_MIN_FILTER, *request.filter_min));
+			GL_CALL(glTexParameteri(target, GL_TEXTURE_MAG_FILTER, *request.filter_mag));
+			GL_CALL(glTexParameteri(target, GL_TEXTURE_WRAP_S, *request.wrap_s));
+			GL_CALL(glTexParameteri(target, GL_TEXTURE_WRAP_T, *request.wrap_t));
+			if (request.texture_type == enums::Texture_Type_::Cube_Map)
+			{
+				GL_CALL(glTexParameteri(target, GL_TEXTURE_WRAP_R, *request.wrap_r));
+			}
+
+			for (std::size_t i{ 0 }; i < request.faces.size(); ++i)
+			{
+				const Face& face{ request.faces[i] };
+				if (utils::Is_Compressed_Format(*face.color_format))
+				{
+					GL_CALL(glCompressedTexImage2D(Get_Face_Target(request.texture_type, i), 0,
+						*face.color_format, face.width, face.height, 0,
+						static_cast<GLsizei>(face.blocks.data.size()), nullptr));
+				}
+				else
+				{
+					GL_CALL(glTexImage2D(Get_Face_Target(request.texture_type, i), 0,
+						*face.color_format, face.width, face.height, 0, *face.data_color_format,
+						utils::Get_Color_Format_Type(*face.color_format), nullptr));
+				}
+			}
+		}
+		else
+		{
+			GL_CALL(glBindTexture(target, request.staging_ID));
+		}
+
+		// Rows are packed tightly by the decoder
+		GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+		bool stalled{ false };
+
+		for (std::size_t i{ 0 }; i < request.faces.size() && !stalled; ++i)
+		{
+
+			Face& face{ request.faces[i] };
+
+			// Compressed faces are uploaded a row of blocks at a time
+			const bool compressed{ utils::Is_Compressed_Format(*face.color_format) };
+			const std::size_t row_height{ compressed ?
+				static_cast<std::size_t>(Block_Encoder::s_block_size) : 1 };
+			const std::size_t row_size{ compressed ? face.blocks.Get_Row_Size() :
+				static_cast<std::size_t>(face.width) * *face.image.Channels() *
+				*face.image.Data_Type() };
+			// Read through the const image so that its data is not copied if it is shared
+			const Image& image{ face.image };
+			const GLenum data_type{ utils::Get_Color_Format_Type(*face.color_format) };
+			const std::uint8_t* data{ compressed ? face.blocks.data.data() :
+				image.Get_Data() };
+
+			while (face.uploaded_rows < face.row_count)
+			{
+
+				std::size_t rows{ Get_Upload_Rows(row_size, face.row_count - face.uploaded_rows,
+					budget_left - uploaded, m_buffer_size) };
+
+				// A row larger than the budget or a buffer still has to get through
+				if (rows == 0 && uploaded == 0 && budget_left == m_frame_budget)
+					rows = 1;
+				if (rows == 0)
+				{
+					stalled = true;
+					break;
+				}
+
+				const std::size_t size{ rows * row_size };
+				const std::uint8_t* rows_data{ data + face.uploaded_rows * row_size };
+
+				const auto y_offset{ static_cast<GLint>(face.uploaded_rows * row_height) };
+				// The last row of blocks may hang over the edge of the image
+				const auto rows_height{ static_cast<GLsizei>(std::min(rows * row_height,
+					static_cast<std::size_t>(face.height - y_offset))) };
+				const GLenum face_target{ Get_Face_Target(request.texture_type, i) };
+
+				auto upload_rows{ [&](const void* pixels)
+				{
+					if (compressed)
+					{
+						GL_CALL(glCompressedTexSubImage2D(face_target, 0, 0, y_offset,
+							face.width, rows_height, *face.color_format,
+							static_cast<GLsizei>(size), pixels));
+					}
+					else
+					{
+						GL_CALL(glTexSubImage2D(face_target, 0, 0, y_offset, face.width,
+							rows_height, *face.data_color_format, data_type, pixels));
+					}
+				} };
+
+				if (size <= m_buffer_size && !m_buffers.empty())
+				{
+					Pixel_Buffer& buffer{ m_buffers[m_next_buffer] };
+					if (!Is_Free(buffer))
+					{
+						stalled = true;
+						break;
+					}
+
+					GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.ID));
+					// The fence has signaled so the buffer needs no further syncing
+					GL_CALL(void* mapped{ glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0,
+						static_cast<GLsizeiptr>(size), GL_MAP_WRITE_BIT |
+						GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT) });
+					std::memcpy(mapped, rows_data, size);
+					GL_CALL(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+
+					upload_rows(nullptr);
+					GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+					GL_CALL(buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+					m_next_buffer = (m_next_buffer + 1) % m_buffers.size();
+				}
+				else
+				{
+					upload_rows(rows_data);
+				}
+
+				face.uploaded_rows += rows;
+				uploaded += size;
+
+			}
+
+			if (face.uploaded_rows == face.row_count)
+			{
+				face.image.Free();
+				face.blocks = {};
+			}
+
+		}
+
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		Texture_::Rebind(request.texture_type);
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to upload streamed texture rows { Path: ",
+			request.faces.front().file_path, " }" });
+	}
+
+	Texture_::Rebind(request.texture_type);
+
+	return uploaded;
+
+}
+
+/**
+ * The staging texture takes over the id of the texture, and any stored binding of the old id
+ * is moved along with it so that a later Rebind does not bind a deleted texture.
+ */
+void tilia::gfx::Texture_Streamer::Finish(Request& request, Texture_& texture)
+{
+
+	const auto target{ static_cast<GLenum>(*request.texture_type) };
+
+	if (request.generate_mipmaps)
+	{
+		Texture_::Unbind(request.texture_type, true);
+		try
+		{
+			GL_CALL(glBindTexture(target, request.staging_ID));
+			GL_CALL(glGenerateMipmap(target));
+		}
+		catch (utils::Tilia_Exception& t_e)
+		{
+			Texture_::Rebind(request.texture_type);
+			throw t_e.Add_Message({ TILIA_LOCATION,
+				"Failed to generate mipmaps of streamed texture { Path: ",
+				request.faces.front().file_path, " }" });
+		}
+		Texture_::Rebind(request.texture_type);
+	}
+
+	texture.Replace_ID(request.staging_ID);
+	request.staging_ID = 0;
+	texture.Set_Levels(request.generate_mipmaps ? Mip_Generator::Get_Level_Count(
+		request.faces.front().width, request.faces.front().height) + 1 : 1);
+
+	if (request.texture_type == enums::Texture_Type_::Cube_Map)
+	{
+		Cube_Map_Data& cube_map_data{ static_cast<Cube_Map&>(texture).m_cube_map_data };
+		cube_map_data.size = request.faces.front().width;
+		for (std::size_t i{ 0 }; i < request.faces.size(); ++i)
+		{
+			cube_map_data.sides[i].texture_data.reset();
+			cube_map_data.sides[i].color_format = request.faces[i].color_format;
+			cube_map_data.sides[i].data_color_format = request.faces[i].data_color_format;
+		}
+	}
+	else
+	{
+		Texture_2D_Def& texture_def{ static_cast<Texture_2D_&>(texture).m_texture_def };
+		const Face& face{ request.faces.front() };
+		texture_def.file_path = face.file_path;
+		texture_def.texture_data.reset();
+		texture_def.width = face.width;
+		texture_def.height = face.height;
+		texture_def.color_format = face.color_format;
+		texture_def.load_color_format = face.data_color_format;
+		texture_def.filter_min = request.filter_min;
+		texture_def.filter_mag = request.filter_mag;
+		texture_def.wrap_s = request.wrap_s;
+		texture_def.wrap_t = request.wrap_t;
+	}
+
+}
+
+void tilia::gfx::Texture_Streamer::Drop(Request& request)
+{
+	if (request.staging_ID)
+	{
+		GL_CALL(glDeleteTextures(1, &request.staging_ID));
+		request.staging_ID = 0;
+	}
+}
+
+bool tilia::gfx::Texture_Streamer::Is_Free(Pixel_Buffer& buffer)
+{
+
+	if (!buffer.fence)
+		return true;
+
+	const auto fence{ static_cast<GLsync>(buffer.fence) };
+
+	// Does not wait, a buffer still being read is left for a later frame
+	GL_CALL(const GLenum status{ glClientWaitSync(fence, 0, 0) });
+	if (status == GL_TIMEOUT_EXPIRED)
+		return false;
+	if (status == GL_WAIT_FAILED)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Failed to wait on pixel buffer { ID: ", buffer.ID, " }" } };
+	}
+
+	GL_CALL(glDeleteSync(fence));
+	buffer.fence = nullptr;
+
+	return true;
+
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+void tilia::gfx::Texture_Streamer::Test()
+{
+
+	SECTION("Upload rows")
+	{
+		// Limited by the budget
+		REQUIRE(Get_Upload_Rows(100, 50, 1000, 4096) == 10);
+		// Limited by the buffer
+		REQUIRE(Get_Upload_Rows(100, 50, 4096, 1000) == 10);
+		// Limited by the rows left
+		REQUIRE(Get_Upload_Rows(100, 5, 4096, 4096) == 5);
+		// Only whole rows are uploaded
+		REQUIRE(Get_Upload_Rows(100, 50, 99, 4096) == 0);
+		REQUIRE(Get_Upload_Rows(100, 50, 199, 4096) == 1);
+	}
+
+	SECTION("Image channels")
+	{
+		REQUIRE(Get_Image_Channels(enums::Color_Format::Red8) == enums::Image_Channels::Grey);
+		REQUIRE(Get_Image_Channels(enums::Color_Format::RGB8) == enums::Image_Channels::RGB);
+		REQUIRE(Get_Image_Channels(enums::Color_Format::RGBA8) == enums::Image_Channels::RGBA);
+		REQUIRE(Get_Image_Channels(enums::Color_Format::R16F) == enums::Image_Channels::Grey);
+		REQUIRE(Get_Image_Channels(enums::Color_Format::RGB16F) == enums::Image_Channels::RGB);
+		REQUIRE(Get_Image_Channels(enums::Color_Format::None) == enums::Image_Channels::RGBA);
+		REQUIRE(Get_Image_Data_Type(enums::Color_Format::RGBA8) ==
+			enums::Image_Data_Type::Unsigned_Byte);
+		REQUIRE(Get_Image_Data_Type(enums::Color_Format::R16F) == enums::Image_Data_Type::Half);
+		REQUIRE(Get_Image_Data_Type(enums::Color_Format::RGB16F) == enums::Image_Data_Type::Half);
+		REQUIRE(Get_Image_Data_Type(enums::Color_Format::None) ==
+			enums::Image_Data_Type::Unsigned_Byte);
+	}
+
+	SECTION("Frame budget")
+	{
+		auto& streamer{ Instance() };
+
+		streamer.Set_Frame_Budget(1024);
+		REQUIRE(streamer.Get_Frame_Budget() == 1024);
+		streamer.Set_Frame_Budget(s_default_frame_budget);
+
+		REQUIRE(streamer.Get_Pending_Count() == 0);
+		// Nothing to upload so nothing touches openGL
+		REQUIRE(streamer.Update() == 0);
+	}
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
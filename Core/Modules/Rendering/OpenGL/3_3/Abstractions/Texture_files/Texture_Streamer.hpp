@@ -0,0 +1,298 @@
+/**************************************************************************************************
+ * @file   Texture_Streamer.hpp
+ *
+ * @brief  Streams textures in from disk without stalling the frame. Images are decoded on the
+ *		   workers of the job system and then uploaded a few rows at a time through a ring of
+ *		   pixel buffer objects, where every buffer is guarded by a fence so that it is only
+ *		   written to once the driver is done reading it. No more than a set amount of bytes is
+ *		   uploaded per frame and textures show a placeholder until they are whole.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_TEXTURE_STREAMER_HPP
+#define TILIA_OPENGL_3_3_TEXTURE_STREAMER_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_TEXTURE_2D__INCLUDE
+#include TILIA_OPENGL_3_3_CUBE_MAP_INCLUDE
+#include TILIA_IMAGE_INCLUDE
+#include TILIA_BLOCK_ENCODER_INCLUDE
+
+namespace tilia
+{
+	namespace gfx
+	{
+
+		/**
+		 * @brief Singleton streaming textures. Update has to be called once per frame by the
+		 * thread owning the context, which is where every upload and every swap from placeholder
+		 * to texture happens. A texture which is destroyed while streaming is dropped. Streamed
+		 * textures keep no copy of their data, mipmaps therefore have to be asked for when
+		 * streaming rather than generated afterwards.
+		 */
+		class Texture_Streamer
+		{
+		public:
+
+			// The default amount of pixel buffers in the ring
+			static constexpr std::size_t s_default_buffer_count{ 3 };
+			// The default size of every pixel buffer in bytes
+			static constexpr std::size_t s_default_buffer_size{ 4 * 1024 * 1024 };
+			// The default amount of bytes which may be uploaded per frame
+			static constexpr std::size_t s_default_frame_budget{ 4 * 1024 * 1024 };
+
+			// The texel shown by textures without any data while they are streamed
+			static constexpr std::uint8_t s_placeholder_texel[4]{ 0x80, 0x80, 0x80, 0xFF };
+
+			/**
+			 * @brief First time it is called it will construct an instance of Texture_Streamer.
+			 * A reference to this instance is returned to anywhere in the program.
+			 *
+			 * @return A reference to an instance of Texture_Streamer.
+			 */
+			static Texture_Streamer& Instance()
+			{
+				static Texture_Streamer texture_streamer{};
+				return texture_streamer;
+			}
+
+			/**
+			 * @brief Creates the ring of pixel buffers. Needs a current context.
+			 *
+			 * @param buffer_count - The amount of pixel buffers, more lets more uploads be in
+			 * flight at once.
+			 * @param buffer_size - The size of every pixel buffer in bytes. Rows larger than a
+			 * buffer are uploaded straight from memory.
+			 * @param frame_budget - The amount of bytes which may be uploaded per frame.
+			 */
+			void Init(std::size_t buffer_count = s_default_buffer_count,
+				std::size_t buffer_size = s_default_buffer_size,
+				std::size_t frame_budget = s_default_frame_budget);
+
+			/**
+			 * @brief Drops every texture still streaming and destroys the pixel buffers.
+			 */
+			void Terminate();
+
+			/**
+			 * @brief Streams the image at the file path of the given definition into a texture.
+			 * The formats, filtering and wrapping of the definition are used while its data,
+			 * width and height are ignored. A texture without any data is given a placeholder
+			 * at once, a texture with data keeps it until the new data is whole.
+			 *
+			 * @param texture - The texture to stream into.
+			 * @param texture_def - The definition of the texture.
+			 * @param generate_mipmaps - Whether or not to generate mipmaps once uploaded, which
+			 * block compressed formats can not.
+			 */
+			void Stream(const std::shared_ptr<Texture_2D_>& texture,
+				const Texture_2D_Def& texture_def, bool generate_mipmaps = false);
+
+			/**
+			 * @brief Streams the image at the given path into a texture with the default
+			 * definition.
+			 */
+			void Stream(const std::shared_ptr<Texture_2D_>& texture,
+				const std::string& texture_path, bool generate_mipmaps = false);
+
+			/**
+			 * @brief Streams the images at the paths of the sides of a cube map into it. The
+			 * formats of the sides as well as the filtering and wrapping of the cube map are
+			 * used. Every side has to be square and of the same size. Sides of block
+			 * compressed formats can not have mipmaps generated.
+			 *
+			 * @param cube_map - The cube map to stream into.
+			 * @param generate_mipmaps - Whether or not to generate mipmaps once uploaded.
+			 */
+			void Stream(const std::shared_ptr<Cube_Map>& cube_map,
+				bool generate_mipmaps = false);
+
+			/**
+			 * @brief Uploads the decoded rows of the streaming textures until either the frame
+			 * budget is spent or no pixel buffer is free, and swaps every texture which has
+			 * become whole in for its placeholder. Decoding failures are thrown from here.
+			 *
+			 * @return The amount of bytes uploaded.
+			 */
+			std::size_t Update();
+
+			/**
+			 * @brief Sets the amount of bytes which may be uploaded per frame. Every frame
+			 * uploads at least one row, even if the row is larger than the budget.
+			 */
+			void Set_Frame_Budget(std::size_t frame_budget) { m_frame_budget = frame_budget; }
+			std::size_t Get_Frame_Budget() const { return m_frame_budget; }
+
+			/**
+			 * @brief Gets the amount of textures which are streaming.
+			 */
+			std::size_t Get_Pending_Count() const { return m_requests.size(); }
+
+			/**
+			 * @brief Whether or not the given texture is streaming.
+			 */
+			bool Is_Streaming(const Texture_& texture) const;
+
+			/**
+			 * @brief Gets the amount of bytes uploaded since Init.
+			 */
+			std::size_t Get_Uploaded_Bytes() const { return m_uploaded_bytes; }
+
+			/**
+			 * @brief Gets the amount of whole rows which fit both in the budget left and in a
+			 * pixel buffer.
+			 *
+			 * @param row_size - The size of a row in bytes.
+			 * @param rows_left - The amount of rows left to upload.
+			 * @param budget_left - The amount of bytes left of the frame budget.
+			 * @param buffer_size - The size of a pixel buffer in bytes.
+			 */
+			static std::size_t Get_Upload_Rows(std::size_t row_size, std::size_t rows_left,
+				std::size_t budget_left, std::size_t buffer_size);
+
+			/**
+			 * @brief Gets the channels to decode an image with for a texture of the given
+			 * format.
+			 */
+			static enums::Image_Channels Get_Image_Channels(enums::Color_Format color_format);
+
+			/**
+			 * @brief Gets the data type to decode an image with for a texture of the given
+			 * format, so that half formats keep their range.
+			 */
+			static enums::Image_Data_Type Get_Image_Data_Type(enums::Color_Format color_format);
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Texture_Streamer. Does not stream anything and so does not
+			 * need a context.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		private:
+
+			/**
+			 * @brief A face of a texture being streamed, the only one of a 2D texture.
+			 */
+			struct Face
+			{
+				std::string file_path{};
+				enums::Color_Format color_format{ enums::Color_Format::RGBA8 };
+				enums::Data_Color_Format data_color_format{ enums::Data_Color_Format::None };
+				// Freed once every row has been uploaded
+				Image image{};
+				// Used instead of the image by block compressed formats, freed along with it
+				Block_Image blocks{};
+				std::int32_t width{};
+				std::int32_t height{};
+				// Rows of texels, or rows of blocks for block compressed formats
+				std::size_t row_count{};
+				std::size_t uploaded_rows{};
+			}; // Face
+
+			/**
+			 * @brief A texture being streamed. Shared with the job decoding it.
+			 */
+			struct Request
+			{
+				std::weak_ptr<Texture_> texture{};
+				enums::Texture_Type_ texture_type{ enums::Texture_Type_::TwoD };
+				std::vector<Face> faces{};
+				enums::Filter_Mode filter_min{ enums::Filter_Mode::Point };
+				enums::Filter_Mode filter_mag{ enums::Filter_Mode::Point };
+				enums::Wrap_Mode wrap_s{ enums::Wrap_Mode::Repeat };
+				enums::Wrap_Mode wrap_t{ enums::Wrap_Mode::Repeat };
+				enums::Wrap_Mode wrap_r{ enums::Wrap_Mode::Repeat };
+				bool generate_mipmaps{ false };
+				// The texture the rows are uploaded to, swapped in once whole
+				std::uint32_t staging_ID{};
+				// Set by the decoding job once the faces, or the error, have been written
+				std::atomic<bool> decoded{ false };
+				std::string error{};
+			}; // Request
+
+			/**
+			 * @brief A pixel buffer of the ring.
+			 */
+			struct Pixel_Buffer
+			{
+				std::uint32_t ID{};
+				// The fence of the last upload from the buffer, nullptr if none is in flight
+				void* fence{ nullptr };
+			}; // Pixel_Buffer
+
+			Texture_Streamer() = default;
+
+			// Texture_Streamer shan't be copyable or moveable
+			Texture_Streamer(const Texture_Streamer&) = delete;
+			Texture_Streamer(Texture_Streamer&&) = delete;
+			Texture_Streamer& operator=(const Texture_Streamer&) = delete;
+			Texture_Streamer& operator=(Texture_Streamer&&) = delete;
+
+			/**
+			 * @brief Replaces any earlier request for the same texture and starts decoding.
+			 */
+			void Submit(std::shared_ptr<Request> request, Texture_& texture, bool has_data);
+
+			/**
+			 * @brief Decodes the faces of a request, ran by a worker.
+			 */
+			static void Decode(Request& request);
+
+			/**
+			 * @brief Uploads as many rows of a request as fit.
+			 *
+			 * @return The amount of bytes uploaded.
+			 */
+			std::size_t Upload(Request& request, std::size_t budget_left);
+
+			/**
+			 * @brief Swaps the staging texture of a whole request in for the texture.
+			 */
+			void Finish(Request& request, Texture_& texture);
+
+			/**
+			 * @brief Deletes the staging texture of a dropped request.
+			 */
+			void Drop(Request& request);
+
+			/**
+			 * @brief Whether or not the driver is done reading the given buffer.
+			 */
+			bool Is_Free(Pixel_Buffer& buffer);
+
+			// The textures being streamed, in the order they were asked for
+			std::vector<std::shared_ptr<Request>> m_requests{};
+
+			// The ring of pixel buffers
+			std::vector<Pixel_Buffer> m_buffers{};
+			// The next buffer of the ring to upload from
+			std::size_t m_next_buffer{};
+			// The size of every pixel buffer in bytes
+			std::size_t m_buffer_size{ s_default_buffer_size };
+
+			// The amount of bytes which may be uploaded per frame
+			std::size_t m_frame_budget{ s_default_frame_budget };
+			// The amount of bytes uploaded since Init
+			std::size_t m_uploaded_bytes{};
+
+		}; // Texture_Streamer
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_TEXTURE_STREAMER_HPP
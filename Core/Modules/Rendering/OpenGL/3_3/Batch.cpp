@@ -33,15 +33,34 @@
 #include "Core/Values/Directories.hpp"
 #include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
 #include TILIA_OPENGL_3_3_UTILS_INCLUDE
+#include TILIA_TILIA_EXCEPTION_INCLUDE
 
 #include <iostream>
 
+tilia::gfx::Batch::Limits tilia::gfx::Batch::s_limits{};
+
+/**
+ * Checks that neither limit is 0 and then sets them.
+ */
+void tilia::gfx::Batch::Set_Limits(const Limits& limits)
+{
+	if (!limits.max_vertices || !limits.max_indices)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Batch limits may not be 0 { Max vertices: ", limits.max_vertices, 
+			", Max indices: ", limits.max_indices, " }" } };
+	}
+
+	s_limits = limits;
+}
+
 /**
- * Sets the batch to be compatible with the given mesh_data. Also calls Set_Vertex_Attribs,
- * generates some buffers, and allocates memory for them.
+ * Sets the batch to be compatible with the given mesh_data and generates the vertex array. The
+ * buffers are gotten from the pool on the first upload once the needed size is known.
  */
-tilia::gfx::Batch::Batch(std::weak_ptr<Mesh_Data> mesh_data)
-	: // Sets batch to be compatible
+tilia::gfx::Batch::Batch(std::weak_ptr<Mesh_Data> mesh_data, Buffer_Pool& buffer_pool)
+	: m_buffer_pool	  { buffer_pool },
+	// Sets batch to be compatible
 	m_textures{  },
 	// Todo: remove posibly
 	m_shader		  { *mesh_data.lock()->shader },
@@ -63,37 +82,35 @@ tilia::gfx::Batch::Batch(std::weak_ptr<Mesh_Data> mesh_data)
 
 	m_textures.resize(32);
 
-	// Generates buffers
+	m_variant_mask = m_shader.lock()->Get_Variant_Mask();
+	m_required_mask = m_variant_mask;
+
+	// Generates vertex array
 	GL_CALL(glGenVertexArrays(1, &m_vao));
-	GL_CALL(glGenBuffers(1, &m_vbo));
-	GL_CALL(glGenBuffers(1, &m_ebo));
 
-	GL_CALL(glBindVertexArray(m_vao));
+}
 
-	// Allocates memory for vertex buffer
-	GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
-	GL_CALL(glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(float) * m_vertex_size * 
-		*enums::Batch_Limits::Max_Vertices), nullptr, GL_STATIC_DRAW));
+/**
+ * Gives the buffers back and deletes the vertex array
+ */
+tilia::gfx::Batch::~Batch()
+{
 
-	// Calls Set_Vertex_Attribs to set vertex attributes
-	Set_Vertex_Attribs();
+	Release_Buffers();
 
-	// Allocates memory for element buffer
-	GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo));
-	GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast <GLsizeiptr>(sizeof(uint32_t) * 
-		*enums::Batch_Limits::Max_Indices), nullptr, GL_STATIC_DRAW));
+	GL_CALL(glDeleteVertexArrays(1, &m_vao));
 
 }
 
 /**
- * Deletes openGL buffers
+ * Gives both buffers back to the pool. The vertex array still refers to them but is not drawn
+ * with until Reserve_Buffers has attached new ones.
  */
-tilia::gfx::Batch::~Batch()
+void tilia::gfx::Batch::Release_Buffers()
 {
 
-	GL_CALL(glDeleteVertexArrays(1, &m_vao));
-	GL_CALL(glDeleteBuffers(1, &m_vbo));
-	GL_CALL(glDeleteBuffers(1, &m_ebo));
+	m_buffer_pool.Release(m_vertex_buffer);
+	m_buffer_pool.Release(m_index_buffer);
 
 }
 
@@ -120,12 +137,20 @@ void tilia::gfx::Batch::Reset(std::weak_ptr<Mesh_Data> mesh_data)
 	m_vertex_size	   = mesh_data.lock()->vertex_size;
 	m_vertex_info	   = *mesh_data.lock()->vertex_info;
 
+	// Starts over from the variant of the new mesh, as the batch is reused across frames
+	m_variant_mask	   = m_shader.lock()->Get_Variant_Mask();
+	m_required_mask	   = m_variant_mask;
+
 	// Clears some data
 	Clear();
 
+	// Without a vertex buffer the attributes are set once one is gotten
+	if (!m_vertex_buffer.ID)
+		return;
+
 	GL_CALL(glBindVertexArray(m_vao));
 
-	GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
+	GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer.ID));
 	
 	// Calls Set_Vertex_Attribs to set vertex attributes
 	Set_Vertex_Attribs();
@@ -171,6 +196,24 @@ bool tilia::gfx::Batch::Push_Mesh(std::weak_ptr<Mesh_Data> mesh_data, float dist
 	if (!Check_Mesh(mesh_data))
 		return false;
 
+	// Switches to the variant having the features of every mesh
+	const auto shader{ mesh_data.lock()->shader->lock() };
+	if (shader->Get_ID() != m_shader.lock()->Get_ID())
+	{
+		const auto merged_mask{ m_variant_mask | shader->Get_Variant_Mask() };
+		if (merged_mask != m_variant_mask)
+		{
+			const auto merged{ shader->Get_Variants()->Get(merged_mask) };
+			// Uniforms outside of blocks are not shared by variants, so the merged variant
+			// drawn in place of the mesh's own takes the values set on it
+			if (merged != shader)
+				merged->Copy_Uniforms(*shader);
+			m_shader = merged;
+		}
+		m_variant_mask = merged_mask;
+		m_required_mask &= shader->Get_Variant_Mask();
+	}
+
 	//glBindVertexArray(m_vao);
 
 	const size_t vertex_count{ mesh_data.lock()->vertex_data->size() };
@@ -382,28 +425,155 @@ void tilia::gfx::Batch::Render()
 
 }
 
-void tilia::gfx::Batch::Map_Data() const
+/**
+ * Textures are marked here rather than in Record, which may run for batches sharing a texture
+ * on several threads at once.
+ */
+void tilia::gfx::Batch::Upload()
 {
+	for (size_t i = 0; i < m_texture_count; i++)
+	{
+		m_textures[i].lock()->Mark_Used();
+	}
 
-	GL_CALL(glBindVertexArray(m_vao));
+	Map_Data();
+}
+
+/**
+ * Records the state, texture, vertex array and shader binds as well as the draw in the same order
+ * as Render.
+ */
+void tilia::gfx::Batch::Record(Command_Buffer& command_buffer, std::uint64_t sort_key) const
+{
+
+	command_buffer.Begin_Packet(sort_key);
+
+	// Sets depth mask and functions
+	if (m_depth_func != enums::Test_Func::None) {
+		command_buffer.Set_Depth_Mask(true);
+		command_buffer.Set_Depth_Func(m_depth_func);
+	}
+	else
+	{
+		command_buffer.Set_Depth_Mask(false);
+	}
+
+	// Binds textures
+	for (size_t i = 0; i < m_texture_count; i++) {
+		auto texture{ m_textures[i].lock() };
+		command_buffer.Bind_Texture(static_cast<uint32_t>(i), texture->Get_Type(), 
+			texture->Get_ID());
+	}
 
-	GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
+	// Binds vertex array
+	command_buffer.Bind_Vertex_Array(m_vao);
 
-	GL_CALL(void* vertex_buffer{ glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY) });
+	// Binds shader
+	command_buffer.Bind_Program(m_shader.lock()->Get_ID());
+
+	// Sets polygonmode
+	command_buffer.Set_Polymode(m_polymode);
+
+	if (!m_transparent)
+	{
+		// Sets face culling
+		command_buffer.Set_Cull_Face(m_cull_face);
+
+		// Draws stuff
+		command_buffer.Draw_Elements(m_primitive, static_cast<uint32_t>(m_index_count));
+	}
+	else
+	{
+		command_buffer.Set_Depth_Mask(false);
+		command_buffer.Set_Cull_Face(enums::Face::None);
+
+		// Draws stuff
+		command_buffer.Draw_Elements(m_primitive, static_cast<uint32_t>(m_index_count));
+
+		command_buffer.Set_Depth_Mask(true);
+	}
+
+}
+
+/**
+ * Makes sure the buffers are big enough and then maps only the used part of each, invalidating
+ * the old contents so that the driver does not have to wait on draws still reading them.
+ */
+void tilia::gfx::Batch::Map_Data()
+{
+
+	GL_CALL(glBindVertexArray(m_vao));
+
+	Reserve_Buffers();
 
 	const size_t vertex_byte_count{ m_vertex_count * sizeof(float) };
-	std::copy(m_vertex_data.begin(), m_vertex_data.end(), static_cast<float*>(vertex_buffer));
+	const size_t index_byte_count{ m_index_count * sizeof(uint32_t) };
+
+	if (vertex_byte_count)
+	{
+		GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer.ID));
 
-	GL_CALL(glUnmapBuffer(GL_ARRAY_BUFFER));
+		GL_CALL(void* vertex_buffer{ glMapBufferRange(GL_ARRAY_BUFFER, 0, 
+			static_cast<GLsizeiptr>(vertex_byte_count), 
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT) });
 
-	GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo));
+		std::copy(m_vertex_data.begin(), m_vertex_data.end(), static_cast<float*>(vertex_buffer));
+
+		GL_CALL(glUnmapBuffer(GL_ARRAY_BUFFER));
+	}
+
+	if (index_byte_count)
+	{
+		// Maps the element buffer attached to the bound vertex array
+		GL_CALL(void* index_buffer{ glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, 
+			static_cast<GLsizeiptr>(index_byte_count), 
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT) });
 
-	GL_CALL(void* index_buffer{ glMapBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY) });
+		std::copy(m_index_data.begin(), m_index_data.end(), static_cast<uint32_t*>(index_buffer));
+
+		GL_CALL(glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER));
+	}
+
+}
+
+/**
+ * For each buffer, if the pushed data does not fit then the old buffer is given back and one of
+ * a big enough size class is gotten and attached to the vertex array.
+ */
+void tilia::gfx::Batch::Reserve_Buffers()
+{
 
+	const size_t vertex_byte_count{ m_vertex_count * sizeof(float) };
 	const size_t index_byte_count{ m_index_count * sizeof(uint32_t) };
-	std::copy(m_index_data.begin(), m_index_data.end(), static_cast<uint32_t*>(index_buffer));
 
-	GL_CALL(glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER));
+	try
+	{
+		if (!m_vertex_buffer.ID || m_vertex_buffer.capacity < vertex_byte_count)
+		{
+			m_buffer_pool.Release(m_vertex_buffer);
+			m_vertex_buffer = m_buffer_pool.Acquire(vertex_byte_count);
+
+			GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer.ID));
+
+			// Calls Set_Vertex_Attribs to point the attributes at the new buffer
+			Set_Vertex_Attribs();
+		}
+
+		if (!m_index_buffer.ID || m_index_buffer.capacity < index_byte_count)
+		{
+			m_buffer_pool.Release(m_index_buffer);
+			m_index_buffer = m_buffer_pool.Acquire(index_byte_count);
+
+			// The element buffer binding is stored in the bound vertex array
+			GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer.ID));
+		}
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to reserve batch buffers { Vertex bytes: ", vertex_byte_count, 
+			", Index bytes: ", index_byte_count, " }" });
+	}
 
 }
 
@@ -522,17 +692,19 @@ bool tilia::gfx::Batch::Check_Mesh(std::weak_ptr<Mesh_Data> mesh_data) const
 	std::shared_ptr<Mesh_Data> temp{ mesh_data };
 	// Checks if vertex count is too big
 	if ((m_vertex_count / m_vertex_size) + (temp->vertex_data->size() / temp->vertex_size) > 
-		*enums::Batch_Limits::Max_Vertices)
+		s_limits.max_vertices)
 		return false;
 	// Checks if index count is too big
-	if (m_index_count + temp->indices->size()    > *enums::Batch_Limits::Max_Indices)
+	if (m_index_count + temp->indices->size()    > s_limits.max_indices)
 		return false;
-	// Checks if texture count is too big
-	if (m_texture_count + temp->textures->size() > utils::Get_Max_Textures())
+	// Checks if texture count is too big, leaving the reserved units free
+	const size_t max_textures{ utils::Get_Max_Textures() };
+	if (m_texture_count + temp->textures->size() + s_limits.reserved_textures > max_textures)
 		return false;
 
-	// Checks if shader is same
-	if (m_shader.lock()->Get_ID()      != temp->shader->lock()->Get_ID())
+	// Checks if shader is same, or a variant of it which can be merged
+	if (m_shader.lock()->Get_ID()      != temp->shader->lock()->Get_ID() && 
+		!Check_Variant(*temp->shader->lock()))
 		return false;
 
 	// // Checks if shader data is same
@@ -584,4 +756,67 @@ bool tilia::gfx::Batch::Check_Mesh(std::weak_ptr<Mesh_Data> mesh_data) const
 
 	// Everything is same returns true
 	return true;
-}
\ No newline at end of file
+}
+
+/**
+ * Both have to be variants of the same shader, and the features the merged variant adds to
+ * any mesh have to fit the merge budget.
+ */
+bool tilia::gfx::Batch::Check_Variant(const Shader& shader) const
+{
+	const auto variants{ m_shader.lock()->Get_Variants() };
+	if (variants == nullptr || variants != shader.Get_Variants())
+		return false;
+
+	const auto mask{ shader.Get_Variant_Mask() };
+	return variants->Can_Merge(m_required_mask & mask, m_variant_mask | mask);
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+void tilia::gfx::Batch::Test()
+{
+
+	// Needs the context the tests are run with to compile the variants
+	Shader_Variants variants{};
+	variants.Init("res/shaders/texture.vert", "res/shaders/texture.frag", "",
+		{ { "LIT", 1.0f }, { "FOG", 1.0f } });
+	variants.Set_Merge_Budget(2.0f);
+
+	const auto lit{ variants.Get(variants.Get_Mask({ "LIT" })) };
+	const auto fog{ variants.Get(variants.Get_Mask({ "FOG" })) };
+	const auto merged{ variants.Get(variants.Get_Mask({ "LIT", "FOG" })) };
+
+	Mesh<4> lit_mesh{}, fog_mesh{};
+	lit_mesh.Set_Shader()(lit);
+	fog_mesh.Set_Shader()(fog);
+
+	Buffer_Pool buffer_pool{};
+	Batch batch{ lit_mesh.Get_Mesh_Data(), buffer_pool };
+
+	// First frame merges both meshes into the variant having both features
+	REQUIRE(batch.Push_Mesh(lit_mesh.Get_Mesh_Data()));
+	REQUIRE(batch.Push_Mesh(fog_mesh.Get_Mesh_Data()));
+	REQUIRE(batch.Get_Shader_ID() == merged->Get_ID());
+
+	// Reused the next frame, the batch starts over from the variant of the first mesh
+	batch.Reset(fog_mesh.Get_Mesh_Data());
+	REQUIRE(batch.Get_Shader_ID() == fog->Get_ID());
+	REQUIRE(batch.Push_Mesh(fog_mesh.Get_Mesh_Data()));
+	REQUIRE(batch.Get_Shader_ID() == fog->Get_ID());
+	REQUIRE(batch.Push_Mesh(lit_mesh.Get_Mesh_Data()));
+	REQUIRE(batch.Get_Shader_ID() == merged->Get_ID());
+
+	// Without a budget the next frame may not merge at all
+	variants.Set_Merge_Budget(0.0f);
+	batch.Reset(lit_mesh.Get_Mesh_Data());
+	REQUIRE(batch.Push_Mesh(lit_mesh.Get_Mesh_Data()));
+	REQUIRE_FALSE(batch.Push_Mesh(fog_mesh.Get_Mesh_Data()));
+	REQUIRE(batch.Get_Shader_ID() == lit->Get_ID());
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
@@ -29,6 +29,9 @@
 // Headers
 #include "Core/Values/Directories.hpp"
 #include TILIA_OPENGL_3_3_MESH_INCLUDE
+#include TILIA_OPENGL_3_3_COMMAND_BUFFER_INCLUDE
+#include TILIA_OPENGL_3_3_BUFFER_POOL_INCLUDE
+#include TILIA_OPENGL_3_3_SHADER_VARIANTS_INCLUDE
 #define TILIA_INCLUDE_OPENGL_3_3_CONSTANTS
 #include TILIA_CONSTANTS_INCLUDE
 
@@ -45,16 +48,41 @@ namespace tilia {
 		class Batch {
 		public:
 
+			/**
+			 * @brief The max amount of vertices and indices a single batch may hold.
+			 */
+			struct Limits
+			{
+				size_t max_vertices{ *enums::Batch_Limits::Max_Vertices };
+				size_t max_indices{ *enums::Batch_Limits::Max_Indices };
+				// The texture units at the top of the range which batches leave for textures
+				// bound by others, such as those of Light_Manager
+				size_t reserved_textures{ 0 };
+			}; // Limits
+
+			/**
+			 * @brief Sets the limits used by every batch when checking if a mesh fits. Batches
+			 * already holding more than the new limits keep their meshes until they are cleared.
+			 *
+			 * @param limits - The new limits, neither the vertex nor the index limit may be 0.
+			 */
+			static void Set_Limits(const Limits& limits);
+			/**
+			 * @brief Gets the limits used by every batch.
+			 */
+			static const Limits& Get_Limits() { return s_limits; }
+
 			/**
 			 * @brief Sets all information specific to the given mesh_data to all such memebers in
 			 * this Batch
 			 * 
 			 * @param mesh_data - The mesh_data to set members to its data
+			 * @param buffer_pool - The pool to get the openGL buffers from, must outlive the batch
 			 */
-			Batch(std::weak_ptr<Mesh_Data> mesh_data);
+			Batch(std::weak_ptr<Mesh_Data> mesh_data, Buffer_Pool& buffer_pool);
 
 			/**
-			 * @brief Deletes all of the openGL buffers
+			 * @brief Gives the openGL buffers back to the pool and deletes the vertex array
 			 */
 			~Batch();
 
@@ -104,6 +132,19 @@ namespace tilia {
 			 */
 			inline size_t Get_Index_Count() const { return m_index_count; }
 
+			/**
+			 * @brief Gets whether or not the batch holds transparent meshes
+			 *
+			 * @return True if the batch is transparent
+			 */
+			inline bool Get_Transparent() const { return m_transparent; }
+			/**
+			 * @brief Gets the id of the shader the batch is drawn with
+			 *
+			 * @return The id of the shader
+			 */
+			inline uint32_t Get_Shader_ID() const { return m_shader.lock()->Get_ID(); }
+
 			/**
 			 * @brief Resets m_texture_count, m_vertex_count, and m_index_count to 0.
 			 */
@@ -115,16 +156,55 @@ namespace tilia {
 			 */
 			void Render();
 
+			/**
+			 * @brief Writes the pushed vertex and index data to the openGL buffers, first getting
+			 * bigger buffers from the pool if needed. Has to be called on the thread owning the
+			 * context before the recorded commands of the batch are replayed. The textures of
+			 * the batch count as used in the current frame, as replaying does not bind them
+			 * through Texture_::Bind.
+			 */
+			void Upload();
+
+			/**
+			 * @brief Gives the openGL buffers back to the pool. New ones are gotten on the next
+			 * upload.
+			 */
+			void Release_Buffers();
+
+			/**
+			 * @brief Records the same state changes and draw as Render into the given command
+			 * buffer instead of calling openGL. Can be called from any thread.
+			 * 
+			 * @param command_buffer - The buffer to record into.
+			 * @param sort_key - The sort key of the recorded packet.
+			 */
+			void Record(Command_Buffer& command_buffer, std::uint64_t sort_key) const;
+
 			// Todo: Placeholder
 			glm::vec3 m_camera_pos{};
 
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Batch. Needs a context to compile shader variants with.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
 		private:
 
 			// Buffers
 
-			uint32_t m_vao{}, // The id to the openGL vertex array object
-				m_vbo{}, // The id to the openGL vertex buffer object
-				m_ebo{}; // The id to the openGL element buffer object
+			// The limits used by every batch
+			static Limits s_limits;
+
+			uint32_t m_vao{}; // The id to the openGL vertex array object
+
+			Buffer_Pool& m_buffer_pool; // The pool the buffers are gotten from
+
+			Buffer_Pool::Pooled_Buffer m_vertex_buffer{}, // The openGL vertex buffer
+				m_index_buffer{}; // The openGL element buffer
 
 			std::vector<std::weak_ptr<Texture_>> m_textures{}; // The texture to be bound and used
 			// to draw with
@@ -147,6 +227,10 @@ namespace tilia {
 
 			std::weak_ptr<Shader> m_shader{}; // The shader of the batch
 
+			// The features of the variant drawn with, which every mesh can be drawn with, and
+			// the features every mesh needs, if the shader is a variant
+			Shader_Variants::Feature_Mask m_variant_mask{}, m_required_mask{};
+
 			//std::weak_ptr<Shader_Data> m_shader_data{}; // The shader data
 
 			size_t m_vertex_size{}; // The size of the vertices bound to the openGL objects
@@ -154,8 +238,8 @@ namespace tilia {
 			Vertex_Info m_vertex_info{}; // The info for each vertex in the vertex buffer
 
 			size_t m_vertex_count{}, // The amount of vertices * m_vertex_size currently in the
-				//vertex buffer(m_vbo)
-				m_index_count{};  // The amount of indices currently in the element buffer(m_ebo)
+				//vertex buffer
+				m_index_count{};  // The amount of indices currently in the element buffer
 
 			// Rendering settings
 
@@ -186,7 +270,13 @@ namespace tilia {
 			void Generate_Texture_Offsets(std::weak_ptr<tilia::gfx::Mesh_Data> mesh_data, 
 				std::unordered_map<uint32_t, uint32_t>& offsets);
 
-			void Map_Data() const;
+			void Map_Data();
+
+			/**
+			 * @brief Makes sure the buffers can hold the pushed data, swapping them for buffers
+			 * of a bigger size class if not. Expects the vertex array to be bound.
+			 */
+			void Reserve_Buffers();
 
 			void Sort_Mesh_Data(const std::vector<float>& vertex_data, 
 				std::vector<uint32_t>& index_data, const uint32_t& start, const uint32_t& end);
@@ -206,6 +296,16 @@ namespace tilia {
 			 */
 			bool Check_Mesh(std::weak_ptr<Mesh_Data> mesh_data) const;
 
+			/**
+			 * @brief Checks if a mesh drawn with a different variant of the shader of the Batch
+			 * can be drawn with a variant having the features of both.
+			 *
+			 * @param shader - The shader of the mesh
+			 *
+			 * @return True if the variant having the features of both fits the merge budget
+			 */
+			bool Check_Variant(const Shader& shader) const;
+
 		};
 
 	}
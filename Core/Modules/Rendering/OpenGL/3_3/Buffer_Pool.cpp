@@ -0,0 +1,155 @@
+// Vendor
+#include "vendor/glad/KHR_Debug_openGL_3_3/include/glad/glad.h"
+
+// Tilia
+#include "Buffer_Pool.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+
+std::size_t tilia::gfx::Buffer_Pool::Get_Size_Class(std::size_t byte_size)
+{
+	std::size_t size_class{ s_min_size_class };
+	while (size_class < byte_size)
+		size_class <<= 1;
+	return size_class;
+}
+
+tilia::gfx::Buffer_Pool::Pooled_Buffer tilia::gfx::Buffer_Pool::Acquire(std::size_t byte_size)
+{
+	const std::size_t size_class{ Get_Size_Class(byte_size) };
+
+	auto free_buffers{ m_free_buffers.find(size_class) };
+	if (free_buffers != m_free_buffers.end() && !free_buffers->second.empty())
+	{
+		const Free_Buffer free_buffer{ free_buffers->second.back() };
+		free_buffers->second.pop_back();
+		m_free_bytes -= size_class;
+		return { free_buffer.ID, size_class };
+	}
+
+	Pooled_Buffer buffer{ 0, size_class };
+
+	try
+	{
+		// Allocates through the copy write target so that no vertex array state is touched
+		GL_CALL(glGenBuffers(1, &buffer.ID));
+		GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, buffer.ID));
+		GL_CALL(glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(size_class), nullptr,
+			GL_DYNAMIC_DRAW));
+		GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to allocate pooled buffer { Size: ", size_class, " }" });
+	}
+
+	m_allocated_bytes += size_class;
+
+	return buffer;
+}
+
+void tilia::gfx::Buffer_Pool::Release(Pooled_Buffer& buffer)
+{
+	if (buffer.ID == 0)
+		return;
+
+	m_free_buffers[buffer.capacity].push_back({ buffer.ID, m_frame });
+	m_free_bytes += buffer.capacity;
+
+	buffer = {};
+}
+
+void tilia::gfx::Buffer_Pool::Trim(std::uint64_t max_idle_frames)
+{
+	for (auto& [size_class, free_buffers] : m_free_buffers)
+	{
+		// Buffers are released in frame order so the oldest ones are first
+		std::size_t trim_count{ 0 };
+		while (trim_count < free_buffers.size() &&
+			m_frame - free_buffers[trim_count].released_frame >= max_idle_frames)
+		{
+			GL_CALL(glDeleteBuffers(1, &free_buffers[trim_count].ID));
+			++trim_count;
+		}
+
+		free_buffers.erase(free_buffers.begin(), free_buffers.begin() + trim_count);
+
+		m_allocated_bytes -= trim_count * size_class;
+		m_free_bytes -= trim_count * size_class;
+	}
+}
+
+tilia::gfx::Buffer_Pool::~Buffer_Pool()
+{
+	try
+	{
+		Clear();
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to delete pooled buffers" });
+
+		// Possibly forward e to someplace else and then throw
+	}
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+void tilia::gfx::Buffer_Pool::Test()
+{
+
+	// Test size classes are powers of two with a lower bound
+
+	REQUIRE(Get_Size_Class(0) == s_min_size_class);
+	REQUIRE(Get_Size_Class(1) == s_min_size_class);
+	REQUIRE(Get_Size_Class(s_min_size_class) == s_min_size_class);
+	REQUIRE(Get_Size_Class(s_min_size_class + 1) == s_min_size_class * 2);
+	REQUIRE(Get_Size_Class(100000) == 131072);
+	REQUIRE(Get_Size_Class(131072) == 131072);
+
+	// Test releasing and reusing without touching openGL
+
+	Buffer_Pool buffer_pool{};
+
+	Pooled_Buffer buffer{ 7, 8192 };
+	buffer_pool.Release(buffer);
+
+	REQUIRE(buffer.ID == 0);
+	REQUIRE(buffer.capacity == 0);
+	REQUIRE(buffer_pool.Get_Free_Bytes() == 8192);
+
+	// Releasing an empty buffer does nothing
+
+	buffer_pool.Release(buffer);
+
+	REQUIRE(buffer_pool.Get_Free_Bytes() == 8192);
+
+	buffer = buffer_pool.Acquire(5000);
+
+	REQUIRE(buffer.ID == 7);
+	REQUIRE(buffer.capacity == 8192);
+	REQUIRE(buffer_pool.Get_Free_Bytes() == 0);
+
+	// Test trimming keeps buffers which have not been idle long enough
+
+	buffer_pool.Release(buffer);
+	buffer_pool.Next_Frame();
+	buffer_pool.Trim(2);
+
+	REQUIRE(buffer_pool.Get_Free_Bytes() == 8192);
+
+	// Reset to default without deleting the made up buffer
+
+	buffer = buffer_pool.Acquire(8192);
+
+	REQUIRE(buffer.ID == 7);
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
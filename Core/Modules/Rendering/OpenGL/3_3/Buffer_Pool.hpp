@@ -0,0 +1,148 @@
+/**************************************************************************************************
+ * @file   Buffer_Pool.hpp
+ *
+ * @brief  Holds a pool of openGL buffers sorted into power of two size classes. Buffers which
+ *		   are given back are reused by later requests of the same size class and are deleted
+ *		   once they have gone unused for long enough.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_BUFFER_POOL_HPP
+#define TILIA_OPENGL_3_3_BUFFER_POOL_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_CONSTANTS_INCLUDE
+
+namespace tilia
+{
+	namespace gfx
+	{
+
+		/**
+		 * @brief A pool of openGL buffers. Is not thread safe and has to be used on the thread
+		 * owning the context.
+		 */
+		class Buffer_Pool
+		{
+		public:
+
+			/**
+			 * @brief A buffer handed out by the pool.
+			 */
+			struct Pooled_Buffer
+			{
+				// The id of the openGL buffer, 0 if no buffer is held
+				std::uint32_t ID{ 0 };
+				// The size of the openGL buffer in bytes
+				std::size_t capacity{ 0 };
+			}; // Pooled_Buffer
+
+			// The smallest size class in bytes
+			static constexpr std::size_t s_min_size_class{ 4096 };
+
+			/**
+			 * @brief Gets the size class which the given size in bytes falls into. This is the
+			 * smallest power of two which is not smaller than the size or s_min_size_class.
+			 */
+			static std::size_t Get_Size_Class(std::size_t byte_size);
+
+			/**
+			 * @brief Gets a buffer which can hold at least the given amount of bytes. Reuses a
+			 * free buffer of the same size class if there is one.
+			 */
+			Pooled_Buffer Acquire(std::size_t byte_size);
+
+			/**
+			 * @brief Gives the buffer back to the pool. The given buffer is reset.
+			 */
+			void Release(Pooled_Buffer& buffer);
+
+			/**
+			 * @brief Advances the frame counter which decides how long free buffers have been
+			 * unused.
+			 */
+			void Next_Frame() { ++m_frame; }
+
+			/**
+			 * @brief Deletes the free buffers which have been unused for more than the given
+			 * amount of frames.
+			 */
+			void Trim(std::uint64_t max_idle_frames);
+
+			/**
+			 * @brief Deletes all of the free buffers.
+			 */
+			void Clear() { Trim(0); }
+
+			/**
+			 * @brief Gets the total size in bytes of every buffer created by the pool which has
+			 * not been deleted.
+			 */
+			std::size_t Get_Allocated_Bytes() const { return m_allocated_bytes; }
+			/**
+			 * @brief Gets the total size in bytes of the free buffers.
+			 */
+			std::size_t Get_Free_Bytes() const { return m_free_bytes; }
+
+			/**
+			 * @brief Deletes all of the free buffers. Buffers still held elsewhere have to be
+			 * given back before the pool is destroyed.
+			 */
+			~Buffer_Pool();
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Buffer_Pool.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		private:
+
+			/**
+			 * @brief A buffer waiting to be reused.
+			 */
+			struct Free_Buffer
+			{
+				std::uint32_t ID{ 0 };
+				std::uint64_t released_frame{ 0 };
+			}; // Free_Buffer
+
+			// The free buffers of every size class, keyed by the size class
+			std::map<std::size_t, std::vector<Free_Buffer>> m_free_buffers{};
+			// The current frame
+			std::uint64_t m_frame{ 0 };
+			// The total size of all buffers created and not yet deleted
+			std::size_t m_allocated_bytes{ 0 };
+			// The total size of the free buffers
+			std::size_t m_free_bytes{ 0 };
+
+		public:
+
+			Buffer_Pool() = default;
+
+			// Buffer_Pool shan't be copyable or moveable
+
+			Buffer_Pool(const Buffer_Pool& other) = delete;
+			Buffer_Pool(Buffer_Pool&& other) = delete;
+
+			Buffer_Pool& operator=(const Buffer_Pool& other) = delete;
+			Buffer_Pool& operator=(Buffer_Pool&& other) = delete;
+
+		}; // Buffer_Pool
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_BUFFER_POOL_HPP
@@ -0,0 +1,209 @@
+// Vendor
+#include "vendor/glad/KHR_Debug_openGL_3_3/include/glad/glad.h"
+
+// Standard
+#include <algorithm>
+#include <iterator>
+
+// Tilia
+#include "Command_Buffer.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
+#include TILIA_OPENGL_3_3_SHADER_INCLUDE
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+
+tilia::gfx::Command_Buffer::Command_Buffer(std::size_t command_capacity,
+	std::size_t packet_capacity)
+{
+	m_commands.reserve(command_capacity);
+	m_packets.reserve(packet_capacity);
+}
+
+void tilia::gfx::Command_Buffer::Begin_Packet(std::uint64_t sort_key)
+{
+	const auto command_count{ static_cast<std::uint32_t>(m_commands.size()) };
+	m_packets.push_back({ sort_key, command_count, command_count });
+}
+
+void tilia::gfx::Command_Queue::Add(const Command_Buffer& buffer)
+{
+	const Render_Command* commands{ buffer.m_commands.data() };
+
+	for (const auto& packet : buffer.m_packets)
+	{
+		m_packets.push_back({ packet.sort_key, static_cast<std::uint32_t>(m_packets.size()),
+			commands + packet.begin, commands + packet.end });
+	}
+}
+
+void tilia::gfx::Command_Queue::Merge()
+{
+	std::sort(m_packets.begin(), m_packets.end(), [](const Packet_Ref& lhs, const Packet_Ref& rhs)
+		{
+			if (lhs.sort_key != rhs.sort_key)
+				return lhs.sort_key < rhs.sort_key;
+			return lhs.order < rhs.order;
+		});
+}
+
+void tilia::gfx::Command_Queue::Submit()
+{
+	Merge();
+
+	// Other code may have changed the bound state since the last submit
+	m_bound_program = 0;
+	m_bound_vertex_array = 0;
+	m_active_slot = static_cast<std::uint32_t>(-1);
+	std::fill(std::begin(m_bound_textures), std::end(m_bound_textures), 0);
+
+	try
+	{
+		for (const auto& packet : m_packets)
+		{
+			for (const Render_Command* command{ packet.begin }; command != packet.end; ++command)
+				Replay(*command);
+		}
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to replay ", m_packets.size(), " command packets" });
+	}
+}
+
+void tilia::gfx::Command_Queue::Replay(const Render_Command& command)
+{
+	const std::uint32_t* arguments{ command.arguments };
+
+	switch (command.type)
+	{
+	case enums::Render_Command_Type::Bind_Program:
+		if (m_bound_program != arguments[0])
+		{
+			// Goes through Shader so that its bound id stays correct for uniform setting
+			Shader::Bind(arguments[0]);
+			m_bound_program = arguments[0];
+		}
+		break;
+	case enums::Render_Command_Type::Bind_Vertex_Array:
+		if (m_bound_vertex_array != arguments[0])
+		{
+			GL_CALL(glBindVertexArray(arguments[0]));
+			m_bound_vertex_array = arguments[0];
+		}
+		break;
+	case enums::Render_Command_Type::Set_Depth_Mask:
+		GL_CALL(glDepthMask(arguments[0] ? GL_TRUE : GL_FALSE));
+		break;
+	case enums::Render_Command_Type::Set_Depth_Func:
+		GL_CALL(glDepthFunc(arguments[0]));
+		break;
+	case enums::Render_Command_Type::Set_Cull_Face:
+		if (arguments[0] != *enums::Face::None)
+		{
+			GL_CALL(glEnable(GL_CULL_FACE));
+			GL_CALL(glCullFace(arguments[0]));
+		}
+		else
+		{
+			GL_CALL(glDisable(GL_CULL_FACE));
+		}
+		break;
+	case enums::Render_Command_Type::Set_Polymode:
+		GL_CALL(glPolygonMode(GL_FRONT_AND_BACK, arguments[0]));
+		break;
+	case enums::Render_Command_Type::Bind_Texture:
+		if (arguments[0] >= std::size(m_bound_textures) ||
+			m_bound_textures[arguments[0]] != arguments[2])
+		{
+			if (m_active_slot != arguments[0])
+			{
+				GL_CALL(glActiveTexture(GL_TEXTURE0 + arguments[0]));
+				m_active_slot = arguments[0];
+			}
+			GL_CALL(glBindTexture(arguments[1], arguments[2]));
+			if (arguments[0] < std::size(m_bound_textures))
+				m_bound_textures[arguments[0]] = arguments[2];
+		}
+		break;
+	case enums::Render_Command_Type::Draw_Elements:
+		GL_CALL(glDrawElements(arguments[0], static_cast<GLsizei>(arguments[1]), GL_UNSIGNED_INT,
+			reinterpret_cast<const void*>(static_cast<std::uintptr_t>(arguments[2]) *
+				sizeof(std::uint32_t))));
+		break;
+	default:
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Render command type ", *command.type, " is undefined" } };
+	}
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+void tilia::gfx::Command_Buffer::Test()
+{
+
+	// Test recording is grouped into packets
+
+	Command_Buffer buffer_0{};
+
+	buffer_0.Begin_Packet(2);
+	buffer_0.Bind_Program(5);
+	buffer_0.Draw_Elements(enums::Primitive::Triangles, 6);
+
+	buffer_0.Begin_Packet(0);
+	buffer_0.Bind_Texture(3, enums::Texture_Type_::TwoD, 7);
+	buffer_0.Set_Cull_Face(enums::Face::Back);
+	buffer_0.Draw_Elements(enums::Primitive::Lines, 2, 4);
+
+	REQUIRE(sizeof(Render_Command) == 16);
+	REQUIRE(buffer_0.Get_Commands().size() == 5);
+	REQUIRE(buffer_0.Get_Packets().size() == 2);
+	REQUIRE(buffer_0.Get_Packets()[0].begin == 0);
+	REQUIRE(buffer_0.Get_Packets()[0].end == 2);
+	REQUIRE(buffer_0.Get_Packets()[1].begin == 2);
+	REQUIRE(buffer_0.Get_Packets()[1].end == 5);
+
+	const Render_Command& texture_command{ buffer_0.Get_Commands()[2] };
+
+	REQUIRE(texture_command.type == enums::Render_Command_Type::Bind_Texture);
+	REQUIRE(texture_command.arguments[0] == 3);
+	REQUIRE(texture_command.arguments[1] == *enums::Texture_Type_::TwoD);
+	REQUIRE(texture_command.arguments[2] == 7);
+
+	// Test merging orders by sort key and then by the order the packets were added
+
+	Command_Buffer buffer_1{};
+
+	buffer_1.Begin_Packet(1);
+	buffer_1.Bind_Vertex_Array(9);
+	buffer_1.Begin_Packet(2);
+	buffer_1.Bind_Vertex_Array(10);
+
+	Command_Queue queue{};
+	queue.Add(buffer_0);
+	queue.Add(buffer_1);
+	queue.Merge();
+
+	REQUIRE(queue.m_packets.size() == 4);
+	REQUIRE(queue.m_packets[0].sort_key == 0);
+	REQUIRE(queue.m_packets[1].sort_key == 1);
+	REQUIRE(queue.m_packets[2].sort_key == 2);
+	REQUIRE(queue.m_packets[2].begin->arguments[0] == 5);
+	REQUIRE(queue.m_packets[3].sort_key == 2);
+	REQUIRE(queue.m_packets[3].begin->arguments[0] == 10);
+
+	// Test clearing keeps the storage
+
+	const auto capacity{ buffer_0.m_commands.capacity() };
+	buffer_0.Clear();
+
+	REQUIRE(buffer_0.Get_Commands().empty());
+	REQUIRE(buffer_0.Get_Packets().empty());
+	REQUIRE(buffer_0.m_commands.capacity() == capacity);
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
@@ -0,0 +1,224 @@
+/**************************************************************************************************
+ * @file   Command_Buffer.hpp
+ *
+ * @brief  Holds a compact buffer of recorded render commands and a queue which merges buffers
+ *		   recorded on different threads by sort key and replays them on the thread owning the
+ *		   context.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_COMMAND_BUFFER_HPP
+#define TILIA_OPENGL_3_3_COMMAND_BUFFER_HPP
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_CONSTANTS_INCLUDE
+#include TILIA_CONSTANTS_INCLUDE
+
+namespace tilia
+{
+	namespace enums
+	{
+		// The different commands which can be recorded into a command buffer.
+		enum class Render_Command_Type : std::uint32_t
+		{
+			// Binds a shader program. Arguments: program id.
+			Bind_Program	  = 0x0000,
+			// Binds a vertex array. Arguments: vertex array id.
+			Bind_Vertex_Array = 0x0001,
+			// Enables or disables writing to the depth buffer. Arguments: bool.
+			Set_Depth_Mask	  = 0x0002,
+			// Sets the depth function. Arguments: Test_Func.
+			Set_Depth_Func	  = 0x0003,
+			// Sets the face to cull, None disables culling. Arguments: Face.
+			Set_Cull_Face	  = 0x0004,
+			// Sets the polygon mode for both faces. Arguments: Polymode.
+			Set_Polymode	  = 0x0005,
+			// Binds a texture to a slot. Arguments: slot, Texture_Type_, texture id.
+			Bind_Texture	  = 0x0006,
+			// Draws unsigned int elements. Arguments: Primitive, count, offset in indices.
+			Draw_Elements	  = 0x0007
+		}; // Render_Command_Type
+	} // enums
+
+	namespace gfx
+	{
+
+		/**
+		 * @brief A single recorded command. Is a plain 16 byte value so that recording never
+		 * does more than write into already reserved memory.
+		 */
+		struct Render_Command
+		{
+			enums::Render_Command_Type type{};
+			std::uint32_t arguments[3]{};
+		}; // Render_Command
+
+		/**
+		 * @brief A buffer of render commands grouped into packets which each have a sort key.
+		 * Only touches the CPU side so it can be recorded on any thread, one thread per buffer.
+		 * Storage is kept when cleared so recording is allocation free once warmed up.
+		 */
+		class Command_Buffer
+		{
+		public:
+
+			/**
+			 * @brief A range of commands which are replayed together, ordered by the sort key.
+			 */
+			struct Packet
+			{
+				std::uint64_t sort_key{};
+				std::uint32_t begin{};
+				std::uint32_t end{};
+			}; // Packet
+
+			/**
+			 * @brief Reserves space for the given number of commands and packets.
+			 */
+			Command_Buffer(std::size_t command_capacity = 1024, std::size_t packet_capacity = 128);
+
+			/**
+			 * @brief Starts a new packet, all commands recorded until the next call belong to
+			 * it.
+			 */
+			void Begin_Packet(std::uint64_t sort_key);
+
+			void Bind_Program(std::uint32_t program_id)
+			{ Push(enums::Render_Command_Type::Bind_Program, program_id); }
+			void Bind_Vertex_Array(std::uint32_t vertex_array_id)
+			{ Push(enums::Render_Command_Type::Bind_Vertex_Array, vertex_array_id); }
+			void Set_Depth_Mask(bool depth_mask)
+			{ Push(enums::Render_Command_Type::Set_Depth_Mask, depth_mask); }
+			void Set_Depth_Func(enums::Test_Func depth_func)
+			{ Push(enums::Render_Command_Type::Set_Depth_Func, *depth_func); }
+			void Set_Cull_Face(enums::Face cull_face)
+			{ Push(enums::Render_Command_Type::Set_Cull_Face, *cull_face); }
+			void Set_Polymode(enums::Polymode polymode)
+			{ Push(enums::Render_Command_Type::Set_Polymode, *polymode); }
+			void Bind_Texture(std::uint32_t slot, enums::Texture_Type_ texture_type,
+				std::uint32_t texture_id)
+			{ Push(enums::Render_Command_Type::Bind_Texture, slot, *texture_type, texture_id); }
+			/**
+			 * @param offset - The offset into the bound element buffer in amount of indices.
+			 */
+			void Draw_Elements(enums::Primitive primitive, std::uint32_t count,
+				std::uint32_t offset = 0)
+			{ Push(enums::Render_Command_Type::Draw_Elements, *primitive, count, offset); }
+
+			/**
+			 * @brief Removes all recorded commands and packets while keeping their storage.
+			 */
+			void Clear()
+			{
+				m_commands.clear();
+				m_packets.clear();
+			}
+
+			/**
+			 * @brief Gets the recorded commands.
+			 */
+			const std::vector<Render_Command>& Get_Commands() const { return m_commands; }
+			/**
+			 * @brief Gets the recorded packets.
+			 */
+			const std::vector<Packet>& Get_Packets() const { return m_packets; }
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Command_Buffer and Command_Queue.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		private:
+
+			void Push(enums::Render_Command_Type type, std::uint32_t argument_0 = 0,
+				std::uint32_t argument_1 = 0, std::uint32_t argument_2 = 0)
+			{
+				if (m_packets.empty())
+					Begin_Packet(0);
+				m_commands.push_back({ type, { argument_0, argument_1, argument_2 } });
+				m_packets.back().end = static_cast<std::uint32_t>(m_commands.size());
+			}
+
+			// The recorded commands
+			std::vector<Render_Command> m_commands{};
+			// The recorded packets
+			std::vector<Packet> m_packets{};
+
+			friend class Command_Queue;
+
+		}; // Command_Buffer
+
+		/**
+		 * @brief Merges the packets of many command buffers by their sort keys and replays them.
+		 * Packets with equal keys keep the order of the buffers and then of their recording.
+		 */
+		class Command_Queue
+		{
+		public:
+
+			/**
+			 * @brief Adds the packets of the given buffer. The buffer must outlive the next call
+			 * to Submit.
+			 */
+			void Add(const Command_Buffer& buffer);
+
+			/**
+			 * @brief Sorts the added packets by their sort keys.
+			 */
+			void Merge();
+
+			/**
+			 * @brief Merges and then replays every added packet. Must be called on the thread
+			 * owning the context. Redundant program, vertex array and texture binds are skipped.
+			 */
+			void Submit();
+
+			/**
+			 * @brief Removes all of the added buffers while keeping the storage.
+			 */
+			void Clear() { m_packets.clear(); }
+
+		private:
+
+			/**
+			 * @brief A packet along with the buffer it was recorded into.
+			 */
+			struct Packet_Ref
+			{
+				std::uint64_t sort_key{};
+				std::uint32_t order{};
+				const Render_Command* begin{};
+				const Render_Command* end{};
+			}; // Packet_Ref
+
+			void Replay(const Render_Command& command);
+
+			// The packets of all added buffers
+			std::vector<Packet_Ref> m_packets{};
+
+			// The state bound by the replay, used to skip redundant binds
+			std::uint32_t m_bound_program{};
+			std::uint32_t m_bound_vertex_array{};
+			std::uint32_t m_active_slot{};
+			std::uint32_t m_bound_textures[32]{};
+
+			friend class Command_Buffer;
+
+		}; // Command_Queue
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_COMMAND_BUFFER_HPP
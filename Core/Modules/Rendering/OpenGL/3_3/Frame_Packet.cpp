@@ -0,0 +1,145 @@
+// Standard
+#include <algorithm>
+
+// Tilia
+#include "Frame_Packet.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+
+void tilia::gfx::Frame_Mesh::Copy(const Mesh_Data& source)
+{
+	vertex_data.assign(source.vertex_data->begin(), source.vertex_data->end());
+	indices.assign(source.indices->begin(), source.indices->end());
+	shader_ref = source.shader->lock();
+	shader = shader_ref;
+	transparent = *source.transparent;
+	primitive = *source.primitive;
+	polymode = *source.polymode;
+	cull_face = *source.cull_face;
+	depth_func = *source.depth_func;
+	color_mask = (source.color_mask != nullptr) ? *source.color_mask : glm::bvec4{ true };
+	stencil_masks = *source.stencil_masks;
+	stencil_funcs = *source.stencil_funcs;
+	compare_s_values = *source.compare_s_values;
+	compare_s_masks = *source.compare_s_masks;
+	for (std::size_t i{ 0 }; i < 3; ++i)
+		stencil_actions[i] = source.stencil_actions[i];
+	vertex_pos_start = *source.vertex_pos_start;
+	vertex_pos_end = *source.vertex_pos_end;
+	texture_offset = *source.texture_offset;
+	texture_refs.clear();
+	textures.clear();
+	for (const auto& texture : *source.textures)
+	{
+		texture_refs.push_back(texture.lock());
+		textures.push_back(texture_refs.back());
+	}
+	vertex_info = *source.vertex_info;
+
+	mesh_data->vertex_size = source.vertex_size;
+	mesh_data->vertex_data = &vertex_data;
+	mesh_data->indices = &indices;
+	mesh_data->shader = &shader;
+	mesh_data->transparent = &transparent;
+	mesh_data->primitive = &primitive;
+	mesh_data->polymode = &polymode;
+	mesh_data->cull_face = &cull_face;
+	mesh_data->depth_func = &depth_func;
+	mesh_data->color_mask = &color_mask;
+	mesh_data->stencil_masks = &stencil_masks;
+	mesh_data->stencil_funcs = &stencil_funcs;
+	mesh_data->compare_s_values = &compare_s_values;
+	mesh_data->compare_s_masks = &compare_s_masks;
+	mesh_data->stencil_actions = stencil_actions;
+	mesh_data->vertex_pos_start = &vertex_pos_start;
+	mesh_data->vertex_pos_end = &vertex_pos_end;
+	mesh_data->texture_offset = &texture_offset;
+	mesh_data->textures = &textures;
+	mesh_data->vertex_info = &vertex_info;
+}
+
+void tilia::gfx::Frame_Packet::Clear(std::uint64_t frame_index)
+{
+	m_frame_index = frame_index;
+	m_meshes.clear();
+	m_uniforms.clear();
+	lights.clear();
+
+	// The copies are kept for their storage, but not the shaders and textures they held
+	for (std::size_t i{ 0 }; i < m_mesh_count; ++i)
+	{
+		m_frame_meshes[i]->shader_ref.reset();
+		m_frame_meshes[i]->texture_refs.clear();
+	}
+	m_mesh_count = 0;
+}
+
+void tilia::gfx::Frame_Packet::Add_Mesh(const Mesh_Data& mesh_data)
+{
+	if (m_mesh_count == m_frame_meshes.size())
+		m_frame_meshes.push_back(std::make_unique<Frame_Mesh>());
+
+	Frame_Mesh& frame_mesh{ *m_frame_meshes[m_mesh_count] };
+	++m_mesh_count;
+
+	frame_mesh.Copy(mesh_data);
+	m_meshes.push_back(frame_mesh.mesh_data);
+}
+
+void tilia::gfx::Frame_Packet::Uniform(std::shared_ptr<Shader> shader,
+	Shader::Uniform_Handle handle, std::initializer_list<float> values)
+{
+	if (values.size() > 16)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Too many values for a frame uniform { Count: ", values.size(), " }" } };
+	}
+
+	Frame_Uniform& uniform{ Add_Uniform(std::move(shader), handle) };
+	std::copy(values.begin(), values.end(), uniform.floats.begin());
+	uniform.size_x = values.size();
+}
+
+void tilia::gfx::Frame_Packet::Uniform(std::shared_ptr<Shader> shader,
+	Shader::Uniform_Handle handle, std::initializer_list<std::int32_t> values)
+{
+	if (values.size() > 4)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Too many values for a frame uniform { Count: ", values.size(), " }" } };
+	}
+
+	Frame_Uniform& uniform{ Add_Uniform(std::move(shader), handle) };
+	std::copy(values.begin(), values.end(), uniform.ints.begin());
+	uniform.size_x = values.size();
+	uniform.is_int = true;
+}
+
+void tilia::gfx::Frame_Packet::Set_Uniforms() const
+{
+	for (const auto& uniform : m_uniforms)
+	{
+		if (uniform.is_int)
+			uniform.shader->Uniform(uniform.handle, uniform.ints.data(), uniform.size_x);
+		else if (uniform.size_y == 0)
+			uniform.shader->Uniform(uniform.handle, uniform.floats.data(), uniform.size_x);
+		else
+			uniform.shader->Uniform(uniform.handle, uniform.floats.data(), uniform.size_x,
+				uniform.size_y);
+	}
+}
+
+tilia::gfx::Frame_Uniform& tilia::gfx::Frame_Packet::Add_Uniform(std::shared_ptr<Shader> shader,
+	Shader::Uniform_Handle handle)
+{
+	if (shader == nullptr)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Frame uniform needs a shader" } };
+	}
+
+	Frame_Uniform& uniform{ m_uniforms.emplace_back() };
+	uniform.shader = std::move(shader);
+	uniform.handle = handle;
+	return uniform;
+}
@@ -0,0 +1,213 @@
+/**************************************************************************************************
+ * @file   Frame_Packet.hpp
+ *
+ * @brief  Holds the immutable snapshot of a frame which the game thread builds and the render
+ *		   thread consumes. The snapshot owns copies of everything it needs so the game thread can
+ *		   keep changing its meshes while the frame is being submitted.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_FRAME_PACKET_HPP
+#define TILIA_OPENGL_3_3_FRAME_PACKET_HPP
+
+// Vendor
+#include "vendor/glm/include/glm/glm.hpp"
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+#include <initializer_list>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_MESH_INCLUDE
+#include TILIA_OPENGL_3_3_LIGHT_MANAGER_INCLUDE
+
+namespace tilia
+{
+	namespace gfx
+	{
+
+		/**
+		 * @brief A copy of the data of a mesh at the time the frame packet was built. Holds a
+		 * Mesh_Data which points into the copy so it can be batched like any other mesh.
+		 */
+		struct Frame_Mesh
+		{
+			std::vector<float> vertex_data{};
+			std::vector<uint32_t> indices{};
+			// Held until the packet is cleared, so the shader and textures drawn are the ones
+			// the mesh had when the packet was built, however the mesh changes afterwards
+			std::shared_ptr<Shader> shader_ref{};
+			std::vector<std::shared_ptr<Texture_>> texture_refs{};
+			// Made from the held references, is what the batches are given
+			std::weak_ptr<Shader> shader{};
+			bool transparent{};
+			enums::Primitive primitive{};
+			enums::Polymode polymode{};
+			enums::Face cull_face{};
+			enums::Test_Func depth_func{};
+			glm::bvec4 color_mask{ true };
+			std::pair<uint8_t, uint8_t> stencil_masks{};
+			std::pair<enums::Test_Func, enums::Test_Func> stencil_funcs{};
+			std::pair<uint8_t, uint8_t> compare_s_values{};
+			std::pair<uint8_t, uint8_t> compare_s_masks{};
+			std::pair<enums::Test_Action, enums::Test_Action> stencil_actions[3]{};
+			uint32_t vertex_pos_start{};
+			uint32_t vertex_pos_end{};
+			int32_t texture_offset{};
+			std::vector<std::weak_ptr<Texture_>> textures{};
+			Vertex_Info vertex_info{};
+
+			// Points into the members above, is what the batches are given
+			std::shared_ptr<Mesh_Data> mesh_data{ std::make_shared<Mesh_Data>() };
+
+			/**
+			 * @brief Copies the data pointed to by the given mesh data. Reuses the capacity of
+			 * the vertex and index vectors from previous frames.
+			 */
+			void Copy(const Mesh_Data& source);
+
+			Frame_Mesh() = default;
+
+			// Frame_Mesh shan't be copyable or moveable since mesh_data points into it
+
+			Frame_Mesh(const Frame_Mesh& other) = delete;
+			Frame_Mesh(Frame_Mesh&& other) = delete;
+
+			Frame_Mesh& operator=(const Frame_Mesh& other) = delete;
+			Frame_Mesh& operator=(Frame_Mesh&& other) = delete;
+
+		}; // Frame_Mesh
+
+		/**
+		 * @brief The value of a uniform captured when the frame packet was built, set on the
+		 * render thread before the meshes of the packet are drawn.
+		 */
+		struct Frame_Uniform
+		{
+			// The shader the uniform is set on, held until the packet is cleared
+			std::shared_ptr<Shader> shader{};
+			Shader::Uniform_Handle handle{};
+			// The values, up to a 4x4 matrix
+			std::array<float, 16> floats{};
+			std::array<std::int32_t, 4> ints{};
+			// The amount of values, or of columns for matrices
+			std::size_t size_x{};
+			// The amount of rows for matrices, 0 for scalars and vectors
+			std::size_t size_y{};
+			// Whether the values are in ints rather than floats
+			bool is_int{ false };
+		}; // Frame_Uniform
+
+		/**
+		 * @brief Everything needed to submit a frame. Is built by the game thread, then handed to
+		 * the render thread which may only read from it.
+		 */
+		class Frame_Packet
+		{
+		public:
+
+			/**
+			 * @brief Removes the meshes and uniforms of the previous frame while keeping their
+			 * storage, letting go of the shaders and textures they held.
+			 *
+			 * @param frame_index - The index of the frame the packet will be built for.
+			 */
+			void Clear(std::uint64_t frame_index);
+
+			/**
+			 * @brief Copies the given mesh data into the packet.
+			 */
+			void Add_Mesh(const Mesh_Data& mesh_data);
+
+			/**
+			 * @brief Gets the mesh data of the copied meshes, in the order they were added.
+			 */
+			const std::vector<std::weak_ptr<Mesh_Data>>& Get_Meshes() const { return m_meshes; }
+
+			/**
+			 * @brief Captures the value of a uniform of the given shader, to be set by
+			 * Set_Uniforms on the render thread.
+			 */
+			void Uniform(std::shared_ptr<Shader> shader, Shader::Uniform_Handle handle,
+				std::initializer_list<float> values);
+			void Uniform(std::shared_ptr<Shader> shader, Shader::Uniform_Handle handle,
+				std::initializer_list<std::int32_t> values);
+
+			template<glm::length_t size, glm::qualifier Q>
+			void Uniform(std::shared_ptr<Shader> shader, Shader::Uniform_Handle handle,
+				const glm::vec<size, float, Q>& v)
+			{
+				Frame_Uniform& uniform{ Add_Uniform(std::move(shader), handle) };
+				for (glm::length_t i{ 0 }; i < size; ++i)
+					uniform.floats[i] = v[i];
+				uniform.size_x = size;
+			}
+
+			template<glm::length_t size_x, glm::length_t size_y, glm::qualifier Q>
+			void Uniform(std::shared_ptr<Shader> shader, Shader::Uniform_Handle handle,
+				const glm::mat<size_x, size_y, float, Q>& m)
+			{
+				Frame_Uniform& uniform{ Add_Uniform(std::move(shader), handle) };
+				const float* values{ glm::value_ptr(m) };
+				std::copy(values, values + size_x * size_y, uniform.floats.begin());
+				uniform.size_x = size_x;
+				uniform.size_y = size_y;
+			}
+
+			/**
+			 * @brief Sets the captured uniforms on their shaders, in the order they were
+			 * captured. Should be called on the thread which owns the context.
+			 */
+			void Set_Uniforms() const;
+
+			/**
+			 * @brief Gets the captured uniforms, in the order they were captured.
+			 */
+			const std::vector<Frame_Uniform>& Get_Uniforms() const { return m_uniforms; }
+
+			/**
+			 * @brief Gets the index of the frame the packet was built for.
+			 */
+			std::uint64_t Get_Frame_Index() const { return m_frame_index; }
+
+			// The camera of the frame
+			glm::vec3 camera_pos{};
+			glm::mat4 view{ 1.0f };
+			glm::mat4 projection{ 1.0f };
+
+			// The size of the framebuffer drawn to
+			glm::ivec2 viewport_size{};
+
+			// The point lights of the frame
+			std::vector<Point_Light> lights{};
+
+		private:
+
+			// The index of the frame the packet was built for
+			std::uint64_t m_frame_index{ 0 };
+			// The copies of the meshes, kept between frames to reuse their storage
+			std::vector<std::unique_ptr<Frame_Mesh>> m_frame_meshes{};
+			// The number of frame meshes in use
+			std::size_t m_mesh_count{ 0 };
+			// The mesh data of the frame meshes in use
+			std::vector<std::weak_ptr<Mesh_Data>> m_meshes{};
+			// The captured uniforms
+			std::vector<Frame_Uniform> m_uniforms{};
+
+			Frame_Uniform& Add_Uniform(std::shared_ptr<Shader> shader,
+				Shader::Uniform_Handle handle);
+
+		}; // Frame_Packet
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_FRAME_PACKET_HPP
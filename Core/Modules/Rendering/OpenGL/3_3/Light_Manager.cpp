@@ -0,0 +1,589 @@
+// Vendor
+#include "vendor/glad/KHR_Debug_openGL_3_3/include/glad/glad.h"
+
+// Standard
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Tilia
+#include "Light_Manager.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
+#include TILIA_OPENGL_3_3_SHADER_INCLUDE
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+#include TILIA_JOB_SYSTEM_INCLUDE
+
+#if TILIA_SSE2 == 1
+// Standard
+#include <emmintrin.h>
+#endif // TILIA_SSE2 == 1
+
+void tilia::gfx::Light_Manager::Init(const Cluster_Grid& grid, std::uint32_t bind_point)
+{
+
+	try
+	{
+		Set_Grid(grid);
+
+		m_parameters.Init(static_cast<std::int32_t>(bind_point));
+
+		m_light_data_buffer.Init(enums::Buffer_Type::Texture_Buffer);
+		m_light_grid_buffer.Init(enums::Buffer_Type::Texture_Buffer);
+		m_light_index_buffer.Init(enums::Buffer_Type::Texture_Buffer);
+
+		// Gives every buffer storage so that the textures are complete before the first upload
+		const glm::uvec4 empty{ 0 };
+		m_light_data_buffer.Allocate(sizeof(empty), enums::Buffer_Access_Type::Draw,
+			enums::Buffer_Access_Frequency::Stream, &empty);
+		m_light_grid_buffer.Allocate(sizeof(empty), enums::Buffer_Access_Type::Draw,
+			enums::Buffer_Access_Frequency::Stream, &empty);
+		m_light_index_buffer.Allocate(sizeof(empty), enums::Buffer_Access_Type::Draw,
+			enums::Buffer_Access_Frequency::Stream, &empty);
+
+		GL_CALL(glGenTextures(1, &m_light_data_texture));
+		GL_CALL(glGenTextures(1, &m_light_grid_texture));
+		GL_CALL(glGenTextures(1, &m_light_index_texture));
+
+		GL_CALL(glBindTexture(GL_TEXTURE_BUFFER, m_light_data_texture));
+		GL_CALL(glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_light_data_buffer.Get_ID()));
+		GL_CALL(glBindTexture(GL_TEXTURE_BUFFER, m_light_grid_texture));
+		GL_CALL(glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, m_light_grid_buffer.Get_ID()));
+		GL_CALL(glBindTexture(GL_TEXTURE_BUFFER, m_light_index_texture));
+		GL_CALL(glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, m_light_index_buffer.Get_ID()));
+		GL_CALL(glBindTexture(GL_TEXTURE_BUFFER, 0));
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to init light manager { Grid: ", grid.x, ", ", grid.y, ", ", grid.z, " }" });
+	}
+
+}
+
+void tilia::gfx::Light_Manager::Terminate()
+{
+
+	GL_CALL(glDeleteTextures(1, &m_light_data_texture));
+	GL_CALL(glDeleteTextures(1, &m_light_grid_texture));
+	GL_CALL(glDeleteTextures(1, &m_light_index_texture));
+
+	m_light_data_texture = 0;
+	m_light_grid_texture = 0;
+	m_light_index_texture = 0;
+
+	m_light_data_buffer.Terminate();
+	m_light_grid_buffer.Terminate();
+	m_light_index_buffer.Terminate();
+
+	m_parameters.Terminate();
+
+}
+
+void tilia::gfx::Light_Manager::Set_Grid(const Cluster_Grid& grid)
+{
+
+	if (!grid.x || !grid.y || !grid.z)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Cluster grid may not have a size of 0 { Grid: ", grid.x, ", ", grid.y, ", ", grid.z,
+			" }" } };
+	}
+
+	m_grid = grid;
+
+	const std::size_t cluster_count{ static_cast<std::size_t>(grid.x) * grid.y * grid.z };
+
+	for (auto* bounds : { &m_cluster_min_x, &m_cluster_min_y, &m_cluster_min_z,
+		&m_cluster_max_x, &m_cluster_max_y, &m_cluster_max_z })
+		bounds->assign(cluster_count, 0.0f);
+
+	m_cluster_counts.assign(cluster_count, 0);
+	m_cluster_lights.assign(cluster_count * s_max_lights_per_cluster, 0);
+	m_light_grid.assign(cluster_count * 2, 0);
+
+	// Forces the bounds to be recalculated
+	m_bounds_projection = glm::mat4{ 0.0f };
+
+}
+
+/**
+ * Slices are spaced exponentially in depth so that clusters keep roughly the same proportions at
+ * every distance. Since the same formula is used by the shaders to find the slice of a fragment,
+ * only the scale and bias are handed to them.
+ */
+void tilia::gfx::Light_Manager::Calculate_Cluster_Bounds(const glm::mat4& projection,
+	float near_plane, float far_plane)
+{
+
+	const float depth_ratio{ far_plane / near_plane };
+	const float log_ratio{ std::log(depth_ratio) };
+
+	m_slice_scale = static_cast<float>(m_grid.z) / log_ratio;
+	m_slice_bias = -static_cast<float>(m_grid.z) * std::log(near_plane) / log_ratio;
+
+	for (std::uint32_t z = 0; z < m_grid.z; ++z)
+	{
+		const float depths[2]{
+			near_plane * std::pow(depth_ratio, static_cast<float>(z) / m_grid.z),
+			near_plane * std::pow(depth_ratio, static_cast<float>(z + 1) / m_grid.z) };
+
+		for (std::uint32_t y = 0; y < m_grid.y; ++y)
+		{
+			const float ndc_y[2]{
+				-1.0f + 2.0f * static_cast<float>(y) / m_grid.y,
+				-1.0f + 2.0f * static_cast<float>(y + 1) / m_grid.y };
+
+			for (std::uint32_t x = 0; x < m_grid.x; ++x)
+			{
+				const float ndc_x[2]{
+					-1.0f + 2.0f * static_cast<float>(x) / m_grid.x,
+					-1.0f + 2.0f * static_cast<float>(x + 1) / m_grid.x };
+
+				glm::vec2 min{ std::numeric_limits<float>::max() };
+				glm::vec2 max{ std::numeric_limits<float>::lowest() };
+
+				// Unprojects the corners of the tile at both depths of the slice
+				for (const float depth : depths)
+				{
+					for (std::size_t i = 0; i < 2; ++i)
+					{
+						const glm::vec2 corner{
+							depth * (ndc_x[i] + projection[2][0]) / projection[0][0],
+							depth * (ndc_y[i] + projection[2][1]) / projection[1][1] };
+						min = glm::min(min, corner);
+						max = glm::max(max, corner);
+					}
+				}
+
+				const std::size_t cluster{ Get_Cluster_Index(x, y, z) };
+
+				m_cluster_min_x[cluster] = min.x;
+				m_cluster_min_y[cluster] = min.y;
+				m_cluster_min_z[cluster] = -depths[1];
+				m_cluster_max_x[cluster] = max.x;
+				m_cluster_max_y[cluster] = max.y;
+				m_cluster_max_z[cluster] = -depths[0];
+			}
+		}
+	}
+
+	m_bounds_projection = projection;
+	m_bounds_near = near_plane;
+	m_bounds_far = far_plane;
+
+}
+
+/**
+ * The depth range of the light gives the slices. The projected x and y of a point in view space
+ * only depend on the point's x or y and depth and change monotonically with both, so projecting
+ * the corners of the light's bounding box at its nearest and furthest depth gives the tiles.
+ */
+tilia::gfx::Light_Manager::Light_Bounds tilia::gfx::Light_Manager::Calculate_Light_Bounds(
+	const Point_Light& light, const glm::mat4& view, const glm::mat4& projection) const
+{
+
+	Light_Bounds bounds{};
+	bounds.view_position = glm::vec3{ view * glm::vec4{ light.position, 1.0f } };
+	bounds.radius = light.radius;
+
+	const float depth{ -bounds.view_position.z };
+
+	if (light.radius <= 0.0f || depth + light.radius < m_bounds_near ||
+		depth - light.radius > m_bounds_far)
+		return bounds;
+
+	const float min_depth{ std::max(depth - light.radius, m_bounds_near) };
+	const float max_depth{ std::min(depth + light.radius, m_bounds_far) };
+
+	auto get_slice{ [this](float slice_depth)
+	{
+		const float slice{ std::floor(std::log(slice_depth) * m_slice_scale + m_slice_bias) };
+		return static_cast<std::uint32_t>(std::clamp(slice, 0.0f,
+			static_cast<float>(m_grid.z - 1)));
+	} };
+
+	bounds.min[2] = get_slice(min_depth);
+	bounds.max[2] = get_slice(max_depth);
+
+	const std::uint32_t tile_counts[2]{ m_grid.x, m_grid.y };
+
+	for (glm::length_t axis = 0; axis < 2; ++axis)
+	{
+		float min_ndc{ std::numeric_limits<float>::max() };
+		float max_ndc{ std::numeric_limits<float>::lowest() };
+
+		for (const float corner_depth : { min_depth, max_depth })
+		{
+			for (const float offset : { -light.radius, light.radius })
+			{
+				const float ndc{ projection[axis][axis] *
+					(bounds.view_position[axis] + offset) / corner_depth - projection[2][axis] };
+				min_ndc = std::min(min_ndc, ndc);
+				max_ndc = std::max(max_ndc, ndc);
+			}
+		}
+
+		if (max_ndc < -1.0f || min_ndc > 1.0f)
+			return bounds;
+
+		const float tile_count{ static_cast<float>(tile_counts[axis]) };
+		bounds.min[axis] = static_cast<std::uint32_t>(std::clamp(
+			std::floor((min_ndc + 1.0f) * 0.5f * tile_count), 0.0f, tile_count - 1.0f));
+		bounds.max[axis] = static_cast<std::uint32_t>(std::clamp(
+			std::floor((max_ndc + 1.0f) * 0.5f * tile_count), 0.0f, tile_count - 1.0f));
+	}
+
+	bounds.visible = true;
+
+	return bounds;
+
+}
+
+void tilia::gfx::Light_Manager::Cull(const glm::mat4& view, const glm::mat4& projection,
+	float near_plane, float far_plane, std::uint32_t viewport_width,
+	std::uint32_t viewport_height)
+{
+
+	if (near_plane <= 0.0f || far_plane <= near_plane)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Failed to cull lights due to invalid depth range { Near: ", near_plane,
+			", Far: ", far_plane, " }" } };
+	}
+
+	if (projection != m_bounds_projection || near_plane != m_bounds_near ||
+		far_plane != m_bounds_far)
+		Calculate_Cluster_Bounds(projection, near_plane, far_plane);
+
+	const std::size_t light_count{ m_lights.size() };
+
+	m_light_bounds.resize(light_count);
+	m_light_data.resize(light_count * 2);
+
+	auto prepare_lights{ [this, &view, &projection](std::size_t begin, std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			const Point_Light& light{ m_lights[i] };
+			m_light_bounds[i] = Calculate_Light_Bounds(light, view, projection);
+			m_light_data[i * 2] = glm::vec4{ light.position, light.radius };
+			m_light_data[i * 2 + 1] = glm::vec4{ light.color, light.intensity };
+		}
+	} };
+
+	auto bin_slices{ [this](std::size_t begin, std::size_t end)
+	{
+		Bin_Slices(static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(end));
+	} };
+
+	jobs::Job_System& job_system{ jobs::Job_System::Instance() };
+
+	if (job_system.Can_Run_Jobs())
+	{
+		job_system.Parallel_For(0, light_count, 256, prepare_lights);
+		// Every slice only writes to its own clusters so slices can be binned in parallel
+		job_system.Parallel_For(0, m_grid.z, 1, bin_slices);
+	}
+	else
+	{
+		prepare_lights(0, light_count);
+		bin_slices(0, m_grid.z);
+	}
+
+	Compact();
+
+	m_grid_parameters = { m_grid.x, m_grid.y, m_grid.z, static_cast<std::uint32_t>(light_count) };
+	m_depth_parameters = { m_slice_scale, m_slice_bias, near_plane, far_plane };
+	m_tile_parameters = {
+		static_cast<float>(m_grid.x) / static_cast<float>(std::max(viewport_width, 1u)),
+		static_cast<float>(m_grid.y) / static_cast<float>(std::max(viewport_height, 1u)),
+		0.0f, 0.0f };
+
+}
+
+/**
+ * Every light overlapping a slice is tested against the clusters of its tile range in that
+ * slice. The tiles of a row lie next to each other in memory so the sphere against box test is
+ * done four clusters at a time when SSE2 is available.
+ */
+void tilia::gfx::Light_Manager::Bin_Slices(std::uint32_t begin, std::uint32_t end)
+{
+
+	const std::size_t slice_size{ static_cast<std::size_t>(m_grid.x) * m_grid.y };
+
+	std::fill(m_cluster_counts.begin() + begin * slice_size,
+		m_cluster_counts.begin() + end * slice_size, 0);
+
+	auto add_light{ [this](std::size_t cluster, std::uint32_t light_index)
+	{
+		std::uint32_t& count{ m_cluster_counts[cluster] };
+		if (count < s_max_lights_per_cluster)
+			m_cluster_lights[cluster * s_max_lights_per_cluster + count++] = light_index;
+	} };
+
+	auto overlaps{ [this](std::size_t cluster, const glm::vec3& center, float radius_squared)
+	{
+		const float dx{ std::max({ m_cluster_min_x[cluster] - center.x,
+			center.x - m_cluster_max_x[cluster], 0.0f }) };
+		const float dy{ std::max({ m_cluster_min_y[cluster] - center.y,
+			center.y - m_cluster_max_y[cluster], 0.0f }) };
+		const float dz{ std::max({ m_cluster_min_z[cluster] - center.z,
+			center.z - m_cluster_max_z[cluster], 0.0f }) };
+		return dx * dx + dy * dy + dz * dz <= radius_squared;
+	} };
+
+	const std::size_t light_count{ m_light_bounds.size() };
+
+	for (std::size_t i = 0; i < light_count; ++i)
+	{
+		const Light_Bounds& bounds{ m_light_bounds[i] };
+
+		if (!bounds.visible || bounds.max[2] < begin || bounds.min[2] >= end)
+			continue;
+
+		const auto light_index{ static_cast<std::uint32_t>(i) };
+		const glm::vec3& center{ bounds.view_position };
+		const float radius_squared{ bounds.radius * bounds.radius };
+
+#if TILIA_SSE2 == 1
+		const __m128 center_x{ _mm_set1_ps(center.x) };
+		const __m128 center_y{ _mm_set1_ps(center.y) };
+		const __m128 center_z{ _mm_set1_ps(center.z) };
+		const __m128 radius_squared_4{ _mm_set1_ps(radius_squared) };
+		const __m128 zero{ _mm_setzero_ps() };
+#endif // TILIA_SSE2 == 1
+
+		const std::uint32_t z_begin{ std::max(bounds.min[2], begin) };
+		const std::uint32_t z_end{ std::min(bounds.max[2] + 1, end) };
+
+		for (std::uint32_t z = z_begin; z < z_end; ++z)
+		{
+			for (std::uint32_t y = bounds.min[1]; y <= bounds.max[1]; ++y)
+			{
+				const std::size_t row{ Get_Cluster_Index(0, y, z) };
+
+				std::size_t x{ bounds.min[0] };
+				const std::size_t x_end{ static_cast<std::size_t>(bounds.max[0]) + 1 };
+
+#if TILIA_SSE2 == 1
+				for (; x + 4 <= x_end; x += 4)
+				{
+					const std::size_t cluster{ row + x };
+
+					auto distance{ [zero](const float* min, const float* max, __m128 center_4)
+					{
+						const __m128 below{ _mm_sub_ps(_mm_loadu_ps(min), center_4) };
+						const __m128 above{ _mm_sub_ps(center_4, _mm_loadu_ps(max)) };
+						return _mm_max_ps(_mm_max_ps(below, above), zero);
+					} };
+
+					const __m128 dx{ distance(&m_cluster_min_x[cluster],
+						&m_cluster_max_x[cluster], center_x) };
+					const __m128 dy{ distance(&m_cluster_min_y[cluster],
+						&m_cluster_max_y[cluster], center_y) };
+					const __m128 dz{ distance(&m_cluster_min_z[cluster],
+						&m_cluster_max_z[cluster], center_z) };
+
+					const __m128 distance_squared{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx),
+						_mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)) };
+
+					const int mask{ _mm_movemask_ps(_mm_cmple_ps(distance_squared,
+						radius_squared_4)) };
+
+					for (std::size_t lane = 0; lane < 4; ++lane)
+					{
+						if (mask & (1 << lane))
+							add_light(cluster + lane, light_index);
+					}
+				}
+#endif // TILIA_SSE2 == 1
+
+				for (; x < x_end; ++x)
+				{
+					if (overlaps(row + x, center, radius_squared))
+						add_light(row + x, light_index);
+				}
+			}
+		}
+	}
+
+}
+
+void tilia::gfx::Light_Manager::Compact()
+{
+
+	const std::size_t cluster_count{ m_cluster_counts.size() };
+
+	m_light_indices.clear();
+
+	for (std::size_t i = 0; i < cluster_count; ++i)
+	{
+		const std::uint32_t count{ m_cluster_counts[i] };
+		const auto* lights{ &m_cluster_lights[i * s_max_lights_per_cluster] };
+
+		m_light_grid[i * 2] = static_cast<std::uint32_t>(m_light_indices.size());
+		m_light_grid[i * 2 + 1] = count;
+
+		m_light_indices.insert(m_light_indices.end(), lights, lights + count);
+	}
+
+}
+
+/**
+ * Reallocates every buffer with its new data so that the driver can hand out new storage instead
+ * of waiting on draws still reading the old.
+ */
+void tilia::gfx::Light_Manager::Upload()
+{
+
+	try
+	{
+		m_parameters.Set<Grid>(m_grid_parameters);
+		m_parameters.Set<Depth>(m_depth_parameters);
+		m_parameters.Set<Tile>(m_tile_parameters);
+		m_parameters.Upload();
+
+		m_light_grid_buffer.Allocate(m_light_grid.size() * sizeof(std::uint32_t),
+			enums::Buffer_Access_Type::Draw, enums::Buffer_Access_Frequency::Stream,
+			m_light_grid.data());
+
+		// Without lights in any cluster the shader never reads the other buffers, and empty
+		// buffers are not uploaded as openGL is not given storage of size 0
+		if (m_light_indices.empty())
+			return;
+
+		m_light_data_buffer.Allocate(m_light_data.size() * sizeof(glm::vec4),
+			enums::Buffer_Access_Type::Draw, enums::Buffer_Access_Frequency::Stream,
+			m_light_data.data());
+		m_light_index_buffer.Allocate(m_light_indices.size() * sizeof(std::uint32_t),
+			enums::Buffer_Access_Type::Draw, enums::Buffer_Access_Frequency::Stream,
+			m_light_indices.data());
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to upload ", m_lights.size(), " lights and ", m_light_indices.size(),
+			" light indices" });
+	}
+
+}
+
+void tilia::gfx::Light_Manager::Bind(std::uint32_t first_texture_slot) const
+{
+
+	const std::uint32_t textures[s_texture_count]{ m_light_data_texture, m_light_grid_texture,
+		m_light_index_texture };
+
+	for (std::uint32_t i = 0; i < s_texture_count; ++i)
+	{
+		GL_CALL(glActiveTexture(GL_TEXTURE0 + first_texture_slot + i));
+		GL_CALL(glBindTexture(GL_TEXTURE_BUFFER, textures[i]));
+	}
+
+}
+
+void tilia::gfx::Light_Manager::Set_Shader_Uniforms(Shader& shader,
+	std::uint32_t first_texture_slot) const
+{
+
+	const auto slot{ static_cast<std::int32_t>(first_texture_slot) };
+
+	try
+	{
+		shader.Uniform(s_light_data_name, { slot });
+		shader.Uniform(s_light_grid_name, { slot + 1 });
+		shader.Uniform(s_light_indices_name, { slot + 2 });
+		shader.Bind_Uniform_Block(s_block_name,
+			static_cast<std::uint32_t>(m_parameters.Get_Bind_Point()));
+	}
+	catch (utils::Tilia_Exception& t_e)
+	{
+		throw t_e.Add_Message({ TILIA_LOCATION,
+			"Failed to set light uniforms for shader { ID: ", shader.Get_ID(), " }" });
+	}
+
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+#include "vendor/glm/include/glm/gtc/matrix_transform.hpp"
+
+void tilia::gfx::Light_Manager::Test()
+{
+
+	Light_Manager light_manager{};
+	light_manager.Set_Grid({ 4, 4, 8 });
+
+	const glm::mat4 view{ 1.0f };
+	const glm::mat4 projection{ glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f) };
+
+	// Test the cluster bounds tile the frustum
+
+	light_manager.Calculate_Cluster_Bounds(projection, 0.1f, 100.0f);
+
+	REQUIRE(light_manager.m_cluster_max_z[0] == Approx(-0.1f));
+	REQUIRE(light_manager.m_cluster_min_z[light_manager.Get_Cluster_Index(0, 0, 7)] ==
+		Approx(-100.0f));
+	// With a 90 degree field of view the frustum is as wide as it is deep
+	REQUIRE(light_manager.m_cluster_min_x[light_manager.Get_Cluster_Index(0, 0, 7)] ==
+		Approx(-100.0f));
+	REQUIRE(light_manager.m_cluster_max_x[light_manager.Get_Cluster_Index(3, 0, 7)] ==
+		Approx(100.0f));
+
+	// Test a light straight ahead only lands in the middle tiles
+
+	light_manager.Get_Lights().push_back({ { 0.0f, 0.0f, -10.0f }, 0.5f });
+	// Test a light behind the camera lands nowhere
+	light_manager.Get_Lights().push_back({ { 0.0f, 0.0f, 10.0f }, 1.0f });
+	// Test a light on the left only lands in left tiles
+	light_manager.Get_Lights().push_back({ { -30.0f, 0.0f, -40.0f }, 1.0f });
+
+	light_manager.Cull(view, projection, 0.1f, 100.0f, 800, 800);
+
+	const std::uint32_t slice{ static_cast<std::uint32_t>(std::floor(
+		std::log(10.0f) * light_manager.m_slice_scale + light_manager.m_slice_bias)) };
+
+	REQUIRE(light_manager.Get_Cluster_Light_Count(1, 1, slice) == 1);
+	REQUIRE(light_manager.Get_Cluster_Light_Count(2, 2, slice) == 1);
+	REQUIRE(light_manager.Get_Cluster_Light_Count(0, 0, slice) == 0);
+	REQUIRE(light_manager.Get_Cluster_Light_Count(3, 3, slice) == 0);
+
+	REQUIRE(!light_manager.m_light_bounds[1].visible);
+
+	const std::uint32_t left_slice{ static_cast<std::uint32_t>(std::floor(
+		std::log(40.0f) * light_manager.m_slice_scale + light_manager.m_slice_bias)) };
+
+	REQUIRE(light_manager.m_light_bounds[2].max[0] == 0);
+	REQUIRE(light_manager.Get_Cluster_Light_Count(0, 1, left_slice) == 1);
+	REQUIRE(light_manager.Get_Cluster_Light_Count(1, 1, left_slice) == 0);
+
+	// Test the compacted lists point at the right lights
+
+	const std::size_t cluster{ light_manager.Get_Cluster_Index(0, 1, left_slice) };
+	const std::uint32_t offset{ light_manager.m_light_grid[cluster * 2] };
+
+	REQUIRE(light_manager.m_light_grid[cluster * 2 + 1] == 1);
+	REQUIRE(light_manager.m_light_indices[offset] == 2);
+
+	// Test every binned light index is counted once
+
+	std::size_t total{ 0 };
+	for (const auto count : light_manager.m_cluster_counts)
+		total += count;
+
+	REQUIRE(total == light_manager.Get_Light_Index_Count());
+
+	// Test many lights in one spot are capped per cluster
+
+	light_manager.Get_Lights().assign(s_max_lights_per_cluster + 10,
+		{ { 0.0f, 0.0f, -10.0f }, 0.5f });
+	light_manager.Cull(view, projection, 0.1f, 100.0f, 800, 800);
+
+	REQUIRE(light_manager.Get_Cluster_Light_Count(1, 1, slice) == s_max_lights_per_cluster);
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
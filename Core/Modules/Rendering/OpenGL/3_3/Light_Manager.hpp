@@ -0,0 +1,271 @@
+/**************************************************************************************************
+ * @file   Light_Manager.hpp
+ *
+ * @brief  Holds the point lights of a scene and bins them into a grid of clusters dividing the
+ *		   view frustum, so that shaders only loop over the lights which can affect the cluster
+ *		   of each fragment. Binning is done on the CPU and the results are read by shaders
+ *		   through texture buffers and a uniform block, see res/shaders/include/
+ *		   clustered_lights.glsl.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_LIGHT_MANAGER_HPP
+#define TILIA_OPENGL_3_3_LIGHT_MANAGER_HPP
+
+// Vendor
+#include "vendor/glm/include/glm/glm.hpp"
+
+// Standard
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_UNIFORM_BLOCK_INCLUDE
+#include TILIA_OPENGL_3_3_BUFFER_INCLUDE
+#include TILIA_CONSTANTS_INCLUDE
+
+namespace tilia
+{
+	namespace gfx
+	{
+
+		// Predefinition
+		class Shader;
+
+		/**
+		 * @brief A light shining equally in all directions which fades out to nothing at its
+		 * radius.
+		 */
+		struct Point_Light
+		{
+			// The position in world space
+			glm::vec3 position{ 0.0f };
+			// The distance at which the light no longer has any effect
+			float radius{ 10.0f };
+			// The color of the light
+			glm::vec3 color{ 1.0f };
+			// Scales the color
+			float intensity{ 1.0f };
+		}; // Point_Light
+
+		/**
+		 * @brief The amount of clusters along each axis of the view frustum.
+		 */
+		struct Cluster_Grid
+		{
+			std::uint32_t x{ 16 };
+			std::uint32_t y{ 9 };
+			std::uint32_t z{ 24 };
+		}; // Cluster_Grid
+
+		/**
+		 * @brief Bins point lights into clusters of the view frustum. The frustum is split into
+		 * tiles on the screen and exponentially sized slices in depth. Cull only touches the CPU
+		 * and spreads the slices over the job system workers, Upload and Bind have to be called
+		 * on the thread owning the context.
+		 */
+		class Light_Manager
+		{
+		public:
+
+			// The max amount of lights which can affect a single cluster, more are ignored
+			static constexpr std::uint32_t s_max_lights_per_cluster{ 128 };
+
+			// The names used for the uniforms in res/shaders/include/clustered_lights.glsl
+			static constexpr const char* s_block_name{ "Light_Clusters" };
+			// The amount of texture slots used by Bind
+			static constexpr std::uint32_t s_texture_count{ 3 };
+			static constexpr const char* s_light_data_name{ "tilia_light_data" };
+			static constexpr const char* s_light_grid_name{ "tilia_light_grid" };
+			static constexpr const char* s_light_indices_name{ "tilia_light_indices" };
+
+			/**
+			 * @brief Creates the openGL buffers and textures.
+			 *
+			 * @param grid - The amount of clusters along each axis.
+			 * @param bind_point - The uniform block binding point of the cluster parameters.
+			 */
+			void Init(const Cluster_Grid& grid = {}, std::uint32_t bind_point = 1);
+
+			/**
+			 * @brief Deletes the openGL buffers and textures.
+			 */
+			void Terminate();
+
+			/**
+			 * @brief Gets the lights, which may be freely added to, removed from and changed
+			 * between calls to Cull.
+			 */
+			std::vector<Point_Light>& Get_Lights() { return m_lights; }
+			/**
+			 * @brief Gets the lights.
+			 */
+			const std::vector<Point_Light>& Get_Lights() const { return m_lights; }
+
+			/**
+			 * @brief Bins the lights into the clusters. Can be called from any thread, although
+			 * it is only done in parallel when the calling thread can run jobs.
+			 *
+			 * @param view - The view matrix of the camera.
+			 * @param projection - The perspective projection matrix of the camera.
+			 * @param near_plane - The near plane distance of the projection.
+			 * @param far_plane - The far plane distance of the projection.
+			 * @param viewport_width - The width in pixels of the viewport rendered to.
+			 * @param viewport_height - The height in pixels of the viewport rendered to.
+			 */
+			void Cull(const glm::mat4& view, const glm::mat4& projection, float near_plane,
+				float far_plane, std::uint32_t viewport_width, std::uint32_t viewport_height);
+
+			/**
+			 * @brief Uploads the results of the last Cull to openGL.
+			 */
+			void Upload();
+
+			/**
+			 * @brief Binds the three light textures to the given and the two following texture
+			 * slots.
+			 */
+			void Bind(std::uint32_t first_texture_slot) const;
+
+			/**
+			 * @brief Points the samplers and uniform block of the given shader at the slots and
+			 * bind point used by Bind and Init.
+			 */
+			void Set_Shader_Uniforms(Shader& shader, std::uint32_t first_texture_slot) const;
+
+			/**
+			 * @brief Gets the amount of lights binned into the given cluster by the last Cull.
+			 */
+			std::uint32_t Get_Cluster_Light_Count(std::uint32_t x, std::uint32_t y,
+				std::uint32_t z) const
+			{
+				return m_cluster_counts[Get_Cluster_Index(x, y, z)];
+			}
+			/**
+			 * @brief Gets the total amount of light indices over all clusters from the last Cull.
+			 */
+			std::size_t Get_Light_Index_Count() const { return m_light_indices.size(); }
+
+			/**
+			 * @brief Gets the grid of clusters.
+			 */
+			const Cluster_Grid& Get_Cluster_Grid() const { return m_grid; }
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Light_Manager. Only tests the binning and so does not need a
+			 * context.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		private:
+
+			/**
+			 * @brief The range of clusters a light may touch, along with its view space position.
+			 */
+			struct Light_Bounds
+			{
+				glm::vec3 view_position{};
+				float radius{};
+				std::uint32_t min[3]{};
+				std::uint32_t max[3]{};
+				bool visible{ false };
+			}; // Light_Bounds
+
+			/**
+			 * @brief Sets the size of the per cluster storage, does not touch openGL.
+			 */
+			void Set_Grid(const Cluster_Grid& grid);
+
+			/**
+			 * @brief Recalculates the view space bounds of every cluster.
+			 */
+			void Calculate_Cluster_Bounds(const glm::mat4& projection, float near_plane,
+				float far_plane);
+
+			/**
+			 * @brief Calculates the range of clusters the given light may touch.
+			 */
+			Light_Bounds Calculate_Light_Bounds(const Point_Light& light, const glm::mat4& view,
+				const glm::mat4& projection) const;
+
+			/**
+			 * @brief Bins every visible light into the clusters of the slices [begin, end).
+			 */
+			void Bin_Slices(std::uint32_t begin, std::uint32_t end);
+
+			/**
+			 * @brief Writes the per cluster lists into one list along with the offset and count
+			 * of every cluster.
+			 */
+			void Compact();
+
+			std::size_t Get_Cluster_Index(std::uint32_t x, std::uint32_t y, std::uint32_t z) const
+			{
+				return x + static_cast<std::size_t>(m_grid.x) * (y +
+					static_cast<std::size_t>(m_grid.y) * z);
+			}
+
+			// The lights
+			std::vector<Point_Light> m_lights{};
+
+			// The amount of clusters along each axis
+			Cluster_Grid m_grid{};
+
+			// The values the cluster bounds were last calculated with
+			glm::mat4 m_bounds_projection{ 0.0f };
+			float m_bounds_near{}, m_bounds_far{};
+			// Scale and bias turning the log of a view depth into a slice
+			float m_slice_scale{}, m_slice_bias{};
+
+			// The view space bounds of every cluster, kept as separate arrays so that a row of
+			// clusters can be tested against a light four at a time
+			std::vector<float> m_cluster_min_x{}, m_cluster_min_y{}, m_cluster_min_z{},
+				m_cluster_max_x{}, m_cluster_max_y{}, m_cluster_max_z{};
+
+			// The bounds of every light from the last Cull
+			std::vector<Light_Bounds> m_light_bounds{};
+
+			// The amount of lights in every cluster
+			std::vector<std::uint32_t> m_cluster_counts{};
+			// s_max_lights_per_cluster light indices for every cluster
+			std::vector<std::uint32_t> m_cluster_lights{};
+
+			// Data for the shaders, two vec4 per light
+			std::vector<glm::vec4> m_light_data{};
+			// The offset and count into m_light_indices of every cluster
+			std::vector<std::uint32_t> m_light_grid{};
+			// The lights of all clusters after each other
+			std::vector<std::uint32_t> m_light_indices{};
+
+			// Parameters read by the shaders to find the cluster of a fragment
+			glm::uvec4 m_grid_parameters{};
+			glm::vec4 m_depth_parameters{};
+			glm::vec4 m_tile_parameters{};
+
+			// The members of the Light_Clusters block
+			enum Parameter : std::size_t { Grid, Depth, Tile };
+
+			// The uniform block holding the parameters
+			Uniform_Block<glm::uvec4, glm::vec4, glm::vec4> m_parameters{};
+
+			// The storage of the light textures
+			Buffer m_light_data_buffer{}, m_light_grid_buffer{}, m_light_index_buffer{};
+			// The buffer textures the shaders read from
+			std::uint32_t m_light_data_texture{}, m_light_grid_texture{},
+				m_light_index_texture{};
+
+		}; // Light_Manager
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_LIGHT_MANAGER_HPP
@@ -0,0 +1,224 @@
+// Standard
+#include <exception>
+
+// Tilia
+#include "Render_Thread.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_TILIA_EXCEPTION_INCLUDE
+#include TILIA_EXCEPTION_HANDLER_INCLUDE
+
+void tilia::gfx::Render_Thread::Start(Context_Function make_context_current,
+	Render_Function render, Release_Function release_context)
+{
+	std::lock_guard lock{ m_mutex };
+
+	if (m_running)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Render thread is already running" } };
+	}
+
+	m_running = true;
+	m_packet_pending = false;
+	m_rendering = false;
+	m_game_index = 0;
+	m_render_index = 1;
+
+	m_thread = std::thread{ &Render_Thread::Thread_Loop, this, std::move(make_context_current),
+		std::move(render), std::move(release_context) };
+}
+
+void tilia::gfx::Render_Thread::Stop()
+{
+	{
+		std::lock_guard lock{ m_mutex };
+		if (!m_running)
+			return;
+		m_running = false;
+	}
+	m_condition.notify_all();
+
+	if (m_thread.joinable())
+		m_thread.join();
+}
+
+tilia::gfx::Frame_Packet& tilia::gfx::Render_Thread::Begin_Frame()
+{
+	std::lock_guard lock{ m_mutex };
+
+	// Submit_Frame made sure the render thread is done with this packet
+	Frame_Packet& packet{ m_packets[m_game_index] };
+	packet.Clear(m_next_frame_index);
+	return packet;
+}
+
+void tilia::gfx::Render_Thread::Submit_Frame()
+{
+	std::unique_lock lock{ m_mutex };
+
+	if (!m_running)
+	{
+		throw utils::Tilia_Exception{ { TILIA_LOCATION,
+			"Can not submit a frame to a render thread which is not running" } };
+	}
+
+	// The packet the game thread will build into next is the one currently being rendered
+	m_condition.wait(lock, [this]() { return !m_packet_pending && !m_rendering; });
+
+	m_render_index = m_game_index;
+	m_game_index ^= 1;
+	m_packet_pending = true;
+	++m_next_frame_index;
+
+	lock.unlock();
+	m_condition.notify_all();
+}
+
+void tilia::gfx::Render_Thread::Wait_Idle()
+{
+	std::unique_lock lock{ m_mutex };
+	m_condition.wait(lock, [this]() { return !m_packet_pending && !m_rendering; });
+}
+
+tilia::gfx::Render_Thread::~Render_Thread()
+{
+	Stop();
+}
+
+void tilia::gfx::Render_Thread::Thread_Loop(Context_Function make_context_current,
+	Render_Function render, Release_Function release_context)
+{
+	utils::Exception_Handler& handler{ utils::Exception_Handler::Instance() };
+
+	// Runs the given function and hands any exception over to the exception handler since
+	// there is nothing on this thread to catch them
+	auto run_guarded{ [&handler](auto&& function)
+	{
+		try
+		{
+			function();
+		}
+		catch (utils::Tilia_Exception& t_e)
+		{
+			handler.Throw(t_e.Add_Message({ TILIA_LOCATION, "Render thread failed" }));
+		}
+		catch (std::exception& e)
+		{
+			handler.Throw(e);
+		}
+	} };
+
+	if (make_context_current)
+		run_guarded(make_context_current);
+
+	while (true)
+	{
+		std::unique_lock lock{ m_mutex };
+		m_condition.wait(lock, [this]() { return m_packet_pending || !m_running; });
+
+		// Packets submitted before stopping are still rendered
+		if (!m_packet_pending)
+			break;
+
+		const Frame_Packet& packet{ m_packets[m_render_index] };
+		m_packet_pending = false;
+		m_rendering = true;
+		lock.unlock();
+
+		run_guarded([&render, &packet]() { render(packet); });
+
+		lock.lock();
+		m_rendering = false;
+		++m_rendered_frames;
+		lock.unlock();
+		m_condition.notify_all();
+	}
+
+	if (release_context)
+		run_guarded(release_context);
+}
+
+#if TILIA_UNIT_TESTS == 1
+
+// Vendor
+#include "vendor/Catch2/Catch2.hpp"
+
+// Standard
+#include <atomic>
+#include <vector>
+
+void tilia::gfx::Render_Thread::Test()
+{
+
+	Render_Thread render_thread{};
+
+	std::thread::id render_thread_id{};
+	std::vector<std::uint64_t> rendered_indices{};
+	std::vector<float> rendered_x{};
+	std::vector<float> rendered_view_x{};
+	std::vector<std::size_t> rendered_light_counts{};
+	std::atomic<bool> released{ false };
+
+	// Test submitting to a stopped render thread throws
+
+	REQUIRE_THROWS(render_thread.Submit_Frame());
+
+	render_thread.Start([&render_thread_id]() { render_thread_id = std::this_thread::get_id(); },
+		[&](const Frame_Packet& packet)
+		{
+			rendered_indices.push_back(packet.Get_Frame_Index());
+			rendered_x.push_back(packet.camera_pos.x);
+			rendered_view_x.push_back(packet.view[3][0]);
+			rendered_light_counts.push_back(packet.lights.size());
+		},
+		[&released]() { released = true; });
+
+	REQUIRE(render_thread.Is_Running());
+
+	// Test packets are rendered in order and the game packet is never the one being rendered
+
+	const Frame_Packet* previous_packet{ nullptr };
+
+	for (std::uint64_t i{ 0 }; i < 100; ++i)
+	{
+		Frame_Packet& packet{ render_thread.Begin_Frame() };
+
+		REQUIRE(&packet != previous_packet);
+		REQUIRE(packet.Get_Frame_Index() == i);
+		REQUIRE(packet.Get_Meshes().size() == 0);
+
+		REQUIRE(packet.lights.empty());
+		REQUIRE(packet.Get_Uniforms().empty());
+
+		packet.camera_pos.x = static_cast<float>(i);
+		packet.view[3][0] = static_cast<float>(i) * 2.0f;
+		packet.lights.resize(static_cast<std::size_t>(i % 4));
+
+		render_thread.Submit_Frame();
+		previous_packet = &packet;
+	}
+
+	render_thread.Wait_Idle();
+
+	REQUIRE(render_thread.Get_Rendered_Frames() == 100);
+	REQUIRE(rendered_indices.size() == 100);
+	for (std::uint64_t i{ 0 }; i < 100; ++i)
+	{
+		REQUIRE(rendered_indices[i] == i);
+		REQUIRE(rendered_x[i] == static_cast<float>(i));
+		REQUIRE(rendered_view_x[i] == static_cast<float>(i) * 2.0f);
+		REQUIRE(rendered_light_counts[i] == static_cast<std::size_t>(i % 4));
+	}
+
+	// Test the context functions were called on the render thread
+
+	render_thread.Stop();
+
+	REQUIRE(!render_thread.Is_Running());
+	REQUIRE(render_thread_id != std::thread::id{});
+	REQUIRE(render_thread_id != std::this_thread::get_id());
+	REQUIRE(released);
+
+}
+
+#endif // TILIA_UNIT_TESTS == 1
@@ -0,0 +1,154 @@
+/**************************************************************************************************
+ * @file   Render_Thread.hpp
+ *
+ * @brief  Holds a class which owns the thread that the OpenGL context is current on. The game
+ *		   thread builds frame packets which the render thread then submits one frame behind, so
+ *		   frame N + 1 can be simulated while frame N is being rendered.
+ *
+ * @author Gustav Fagerlind
+ * @date   18/10/2026
+ *************************************************************************************************/
+
+#ifndef TILIA_OPENGL_3_3_RENDER_THREAD_HPP
+#define TILIA_OPENGL_3_3_RENDER_THREAD_HPP
+
+// Standard
+#include <cstdint>
+#include <array>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// Tilia
+#include "Core/Values/Directories.hpp"
+#include TILIA_OPENGL_3_3_FRAME_PACKET_INCLUDE
+#include TILIA_CONSTANTS_INCLUDE
+
+namespace tilia
+{
+	namespace gfx
+	{
+
+		/**
+		 * @brief Runs the rendering of frame packets on its own thread. Holds two packets, one
+		 * which the game thread is building and one which the render thread is reading from.
+		 */
+		class Render_Thread
+		{
+		public:
+
+			// Called once on the render thread before any frame, should make the context current
+			using Context_Function = std::function<void()>;
+			// Called on the render thread for every submitted packet
+			using Render_Function = std::function<void(const Frame_Packet&)>;
+			// Called once on the render thread when stopping, should release the context
+			using Release_Function = std::function<void()>;
+
+			/**
+			 * @brief Starts the render thread. The context must not be current on the calling
+			 * thread.
+			 *
+			 * @param make_context_current - Makes the context current on the render thread.
+			 * @param render - Renders a given frame packet.
+			 * @param release_context - Releases the context from the render thread.
+			 */
+			void Start(Context_Function make_context_current, Render_Function render,
+				Release_Function release_context = {});
+
+			/**
+			 * @brief Waits for the last submitted packet to be rendered and then joins the render
+			 * thread.
+			 */
+			void Stop();
+
+			/**
+			 * @brief Gets the packet which the game thread should build the next frame into. Is
+			 * never read by the render thread until it is submitted.
+			 */
+			Frame_Packet& Begin_Frame();
+
+			/**
+			 * @brief Hands the packet returned by Begin_Frame to the render thread. Blocks while
+			 * the render thread is still busy with the previous packet.
+			 */
+			void Submit_Frame();
+
+			/**
+			 * @brief Blocks until every submitted packet has been rendered.
+			 */
+			void Wait_Idle();
+
+			/**
+			 * @brief Gets the number of frames which have been rendered.
+			 */
+			std::uint64_t Get_Rendered_Frames() const
+			{
+				std::lock_guard lock{ m_mutex };
+				return m_rendered_frames;
+			}
+
+			/**
+			 * @brief Whether or not the render thread is running.
+			 */
+			bool Is_Running() const
+			{
+				std::lock_guard lock{ m_mutex };
+				return m_running;
+			}
+
+			~Render_Thread();
+
+#if TILIA_UNIT_TESTS == 1
+
+			/**
+			 * @brief Unit test for Render_Thread.
+			 */
+			static void Test();
+
+#endif // TILIA_UNIT_TESTS == 1
+
+		private:
+
+			void Thread_Loop(Context_Function make_context_current, Render_Function render,
+				Release_Function release_context);
+
+			// The two packets, one for building and one for rendering
+			std::array<Frame_Packet, 2> m_packets{};
+			// The index of the packet the game thread builds into
+			std::size_t m_game_index{ 0 };
+			// The index of the packet the render thread reads from
+			std::size_t m_render_index{ 1 };
+			// Whether or not a packet has been submitted but not yet picked up
+			bool m_packet_pending{ false };
+			// Whether or not the render thread is reading from its packet
+			bool m_rendering{ false };
+			// Whether or not the render thread should keep running
+			bool m_running{ false };
+			// The index given to the next built packet
+			std::uint64_t m_next_frame_index{ 0 };
+			// The number of frames which have been rendered
+			std::uint64_t m_rendered_frames{ 0 };
+
+			std::thread m_thread{};
+			mutable std::mutex m_mutex{};
+			std::condition_variable m_condition{};
+
+		public:
+
+			Render_Thread() = default;
+
+			// Render_Thread shan't be copyable or moveable
+
+			Render_Thread(const Render_Thread& other) = delete;
+			Render_Thread(Render_Thread&& other) = delete;
+
+			Render_Thread& operator=(const Render_Thread& other) = delete;
+			Render_Thread& operator=(Render_Thread&& other) = delete;
+
+		}; // Render_Thread
+
+	} // gfx
+} // tilia
+
+#endif // TILIA_OPENGL_3_3_RENDER_THREAD_HPP
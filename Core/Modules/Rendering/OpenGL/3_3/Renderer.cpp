@@ -12,46 +12,149 @@
  * @date   29/05/2022
  *********************************************************************/
 
+// Vendor
+#include "vendor/glad/KHR_Debug_openGL_3_3/include/glad/glad.h"
+
 // Standard
 #include <map>
+#include <algorithm>
+#include <cmath>
 
 // Headers
 #include "Renderer.hpp"
+#include "Core/Values/Directories.hpp"
+#include TILIA_JOB_SYSTEM_INCLUDE
+#include TILIA_OPENGL_3_3_UNIFORM_BUFFER_INCLUDE
+#include TILIA_OPENGL_3_3_TEXTURE_RESIDENCY_INCLUDE
+#include TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE
 
 #include <iostream>
 
 void tilia::gfx::Renderer::Render()
+{
+	Request_Levels(m_mesh_data, m_view, m_projection);
+	Render_Meshes(m_mesh_data, m_camera_pos);
+}
+
+void tilia::gfx::Renderer::Build_Frame_Packet(Frame_Packet& packet) const
+{
+	packet.camera_pos = m_camera_pos;
+	packet.view = m_view;
+	packet.projection = m_projection;
+
+	for (const auto& mesh_data : m_mesh_data)
+	{
+		if (auto mesh{ mesh_data.lock() })
+			packet.Add_Mesh(*mesh);
+	}
+}
+
+void tilia::gfx::Renderer::Render(const Frame_Packet& packet)
+{
+	packet.Set_Uniforms();
+	Request_Levels(packet.Get_Meshes(), packet.view, packet.projection);
+	Render_Meshes(packet.Get_Meshes(), packet.camera_pos);
+}
+
+/**
+ * The meshes are bounded by spheres around the boxes of their positions, whose size on screen
+ * is taken through the projection, perspective or orthographic.
+ */
+void tilia::gfx::Renderer::Request_Levels(const std::vector<std::weak_ptr<Mesh_Data>>& meshes,
+	const glm::mat4& view, const glm::mat4& projection) const
+{
+
+	GLint viewport[4]{};
+	GL_CALL(glGetIntegerv(GL_VIEWPORT, viewport));
+	const auto viewport_height{ static_cast<float>(viewport[3]) };
+	const bool perspective{ projection[2][3] != 0.0f };
+
+	Texture_Residency& residency{ Texture_Residency::Instance() };
+
+	for (const auto& mesh_data : meshes)
+	{
+		const auto mesh{ mesh_data.lock() };
+		if (!mesh || mesh->textures->empty())
+			continue;
+
+		const std::vector<float>& vertex_data{ *mesh->vertex_data };
+		const size_t vertex_size{ mesh->vertex_size };
+		const size_t start{ *mesh->vertex_pos_start };
+		const size_t end{ std::min<size_t>(*mesh->vertex_pos_end, start + 2) };
+		if (vertex_data.size() < vertex_size || end < start)
+			continue;
+
+		// Axes the positions leave out stay at 0
+		glm::vec3 min{}, max{};
+		for (size_t k = start; k <= end; k++)
+		{
+			const auto axis{ static_cast<glm::vec3::length_type>(k - start) };
+			min[axis] = max[axis] = vertex_data[k];
+		}
+		for (size_t i = vertex_size; i + vertex_size <= vertex_data.size(); i += vertex_size)
+		{
+			for (size_t k = start; k <= end; k++)
+			{
+				const auto axis{ static_cast<glm::vec3::length_type>(k - start) };
+				min[axis] = std::min(min[axis], vertex_data[i + k]);
+				max[axis] = std::max(max[axis], vertex_data[i + k]);
+			}
+		}
+
+		const glm::vec3 center{ view * glm::vec4{ (min + max) * 0.5f, 1.0f } };
+		const float radius{ glm::length(max - min) * 0.5f };
+
+		// The camera looks down negative z
+		if (center.z - radius > 0.0f)
+			continue;
+
+		const float screen_size{ perspective ?
+			Texture_Residency::Get_Screen_Size(radius, glm::length(center),
+				2.0f * std::atan(1.0f / projection[1][1]), viewport_height) :
+			radius * projection[1][1] * viewport_height };
+
+		for (const auto& texture : *mesh->textures)
+		{
+			if (const auto locked{ texture.lock() })
+				residency.Request_Screen_Size(*locked, screen_size);
+		}
+	}
+
+}
+
+void tilia::gfx::Renderer::Render_Meshes(const std::vector<std::weak_ptr<Mesh_Data>>& meshes,
+	const glm::vec3& camera_pos)
 {
 
 	std::map<float, std::vector<std::weak_ptr<Mesh_Data>>> transparent_meshes{};
 
-	const size_t mesh_count{ m_mesh_data.size() };
+	const size_t mesh_count{ meshes.size() };
 
 	for (size_t i = 0; i < mesh_count; i++)
 	{
-		if (*m_mesh_data[i].lock()->transparent)
+		if (*meshes[i].lock()->transparent)
 		{
 
 			float total_length{};
-			const size_t vertex_count{ m_mesh_data[i].lock()->vertex_data->size() };
-			const size_t vertex_size{ m_mesh_data[i].lock()->vertex_size };
+			const size_t vertex_count{ meshes[i].lock()->vertex_data->size() };
+			const size_t vertex_size{ meshes[i].lock()->vertex_size };
 
-			const size_t start{ *m_mesh_data[i].lock()->vertex_pos_start };
-			const size_t end{ *m_mesh_data[i].lock()->vertex_pos_end };
+			const size_t start{ *meshes[i].lock()->vertex_pos_start };
+			const size_t end{ *meshes[i].lock()->vertex_pos_end };
 			for (size_t j = 0; j < vertex_count; j += vertex_size)
 			{
 
 				for (size_t k = start; k <= end; k++)
 				{
-					total_length += fabs((*m_mesh_data[i].lock()->vertex_data)[j + k] - 
-						m_camera_pos[static_cast<glm::vec3::length_type>(k - start)]);
+					total_length += fabs((*meshes[i].lock()->vertex_data)[j + k] - 
+						camera_pos[static_cast<glm::vec3::length_type>(k - start)]);
 				}
 
 			}
 
 			float average_length{ total_length / vertex_count };
 
-			transparent_meshes[average_length].push_back(m_mesh_data[i]);
+			transparent_meshes[average_length].push_back(meshes[i]);
 
 			continue;
 		}
@@ -60,18 +163,18 @@ void tilia::gfx::Renderer::Render()
 		for (size_t j = 0; j < batch_count; j++)
 		{
 			if (!m_batches[j]->Get_Mesh_Count()) {
-				m_batches[j]->Reset(m_mesh_data[i]);
-				m_batches[j]->Push_Mesh(m_mesh_data[i]);
+				m_batches[j]->Reset(meshes[i]);
+				m_batches[j]->Push_Mesh(meshes[i]);
 				goto cont_o_loop;
 			}
-			if (m_batches[j]->Push_Mesh(m_mesh_data[i])) {
+			if (m_batches[j]->Push_Mesh(meshes[i])) {
 				goto cont_o_loop;
 			}
 		}
 
-		m_batches.push_back(std::make_unique<Batch>(m_mesh_data[i]));
+		m_batches.push_back(std::make_unique<Batch>(meshes[i], m_buffer_pool));
 
-		m_batches[m_batches.size() - 1]->Push_Mesh(m_mesh_data[i]);
+		m_batches[m_batches.size() - 1]->Push_Mesh(meshes[i]);
 
 	cont_o_loop:
 		continue;
@@ -95,7 +198,7 @@ void tilia::gfx::Renderer::Render()
 				}
 			}
 
-			m_batches.push_back(std::make_unique<Batch>(it->second[j]));
+			m_batches.push_back(std::make_unique<Batch>(it->second[j], m_buffer_pool));
 
 			m_batches[m_batches.size() - 1]->Push_Mesh(it->second[j]);
 
@@ -105,17 +208,76 @@ void tilia::gfx::Renderer::Render()
 		}
 	}
 
-	//std::cout << "Batch count: " << m_batches.size() << '\n';
+	// Batches left empty give their buffers back to the pool
+	m_batches.erase(std::remove_if(m_batches.begin(), m_batches.end(), 
+		[](const std::unique_ptr<Batch>& batch) { return !batch->Get_Mesh_Count(); }), 
+		m_batches.end());
+
 	const size_t batch_count{ m_batches.size() };
+
+	// Writing the buffers needs the context so it is done on this thread
+	for (size_t i = 0; i < batch_count; i++)
+	{
+		m_batches[i]->m_camera_pos = camera_pos;
+		m_batches[i]->Upload();
+	}
+
+	Record_Batches(batch_count);
+
+	m_command_queue.Clear();
+	for (const auto& command_buffer : m_command_buffers)
+		m_command_queue.Add(command_buffer);
+	m_command_queue.Submit();
+
 	for (size_t i = 0; i < batch_count; i++)
 	{
-		//std::cout << "Mesh count: " << m_batches[i]->Get_Mesh_Count() 
-		//	<< " <<>> Vertex count: " << m_batches[i]->Get_Vertex_Count() / 
-		//	m_batches[i]->Get_Vertex_Size()
-		//	<< " <<>> Index count: " << m_batches[i]->Get_Index_Count() << '\n';
-		m_batches[i]->m_camera_pos = m_camera_pos;
-		m_batches[i]->Render();
 		m_batches[i]->Clear();
 	}
 
+	m_buffer_pool.Next_Frame();
+	m_buffer_pool.Trim(s_max_idle_buffer_frames);
+
+	Uniform_Buffer::Next_Frame();
+
+}
+
+void tilia::gfx::Renderer::Record_Batches(std::size_t batch_count)
+{
+
+	jobs::Job_System& job_system{ jobs::Job_System::Instance() };
+
+	const bool use_jobs{ job_system.Can_Run_Jobs() && batch_count > 1 };
+	const size_t thread_count{ use_jobs ? job_system.Get_Worker_Count() + 1 : 1 };
+
+	if (m_command_buffers.size() < thread_count)
+		m_command_buffers.resize(thread_count);
+	for (auto& command_buffer : m_command_buffers)
+		command_buffer.Clear();
+
+	auto record{ [this, use_jobs](size_t begin, size_t end)
+	{
+		Command_Buffer& command_buffer{ 
+			m_command_buffers[use_jobs ? jobs::Job_System::Get_Thread_Index() : 0] };
+		for (size_t i = begin; i < end; i++)
+		{
+			if (m_batches[i]->Get_Mesh_Count())
+				m_batches[i]->Record(command_buffer, Get_Sort_Key(i));
+		}
+	} };
+
+	if (use_jobs)
+		job_system.Parallel_For(0, batch_count, 4, record);
+	else
+		record(0, batch_count);
+
+}
+
+std::uint64_t tilia::gfx::Renderer::Get_Sort_Key(std::size_t batch_index) const
+{
+	const Batch& batch{ *m_batches[batch_index] };
+
+	if (batch.Get_Transparent())
+		return (std::uint64_t{ 1 } << 63) | batch_index;
+
+	return (static_cast<std::uint64_t>(batch.Get_Shader_ID()) << 32) | batch_index;
 }
@@ -28,6 +28,9 @@
 #include "Core/Values/Directories.hpp"
 #include TILIA_OPENGL_3_3_MESH_INCLUDE
 #include TILIA_OPENGL_3_3_BATCH_INCLUDE
+#include TILIA_OPENGL_3_3_BUFFER_POOL_INCLUDE
+#include TILIA_OPENGL_3_3_FRAME_PACKET_INCLUDE
+#include TILIA_OPENGL_3_3_COMMAND_BUFFER_INCLUDE
 
 namespace tilia {
 
@@ -52,15 +55,66 @@ namespace tilia {
 
 			void Render();
 
+			/**
+			 * @brief Copies the added meshes, the camera position and the view and projection
+			 * into the given packet so it can be rendered on another thread while the meshes
+			 * keep changing.
+			 */
+			void Build_Frame_Packet(Frame_Packet& packet) const;
+
+			/**
+			 * @brief Sets the uniforms captured by the given packet and then renders its
+			 * meshes. Should be called on the thread which owns the context.
+			 */
+			void Render(const Frame_Packet& packet);
+
 			// Todo: Placeholder
 			glm::vec3 m_camera_pos{};
+			glm::mat4 m_view{ 1.0f };
+			glm::mat4 m_projection{ 1.0f };
 
 		private:
 
+			void Render_Meshes(const std::vector<std::weak_ptr<Mesh_Data>>& meshes,
+				const glm::vec3& camera_pos);
+
+			/**
+			 * @brief Requests the mip levels the textures of the given meshes need for how
+			 * large the meshes are on screen from Texture_Residency, so that streamed textures
+			 * only hold those. Meshes behind the camera request nothing. Needs the context to
+			 * get the viewport from.
+			 */
+			void Request_Levels(const std::vector<std::weak_ptr<Mesh_Data>>& meshes,
+				const glm::mat4& view, const glm::mat4& projection) const;
+
+			/**
+			 * @brief Records the first batch_count batches into the command buffers, spread over
+			 * the job system workers when the calling thread can run jobs.
+			 */
+			void Record_Batches(std::size_t batch_count);
+
+			/**
+			 * @brief Gets the sort key of the batch at the given index. Opaque batches go first,
+			 * grouped by shader, and transparent batches keep their back to front order.
+			 */
+			std::uint64_t Get_Sort_Key(std::size_t batch_index) const;
+
+			// The amount of frames a free pooled buffer is kept before it is deleted
+			static constexpr std::uint64_t s_max_idle_buffer_frames{ 120 };
+
 			std::vector<std::weak_ptr<Mesh_Data>> m_mesh_data{};
 
+			// Holds the buffers of the batches, declared first so that it outlives them
+			Buffer_Pool m_buffer_pool{};
+
 			std::vector<std::unique_ptr<Batch>> m_batches{};
 
+			// One command buffer per thread recording batches
+			std::vector<Command_Buffer> m_command_buffers{};
+
+			// Merges and replays the command buffers
+			Command_Queue m_command_queue{};
+
 		};
 
 	}
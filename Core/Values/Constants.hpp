@@ -127,4 +127,34 @@ namespace tilia
  */
 #define TILIA_UNIT_TESTS 0
 
+/**
+ * @brief Whether or not SSE2 intrinsics can be used. Code using them has to keep a scalar path
+ * for when this is 0.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TILIA_SSE2 1
+#else
+#define TILIA_SSE2 0
+#endif
+
+/**
+ * @brief Whether or not AVX intrinsics can be used. Only set when the compiler is asked to
+ * target AVX, code using them has to keep an SSE2 or scalar path for when this is 0.
+ */
+#if defined(__AVX__)
+#define TILIA_AVX 1
+#else
+#define TILIA_AVX 0
+#endif
+
+/**
+ * @brief Whether or not the F16C instructions converting between 32 and 16 bit floats can be
+ * used. Every CPU with AVX2 has them.
+ */
+#if defined(__F16C__) || defined(__AVX2__)
+#define TILIA_F16C 1
+#else
+#define TILIA_F16C 0
+#endif
+
 #endif // TILIA_CONSTANTS_HPP
@@ -16,6 +16,10 @@
 #define TILIA_TILIA_EXCEPTION_INCLUDE "Core/Modules/Exceptions/Tilia_Exception.hpp"
 
 #define TILIA_WINDOWS_FILE_SYSTEM_INCLUDE "Core/Modules/File_System/Windows/File_System.hpp"
+#define TILIA_WINDOWS_MAPPED_FILE_INCLUDE "Core/Modules/File_System/Windows/Mapped_File.hpp"
+
+#define TILIA_JOB_SYSTEM_INCLUDE "Core/Modules/Jobs/Job_System.hpp"
+#define TILIA_WORK_STEALING_DEQUE_INCLUDE "Core/Modules/Jobs/Work_Stealing_Deque.hpp"
 
 #define TILIA_OPENGL_3_3_ERROR_HANDLING_INCLUDE "Core/Modules/Error_Handling/OpenGL/3_3/Error_Handling.hpp"
 
@@ -23,15 +27,29 @@
 #define TILIA_OPENGL_3_3_SHADER_DATA_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Shader_Data.hpp"
 #define TILIA_OPENGL_3_3_SHADER_PART_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Shader_Part.hpp"
 #define TILIA_OPENGL_3_3_UNIFORM_BUFFER_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Uniform_Buffer.hpp"
+#define TILIA_OPENGL_3_3_UNIFORM_BLOCK_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Uniform_Block.hpp"
+#define TILIA_OPENGL_3_3_PROGRAM_BINARY_CACHE_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Program_Binary_Cache.hpp"
+#define TILIA_OPENGL_3_3_SHADER_COMPILER_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Shader_Compiler.hpp"
+#define TILIA_OPENGL_3_3_SHADER_PREPROCESSOR_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Shader_Preprocessor.hpp"
+#define TILIA_OPENGL_3_3_SHADER_VARIANTS_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Shader_Variants.hpp"
 
 #define TILIA_OPENGL_3_3_CUBE_MAP_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Cube_Map.hpp"
 #define TILIA_OPENGL_3_3_CUBE_MAP_DATA_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Cube_Map_Data.hpp"
 #define TILIA_OPENGL_3_3_TEXTURE__INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Texture_.hpp"
 #define TILIA_OPENGL_3_3_TEXTURE_2D__INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Texture_2D_.hpp"
+#define TILIA_OPENGL_3_3_TEXTURE_STREAMER_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Texture_Streamer.hpp"
+#define TILIA_OPENGL_3_3_TEXTURE_CONTAINER_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Texture_Container.hpp"
+#define TILIA_OPENGL_3_3_TEXTURE_RESIDENCY_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Texture_Residency.hpp"
+#define TILIA_OPENGL_3_3_TEXTURE_CACHE_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Texture_Cache.hpp"
 
 #define TILIA_OPENGL_3_3_BUFFER_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Buffer.hpp"
 
 #define TILIA_OPENGL_3_3_BATCH_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Batch.hpp"
+#define TILIA_OPENGL_3_3_BUFFER_POOL_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Buffer_Pool.hpp"
+#define TILIA_OPENGL_3_3_COMMAND_BUFFER_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Command_Buffer.hpp"
+#define TILIA_OPENGL_3_3_FRAME_PACKET_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Frame_Packet.hpp"
+#define TILIA_OPENGL_3_3_LIGHT_MANAGER_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Light_Manager.hpp"
+#define TILIA_OPENGL_3_3_RENDER_THREAD_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Render_Thread.hpp"
 #define TILIA_OPENGL_3_3_MESH_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Mesh.hpp"
 #define TILIA_OPENGL_3_3_RENDERER_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Renderer.hpp"
 #define TILIA_OPENGL_3_3_VERTEX_INCLUDE "Core/Modules/Rendering/OpenGL/3_3/Vertex.hpp"
@@ -46,6 +64,10 @@
 #define TILIA_WINDOW_PROPERTIES_INCLUDE "Core/Modules/Windowing/Window_Properties.hpp"
 
 #define TILIA_IMAGE_INCLUDE "Core/Modules/Images/Image.hpp"
+#define TILIA_BLOCK_ENCODER_INCLUDE "Core/Modules/Images/Block_Encoder.hpp"
+#define TILIA_MIP_GENERATOR_INCLUDE "Core/Modules/Images/Mip_Generator.hpp"
+#define TILIA_PIXEL_CONVERTER_INCLUDE "Core/Modules/Images/Pixel_Converter.hpp"
+#define TILIA_CHANNEL_PACKER_INCLUDE "Core/Modules/Images/Channel_Packer.hpp"
 
 #define TILIA_TEMP_CAMERA_INCLUDE "Core/Temp/Camera.hpp"
 #define TILIA_TEMP_INPUT_INCLUDE "Core/Temp/Input.hpp"
@@ -68,6 +90,10 @@
 #include "Core/Modules/Exceptions/Tilia_Exception.hpp"
 
 #include "Core/Modules/File_System/Windows/File_System.hpp"
+#include "Core/Modules/File_System/Windows/Mapped_File.hpp"
+
+#include "Core/Modules/Jobs/Job_System.hpp"
+#include "Core/Modules/Jobs/Work_Stealing_Deque.hpp"
 
 #include "Core/Modules/Rendering/OpenGL/3_3/Error_Handling.hpp"
 
@@ -75,15 +101,29 @@
 #include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Shader_Data.hpp"
 #include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Shader_Part.hpp"
 #include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Uniform_Buffer.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Uniform_Block.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Program_Binary_Cache.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Shader_Compiler.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Shader_Preprocessor.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Shader_Files/Shader_Variants.hpp"
 
 #include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Cube_Map.hpp"
 #include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Cube_Map_Data.hpp"
 #include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Texture_.hpp"
 #include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Texture_2D_.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Texture_Streamer.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Texture_Container.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Texture_Residency.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Texture_Files/Texture_Cache.hpp"
 
 #include "Core/Modules/Rendering/OpenGL/3_3/Abstractions/Buffer.hpp"
 
 #include "Core/Modules/Rendering/OpenGL/3_3/Batch.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Buffer_Pool.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Command_Buffer.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Frame_Packet.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Light_Manager.hpp"
+#include "Core/Modules/Rendering/OpenGL/3_3/Render_Thread.hpp"
 #include "Core/Modules/Rendering/OpenGL/3_3/Mesh.hpp"
 #include "Core/Modules/Rendering/OpenGL/3_3/Renderer.hpp"
 #include "Core/Modules/Rendering/OpenGL/3_3/Vertex.hpp"
@@ -98,6 +138,10 @@
 #include "Core/Modules/Windowing/Window_Properties.hpp"
 
 #include "Core/Modules/Images/Image.hpp"
+#include "Core/Modules/Images/Block_Encoder.hpp"
+#include "Core/Modules/Images/Mip_Generator.hpp"
+#include "Core/Modules/Images/Pixel_Converter.hpp"
+#include "Core/Modules/Images/Channel_Packer.hpp"
 
 #include "Core/Temp/Camera.hpp"
 #include "Core/Temp/Input.hpp"
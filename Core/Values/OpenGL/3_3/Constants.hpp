@@ -71,6 +71,24 @@ namespace tilia {
 			// The red, green, and blue color channels and the alpha channel, consists of 32 
 			// bits(4 bytes).
 			RGBA8 = 0x8058, 
+			// The red, green, and blue color channels, block compressed to 4 bits per texel. Also
+			// called DXT1, needs GL_EXT_texture_compression_s3tc.
+			BC1   = 0x83F0,
+			// The red, green, and blue color channels and the alpha channel, block compressed to 
+			// 8 bits per texel. Also called DXT5, needs GL_EXT_texture_compression_s3tc.
+			BC3   = 0x83F3,
+			// The red color channel, block compressed to 4 bits per texel. Also called RGTC1.
+			BC4   = 0x8DBB,
+			// The red and green color channels, block compressed to 8 bits per texel. Also called
+			// RGTC2.
+			BC5   = 0x8DBD,
+			// The red color channel, as a 16 bit float.
+			R16F    = 0x822D,
+			// The red, green, and blue color channels, as 16 bit floats(6 bytes).
+			RGB16F  = 0x881B,
+			// The red, green, and blue color channels and the alpha channel, as 16 bit floats(8
+			// bytes). For images of high dynamic range.
+			RGBA16F = 0x881A,
 		}; // Color_Format
 
 		// Different types of filtering modes for textures. Underlying value is the value defined
@@ -291,7 +309,9 @@ namespace tilia {
 			// Element buffer object, ebo.
 		    Element_Buffer = 0x8893, 
 			// Uniform buffer object, ubo.
-			Uniform_Buffer = 0x8A11  
+			Uniform_Buffer = 0x8A11, 
+			// Storage of a buffer texture, read in shaders with texelFetch.
+			Texture_Buffer = 0x8C2A  
 		}; // Buffer_Type
 
 		// Different ways to access openGL buffers. Add to buffer frequency value to combine into
@@ -16,6 +16,9 @@
 // Dependencies
 #include "vendor/glad/KHR_Debug_openGL_3_3/include/glad/glad.h"
 
+// Standard
+#include <cstring>
+
 // Headers
 #include "Utils.hpp"
 #include "Core/Values/Directories.hpp"
@@ -31,6 +34,23 @@ std::uint32_t tilia::utils::Get_Max_Textures()
 	return static_cast<std::uint32_t>(amount);
 }
 
+/**
+ * Walks the extensions listed by the driver looking for the given name
+ */
+bool tilia::utils::Has_Extension(const char* name)
+{
+	std::int32_t count{};
+	GL_CALL(glGetIntegerv(GL_NUM_EXTENSIONS, &count));
+	for (std::int32_t i{ 0 }; i < count; ++i)
+	{
+		GL_CALL(const auto extension{ reinterpret_cast<const char*>(
+			glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i))) });
+		if (extension != nullptr && std::strcmp(extension, name) == 0)
+			return true;
+	}
+	return false;
+}
+
 /**
  * Gets the amount of indecies needed for the given primitve
  */
@@ -59,12 +79,15 @@ std::uint32_t tilia::utils::Get_Color_Format_Count(const std::uint32_t& color_fo
 	{
 	case GL_RED:
 	case GL_R8:
+	case GL_R16F:
 		return 1;
 	case GL_RGB:
 	case GL_RGB8:
+	case GL_RGB16F:
 		return 3;
 	case GL_RGBA:
 	case GL_RGBA8:
+	case GL_RGBA16F:
 		return 4;
 	case GL_NONE:
 	default:
@@ -72,6 +95,44 @@ std::uint32_t tilia::utils::Get_Color_Format_Count(const std::uint32_t& color_fo
 	}
 }
 
+bool tilia::utils::Is_Half_Format(const std::uint32_t& color_format)
+{
+	switch (static_cast<enums::Color_Format>(color_format))
+	{
+	case enums::Color_Format::R16F:
+	case enums::Color_Format::RGB16F:
+	case enums::Color_Format::RGBA16F:
+		return true;
+	default:
+		return false;
+	}
+}
+
+std::uint32_t tilia::utils::Get_Color_Format_Type(const std::uint32_t& color_format)
+{
+	return (Is_Half_Format(color_format)) ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE;
+}
+
+std::uint32_t tilia::utils::Get_Color_Format_Size(const std::uint32_t& color_format)
+{
+	return Get_Color_Format_Count(color_format) *
+		((Is_Half_Format(color_format)) ? sizeof(std::uint16_t) : sizeof(std::uint8_t));
+}
+
+bool tilia::utils::Is_Compressed_Format(const std::uint32_t& color_format)
+{
+	switch (static_cast<enums::Color_Format>(color_format))
+	{
+	case enums::Color_Format::BC1:
+	case enums::Color_Format::BC3:
+	case enums::Color_Format::BC4:
+	case enums::Color_Format::BC5:
+		return true;
+	default:
+		return false;
+	}
+}
+
 const char* tilia::utils::Get_Cube_Map_Side_String(const std::uint32_t& cube_map_side)
 {
 	switch (cube_map_side)
@@ -109,16 +170,17 @@ tilia::enums::Data_Color_Format tilia::utils::Get_Data_Color_Format(
 	}
 }
 
-tilia::enums::Color_Format tilia::utils::Get_Color_Format(const std::uint32_t& color_format_count)
+tilia::enums::Color_Format tilia::utils::Get_Color_Format(const std::uint32_t& color_format_count,
+	bool half)
 {
 	switch (color_format_count)
 	{
 	case 1:
-		return enums::Color_Format::Red8;
+		return (half) ? enums::Color_Format::R16F : enums::Color_Format::Red8;
 	case 3:
-		return enums::Color_Format::RGB8;
+		return (half) ? enums::Color_Format::RGB16F : enums::Color_Format::RGB8;
 	case 4:
-		return enums::Color_Format::RGBA8;
+		return (half) ? enums::Color_Format::RGBA16F : enums::Color_Format::RGBA8;
 	default:
 		return enums::Color_Format::None;
 	}
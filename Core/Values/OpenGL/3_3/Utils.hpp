@@ -36,6 +36,13 @@ namespace tilia {
 		 */
 		std::uint32_t Get_Max_Textures();
 
+		/**
+		 * @brief Whether or not the driver lists the given extension
+		 * 
+		 * @param name - The name of the extension, such as GL_ARB_get_program_binary
+		 */
+		bool Has_Extension(const char* name);
+
 		/**
 		 * @brief Gets the smalles amount of indices needed for a primitve
 		 * 
@@ -45,10 +52,33 @@ namespace tilia {
 
 		std::uint32_t Get_Color_Format_Count(const std::uint32_t& color_format);
 
+		/**
+		 * @brief Whether or not the given color format holds 16 bit floats
+		 */
+		bool Is_Half_Format(const std::uint32_t& color_format);
+
+		/**
+		 * @brief Gets the openGL type of the values uploaded to a texture of the given
+		 * uncompressed color format, GL_HALF_FLOAT for half formats and GL_UNSIGNED_BYTE
+		 * otherwise
+		 */
+		std::uint32_t Get_Color_Format_Type(const std::uint32_t& color_format);
+
+		/**
+		 * @brief Gets the size in bytes of a texel of the given uncompressed color format
+		 */
+		std::uint32_t Get_Color_Format_Size(const std::uint32_t& color_format);
+
+		/**
+		 * @brief Whether or not the given color format is block compressed
+		 */
+		bool Is_Compressed_Format(const std::uint32_t& color_format);
+
 		const char* Get_Cube_Map_Side_String(const std::uint32_t& cube_map_side);
 
 		enums::Data_Color_Format Get_Data_Color_Format(const std::uint32_t& color_format_count);
-		enums::Color_Format Get_Color_Format(const std::uint32_t& color_format_count);
+		enums::Color_Format Get_Color_Format(const std::uint32_t& color_format_count,
+			bool half = false);
 
 		std::size_t Get_Shader_Type_Index(const enums::Shader_Type& type);
 		enums::Shader_Type Get_Index_Shader_Type(const std::size_t index);
@@ -12,6 +12,7 @@
 #include <memory>
 #include <vector>
 #include <map>
+#include <filesystem>
 
 #include "Values/Directories.hpp"
 
@@ -34,13 +35,30 @@
 #include TILIA_TEMP_LIMIT_FPS_INCLUDE
 #include TILIA_TEMP_STOPWATCH_INCLUDE
 #include TILIA_OPENGL_3_3_UNIFORM_BUFFER_INCLUDE
+#include TILIA_OPENGL_3_3_UNIFORM_BLOCK_INCLUDE
+#include TILIA_OPENGL_3_3_PROGRAM_BINARY_CACHE_INCLUDE
+#include TILIA_OPENGL_3_3_SHADER_COMPILER_INCLUDE
+#include TILIA_OPENGL_3_3_SHADER_PREPROCESSOR_INCLUDE
+#include TILIA_OPENGL_3_3_SHADER_VARIANTS_INCLUDE
+#include TILIA_OPENGL_3_3_TEXTURE_STREAMER_INCLUDE
+#include TILIA_BLOCK_ENCODER_INCLUDE
+#include TILIA_OPENGL_3_3_TEXTURE_CONTAINER_INCLUDE
+#include TILIA_MIP_GENERATOR_INCLUDE
+#include TILIA_PIXEL_CONVERTER_INCLUDE
+#include TILIA_CHANNEL_PACKER_INCLUDE
+#include TILIA_OPENGL_3_3_TEXTURE_RESIDENCY_INCLUDE
+#include TILIA_OPENGL_3_3_TEXTURE_CACHE_INCLUDE
 #include TILIA_CONSTANTS_INCLUDE
 #include TILIA_OPENGL_3_3_BUFFER_INCLUDE
 #include TILIA_WINDOW_INCLUDE
 #include TILIA_MONITOR_INCLUDE
 #include TILIA_IMAGE_INCLUDE
+#include TILIA_JOB_SYSTEM_INCLUDE
+#include TILIA_OPENGL_3_3_RENDER_THREAD_INCLUDE
+#include TILIA_OPENGL_3_3_LIGHT_MANAGER_INCLUDE
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
+void framebuffer_resize_callback(GLFWwindow* window, int width, int height);
 void processInput();
 
 void error_callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam)
@@ -74,6 +92,8 @@ static Logger& logger{ Logger::Instance() };
 
 static Exception_Handler& handler{ Exception_Handler::Instance() };
 
+static jobs::Job_System& job_system{ jobs::Job_System::Instance() };
+
 bool print_opengl_things{ false };
 
 enums::Polymode polymode{ enums::Polymode::Fill };
@@ -319,6 +339,7 @@ int main()
 
 #if 0
 
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #define CATCH_CONFIG_RUNNER
 #include "vendor/Catch2/Catch2.hpp"
 
@@ -426,6 +447,82 @@ TEST_CASE("Image", "[Image]") {
     tilia::Image::Test();
 }
 
+TEST_CASE("Job_System", "[Job_System]") {
+    tilia::jobs::Job_System::Test();
+}
+
+TEST_CASE("Render_Thread", "[Render_Thread]") {
+    tilia::gfx::Render_Thread::Test();
+}
+
+TEST_CASE("Command_Buffer", "[Command_Buffer]") {
+    tilia::gfx::Command_Buffer::Test();
+}
+
+TEST_CASE("Buffer_Pool", "[Buffer_Pool]") {
+    tilia::gfx::Buffer_Pool::Test();
+}
+
+TEST_CASE("Batch", "[Batch]") {
+    tilia::gfx::Batch::Test();
+}
+
+TEST_CASE("Light_Manager", "[Light_Manager]") {
+    tilia::gfx::Light_Manager::Test();
+}
+
+TEST_CASE("Uniform_Buffer", "[Uniform_Buffer]") {
+    tilia::gfx::Uniform_Buffer::Test();
+}
+
+TEST_CASE("Program_Binary_Cache", "[Program_Binary_Cache]") {
+    tilia::gfx::Program_Binary_Cache::Test();
+}
+
+TEST_CASE("Shader_Compiler", "[Shader_Compiler]") {
+    tilia::gfx::Shader_Compiler::Test();
+}
+
+TEST_CASE("Shader_Preprocessor", "[Shader_Preprocessor]") {
+    tilia::gfx::Shader_Preprocessor::Test();
+}
+
+TEST_CASE("Shader_Variants", "[Shader_Variants]") {
+    tilia::gfx::Shader_Variants::Test();
+}
+
+TEST_CASE("Texture_Streamer", "[Texture_Streamer]") {
+    tilia::gfx::Texture_Streamer::Test();
+}
+
+TEST_CASE("Block_Encoder", "[Block_Encoder]") {
+    tilia::Block_Encoder::Test();
+}
+
+TEST_CASE("Texture_Container", "[Texture_Container]") {
+    tilia::gfx::Texture_Container::Test();
+}
+
+TEST_CASE("Mip_Generator", "[Mip_Generator]") {
+    tilia::Mip_Generator::Test();
+}
+
+TEST_CASE("Pixel_Converter", "[Pixel_Converter]") {
+    tilia::Pixel_Converter::Test();
+}
+
+TEST_CASE("Texture_Residency", "[Texture_Residency]") {
+    tilia::gfx::Texture_Residency::Test();
+}
+
+TEST_CASE("Texture_Cache", "[Texture_Cache]") {
+    tilia::gfx::Texture_Cache::Test();
+}
+
+TEST_CASE("Channel_Packer", "[Channel_Packer]") {
+    tilia::Channel_Packer::Test();
+}
+
 #endif
 
 #if 1
@@ -449,6 +546,8 @@ int main()
             logger.Add_Output_Filter(std::cout.rdbuf(), "debug severity message");
         }
 
+        job_system.Init();
+
         // glfw: initialize and configure
         // ------------------------------
         windowing::Window::Init();
@@ -866,6 +965,8 @@ int main()
 
 
 
+            job_system.Update();
+
             handler.Update();
 
             // glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
@@ -880,6 +981,8 @@ int main()
 
         }
 
+        job_system.Terminate();
+
         window.Destroy();
 
         // optional: de-allocate all resources once they've outlived their purpose:
@@ -1092,7 +1195,8 @@ int main()
             return -1;
         }
         glfwMakeContextCurrent(window);
-        glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+        // The context is current on the render thread, so resizing only records the size
+        glfwSetFramebufferSizeCallback(window, framebuffer_resize_callback);
         
         // tell GLFW to capture our mouse
         //glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
@@ -1107,6 +1211,17 @@ int main()
             return -1;
         }
         
+        // Programs are loaded from their binaries when possible
+        Program_Binary_Cache::Instance().Init("cache/shaders", 
+            reinterpret_cast<Program_Binary_Cache::Load_Proc>(glfwGetProcAddress));
+        Shader_Compiler::Instance().Init(
+            reinterpret_cast<Shader_Compiler::Load_Proc>(glfwGetProcAddress));
+        // Streamed textures are decoded on the workers
+        job_system.Init();
+        Texture_Streamer::Instance().Init();
+        // Block compressed textures are only encoded the first time they are loaded
+        Block_Encoder::Instance().Init("cache/textures");
+
         input.Init(window);
 
         glEnable(GL_BLEND);
@@ -1128,6 +1243,9 @@ int main()
 
         // auto cube_shader{ std::make_shared<Shader<false>>(Shader<false>{ { "res/shaders/cube_shader.vert" }, { "res/shaders/cube_shader.frag" }, true }) };
 
+        // Every part is compiled and every shader linked once, all at the same time
+        Shader_Compiler::Instance().Begin_Batch();
+
         auto 
         light_v_shader{ std::make_shared<Shader_Part>("res/shaders/light_shader.vert", enums::Shader_Type::Vertex, true) },
         light_f_shader{ std::make_shared<Shader_Part>("res/shaders/light_shader.frag", enums::Shader_Type::Fragment, true) };
@@ -1136,6 +1254,11 @@ int main()
 
         light_shader->Init({ light_v_shader }, { light_f_shader }, {});
 
+        // The same program for the streamed boxes, whose texture has no packed channels
+        auto streamed_light_shader{ std::make_shared<Shader>() };
+
+        streamed_light_shader->Init({ light_v_shader }, { light_f_shader }, {});
+
         auto 
         cube_v_shader{ std::make_shared<Shader_Part>("res/shaders/cube_shader.vert", enums::Shader_Type::Vertex, true) },
         cube_f_shader{ std::make_shared<Shader_Part>("res/shaders/cube_shader.frag", enums::Shader_Type::Fragment, true) };
@@ -1144,17 +1267,65 @@ int main()
 
         cube_shader->Init({ cube_v_shader }, { cube_f_shader }, {});
 
-        Uniform_Buffer ub{};
-
-        ub.Init({ { "projection", { enums::GLSL_Scalar_Type::Float, enums::GLSL_Container_Type::Matrix4 } }, { "view", { enums::GLSL_Scalar_Type::Float, enums::GLSL_Container_Type::Matrix4 } } }, true);
+        Shader_Compiler::Instance().End_Batch();
 
-        ub.Set_Bind_Point(0);
+        // The Matrices block of the shaders, laid out at compile time
+        enum Matrices_Member : std::size_t { Projection, View };
+        Uniform_Block<glm::mat4, glm::mat4> ub{};
 
-        ub.Bind();
+        ub.Init(0);
 
         light_shader->Bind_Uniform_Block("Matrices", 0);
+        streamed_light_shader->Bind_Uniform_Block("Matrices", 0);
         cube_shader->Bind_Uniform_Block("Matrices", 0);
 
+        // The light textures are bound to the last slots, which the batches leave free
+        const uint32_t light_texture_slot{
+            utils::Get_Max_Textures() - Light_Manager::s_texture_count };
+        Batch::Limits batch_limits{ Batch::Get_Limits() };
+        batch_limits.reserved_textures = Light_Manager::s_texture_count;
+        Batch::Set_Limits(batch_limits);
+
+        Light_Manager light_manager{};
+        light_manager.Init({}, 1);
+        light_manager.Set_Shader_Uniforms(*light_shader, light_texture_slot);
+        light_manager.Set_Shader_Uniforms(*streamed_light_shader, light_texture_slot);
+
+        // Set every frame, so looked up once
+        const auto ambient_color{ light_shader->Get_Uniform_Handle("ambientColor") };
+        const auto view_pos{ light_shader->Get_Uniform_Handle("viewPos") };
+        const auto streamed_ambient_color{
+            streamed_light_shader->Get_Uniform_Handle("ambientColor") };
+        const auto streamed_view_pos{ streamed_light_shader->Get_Uniform_Handle("viewPos") };
+
+        // The specular map is packed into the alpha of the diffuse map when the assets are
+        // built, so that the boxes bind a single texture
+        const std::string packed_box_path{ "cache/textures/container2_packed.ttex" };
+        Channel_Packing box_packing{ Channel_Packing::Read(packed_box_path) };
+        if (!std::filesystem::exists(packed_box_path))
+        {
+            const Image packed_box{ Channel_Packer::Pack("res/textures/container2.png", 3,
+                { { enums::Material_Map::Specular, "res/textures/container2_specular.png" } },
+                box_packing) };
+            Texture_Container::Bake(std::vector<Image>(6, packed_box), packed_box_path,
+                enums::Color_Format::RGBA8);
+            box_packing.Write(packed_box_path);
+        }
+
+        // Loaded straight from the container, its mip levels streamed by how large the boxes
+        // are on screen
+        std::shared_ptr<Cube_Map> packed_box_texture{ std::make_shared<Cube_Map>() };
+        {
+            Texture_Container container{};
+            container.Open(packed_box_path);
+            packed_box_texture->Load_Container(container);
+        }
+        Texture_Residency::Instance().Track(packed_box_texture);
+
+        const auto specular_mask{ box_packing.Get_Mask(enums::Material_Map::Specular) };
+        light_shader->Uniform(Channel_Packing::Get_Uniform_Name(enums::Material_Map::Specular),
+            specular_mask.data(), specular_mask.size());
+
         Cube_Map_Data def{};
         
         def.sides[0].file_path = "res/textures/container2.png";
@@ -1164,26 +1335,18 @@ int main()
         def.sides[4].file_path = "res/textures/container2.png";
         def.sides[5].file_path = "res/textures/container2.png";
 
+        // Drawn with a placeholder until streamed in
         std::shared_ptr<Cube_Map> box_texture{ std::make_shared<Cube_Map>() };
-        box_texture->Set_Cube_Map_Data(def, true);
-        box_texture->Reload();
-        
-        // std::shared_ptr<Cube_Map> box_specular_texture{ std::make_shared<Cube_Map>() };
-        // box_specular_texture->Set_Paths({
-        //     "res/textures/container2_specular.png",
-        //     "res/textures/container2_specular.png",
-        //     "res/textures/container2_specular.png",
-        //     "res/textures/container2_specular.png",
-        //     "res/textures/container2_specular.png",
-        //     "res/textures/container2_specular.png"
-        // }, true);
-        // box_specular_texture->Reload();
+        box_texture->Set_Cube_Map_Data(def);
+        Texture_Streamer::Instance().Stream(box_texture);
+        // Evicted once unused while over budget, and streamed back in when bound again
+        Texture_Residency::Instance().Track(box_texture);
         
         //std::shared_ptr<Texture_2D_> tex_2d{ std::make_shared<Texture_2D_>() };
         //tex_2d->Set_Texture("res/teures/container2.png");
 
         constexpr size_t cube_count{ 10 };
-        constexpr size_t light_count{ 1 };
+        constexpr size_t light_count{ 4 };
         
         // positions all containers
         glm::vec3 cubePositions[] = {
@@ -1198,13 +1361,14 @@ int main()
             glm::vec3(1.5f,  0.2f, -1.5f),
             glm::vec3(-1.3f,  1.0f, -1.5f)
         };
-        // positions of the point lights
-        glm::vec3 pointLightPositions[] = {
-            glm::vec3(1.2f, 1.0f, 2.0f),
-            glm::vec3(2.3f, -3.3f, -4.0f),
-            glm::vec3(-4.0f,  2.0f, -12.0f),
-            glm::vec3(0.0f,  0.0f, -3.0f)
+        // the point lights
+        light_manager.Get_Lights() = {
+            { glm::vec3(1.2f, 1.0f, 2.0f), 10.0f },
+            { glm::vec3(2.3f, -3.3f, -4.0f), 10.0f },
+            { glm::vec3(-4.0f,  2.0f, -12.0f), 10.0f },
+            { glm::vec3(0.0f,  0.0f, -3.0f), 10.0f }
         };
+        const std::vector<Point_Light>& initial_lights{ light_manager.Get_Lights() };
 
         std::vector<std::shared_ptr<Mesh<9>>> meshes{};
         
@@ -1215,10 +1379,17 @@ int main()
 
             std::shared_ptr<Mesh<9>> new_mesh{ std::make_shared<Mesh<9>>() };
 
-            new_mesh->Set_Shader()(light_shader);
-
-            new_mesh->Add_Texture(box_texture);
-            //new_mesh->Add_Texture(box_specular_texture);
+            // Every other box is streamed in without its specular map
+            if (i % 2 == 0)
+            {
+                new_mesh->Set_Shader()(light_shader);
+                new_mesh->Add_Texture(packed_box_texture);
+            }
+            else
+            {
+                new_mesh->Set_Shader()(streamed_light_shader);
+                new_mesh->Add_Texture(box_texture);
+            }
 
             new_mesh->Set_Cull_Face()(enums::Face::Back);
 
@@ -1245,7 +1416,7 @@ int main()
 
             new_mesh->Set_Primitive()(enums::Primitive::Triangles);
 
-            model = glm::translate(glm::mat4{ 1.0f }, pointLightPositions[i]);
+            model = glm::translate(glm::mat4{ 1.0f }, initial_lights[i].position);
             model = glm::scale(model, { 0.2f, 0.2f, 0.2f });
 
             create_cube(*new_mesh, model);
@@ -1256,6 +1427,48 @@ int main()
 
         }
     
+        // The render thread owns the context from here on, rendering frame N while frame N + 1
+        // is simulated
+        glfwMakeContextCurrent(nullptr);
+
+        Render_Thread render_thread{};
+        render_thread.Start([window]() { glfwMakeContextCurrent(window); },
+            [&](const Frame_Packet& packet)
+            {
+                glViewport(0, 0, packet.viewport_size.x, packet.viewport_size.y);
+                glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+                ub.Set<Projection>(packet.projection);
+                ub.Set<View>(packet.view);
+                ub.Upload();
+
+                light_manager.Get_Lights() = packet.lights;
+                light_manager.Cull(packet.view, packet.projection, 0.01f, 100.0f, 
+                    packet.viewport_size.x, packet.viewport_size.y);
+                light_manager.Upload();
+                light_manager.Bind(light_texture_slot);
+
+                try
+                {
+                    Texture_Streamer::Instance().Update();
+                    Texture_Residency::Instance().Update();
+                    // Images only the cache still holds are dropped once textures are made
+                    Texture_Cache::Instance().Trim();
+                    renderer.Render(packet);
+                }
+                catch (const std::exception& e)
+                {
+                    std::cout << e.what() << '\n';
+                }
+
+                glfwSwapBuffers(window);
+            },
+            []() { glfwMakeContextCurrent(nullptr); });
+
+        // The lights simulated on this thread, copied into every frame packet
+        std::vector<Point_Light> point_lights{ light_manager.Get_Lights() };
+
         // render loop
         // -----------
         while (!glfwWindowShouldClose(window))
@@ -1266,7 +1479,7 @@ int main()
             if (!pause)
                 light_z += 1.0f * deltaTime;
 
-            pointLightPositions[0].z = -sinf(static_cast<float>(light_z)) * 5.0f;
+            point_lights[0].position.z = -sinf(static_cast<float>(light_z)) * 5.0f;
             
             for (size_t i = 0; i < cube_count + light_count; i++)
             {
@@ -1288,7 +1501,7 @@ int main()
                 else if (i >= cube_count)
                 {
 
-                    model = glm::translate(glm::mat4{ 1.0f }, pointLightPositions[i - cube_count]);
+                    model = glm::translate(glm::mat4{ 1.0f }, point_lights[i - cube_count].position);
 
                     model = glm::scale(model, glm::vec3{ 0.2f });
 
@@ -1310,43 +1523,29 @@ int main()
             std::cout << fps << " : " << deltaTime << " : " << add_angle << " : "<< angle << " : " << axis.x << " , " << axis.y << " , " << axis.z << '\n';
 
             processInput();
-            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
-            // pass projection matrix to shader (note that in this case it could change every frame)
-            glm::mat4 projection{ glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.01f, 100.0f) };
-            ub.Uniform("projection[0]", projection[0]);
-            ub.Uniform("projection[1]", projection[1]);
-            ub.Uniform("projection[2]", projection[2]);
-            ub.Uniform("projection[3]", projection[3]);
-
-            // camera/view transformation
-            glm::mat4 view{ camera.GetViewMatrix() };
-            ub.Uniform("view", view);
-
-            // glBindBuffer(GL_UNIFORM_BUFFER, ube_matrices);
-            // glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(projection));
-
-            // glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(view));
-            // glBindBuffer(GL_UNIFORM_BUFFER, 0);
+            // Everything the render thread needs is copied into the packet
+            Frame_Packet& packet{ render_thread.Begin_Frame() };
 
             renderer.m_camera_pos = camera.Position;
+            renderer.m_projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.01f, 100.0f);
+            renderer.m_view = camera.GetViewMatrix();
+            renderer.Build_Frame_Packet(packet);
 
-            light_shader->Uniform("lightColor", { 1.0f, 1.0f, 1.0f });
-            light_shader->Uniform("lightPos", pointLightPositions[0]);
+            packet.viewport_size = { SCR_WIDTH, SCR_HEIGHT };
+            packet.lights = point_lights;
+            packet.Uniform(light_shader, ambient_color, { 1.0f, 1.0f, 1.0f });
+            packet.Uniform(light_shader, view_pos, camera.Position);
+            packet.Uniform(streamed_light_shader, streamed_ambient_color, { 1.0f, 1.0f, 1.0f });
+            packet.Uniform(streamed_light_shader, streamed_view_pos, camera.Position);
 
-            try
-            {
-                renderer.Render();
-            }
-            catch (const std::exception& e)
-            {
-                std::cout << e.what() << '\n';
-            }
+            // Blocks while the render thread is still rendering the previous frame
+            render_thread.Submit_Frame();
 
-            // glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
-            // -------------------------------------------------------------------------------
-            glfwSwapBuffers(window);
+            job_system.Update();
+
+            // glfw: poll IO events (keys pressed/released, mouse moved etc.)
+            // ---------------------------------------------------------------
             glfwPollEvents();
             input.Update();
 
@@ -1354,9 +1553,23 @@ int main()
 
         }
 
+        render_thread.Stop();
+        glfwMakeContextCurrent(window);
+
         // optional: de-allocate all resources once they've outlived their purpose:
         // ------------------------------------------------------------------------
 
+        light_manager.Terminate();
+
+        const auto& shader_cache{ Program_Binary_Cache::Instance().Get_Stats() };
+        std::cout << "Program binary cache hit rate: " << shader_cache.Get_Hit_Rate() << " ("
+            << shader_cache.hits << " hits, " << shader_cache.misses << " misses, " 
+            << shader_cache.rejected << " rejected)\n";
+        Texture_Streamer::Instance().Terminate();
+        job_system.Terminate();
+        Program_Binary_Cache::Instance().Terminate();
+        Shader_Compiler::Instance().Terminate();
+
         // glfw: terminate, clearing all previously allocated GLFW resources.
         // ------------------------------------------------------------------
     }
@@ -1591,6 +1804,13 @@ void processInput()
 
 // glfw: whenever the window size changed (by OS or user resize) this callback function executes
 // ---------------------------------------------------------------------------------------------
+void framebuffer_resize_callback(GLFWwindow* window, int width, int height)
+{
+    // Only records the size, the viewport is set by the thread owning the context
+    SCR_WIDTH = width;
+    SCR_HEIGHT = height;
+}
+
 void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
     glfwMakeContextCurrent(window);
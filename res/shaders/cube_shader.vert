@@ -1,11 +1,7 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 
-layout (std140) uniform Matrices
-{
-    mat4 projection;
-    mat4 view;
-};
+#include "include/matrices.glsl"
 
 void main()
 {
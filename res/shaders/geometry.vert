@@ -2,11 +2,7 @@
 layout (location = 0) in vec2 aPos;
 layout (location = 1) in vec3 aColor;
 
-layout (std140) uniform Matrices
-{
-    mat4 projection;
-    mat4 view;
-};
+#include "include/matrices.glsl"
 
 out VS_OUT {
     vec3 color;
@@ -0,0 +1,43 @@
+// Unpacks the single channel maps packed into the channels of other maps by
+// tilia::Channel_Packer. Include after the #version line, set the mask of every packed map
+// from tilia::Channel_Packing::Get_Mask through the uniform named by Get_Uniform_Name, and pass
+// the texel of the packed texture to the getters. Maps which are not packed have an all zero
+// mask and unpack to their fallback.
+
+// Selects the channel holding each map
+uniform vec4 tilia_specular_channel;
+uniform vec4 tilia_roughness_channel;
+uniform vec4 tilia_metallic_channel;
+uniform vec4 tilia_occlusion_channel;
+uniform vec4 tilia_mask_channel;
+
+float Tilia_Unpack(vec4 texel, vec4 channel, float fallback)
+{
+    // The mask sums to one when the map is packed and to zero otherwise
+    return dot(texel, channel) + fallback * (1.0 - dot(channel, vec4(1.0)));
+}
+
+float Tilia_Get_Specular(vec4 texel)
+{
+    return Tilia_Unpack(texel, tilia_specular_channel, 1.0);
+}
+
+float Tilia_Get_Roughness(vec4 texel)
+{
+    return Tilia_Unpack(texel, tilia_roughness_channel, 1.0);
+}
+
+float Tilia_Get_Metallic(vec4 texel)
+{
+    return Tilia_Unpack(texel, tilia_metallic_channel, 0.0);
+}
+
+float Tilia_Get_Occlusion(vec4 texel)
+{
+    return Tilia_Unpack(texel, tilia_occlusion_channel, 1.0);
+}
+
+float Tilia_Get_Mask(vec4 texel)
+{
+    return Tilia_Unpack(texel, tilia_mask_channel, 1.0);
+}
@@ -0,0 +1,96 @@
+// Clustered point lights, filled by tilia::gfx::Light_Manager.
+// Include after the #version line and call Tilia_Point_Lights with the view depth of the
+// fragment, which is the negated z of its view space position.
+
+// Two texels per light: position and radius, then color and intensity
+uniform samplerBuffer tilia_light_data;
+// Per cluster: offset into tilia_light_indices and light count
+uniform usamplerBuffer tilia_light_grid;
+// The lights of every cluster after each other
+uniform usamplerBuffer tilia_light_indices;
+
+layout (std140) uniform Light_Clusters
+{
+    // Clusters along x, y and z, and the total light count
+    uvec4 tilia_cluster_grid;
+    // Slice scale, slice bias, near and far
+    vec4 tilia_cluster_depth;
+    // Clusters per pixel along x and y
+    vec4 tilia_cluster_tile;
+};
+
+int Tilia_Get_Cluster(float view_depth)
+{
+    vec2 max_tile = vec2(tilia_cluster_grid.xy - uvec2(1u));
+    uvec2 tile = uvec2(clamp(floor(gl_FragCoord.xy * tilia_cluster_tile.xy), vec2(0.0), max_tile));
+
+    float slice = floor(log(max(view_depth, tilia_cluster_depth.z)) * tilia_cluster_depth.x +
+        tilia_cluster_depth.y);
+    uint z = uint(clamp(slice, 0.0, float(tilia_cluster_grid.z - 1u)));
+
+    return int(tile.x + tilia_cluster_grid.x * (tile.y + tilia_cluster_grid.y * z));
+}
+
+vec3 Tilia_Point_Lights(vec3 frag_pos, vec3 normal, float view_depth)
+{
+    uvec2 range = texelFetch(tilia_light_grid, Tilia_Get_Cluster(view_depth)).xy;
+
+    vec3 result = vec3(0.0);
+
+    for (uint i = 0u; i < range.y; ++i)
+    {
+        int light = int(texelFetch(tilia_light_indices, int(range.x + i)).r);
+
+        vec4 position_radius = texelFetch(tilia_light_data, light * 2);
+        vec4 color_intensity = texelFetch(tilia_light_data, light * 2 + 1);
+
+        vec3 to_light = position_radius.xyz - frag_pos;
+        float distance = length(to_light);
+
+        float attenuation = clamp(1.0 - distance / position_radius.w, 0.0, 1.0);
+        attenuation *= attenuation;
+
+        float diffuse = max(dot(normal, to_light / max(distance, 0.0001)), 0.0);
+
+        result += diffuse * attenuation * color_intensity.rgb * color_intensity.a;
+    }
+
+    return result;
+}
+
+// As Tilia_Point_Lights, also summing the Blinn-Phong highlights of the lights into specular,
+// seen along view_dir from the fragment to the camera
+vec3 Tilia_Point_Lights(vec3 frag_pos, vec3 normal, float view_depth, vec3 view_dir,
+    float shininess, out vec3 specular)
+{
+    uvec2 range = texelFetch(tilia_light_grid, Tilia_Get_Cluster(view_depth)).xy;
+
+    vec3 result = vec3(0.0);
+    specular = vec3(0.0);
+
+    for (uint i = 0u; i < range.y; ++i)
+    {
+        int light = int(texelFetch(tilia_light_indices, int(range.x + i)).r);
+
+        vec4 position_radius = texelFetch(tilia_light_data, light * 2);
+        vec4 color_intensity = texelFetch(tilia_light_data, light * 2 + 1);
+
+        vec3 to_light = position_radius.xyz - frag_pos;
+        float distance = length(to_light);
+        vec3 light_dir = to_light / max(distance, 0.0001);
+
+        float attenuation = clamp(1.0 - distance / position_radius.w, 0.0, 1.0);
+        attenuation *= attenuation;
+
+        vec3 radiance = attenuation * color_intensity.rgb * color_intensity.a;
+
+        float diffuse = max(dot(normal, light_dir), 0.0);
+        float highlight = (diffuse > 0.0) ?
+            pow(max(dot(normal, normalize(light_dir + view_dir)), 0.0), shininess) : 0.0;
+
+        result += diffuse * radiance;
+        specular += highlight * radiance;
+    }
+
+    return result;
+}
@@ -0,0 +1,7 @@
+// The camera matrices, bound to the uniform block binding point 0 by the renderer.
+
+layout (std140) uniform Matrices
+{
+    mat4 projection;
+    mat4 view;
+};
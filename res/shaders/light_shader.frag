@@ -1,27 +1,34 @@
 #version 330 core
+#include "include/clustered_lights.glsl"
+#include "include/channel_packing.glsl"
+
 out vec4 FragColor;
 
 in vec3 FragPos;
 in vec3 Normal;
 in vec3 Tex_Coords;
+in float View_Depth;
 
 uniform samplerCube cube_map;
 
-uniform vec3 lightColor;
-uniform vec3 lightPos;
+uniform vec3 ambientColor;
+uniform vec3 viewPos;
 
 void main()
 {
     float ambientStrength = 0.1;
-    vec3 ambient = ambientStrength * lightColor;
+    vec3 ambient = ambientStrength * ambientColor;
 
     vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(lightPos - FragPos);  
+    vec3 viewDir = normalize(viewPos - FragPos);
+
+    vec3 specular;
+    vec3 diffuse = Tilia_Point_Lights(FragPos, norm, View_Depth, viewDir, 32.0, specular);
 
-    float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor;
+    // The specular map is packed into a channel of the diffuse map
+    vec4 texel = texture(cube_map, Tex_Coords);
 
-    vec3 result = (ambient + diffuse) * texture(cube_map, Tex_Coords).rgb;
+    vec3 result = (ambient + diffuse) * texel.rgb + specular * Tilia_Get_Specular(texel);
       
     FragColor = vec4(result, 1.0);
     //FragColor = vec4(abs(Normal), 1.0);
@@ -6,17 +6,15 @@ layout (location = 2) in vec3 tex_coords;
 out vec3 FragPos;
 out vec3 Normal;
 out vec3 Tex_Coords;
+out float View_Depth;
 
-layout (std140) uniform Matrices
-{
-    mat4 projection;
-    mat4 view;
-};
+#include "include/matrices.glsl"
 
 void main()
 {
     Tex_Coords = tex_coords;
     FragPos = aPos;
     Normal = aNormal;  
+    View_Depth = -(view * vec4(aPos, 1.0)).z;
     gl_Position = projection * view * vec4(aPos, 1.0);
 }
\ No newline at end of file